@@ -9,7 +9,7 @@
 #include "fakeoptimatrix.hpp"
 
 /***********************************************************************/
-FakeOptiMatrix::FakeOptiMatrix() : OptiMatrix() {
+FakeOptiMatrix::FakeOptiMatrix(bool overlap) : OptiMatrix() {
     try {
         m = MothurOut::getInstance();
         
@@ -19,7 +19,7 @@ FakeOptiMatrix::FakeOptiMatrix() : OptiMatrix() {
         //create 90 non singletons
         for (int i = 0; i < 90; i++) { nameMap.push_back(toString(i));  }
         
-        closeness.resize(90);
+        vector< vector<int> > closeness(90);
         int count = 0;
         for (int i = 0; i < 9; i++) {
             set<int> close;
@@ -28,10 +28,21 @@ FakeOptiMatrix::FakeOptiMatrix() : OptiMatrix() {
             
             for (set<int>::iterator it = close.begin(); it != close.end(); it++) {
                 //add close sequences to each sequence in this set, do not include self
-                for (int j = 0; j < 10; j++) { if ((j+count) != *it) {   closeness[j+count].insert(*it);  } }
+                for (int j = 0; j < 10; j++) { if ((j+count) != *it) {   closeness[j+count].push_back(*it);  } }
             }
             count += 10;
         }
+        
+        if (overlap) { //the first 3 sequences in each set are also close to the first 3 in the next set, and the last 2 in each set are not close to each other
+            for (int i = 0; i < 80; i++) {
+                if ((i%10) < 3) { closeness[i].push_back(i+10); closeness[i+10].push_back(i); }
+            }
+            for (int i = 8; i < 90; i+=10) {
+                closeness[i].erase(remove(closeness[i].begin(), closeness[i].end(), i+1), closeness[i].end());
+                closeness[i+1].erase(remove(closeness[i+1].begin(), closeness[i+1].end(), i), closeness[i+1].end());
+            }
+        }
+        setCloseness(closeness);
     }
     catch(exception& e) {
         m->errorOut(e, "FakeOptiMatrix", "FakeOptiMatrix");
@@ -14,7 +14,7 @@
 class FakeOptiMatrix : public OptiMatrix {
     
 public:
-    FakeOptiMatrix(); 
+    FakeOptiMatrix(bool overlap = false); //9 sets of 10 close sequences and 10 singletons, overlap links neighboring sets
     ~FakeOptiMatrix(){ }
 };
 
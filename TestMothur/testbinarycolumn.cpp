@@ -0,0 +1,313 @@
+//
+//  testbinarycolumn.cpp
+//  Mothur
+//
+//
+
+#include "testbinarycolumn.h"
+#include "distancecommand.h"
+
+/**************************************************************************************************/
+//families of aligned seqs with a few differences each, so some distances are under the cutoff and some aren't
+TestBinaryColumn::TestBinaryColumn() {  //setup
+    m = MothurOut::getInstance();
+    m->setRandomSeed(19760620);
+    util = Utils(); //seeded from the seed just set
+    
+    fastaFile = "testbinarycolumn.fasta";
+    nameFile = "testbinarycolumn.names";
+    
+    string bases = "ACGT";
+    ofstream out, outName;
+    util.openOutputFile(fastaFile, out);
+    util.openOutputFile(nameFile, outName);
+    
+    for (int i = 0; i < 6; i++) {
+        string parent(120, '-');
+        for (int j = 0; j < parent.length(); j++) { if (util.getRandomIndex(5) != 0) { parent[j] = bases[util.getRandomIndex(3)]; } }
+        
+        for (int j = 0; j < 25; j++) {
+            string seq = parent;
+            int numEdits = util.getRandomIndex(15);
+            for (int k = 0; k < numEdits; k++) { seq[util.getRandomIndex(seq.length()-1)] = bases[util.getRandomIndex(3)]; }
+            int endGaps = util.getRandomIndex(4);
+            for (int k = 0; k < endGaps; k++) { seq[k] = '.'; }
+            
+            string name = "seq" + toString(i) + "_" + toString(j);
+            out << '>' << name << endl << seq << endl;
+            outName << name << '\t' << name << endl;
+        }
+    }
+    out.close(); outName.close();
+    
+    columnFile = runDistSeqs("column");
+    binaryFile = runDistSeqs("binary");
+}
+/**************************************************************************************************/
+TestBinaryColumn::~TestBinaryColumn() {
+    util.mothurRemove(fastaFile); util.mothurRemove(nameFile);
+    util.mothurRemove(columnFile); util.mothurRemove(binaryFile);
+    m->setControl_pressed(false);
+}
+/**************************************************************************************************/
+string TestBinaryColumn::runDistSeqs(string output) {
+    Command* distCommand = new DistanceCommand("fasta=" + fastaFile + ", cutoff=0.1, processors=2, output=" + output);
+    distCommand->execute();
+    
+    map<string, vector<string> > outputFilenames = distCommand->getOutputFiles();
+    delete distCommand;
+    
+    return outputFilenames["column"][0];
+}
+/**************************************************************************************************/
+map< pair<string, string>, float > TestBinaryColumn::readText(string filename) {
+    map< pair<string, string>, float > dists;
+    
+    ifstream in; util.openInputFile(filename, in);
+    string first, second; float dist;
+    while (in >> first >> second >> dist) {
+        if (second < first) { swap(first, second); }
+        dists[make_pair(first, second)] = dist;
+    }
+    in.close();
+    
+    return dists;
+}
+/**************************************************************************************************/
+map< pair<string, string>, float > TestBinaryColumn::readBinary(string filename) {
+    map< pair<string, string>, float > dists;
+    
+    BinaryColumnFile in(filename);
+    string first, second; float dist;
+    while (in.read(first, second, dist)) {
+        if (second < first) { swap(first, second); }
+        dists[make_pair(first, second)] = dist;
+    }
+    
+    return dists;
+}
+/**************************************************************************************************/
+set< pair<string, string> > TestBinaryColumn::getClosePairs(OptiMatrix& matrix) {
+    set< pair<string, string> > pairs;
+    
+    for (int i = 0; i < matrix.getNumSeqs(); i++) {
+        closeSeqsRange closeSeqs = matrix.getCloseSeqs(i);
+        for (const int* it = closeSeqs.begin(); it != closeSeqs.end(); it++) {
+            string first = matrix.getName(i); string second = matrix.getName(*it);
+            if (second < first) { swap(first, second); }
+            pairs.insert(make_pair(first, second));
+        }
+    }
+    
+    return pairs;
+}
+/**************************************************************************************************/
+void TestBinaryColumn::writeFile(string filename, string contents) {
+    ofstream out; util.openOutputFileBinary(filename, out);
+    out.write(contents.c_str(), contents.length());
+    out.close();
+}
+/**************************************************************************************************/
+TEST(TestBinaryColumn, sameAsText) {
+    TestBinaryColumn test;
+    
+    EXPECT_FALSE(BinaryColumnFile::isBinary(test.columnFile));
+    ASSERT_TRUE(BinaryColumnFile::isBinary(test.binaryFile));
+    
+    map< pair<string, string>, float > textDists = test.readText(test.columnFile);
+    map< pair<string, string>, float > binaryDists = test.readBinary(test.binaryFile);
+    
+    EXPECT_GT(textDists.size(), 100);
+    ASSERT_EQ(textDists.size(), binaryDists.size());
+    for (map< pair<string, string>, float >::iterator it = textDists.begin(); it != textDists.end(); it++) {
+        map< pair<string, string>, float >::iterator itBinary = binaryDists.find(it->first);
+        ASSERT_TRUE(itBinary != binaryDists.end()) << it->first.first << " " << it->first.second;
+        EXPECT_NEAR(it->second, itBinary->second, 0.00001); //the text file has 6 digits
+    }
+}
+/**************************************************************************************************/
+TEST(TestBinaryColumn, optiMatrixSameAsText) {
+    TestBinaryColumn test;
+    
+    for (double cutoff = 0.02; cutoff < 0.1; cutoff += 0.03) {
+        OptiMatrix text(test.columnFile, test.nameFile, "name", "column", cutoff, false);
+        OptiMatrix binary(test.binaryFile, test.nameFile, "name", "column", cutoff, false);
+        
+        ASSERT_FALSE(MothurOut::getInstance()->getControl_pressed());
+        EXPECT_EQ(text.getNumSeqs(), binary.getNumSeqs());
+        EXPECT_EQ(text.getNumSingletons(), binary.getNumSingletons());
+        EXPECT_EQ(text.getNumDists(), binary.getNumDists());
+        EXPECT_EQ(test.getClosePairs(text), test.getClosePairs(binary));
+    }
+}
+/**************************************************************************************************/
+//rows out of order, empty rows and columns that take more than one byte
+TEST(TestBinaryColumn, writeRead) {
+    TestBinaryColumn test;
+    
+    vector<string> names; for (int i = 0; i < 20000; i++) { names.push_back("n" + toString(i)); }
+    string contents = BinaryColumnFile::getHeader(names);
+    
+    vector<int> columns; vector<float> dists;
+    columns.push_back(3); columns.push_back(200); columns.push_back(19000); dists.push_back(0.5); dists.push_back(0.25); dists.push_back(-1);
+    BinaryColumnFile::appendRow(contents, 19999, columns, dists);
+    columns.clear(); dists.clear();
+    BinaryColumnFile::appendRow(contents, 5, columns, dists); //no distances, nothing written
+    columns.push_back(0); dists.push_back(0.125);
+    BinaryColumnFile::appendRow(contents, 1, columns, dists);
+    test.writeFile("testbinarycolumn.written.dist", contents);
+    
+    BinaryColumnFile in("testbinarycolumn.written.dist");
+    ASSERT_TRUE(in.getOpen());
+    ASSERT_EQ(20000, in.getNumNames());
+    
+    int row, column; float dist;
+    for (int pass = 0; pass < 2; pass++) {
+        ASSERT_TRUE(in.read(row, column, dist)); EXPECT_EQ(19999, row); EXPECT_EQ(3, column); EXPECT_EQ(0.5, dist);
+        ASSERT_TRUE(in.read(row, column, dist)); EXPECT_EQ(19999, row); EXPECT_EQ(200, column); EXPECT_EQ(0.25, dist);
+        ASSERT_TRUE(in.read(row, column, dist)); EXPECT_EQ(19999, row); EXPECT_EQ(19000, column); EXPECT_EQ(-1, dist);
+        string first, second;
+        ASSERT_TRUE(in.read(first, second, dist)); EXPECT_EQ("n1", first); EXPECT_EQ("n0", second); EXPECT_EQ(0.125, dist);
+        EXPECT_FALSE(in.read(row, column, dist));
+        in.rewind();
+    }
+    EXPECT_FALSE(MothurOut::getInstance()->getControl_pressed());
+    
+    Utils util; util.mothurRemove("testbinarycolumn.written.dist");
+}
+/**************************************************************************************************/
+TEST(TestBinaryColumn, emptyAndTruncated) {
+    TestBinaryColumn test;
+    Utils util;
+    string filename = "testbinarycolumn.bad.dist";
+    
+    //an empty file is not binary, so it is read as a text column file
+    test.writeFile(filename, "");
+    EXPECT_FALSE(BinaryColumnFile::isBinary(filename));
+    
+    //names but no distances, everyone is a singleton
+    vector<string> names; names.push_back("seq0_0"); names.push_back("seq0_1");
+    test.writeFile(filename, BinaryColumnFile::getHeader(names));
+    {
+        BinaryColumnFile in(filename);
+        ASSERT_TRUE(in.getOpen());
+        int row, column; float dist;
+        EXPECT_FALSE(in.read(row, column, dist));
+        EXPECT_FALSE(MothurOut::getInstance()->getControl_pressed());
+    }
+    
+    ifstream in; util.openInputFileBinary(test.binaryFile, in);
+    string contents((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    in.close();
+    
+    //cut in the names
+    test.writeFile(filename, contents.substr(0, 20));
+    {
+        BinaryColumnFile bad(filename);
+        EXPECT_FALSE(bad.getOpen());
+    }
+    
+    //cut in the last distance
+    test.writeFile(filename, contents.substr(0, contents.length()-2));
+    test.readBinary(filename);
+    EXPECT_TRUE(MothurOut::getInstance()->getControl_pressed());
+    MothurOut::getInstance()->setControl_pressed(false);
+    
+    //not a binary file, or written by another version
+    string otherVersion = contents.substr(0, 30); otherVersion[4] = 2;
+    test.writeFile(filename, otherVersion);
+    {
+        BinaryColumnFile bad(filename);
+        EXPECT_FALSE(bad.getOpen());
+    }
+    
+    util.mothurRemove(filename);
+}
+/**************************************************************************************************/
+//a column that takes more than one byte, cut inside the distance or the row start after it
+TEST(TestBinaryColumn, truncatedAfterLongVarint) {
+    TestBinaryColumn test;
+    string filename = "testbinarycolumn.bad.dist";
+    
+    vector<string> names; for (int i = 0; i < 200; i++) { names.push_back("n" + toString(i)); }
+    string header = BinaryColumnFile::getHeader(names);
+    
+    string row = "";
+    vector<int> columns; vector<float> dists;
+    columns.push_back(140); dists.push_back(0.5);
+    BinaryColumnFile::appendRow(row, 150, columns, dists); //2 byte row, 1 byte count, 2 byte column, then the distance
+    
+    //the column and 3 bytes of the distance are more than the 5 bytes a read once needed
+    for (int cut = 1; cut < 4; cut++) {
+        test.writeFile(filename, header + row.substr(0, row.length()-cut));
+        BinaryColumnFile in(filename);
+        int thisRow, thisColumn; float dist;
+        EXPECT_FALSE(in.read(thisRow, thisColumn, dist)) << cut;
+        EXPECT_TRUE(MothurOut::getInstance()->getControl_pressed()) << cut;
+        MothurOut::getInstance()->setControl_pressed(false);
+    }
+    
+    //half of the next row start
+    test.writeFile(filename, header + row + row.substr(0, 1));
+    {
+        BinaryColumnFile in(filename);
+        int thisRow, thisColumn; float dist;
+        ASSERT_TRUE(in.read(thisRow, thisColumn, dist));
+        EXPECT_EQ(150, thisRow); EXPECT_EQ(140, thisColumn); EXPECT_EQ(0.5, dist);
+        EXPECT_FALSE(in.read(thisRow, thisColumn, dist));
+        EXPECT_TRUE(MothurOut::getInstance()->getControl_pressed());
+        MothurOut::getInstance()->setControl_pressed(false);
+    }
+    
+    Utils util; util.mothurRemove(filename);
+}
+/**************************************************************************************************/
+//a name without distances doesn't have to be in the name file, the same as in a text column file
+TEST(TestBinaryColumn, nameWithoutDistances) {
+    TestBinaryColumn test;
+    string filename = "testbinarycolumn.extra.dist";
+    
+    vector<string> names;
+    {
+        BinaryColumnFile in(test.binaryFile);
+        for (int i = 0; i < in.getNumNames(); i++) { names.push_back(in.getName(i)); }
+    }
+    string header = BinaryColumnFile::getHeader(names);
+    
+    ifstream in; Utils util; util.openInputFileBinary(test.binaryFile, in);
+    string contents((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    in.close();
+    
+    names.push_back("notInNames");
+    test.writeFile(filename, BinaryColumnFile::getHeader(names) + contents.substr(header.length()));
+    
+    OptiMatrix binary(test.binaryFile, test.nameFile, "name", "column", 0.05, false);
+    OptiMatrix extra(filename, test.nameFile, "name", "column", 0.05, false);
+    ASSERT_FALSE(MothurOut::getInstance()->getControl_pressed());
+    EXPECT_EQ(binary.getNumSingletons(), extra.getNumSingletons());
+    EXPECT_EQ(test.getClosePairs(binary), test.getClosePairs(extra));
+    
+    NameAssignment nameMap(test.nameFile); nameMap.readMap();
+    vector<long long> numDists;
+    string files[] = { test.binaryFile, filename };
+    for (int i = 0; i < 2; i++) {
+        ReadColumnMatrix read(files[i]);
+        read.setCutoff(0.05);
+        EXPECT_EQ(1, read.read(&nameMap));
+        numDists.push_back(0);
+        for (int j = 0; j < read.getDMatrix()->seqVec.size(); j++) { numDists[i] += read.getDMatrix()->seqVec[j].size(); }
+        delete read.getDMatrix(); delete read.getListVector();
+    }
+    EXPECT_GT(numDists[0], 0);
+    EXPECT_EQ(numDists[0], numDists[1]);
+    
+    util.mothurRemove(filename);
+}
+/**************************************************************************************************/
+//only cluster and cluster.split read binary files, so dist.seqs output=binary leaves the current column file alone
+TEST(TestBinaryColumn, notCurrentColumn) {
+    TestBinaryColumn test; //writes the column file, then the binary one
+    
+    EXPECT_EQ(test.columnFile, CurrentFile::getInstance()->getColumnFile());
+}
+/**************************************************************************************************/
@@ -0,0 +1,37 @@
+//
+//  testbinarycolumn.h
+//  Mothur
+//
+//
+
+#ifndef testbinarycolumn_h
+#define testbinarycolumn_h
+
+#include "gtest.h"
+#include "binarycolumn.h"
+#include "optimatrix.h"
+#include "readcolumn.h"
+#include "nameassignment.hpp"
+
+class TestBinaryColumn {
+    
+public:
+    
+    TestBinaryColumn();
+    ~TestBinaryColumn();
+    
+    string fastaFile, nameFile, columnFile, binaryFile;
+    
+    map< pair<string, string>, float > readText(string); //column file. distances keyed by the names in order
+    map< pair<string, string>, float > readBinary(string);
+    set< pair<string, string> > getClosePairs(OptiMatrix&); //close pairs by name, in order
+    void writeFile(string, string); //filename, contents
+    
+private:
+    MothurOut* m;
+    Utils util;
+    
+    string runDistSeqs(string); //output. returns the dist file
+};
+
+#endif /* testbinarycolumn_h */
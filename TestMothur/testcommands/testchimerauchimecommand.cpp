@@ -0,0 +1,116 @@
+//
+//  testchimerauchimecommand.cpp
+//  Mothur
+//
+//
+
+#include "testchimerauchimecommand.h"
+
+/**************************************************************************************************/
+//abundant parents, rarer point variants of them and rarer chimeras of two of them, so later queries
+//choose chimeras found earlier in the same batch as candidate parents
+TestChimeraUchimeCommand::TestChimeraUchimeCommand() {  //setup
+    m = MothurOut::getInstance();
+    m->setRandomSeed(19760620);
+    util = Utils(); //seeded from the seed just set
+    
+    fastaFile = "testchimerauchimecommand.fasta";
+    countFile = "testchimerauchimecommand.count_table";
+    
+    string bases = "ACGT";
+    string root = "";
+    for (int i = 0; i < 320; i++) { root += bases[util.getRandomIndex(3)]; }
+    
+    vector<string> parents;
+    for (int i = 0; i < 20; i++) {
+        string parent = root;
+        for (int j = 0; j < parent.length(); j++) { if (util.getRandomIndex(7) == 0) { parent[j] = bases[util.getRandomIndex(3)]; } }
+        parents.push_back(parent);
+    }
+    
+    ofstream out, outCount;
+    util.openOutputFile(fastaFile, out);
+    util.openOutputFile(countFile, outCount);
+    outCount << "Representative_Sequence\ttotal" << endl;
+    
+    for (int i = 0; i < 400; i++) {
+        string seq; int abund;
+        if (i < parents.size()) { seq = parents[i]; abund = 50 + util.getRandomIndex(450); }
+        else if (util.getRandomIndex(2) == 0) {
+            int a = util.getRandomIndex(parents.size()-1);
+            int b = util.getRandomIndex(parents.size()-1);
+            if (a == b) { b = (a + 1) % parents.size(); }
+            int breakPoint = 60 + util.getRandomIndex(200);
+            seq = parents[a].substr(0, breakPoint) + parents[b].substr(breakPoint);
+            abund = 1 + util.getRandomIndex(29);
+        }else {
+            seq = parents[util.getRandomIndex(parents.size()-1)];
+            for (int j = 0; j < 3; j++) { seq[util.getRandomIndex(seq.length()-1)] = bases[util.getRandomIndex(3)]; }
+            abund = 1 + util.getRandomIndex(9);
+        }
+        
+        string name = "seq" + toString(i);
+        out << '>' << name << endl << seq << endl;
+        outCount << name << '\t' << abund << endl;
+    }
+    out.close(); outCount.close();
+    
+    //mothur runs the uchime installed next to it. the tests run beside a uchime built from uchime_src
+    current = CurrentFile::getInstance();
+    programPath = current->getProgramPath();
+    if (programPath == "") { current->setProgramPath(string(".") + PATH_SEPARATOR); }
+    
+    string uchimeName = "uchime"; uchimeName += EXECUTABLE_EXT;
+    ifstream in;
+    foundUchime = util.openInputFile(current->getProgramPath() + uchimeName, in, "no error"); in.close();
+}
+/**************************************************************************************************/
+TestChimeraUchimeCommand::~TestChimeraUchimeCommand() {
+    util.mothurRemove(fastaFile); util.mothurRemove(countFile);
+    if (programPath == "") { current->setProgramPath(""); }
+    m->setControl_pressed(false);
+}
+/**************************************************************************************************/
+map<string, string> TestChimeraUchimeCommand::runUchime(int processors) {
+    Command* uchimeCommand = new ChimeraUchimeCommand("fasta=" + fastaFile + ", count=" + countFile + ", reference=self, chimealns=t, processors=" + toString(processors));
+    uchimeCommand->execute();
+    
+    map<string, vector<string> > outputFilenames = uchimeCommand->getOutputFiles();
+    delete uchimeCommand;
+    
+    map<string, string> contents;
+    string types[] = { "chimera", "accnos", "alns", "count" };
+    for (int i = 0; i < 4; i++) {
+        vector<string> filenames = outputFilenames[types[i]];
+        for (int j = 0; j < filenames.size(); j++) {
+            ifstream in; util.openInputFile(filenames[j], in);
+            while (!in.eof()) { contents[types[i]] += util.getline(in) + '\n'; util.gobble(in); }
+            in.close();
+            util.mothurRemove(filenames[j]);
+        }
+    }
+    
+    return contents;
+}
+/**************************************************************************************************/
+TEST(Test_Command_ChimeraUchime, selfProcessorsSameAsOne) {
+    TestChimeraUchimeCommand testUchime;
+    if (!testUchime.foundUchime) { cout << "uchime not found, skipping\n"; return; }
+    
+    map<string, string> one = testUchime.runUchime(1);
+    
+    ASSERT_NE(one["chimera"], "");
+    ASSERT_NE(one["accnos"], "");
+    ASSERT_NE(one["alns"], "");
+    
+    //the uchime processes check the sequences in batches, the batch size is 32 per process
+    int processors[] = { 2, 4, 7 };
+    for (int i = 0; i < 3; i++) {
+        map<string, string> several = testUchime.runUchime(processors[i]);
+        EXPECT_EQ(one["chimera"], several["chimera"]) << processors[i] << " processors";
+        EXPECT_EQ(one["accnos"], several["accnos"]) << processors[i] << " processors";
+        EXPECT_EQ(one["alns"], several["alns"]) << processors[i] << " processors";
+        EXPECT_EQ(one["count"], several["count"]) << processors[i] << " processors";
+    }
+}
+/**************************************************************************************************/
@@ -0,0 +1,32 @@
+//
+//  testchimerauchimecommand.h
+//  Mothur
+//
+//
+
+#ifndef testchimerauchimecommand_h
+#define testchimerauchimecommand_h
+
+#include "gtest.h"
+#include "chimerauchimecommand.h"
+
+class TestChimeraUchimeCommand {
+    
+public:
+    
+    TestChimeraUchimeCommand();
+    ~TestChimeraUchimeCommand();
+    
+    string fastaFile, countFile;
+    bool foundUchime;
+    
+    map<string, string> runUchime(int); //processors. returns the contents of the chimera, accnos and alns files
+    
+private:
+    MothurOut* m;
+    CurrentFile* current;
+    Utils util;
+    string programPath;
+};
+
+#endif /* testchimerauchimecommand_h */
@@ -0,0 +1,91 @@
+//
+//  testclustercommand.cpp
+//  Mothur
+//
+//
+
+#include "testclustercommand.h"
+
+/**************************************************************************************************/
+//tied distances, cells missing from the matrix and a sequence with no distances below the cutoff
+TestClusterCommand::TestClusterCommand() {  //setup
+    m = MothurOut::getInstance();
+    
+    columnFile = "testclustercommand.dist";
+    nameFile = "testclustercommand.names";
+    
+    ofstream out;
+    util.openOutputFile(columnFile, out);
+    out << "a\tb\t0.01\nc\td\t0.01\na\tc\t0.02\na\td\t0.02\nb\tc\t0.03\nb\td\t0.035\n";
+    out << "e\tf\t0.02\ne\tg\t0.03\nf\tg\t0.02\nc\te\t0.03\nd\te\t0.04\ng\th\t0.045\n";
+    out.close();
+    
+    util.openOutputFile(nameFile, out);
+    out << "a\ta,a2\nb\tb\nc\tc\nd\td\ne\te\nf\tf\ng\tg\nh\th,h2,h3\ni\ti\n";
+    out.close();
+}
+/**************************************************************************************************/
+TestClusterCommand::~TestClusterCommand() {
+    util.mothurRemove(columnFile); util.mothurRemove(nameFile);
+    m->setControl_pressed(false);
+}
+/**************************************************************************************************/
+map<string, string> TestClusterCommand::runCluster(string method) {
+    CurrentFile::getInstance()->clearCurrentFiles();
+    m->setRandomSeed(19760620); //ties are broken at random
+    
+    Command* clusterCommand = new ClusterCommand("column=" + columnFile + ", name=" + nameFile + ", cutoff=0.05, method=" + method);
+    clusterCommand->execute();
+    
+    map<string, vector<string> > outputFilenames = clusterCommand->getOutputFiles();
+    delete clusterCommand;
+    
+    map<string, string> contents;
+    for (map<string, vector<string> >::iterator it = outputFilenames.begin(); it != outputFilenames.end(); it++) {
+        for (int i = 0; i < it->second.size(); i++) {
+            ifstream in; util.openInputFile(it->second[i], in);
+            contents[it->first] += string((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+            in.close();
+            util.mothurRemove(it->second[i]);
+        }
+    }
+    
+    return contents;
+}
+/**************************************************************************************************/
+//the outputs cluster wrote when getSmallestCell searched every cell of the matrix. e-f and f-g tie at 0.02, and the tie
+//decides the OTUs at 0.02 for furthest, average and weighted. average and weighted lower the cutoff to 0.035 for the missing cells
+TEST(Test_Command_Cluster, sameAsOld) {
+    TestClusterCommand test;
+    
+    string unique = "unique\t9\th,h2,h3\ta,a2\tb\tc\td\te\tf\tg\ti\n";
+    string header = "label\tnumOtus\tOtu1\tOtu2\tOtu3\tOtu4\tOtu5\tOtu6\tOtu7\tOtu8\tOtu9\n";
+    string first = header + unique + "0.01\t7\ta,a2,b\th,h2,h3\tc,d\te\tf\tg\ti\n";
+    string firstRAbund = "unique\t9\t3\t2\t1\t1\t1\t1\t1\t1\t1\n0.01\t7\t3\t3\t2\t1\t1\t1\t1\n";
+    string firstSAbund = "unique\t3\t7\t1\t1\n0.01\t3\t4\t1\t2\n";
+    
+    string averageList = first + "0.02\t6\ta,a2,b\th,h2,h3\tc,d\tf,g\te\ti\n0.03\t4\ta,a2,b,c,d\te,f,g\th,h2,h3\ti\n";
+    string averageRAbund = firstRAbund + "0.02\t6\t3\t3\t2\t2\t1\t1\n0.03\t4\t5\t3\t3\t1\n";
+    string averageSAbund = firstSAbund + "0.02\t3\t2\t2\t2\n0.03\t5\t1\t0\t2\t0\t1\n";
+    
+    map<string, string> found = test.runCluster("average");
+    EXPECT_EQ(averageList, found["list"]);
+    EXPECT_EQ(averageRAbund, found["rabund"]);
+    EXPECT_EQ(averageSAbund, found["sabund"]);
+    
+    found = test.runCluster("weighted");
+    EXPECT_EQ(averageList, found["list"]);
+    EXPECT_EQ(averageRAbund, found["rabund"]);
+    EXPECT_EQ(averageSAbund, found["sabund"]);
+    
+    found = test.runCluster("furthest");
+    EXPECT_EQ(first + "0.02\t6\ta,a2,b\th,h2,h3\tc,d\tf,g\te\ti\n0.03\t5\ta,a2,b\te,f,g\th,h2,h3\tc,d\ti\n0.04\t4\ta,a2,b,c,d\te,f,g\th,h2,h3\ti\n", found["list"]);
+    EXPECT_EQ(firstRAbund + "0.02\t6\t3\t3\t2\t2\t1\t1\n0.03\t5\t3\t3\t3\t2\t1\n0.04\t4\t5\t3\t3\t1\n", found["rabund"]);
+    EXPECT_EQ(firstSAbund + "0.02\t3\t2\t2\t2\n0.03\t3\t1\t1\t3\n0.04\t5\t1\t0\t2\t0\t1\n", found["sabund"]);
+    
+    found = test.runCluster("nearest");
+    EXPECT_EQ(first + "0.02\t4\ta,a2,b,c,d\te,f,g\th,h2,h3\ti\n", found["list"]);
+    EXPECT_EQ(firstRAbund + "0.02\t4\t5\t3\t3\t1\n", found["rabund"]);
+    EXPECT_EQ(firstSAbund + "0.02\t5\t1\t0\t2\t0\t1\n", found["sabund"]);
+}
+/**************************************************************************************************/
@@ -0,0 +1,29 @@
+//
+//  testclustercommand.h
+//  Mothur
+//
+//
+
+#ifndef testclustercommand_h
+#define testclustercommand_h
+
+#include "gtest.h"
+#include "clustercommand.h"
+
+class TestClusterCommand {
+    
+public:
+    
+    TestClusterCommand();
+    ~TestClusterCommand();
+    
+    string columnFile, nameFile;
+    
+    map<string, string> runCluster(string); //method. returns the contents of the list, rabund and sabund outputs, and removes them
+    
+private:
+    MothurOut* m;
+    Utils util;
+};
+
+#endif /* testclustercommand_h */
@@ -0,0 +1,94 @@
+//
+//  testdeconvolutecommand.cpp
+//  Mothur
+//
+//
+
+#include "testdeconvolutecommand.h"
+
+/**************************************************************************************************/
+//reads with the same sequence, a name used twice and a name missing from the name file
+TestDeconvoluteCommand::TestDeconvoluteCommand() {  //setup
+    m = MothurOut::getInstance();
+    
+    //not the names unique.seqs gives its outputs
+    fastaFile = "testdeconvolutecommand.fasta";
+    nameFile = "testdeconvolutecommand.input.names";
+    countFile = "testdeconvolutecommand.input.count_table";
+    
+    ofstream out;
+    util.openOutputFile(fastaFile, out);
+    out << ">r1\nACGTACGT\n>r2\nACGTACGT\n>r3\nAGGTACGT\n>r4\nACGTACGT\n>r5\nAGGTACGT\n>r6\nTTTTACGT\n";
+    out << ">r2\nAGGTACGT\n>r8\nCCCCACGT\n>r9\nCCCCACGT\n";
+    out.close();
+    
+    util.openOutputFile(nameFile, out);
+    out << "r1\tr1,x1\nr2\tr2\nr3\tr3,x3,y3\nr4\tr4\nr5\tr5\nr6\tr6\nr9\tr9,x9\n";
+    out.close();
+    
+    util.openOutputFile(countFile, out);
+    out << "Representative_Sequence\ttotal\nr1\t2\nr2\t1\nr3\t3\nr4\t1\nr5\t1\nr6\t1\nr8\t1\nr9\t2\n";
+    out.close();
+}
+/**************************************************************************************************/
+TestDeconvoluteCommand::~TestDeconvoluteCommand() {
+    util.mothurRemove(fastaFile); util.mothurRemove(nameFile); util.mothurRemove(countFile);
+    m->setControl_pressed(false);
+}
+/**************************************************************************************************/
+map<string, string> TestDeconvoluteCommand::runUniqueSeqs(string options) {
+    CurrentFile::getInstance()->clearCurrentFiles(); //so the outputs of the last run are not used
+    
+    Command* uniqueCommand = new DeconvoluteCommand("fasta=" + fastaFile + options);
+    uniqueCommand->execute();
+    
+    map<string, vector<string> > outputFilenames = uniqueCommand->getOutputFiles();
+    delete uniqueCommand;
+    
+    map<string, string> contents;
+    for (map<string, vector<string> >::iterator it = outputFilenames.begin(); it != outputFilenames.end(); it++) {
+        for (int i = 0; i < it->second.size(); i++) {
+            ifstream in; util.openInputFile(it->second[i], in);
+            contents[it->first] += string((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+            in.close();
+            util.mothurRemove(it->second[i]);
+        }
+    }
+    
+    return contents;
+}
+/**************************************************************************************************/
+//the outputs unique.seqs wrote before the sequences and names were kept in SequenceHashTables. r2 is in the fasta file twice
+//and r8 is not in the name file
+TEST(Test_Command_UniqueSeqs, sameAsOld) {
+    TestDeconvoluteCommand test;
+    
+    string fasta = ">r1\nACGTACGT\n>r3\nAGGTACGT\n>r6\nTTTTACGT\n>r8\nCCCCACGT\n";
+    string nameFasta = fasta + ">r9\nCCCCACGT\n"; //r8 was printed, but was not in the name file, so r9 was printed too
+    
+    map<string, string> found = test.runUniqueSeqs("");
+    EXPECT_EQ(fasta, found["fasta"]);
+    EXPECT_EQ("r1\tr1,r2,r4\nr3\tr3,r5,r2\nr6\tr6\nr8\tr8,r9\n", found["name"]);
+    
+    found = test.runUniqueSeqs(", format=count");
+    EXPECT_EQ(fasta, found["fasta"]);
+    EXPECT_EQ("Representative_Sequence\ttotal\nr1\t3\nr3\t3\nr6\t1\nr8\t2\n", found["count"]);
+    
+    found = test.runUniqueSeqs(", name=" + test.nameFile);
+    EXPECT_EQ(nameFasta, found["fasta"]);
+    EXPECT_EQ("r1\tr1,x1,r2,r4\nr3\tr3,x3,y3,r5,r2\nr6\tr6\nr9\tr9,x9\n", found["name"]);
+    
+    found = test.runUniqueSeqs(", name=" + test.nameFile + ", format=count");
+    EXPECT_EQ(nameFasta, found["fasta"]);
+    EXPECT_EQ("Representative_Sequence\ttotal\nr1\t4\nr3\t5\nr6\t1\nr9\t2\n", found["count"]);
+    
+    found = test.runUniqueSeqs(", count=" + test.countFile + ", format=name");
+    EXPECT_EQ(fasta, found["fasta"]);
+    EXPECT_EQ("r1_0\tr1_0,r1_1,r2_0,r4_0\nr3_0\tr3_0,r3_1,r3_2,r5_0,r2_0\nr6_0\tr6_0\nr8_0\tr8_0,r9_0,r9_1\n", found["name"]);
+    
+    //the second r2 is no longer in the count table after the first was merged into r1, which stops the command
+    found = test.runUniqueSeqs(", count=" + test.countFile);
+    EXPECT_EQ(0, found.size());
+    EXPECT_TRUE(MothurOut::getInstance()->getControl_pressed());
+}
+/**************************************************************************************************/
@@ -0,0 +1,29 @@
+//
+//  testdeconvolutecommand.h
+//  Mothur
+//
+//
+
+#ifndef testdeconvolutecommand_h
+#define testdeconvolutecommand_h
+
+#include "gtest.h"
+#include "deconvolutecommand.h"
+
+class TestDeconvoluteCommand {
+    
+public:
+    
+    TestDeconvoluteCommand();
+    ~TestDeconvoluteCommand();
+    
+    string fastaFile, nameFile, countFile;
+    
+    map<string, string> runUniqueSeqs(string); //options. returns the contents of the fasta and name or count outputs, and removes them
+    
+private:
+    MothurOut* m;
+    Utils util;
+};
+
+#endif /* testdeconvolutecommand_h */
@@ -0,0 +1,92 @@
+//
+//  testsharedcommand.cpp
+//  Mothur
+//
+//
+
+#include "testsharedcommand.h"
+#include "sparsesharedfile.h"
+
+/**************************************************************************************************/
+//two labels, neither of them the 0.02 the tests ask for, so make.shared falls back to 0.01
+TestSharedCommand::TestSharedCommand() {  //setup
+    m = MothurOut::getInstance();
+    
+    listFile = "testsharedcommand.list";
+    groupFile = "testsharedcommand.groups";
+    
+    ofstream out;
+    util.openOutputFile(listFile, out);
+    out << "label\tnumOtus\tOtu1\tOtu2\tOtu3\tOtu4" << endl;
+    out << "0.01\t4\ts1,s2,s3\ts4,s5\ts6\ts7,s8" << endl;
+    out << "0.03\t3\ts1,s2,s3,s6\ts4,s5\ts7,s8" << endl;
+    out.close();
+    
+    util.openOutputFile(groupFile, out);
+    out << "s1\tA\ns2\tB\ns3\tC\ns4\tA\ns5\tA\ns6\tB\ns7\tC\ns8\tC\n";
+    out.close();
+}
+/**************************************************************************************************/
+TestSharedCommand::~TestSharedCommand() {
+    util.mothurRemove(listFile); util.mothurRemove(groupFile);
+    m->setControl_pressed(false);
+}
+/**************************************************************************************************/
+vector<string> TestSharedCommand::runMakeShared(string options) {
+    Command* sharedCommand = new SharedCommand("list=" + listFile + ", group=" + groupFile + ", " + options);
+    sharedCommand->execute();
+    
+    map<string, vector<string> > outputFilenames = sharedCommand->getOutputFiles();
+    delete sharedCommand;
+    
+    return outputFilenames["shared"];
+}
+/**************************************************************************************************/
+vector<SharedRAbundVectors*> TestSharedCommand::readAll(string filename) {
+    vector<SharedRAbundVectors*> labels;
+    
+    InputData input(filename, "sharedfile", nullVector);
+    SharedRAbundVectors* shared = input.getSharedRAbundVectors();
+    while (shared != NULL) {
+        labels.push_back(shared);
+        shared = input.getSharedRAbundVectors();
+    }
+    
+    return labels;
+}
+/**************************************************************************************************/
+//sparse=t converts the text output as it was written, it does not pick the labels and groups a second time
+TEST(Test_Command_MakeShared, sparseKeepsFallbackLabel) {
+    TestSharedCommand testShared;
+    Utils util;
+    
+    string options[] = { "label=0.02", "label=0.02, groups=A-C" };
+    for (int i = 0; i < 2; i++) {
+        vector<string> textFiles = testShared.runMakeShared(options[i] + ", sparse=f");
+        ASSERT_EQ(1, textFiles.size());
+        vector<SharedRAbundVectors*> expected = testShared.readAll(textFiles[0]);
+        
+        vector<string> sparseFiles = testShared.runMakeShared(options[i] + ", sparse=t");
+        ASSERT_EQ(1, sparseFiles.size());
+        SparseSharedFile sparse;
+        EXPECT_TRUE(sparse.isSparse(sparseFiles[0]));
+        vector<SharedRAbundVectors*> found = testShared.readAll(sparseFiles[0]);
+        
+        ASSERT_EQ(1, expected.size());
+        EXPECT_EQ("0.01", expected[0]->getLabel());
+        ASSERT_EQ(expected.size(), found.size()) << options[i];
+        EXPECT_EQ(expected[0]->getLabel(), found[0]->getLabel());
+        ASSERT_EQ(expected[0]->getNumBins(), found[0]->getNumBins());
+        
+        vector<string> groups = expected[0]->getNamesGroups();
+        ASSERT_EQ(groups, found[0]->getNamesGroups());
+        for (int j = 0; j < groups.size(); j++) {
+            for (int k = 0; k < expected[0]->getNumBins(); k++) { EXPECT_EQ(expected[0]->get(k, groups[j]), found[0]->get(k, groups[j])); }
+        }
+        
+        for (int j = 0; j < expected.size(); j++) { delete expected[j]; }
+        for (int j = 0; j < found.size(); j++) { delete found[j]; }
+        util.mothurRemove(sparseFiles[0]); //the sparse file replaced the text one of the same name
+    }
+}
+/**************************************************************************************************/
@@ -0,0 +1,31 @@
+//
+//  testsharedcommand.h
+//  Mothur
+//
+//
+
+#ifndef testsharedcommand_h
+#define testsharedcommand_h
+
+#include "gtest.h"
+#include "sharedcommand.h"
+#include "inputdata.h"
+
+class TestSharedCommand {
+    
+public:
+    
+    TestSharedCommand();
+    ~TestSharedCommand();
+    
+    string listFile, groupFile;
+    
+    vector<string> runMakeShared(string); //options. returns the shared files
+    vector<SharedRAbundVectors*> readAll(string); //every label InputData returns
+    
+private:
+    MothurOut* m;
+    Utils util;
+};
+
+#endif /* testsharedcommand_h */
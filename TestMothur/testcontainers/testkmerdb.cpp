@@ -0,0 +1,162 @@
+//
+//  testkmerdb.cpp
+//  Mothur
+//
+//
+
+#include "testkmerdb.h"
+
+/**************************************************************************************************/
+//families of random seqs with a few changes each, some with Ns
+TestKmerDB::TestKmerDB() {  //setup
+    m = MothurOut::getInstance();
+    m->setRandomSeed(19760620);
+    util = Utils(); //seeded from the seed just set
+    kmerSize = 4;
+    
+    fastaFile = "testkmerdb.fasta";
+    shortcutFile = "testkmerdb.4mer";
+    textFile = "testkmerdb.text.4mer";
+    
+    string bases = "ACGT";
+    for (int i = 0; i < 8; i++) {
+        string parent = "";
+        int length = 100 + util.getRandomIndex(100);
+        for (int j = 0; j < length; j++) { parent += bases[util.getRandomIndex(3)]; }
+        
+        for (int j = 0; j < 5; j++) {
+            string seq = parent;
+            int numEdits = util.getRandomIndex(20);
+            for (int k = 0; k < numEdits; k++) { seq[util.getRandomIndex(seq.length()-1)] = bases[util.getRandomIndex(3)]; }
+            if (util.getRandomIndex(3) == 0) { seq[util.getRandomIndex(seq.length()-1)] = 'N'; }
+            
+            seqs.push_back(Sequence("seq" + toString(i) + "_" + toString(j), seq));
+        }
+    }
+}
+/**************************************************************************************************/
+TestKmerDB::~TestKmerDB() {
+    util.mothurRemove(shortcutFile); util.mothurRemove(textFile);
+    m->setControl_pressed(false);
+}
+/**************************************************************************************************/
+KmerDB* TestKmerDB::buildDB(vector<Sequence>& theseSeqs) {
+    KmerDB* db = new KmerDB(fastaFile, kmerSize);
+    for (int i = 0; i < theseSeqs.size(); i++) { db->addSequence(theseSeqs[i]); }
+    db->setNumSeqs(theseSeqs.size());
+    return db;
+}
+/**************************************************************************************************/
+KmerDB* TestKmerDB::readDB(string filename, int thisKmerSize) {
+    KmerDB* db = new KmerDB(fastaFile, thisKmerSize);
+    ifstream in; util.openInputFile(filename, in);
+    db->readKmerDB(in);
+    db->setNumSeqs(seqs.size());
+    return db;
+}
+/**************************************************************************************************/
+//same as generateDB before the binary shortcut files. the N kmer was not written
+void TestKmerDB::writeText(KmerDB& db, string filename) {
+    ofstream out; util.openOutputFile(filename, out);
+    
+    out << "#" << CurrentFile::getInstance()->getVersion() << endl;
+    for (int i = 0; i < db.getMaxKmer(); i++) {
+        vector<int> locations = db.getSequencesWithKmer(i);
+        out << i << ' ' << locations.size();
+        for (int j = 0; j < locations.size(); j++) { out << ' ' << locations[j]; }
+        out << endl;
+    }
+    out.close();
+}
+/**************************************************************************************************/
+void TestKmerDB::compare(KmerDB& db, KmerDB& db2, bool includeN) {
+    ASSERT_EQ(db.getMaxKmer(), db2.getMaxKmer());
+    
+    int numKmers = db.getMaxKmer(); if (includeN) { numKmers++; }
+    for (int i = 0; i < numKmers; i++) {
+        ASSERT_EQ(db.getCount(i), db2.getCount(i)) << "kmer " << i;
+        ASSERT_EQ(db.getSequencesWithKmer(i), db2.getSequencesWithKmer(i)) << "kmer " << i;
+    }
+    
+    //the seqs with a few more changes, so the searches are not all exact. without the N kmer, queries with an N score differently
+    Utils random;
+    for (int i = 0; i < seqs.size(); i++) {
+        string query = seqs[i].getAligned();
+        if (!includeN && (query.find('N') != string::npos)) { continue; }
+        for (int k = 0; k < 10; k++) { query[random.getRandomIndex(query.length()-1)] = 'A'; }
+        Sequence querySeq("query", query);
+        
+        vector<float> scores, scores2;
+        EXPECT_EQ(db.findClosestSequences(&querySeq, 1, scores), db2.findClosestSequences(&querySeq, 1, scores2));
+        EXPECT_EQ(scores, scores2);
+        EXPECT_EQ(db.findClosestSequences(&querySeq, 3, scores), db2.findClosestSequences(&querySeq, 3, scores2));
+        EXPECT_EQ(scores, scores2);
+    }
+}
+/**************************************************************************************************/
+TEST(TestKmerDB, roundTrip) {
+    TestKmerDB test;
+    
+    KmerDB* memory = test.buildDB(test.seqs);
+    memory->generateDB();
+    test.writeText(*memory, test.textFile);
+    
+    KmerDB* binary = test.readDB(test.shortcutFile, 4);
+    ASSERT_FALSE(MothurOut::getInstance()->getControl_pressed());
+    KmerDB* text = test.readDB(test.textFile, 4);
+    
+    EXPECT_GT(memory->getCount(memory->getMaxKmer()), 0); //some seqs have an N
+    
+    test.compare(*memory, *binary, true);
+    test.compare(*text, *binary, false);
+    
+    delete memory; delete binary; delete text;
+}
+/**************************************************************************************************/
+TEST(TestKmerDB, emptyDB) {
+    TestKmerDB test;
+    vector<Sequence> noSeqs;
+    
+    KmerDB* memory = test.buildDB(noSeqs);
+    memory->generateDB();
+    delete memory;
+    
+    KmerDB* binary = test.readDB(test.shortcutFile, 4);
+    ASSERT_FALSE(MothurOut::getInstance()->getControl_pressed());
+    for (int i = 0; i <= binary->getMaxKmer(); i++) { ASSERT_EQ(0, binary->getCount(i)); }
+    delete binary;
+}
+/**************************************************************************************************/
+TEST(TestKmerDB, truncated) {
+    TestKmerDB test;
+    Utils util;
+    
+    KmerDB* memory = test.buildDB(test.seqs);
+    memory->generateDB();
+    delete memory;
+    
+    ifstream in; util.openInputFileBinary(test.shortcutFile, in);
+    string contents((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    in.close();
+    
+    //cut in the postings
+    ofstream out; util.openOutputFileBinary(test.shortcutFile, out);
+    out.write(contents.c_str(), contents.length()-8);
+    out.close();
+    
+    KmerDB* binary = test.readDB(test.shortcutFile, 4);
+    EXPECT_TRUE(MothurOut::getInstance()->getControl_pressed());
+    delete binary;
+    MothurOut::getInstance()->setControl_pressed(false);
+    
+    //a shortcut file for another kmer size
+    util.openOutputFileBinary("testkmerdb.5mer", out);
+    out.write(contents.c_str(), contents.length());
+    out.close();
+    
+    binary = test.readDB("testkmerdb.5mer", 5);
+    EXPECT_TRUE(MothurOut::getInstance()->getControl_pressed());
+    delete binary;
+    util.mothurRemove("testkmerdb.5mer");
+}
+/**************************************************************************************************/
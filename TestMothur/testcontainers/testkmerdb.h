@@ -0,0 +1,34 @@
+//
+//  testkmerdb.h
+//  Mothur
+//
+//
+
+#ifndef testkmerdb_h
+#define testkmerdb_h
+
+#include "gtest.h"
+#include "kmerdb.hpp"
+
+class TestKmerDB {
+    
+public:
+    
+    TestKmerDB();
+    ~TestKmerDB();
+    
+    vector<Sequence> seqs;
+    string fastaFile, shortcutFile, textFile;
+    
+    KmerDB* buildDB(vector<Sequence>&); //in memory, from addSequence
+    KmerDB* readDB(string, int); //shortcut file, kmer size
+    void writeText(KmerDB&, string); //the text shortcut file written by older versions
+    void compare(KmerDB&, KmerDB&, bool); //includes the N kmer
+    
+private:
+    MothurOut* m;
+    Utils util;
+    int kmerSize;
+};
+
+#endif /* testkmerdb_h */
@@ -0,0 +1,182 @@
+//
+//  testpreclusterindex.cpp
+//  Mothur
+//
+//
+
+#include "testpreclusterindex.h"
+
+/**************************************************************************************************/
+TestPreClusterIndex::TestPreClusterIndex() {  //setup
+    m = MothurOut::getInstance();
+    m->setRandomSeed(19760620);
+    util = Utils(); //seeded from the seed just set
+    alignment = new NeedlemanOverlap(-2.0, 1.0, -1.0, 1000); //pre.cluster defaults
+}
+/**************************************************************************************************/
+TestPreClusterIndex::~TestPreClusterIndex() { delete alignment; }
+/**************************************************************************************************/
+char TestPreClusterIndex::randomBase() {
+    string bases = "ACGT";
+    return bases[util.getRandomIndex(3)];
+}
+/**************************************************************************************************/
+//each family is a random parent and children with 1 to 4 substitutions, insertions or deletions, so many pairs are near diffs
+vector<string> TestPreClusterIndex::makeUnaligned(int numFamilies, int numChildren, int length) {
+    vector<string> seqs;
+    
+    for (int i = 0; i < numFamilies; i++) {
+        string parent = "";
+        for (int j = 0; j < length + util.getRandomIndex(20); j++) { parent += randomBase(); }
+        seqs.push_back(parent);
+        
+        for (int j = 0; j < numChildren; j++) {
+            string child = parent;
+            int numEdits = util.getRandomIndex(3) + 1;
+            for (int k = 0; k < numEdits; k++) {
+                int pos = util.getRandomIndex(child.length()-1);
+                int edit = util.getRandomIndex(2);
+                if (edit == 0)      { child[pos] = randomBase(); }
+                else if (edit == 1) { child.insert(child.begin()+pos, randomBase()); }
+                else                { child.erase(child.begin()+pos); }
+            }
+            seqs.push_back(child);
+        }
+    }
+    
+    return seqs;
+}
+/**************************************************************************************************/
+//the parents share gap columns like a filtered alignment, the children change 1 to 4 columns to a base or a gap
+vector<string> TestPreClusterIndex::makeAligned(int numFamilies, int numChildren, int numColumns) {
+    vector<string> seqs;
+    string chars = "ACGT-";
+    
+    string gaps(numColumns, ' ');
+    for (int j = 0; j < numColumns; j++) { if (util.getRandomIndex(4) == 0) { gaps[j] = '-'; } }
+    
+    for (int i = 0; i < numFamilies; i++) {
+        string parent = gaps;
+        for (int j = 0; j < numColumns; j++) { if (parent[j] == ' ') { parent[j] = randomBase(); } }
+        int endGaps = util.getRandomIndex(5);
+        for (int j = 0; j < endGaps; j++) { parent[j] = '.'; parent[numColumns-1-j] = '.'; }
+        seqs.push_back(parent);
+        
+        for (int j = 0; j < numChildren; j++) {
+            string child = parent;
+            int numEdits = util.getRandomIndex(3) + 1;
+            for (int k = 0; k < numEdits; k++) { child[util.getRandomIndex(numColumns-1)] = chars[util.getRandomIndex(4)]; }
+            seqs.push_back(child);
+        }
+    }
+    
+    return seqs;
+}
+/**************************************************************************************************/
+//same as calcMisMatches in preclustercommand.cpp without stopping at diffs
+vector< vector<int> > TestPreClusterIndex::countMisMatches(vector<string>& seqs, bool aligned) {
+    vector< vector<int> > results(seqs.size());
+    
+    for (int i = 0; i < seqs.size(); i++) {
+        for (int j = i+1; j < seqs.size(); j++) {
+            int numBad = 0;
+            
+            if (aligned) {
+                for (int k = 0; k < seqs[i].length(); k++) { if (seqs[i][k] != seqs[j][k]) { numBad++; } }
+            }else {
+                //align seq j to seq i, chop the end gaps of j
+                alignment->align(seqs[j], seqs[i]);
+                string seq2 = alignment->getSeqAAln();
+                string seq1 = alignment->getSeqBAln();
+                
+                int startPos = 0;
+                int endPos = seq2.length()-1;
+                for (int k = 0; k < seq2.length(); k++) {  if (isalpha(seq2[k])) { startPos = k; break; } }
+                for (int k = seq2.length()-1; k >= 0; k--) {  if (isalpha(seq2[k])) { endPos = k; break; } }
+                
+                for (int k = startPos; k <= endPos; k++) { if (seq2[k] != seq1[k]) { numBad++; } }
+            }
+            results[i].push_back(numBad);
+        }
+    }
+    
+    return results;
+}
+/**************************************************************************************************/
+int TestPreClusterIndex::checkCandidates(vector<string>& seqs, bool aligned, int diffs) {
+    vector< vector<int> > misMatches = countMisMatches(seqs, aligned);
+    PreClusterIndex index(seqs, diffs, aligned);
+    
+    int numWithin = 0;
+    vector<int> candidates;
+    for (int i = 0; i < seqs.size(); i++) {
+        index.getCandidates(i, candidates);
+        
+        EXPECT_TRUE(is_sorted(candidates.begin(), candidates.end()));
+        if (candidates.size() != 0) { EXPECT_GT(candidates[0], i); }
+        
+        for (int j = i+1; j < seqs.size(); j++) {
+            if (misMatches[i][j-i-1] <= diffs) {
+                numWithin++;
+                EXPECT_TRUE(binary_search(candidates.begin(), candidates.end(), j)) << "seq " << j << " is " << misMatches[i][j-i-1] << " from seq " << i << " but not a candidate, diffs=" << diffs;
+            }
+        }
+    }
+    
+    return numWithin;
+}
+/**************************************************************************************************/
+TEST(TestPreClusterIndex, alignedCandidates) {
+    TestPreClusterIndex test;
+    vector<string> seqs = test.makeAligned(12, 8, 120);
+    
+    for (int diffs = 1; diffs <= 3; diffs++) {
+        int numWithin = test.checkCandidates(seqs, true, diffs);
+        EXPECT_GT(numWithin, 30); //plenty of pairs to find
+    }
+}
+/**************************************************************************************************/
+TEST(TestPreClusterIndex, unalignedCandidates) {
+    TestPreClusterIndex test;
+    vector<string> seqs = test.makeUnaligned(12, 8, 80);
+    
+    for (int diffs = 1; diffs <= 3; diffs++) {
+        int numWithin = test.checkCandidates(seqs, false, diffs);
+        EXPECT_GT(numWithin, 30);
+    }
+}
+/**************************************************************************************************/
+//the shortest seq sets the piece length, so a short seq makes short pieces for everyone
+TEST(TestPreClusterIndex, unalignedShortSeq) {
+    TestPreClusterIndex test;
+    vector<string> seqs = test.makeUnaligned(6, 8, 60);
+    seqs.insert(seqs.begin()+3, seqs[0].substr(10, 9));
+    
+    for (int diffs = 1; diffs <= 3; diffs++) { test.checkCandidates(seqs, false, diffs); }
+}
+/**************************************************************************************************/
+//the child's only piece without a difference is the last window of the parent
+TEST(TestPreClusterIndex, unalignedLastWindow) {
+    TestPreClusterIndex test;
+    vector<string> seqs = test.makeUnaligned(1, 0, 40);
+    seqs[0] = seqs[0].substr(0, 40);
+    
+    string child = seqs[0];
+    child[5] = (child[5] == 'A') ? 'C' : 'A';
+    seqs.push_back(child);
+    
+    ASSERT_EQ(1, test.checkCandidates(seqs, false, 1));
+}
+/**************************************************************************************************/
+//too short to cut into diffs+1 pieces, everyone after you is a candidate
+TEST(TestPreClusterIndex, tooShort) {
+    vector<string> seqs; seqs.push_back("AC"); seqs.push_back("AG"); seqs.push_back("TT");
+    PreClusterIndex index(seqs, 3, true);
+    
+    vector<int> candidates;
+    index.getCandidates(0, candidates);
+    ASSERT_EQ(2, candidates.size());
+    index.getCandidates(2, candidates);
+    ASSERT_EQ(0, candidates.size());
+}
+/**************************************************************************************************/
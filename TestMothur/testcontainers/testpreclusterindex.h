@@ -0,0 +1,34 @@
+//
+//  testpreclusterindex.h
+//  Mothur
+//
+//
+
+#ifndef testpreclusterindex_h
+#define testpreclusterindex_h
+
+#include "gtest.h"
+#include "preclusterindex.h"
+#include "needlemanoverlap.hpp"
+
+class TestPreClusterIndex {
+    
+public:
+    
+    TestPreClusterIndex();
+    ~TestPreClusterIndex();
+    
+    vector<string> makeUnaligned(int, int, int); //families, children per family, length of the parents
+    vector<string> makeAligned(int, int, int); //families, children per family, number of columns
+    vector< vector<int> > countMisMatches(vector<string>&, bool); //seqs, aligned. mismatches of every seq with the seqs after it, counted the way pre.cluster does
+    int checkCandidates(vector<string>&, bool, int); //seqs, aligned, diffs. number of pairs within diffs, fails if one of them is not a candidate
+    
+private:
+    MothurOut* m;
+    Utils util;
+    NeedlemanOverlap* alignment;
+    
+    char randomBase();
+};
+
+#endif /* testpreclusterindex_h */
@@ -58,3 +58,129 @@ TEST_CASE("Testing Sequence Class") {
 }
 
 */
+/**************************************************************************************************/
+void TestSequence::oldGobble(istream& f) {
+    char d;
+    while(isspace(d=f.get()))		{ ;}
+    if(!f.eof()) { f.putback(d); }
+}
+/**************************************************************************************************/
+string TestSequence::oldCommentString(istream& fastaFile) {
+    char letter;
+    string temp = "";
+    
+    while(fastaFile){
+        letter=fastaFile.get();
+        if((letter == '\r') || (letter == '\n') || letter == -1){
+            oldGobble(fastaFile);  //in case its a \r\n situation
+            break;
+        }else {
+            temp += letter;
+        }
+    }
+    
+    return temp;
+}
+/**************************************************************************************************/
+string TestSequence::oldSequenceString(istream& fastaFile, int& numAmbig) {
+    char letter;
+    string sequence = "";
+    numAmbig = 0;
+    
+    while(fastaFile){
+        letter= fastaFile.get();
+        if(letter == '>'){
+            fastaFile.putback(letter);
+            break;
+        }else if (letter == ' ') {;}
+        else if(isprint(letter)){
+            letter = toupper(letter);
+            if(letter == 'U'){letter = 'T';}
+            if(letter != '.' && letter != '-' && letter != 'A' && letter != 'T' && letter != 'G'  && letter != 'C' && letter != 'N'){
+                letter = 'N';
+                numAmbig++;
+            }
+            sequence += letter;
+        }
+    }
+    
+    return sequence;
+}
+/**************************************************************************************************/
+//headers with comments, blank lines, \r\n and \r line ends, tabs and spaces, lowercase, U's and IUPAC codes, and a last
+//record with no line end
+static string fastaParseText() {
+    string text = "";
+    text += ">seq1 sample=A; primer=forward\n";
+    text += "acgtACGTnnNN\n\n";
+    text += "RYKMSWBDHV..--uU\n";
+    text += "\n\n";
+    text += ">seq2\tcomment after a tab\r\n";
+    text += "AC GT\tAC\r\n";
+    text += "ryk msw bdhv\r\n\r\n";
+    text += ">seq3\n";
+    text += "..ACGT-acgt--\rNNNN\r";
+    text += ">seq4 \n";
+    text += "\n";
+    text += ">seq5 last record\n";
+    text += "xyzACGT*#1234";
+    return text;
+}
+/**************************************************************************************************/
+//Sequence(ifstream&) reads every record the way the character at a time parse did, and leaves the file at the same place
+TEST(TestSequence, fastaParseMatchesOld) {
+    MothurOut* m = MothurOut::getInstance();
+    Utils util;
+    string filename = "testsequence.fasta";
+    
+    ofstream out;
+    util.openOutputFile(filename, out);
+    out << fastaParseText();
+    out.close();
+    
+    ifstream in, oldIn;
+    util.openInputFile(filename, in);
+    util.openInputFile(filename, oldIn);
+    
+    int count = 0;
+    while (!in.eof()) {
+        if (m->getControl_pressed()) { break; }
+        
+        Sequence seq(in); util.gobble(in);
+        
+        string name = ""; oldIn >> name; name = name.substr(1);
+        string comment = TestSequence::oldCommentString(oldIn);
+        int numAmbig = 0;
+        string aligned = TestSequence::oldSequenceString(oldIn, numAmbig);
+        TestSequence::oldGobble(oldIn);
+        
+        EXPECT_EQ(name, seq.getName());
+        EXPECT_EQ(comment, seq.getComment()) << name;
+        EXPECT_EQ(aligned, seq.getAligned()) << name;
+        EXPECT_EQ(oldIn.eof(), in.eof()) << name;
+        if (!in.eof()) { EXPECT_EQ(oldIn.tellg(), in.tellg()) << name; }
+        count++;
+    }
+    in.close(); oldIn.close();
+    
+    EXPECT_EQ(5, count);
+    util.mothurRemove(filename);
+}
+/**************************************************************************************************/
+//the same characters are kept, converted and counted as ambiguous from streams and strings
+TEST(TestSequence, sequenceStringMatchesOld) {
+    string bodies[] = { "acgtACGTnnNN\n\nRYKMSWBDHV..--uU\n\n", "AC GT\tAC\r\nryk msw bdhv\r\n>next", "xyzACGT*#1234", "", "\n\n>" };
+    
+    TestSequence seq;
+    for (int i = 0; i < 5; i++) {
+        istringstream oldIn(bodies[i]), in(bodies[i]);
+        int oldAmbig = 0, numAmbig = 0;
+        string expected = TestSequence::oldSequenceString(oldIn, oldAmbig);
+        string found = seq.readSequenceString(in, numAmbig);
+        
+        EXPECT_EQ(expected, found) << i;
+        EXPECT_EQ(oldAmbig, numAmbig) << i;
+        EXPECT_EQ(oldIn.peek(), in.peek()) << i;
+    }
+}
+/**************************************************************************************************/
@@ -8,6 +8,7 @@
 
 #ifndef Mothur_testsequence_h
 #define Mothur_testsequence_h
+#include "gtest.h"
 #include "sequence.hpp"
 
 class TestSequence : public Sequence {
@@ -15,6 +16,12 @@ class TestSequence : public Sequence {
     public:
     
     using Sequence::initialize;
+    using Sequence::readSequenceString;
+    
+    //the character at a time parse Sequence(ifstream&) used before readSequenceString, kept to compare against
+    static void oldGobble(istream&);
+    static string oldCommentString(istream&);
+    static string oldSequenceString(istream&, int&);
     
 };
 
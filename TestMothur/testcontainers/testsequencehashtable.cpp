@@ -0,0 +1,146 @@
+//
+//  testsequencehashtable.cpp
+//  Mothur
+//
+//
+
+#include "testsequencehashtable.h"
+
+/**************************************************************************************************/
+//reads with the same sequence, a name used twice and a name missing from the name file
+TestSequenceHashTable::TestSequenceHashTable() {  //setup
+    m = MothurOut::getInstance();
+    
+    fastaFile = "testsequencehashtable.fasta";
+    nameFile = "testsequencehashtable.names";
+    
+    ofstream out;
+    util.openOutputFile(fastaFile, out);
+    out << ">r1\nACGTACGT\n>r2\nACGTACGT\n>r3\nAGGTACGT\n>r4\nACGTACGT\n>r5\nAGGTACGT\n>r6\nTTTTACGT\n";
+    out << ">r2\nAGGTACGT\n>r8\nCCCCACGT\n>r9\nCCCCACGT\n";
+    out.close();
+    
+    util.openOutputFile(nameFile, out);
+    out << "r1\tr1,x1\nr2\tr2\nr3\tr3,x3,y3\nr4\tr4\nr5\tr5\nr6\tr6\nr9\tr9,x9\n";
+    out.close();
+}
+/**************************************************************************************************/
+TestSequenceHashTable::~TestSequenceHashTable() {
+    util.mothurRemove(fastaFile); util.mothurRemove(nameFile);
+    m->setControl_pressed(false);
+}
+/**************************************************************************************************/
+int TestSequenceHashTable::addWithHash(const string& s, SequenceHash hash, bool& isNew) {
+    int slot = findSlot(hash, s);
+    if (slots[slot] != -1) { isNew = false; return slots[slot]; }
+    
+    isNew = true;
+    int index = store(s, hash);
+    slots[slot] = index;
+    if ((2 * (unsigned long long)lengths.size()) > slots.size()) { resize(); }
+    
+    return index;
+}
+/**************************************************************************************************/
+int TestSequenceHashTable::findWithHash(const string& s, SequenceHash hash) {
+    return slots[findSlot(hash, s)];
+}
+/**************************************************************************************************/
+//enough strings to grow the slots several times, each found again at the index it was given
+TEST(TestSequenceHashTable, growth) {
+    TestSequenceHashTable table;
+    
+    int startSlots = table.getNumSlots();
+    vector<string> strings;
+    for (int i = 0; i < 20000; i++) {
+        string s = ""; for (int j = i; j > 0; j /= 4) { s += "ACGT"[j % 4]; }
+        strings.push_back(s + "-" + toString(i % 7)); //the same prefix for several
+    }
+    
+    for (int i = 0; i < strings.size(); i++) {
+        bool isNew = false;
+        EXPECT_EQ(i, table.add(strings[i], isNew));
+        EXPECT_TRUE(isNew);
+    }
+    EXPECT_EQ(strings.size(), table.size());
+    EXPECT_GT(table.getNumSlots(), startSlots * 16);
+    EXPECT_GE(table.getNumSlots(), 2 * table.size());
+    
+    for (int i = 0; i < strings.size(); i++) {
+        bool isNew = true;
+        ASSERT_EQ(i, table.add(strings[i], isNew));
+        EXPECT_FALSE(isNew);
+        EXPECT_EQ(i, table.find(strings[i]));
+        EXPECT_EQ(strings[i], table.get(i));
+    }
+    EXPECT_EQ(-1, table.find("ACGTN"));
+    EXPECT_EQ(-1, table.find(""));
+    
+    bool isNew = false;
+    EXPECT_EQ(strings.size(), table.add("", isNew)); EXPECT_TRUE(isNew);
+    EXPECT_EQ("", table.get(strings.size()));
+}
+/**************************************************************************************************/
+//strings with the same hash are told apart by their stored copy, before and after the slots grow
+TEST(TestSequenceHashTable, collisions) {
+    TestSequenceHashTable table;
+    
+    SequenceHash same; same.first = 12345; same.second = 67890;
+    string strings[] = { "ACGT", "ACGA", "ACG", "TTTTTTTTTTTTTTTTTTTTTTTT" };
+    for (int i = 0; i < 4; i++) {
+        bool isNew = false;
+        EXPECT_EQ(i, table.addWithHash(strings[i], same, isNew));
+        EXPECT_TRUE(isNew);
+    }
+    
+    //fill the slots around them with other strings so the table grows past them
+    for (int i = 0; i < 3000; i++) { bool isNew; table.add("seq" + toString(i), isNew); }
+    
+    for (int i = 0; i < 4; i++) {
+        bool isNew = true;
+        EXPECT_EQ(i, table.addWithHash(strings[i], same, isNew));
+        EXPECT_FALSE(isNew);
+        EXPECT_EQ(i, table.findWithHash(strings[i], same));
+        EXPECT_EQ(strings[i], table.get(i));
+    }
+    EXPECT_EQ(-1, table.findWithHash("ACGC", same));
+    for (int i = 0; i < 3000; i++) { EXPECT_EQ(i+4, table.find("seq" + toString(i))); }
+}
+/**************************************************************************************************/
+//the lookups give what the map based FastaMap gave. the second r2 keeps the first sequence without a name file and
+//replaces it with one, and r8 adds nothing to its names because it is not in the name file
+TEST(TestSequenceHashTable, fastaMapSameAsOld) {
+    TestSequenceHashTable test;
+    
+    string seqs[] = { "ACGTACGT", "AGGTACGT", "TTTTACGT", "CCCCACGT", "GGGGGGGG" };
+    string names[] = { "r1", "r2", "r3", "r4", "r5", "r6", "r8", "r9", "r10" };
+    
+    FastaMap fasta;
+    fasta.readFastaFile(test.fastaFile);
+    EXPECT_EQ(4, fasta.sizeUnique());
+    
+    string fastaSeqs[] = { "ACGTACGT", "ACGTACGT", "AGGTACGT", "ACGTACGT", "AGGTACGT", "TTTTACGT", "CCCCACGT", "CCCCACGT", "not found" };
+    for (int i = 0; i < 9; i++) { EXPECT_EQ(fastaSeqs[i], fasta.getSequence(names[i])) << names[i]; }
+    
+    string fastaGroups[] = { "r1", "r3", "r6", "r8", "" };
+    string fastaNames[] = { "r1,r2,r4", "r3,r5,r2", "r6", "r8,r9", "" };
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(fastaGroups[i], fasta.getGroupName(seqs[i])) << seqs[i];
+        EXPECT_EQ(fastaNames[i], fasta.getNames(seqs[i])) << seqs[i];
+    }
+    
+    FastaMap fastaNameFile;
+    fastaNameFile.readFastaFile(test.fastaFile, test.nameFile);
+    EXPECT_EQ(4, fastaNameFile.sizeUnique());
+    
+    string nameSeqs[] = { "ACGTACGT", "AGGTACGT", "AGGTACGT", "ACGTACGT", "AGGTACGT", "TTTTACGT", "CCCCACGT", "CCCCACGT", "not found" };
+    for (int i = 0; i < 9; i++) { EXPECT_EQ(nameSeqs[i], fastaNameFile.getSequence(names[i])) << names[i]; }
+    
+    string nameGroups[] = { "r1", "r3", "r6", "r8", "" };
+    string nameNames[] = { "r1,x1,r2,r4", "r3,x3,y3,r5,r2", "r6", ",r9,x9", "" };
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(nameGroups[i], fastaNameFile.getGroupName(seqs[i])) << seqs[i];
+        EXPECT_EQ(nameNames[i], fastaNameFile.getNames(seqs[i])) << seqs[i];
+    }
+}
+/**************************************************************************************************/
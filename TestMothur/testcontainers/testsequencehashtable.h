@@ -0,0 +1,32 @@
+//
+//  testsequencehashtable.h
+//  Mothur
+//
+//
+
+#ifndef testsequencehashtable_h
+#define testsequencehashtable_h
+
+#include "gtest.h"
+#include "sequencehashtable.h"
+#include "fastamap.h"
+
+class TestSequenceHashTable : public SequenceHashTable {
+    
+public:
+    
+    TestSequenceHashTable();
+    ~TestSequenceHashTable();
+    
+    int addWithHash(const string&, SequenceHash, bool&); //add, with the hash given instead of the string's
+    int findWithHash(const string&, SequenceHash);
+    int getNumSlots() { return (int)slots.size(); }
+    
+    string fastaFile, nameFile;
+    
+private:
+    MothurOut* m;
+    Utils util;
+};
+
+#endif /* testsequencehashtable_h */
@@ -0,0 +1,206 @@
+//
+//  testsparsesharedfile.cpp
+//  Mothur
+//
+//
+
+#include "testsparsesharedfile.h"
+
+/**************************************************************************************************/
+//three labels, each after the header line make.shared writes. Otu2 of the first label and Otu1 of the second are only in
+//group B, so they are dropped when groups=A-C
+TestSparseSharedFile::TestSparseSharedFile() {  //setup
+    m = MothurOut::getInstance();
+    
+    textFile = "testsparsesharedfile.shared";
+    sparseFile = "testsparsesharedfile.sparse.shared";
+    
+    ofstream out;
+    util.openOutputFile(textFile, out);
+    out << "label\tGroup\tnumOtus\tOtu1\tOtu2\tOtu3\tOtu4\tOtu5" << endl;
+    out << "0.01\tA\t5\t4\t0\t1\t0\t2" << endl;
+    out << "0.01\tB\t5\t0\t3\t0\t0\t1" << endl;
+    out << "0.01\tC\t5\t1\t0\t0\t6\t0" << endl;
+    out << "label\tGroup\tnumOtus\tOtu1\tOtu2\tOtu3\tOtu4" << endl;
+    out << "0.02\tA\t4\t0\t5\t1\t2" << endl;
+    out << "0.02\tB\t4\t4\t0\t0\t1" << endl;
+    out << "0.02\tC\t4\t0\t6\t0\t0" << endl;
+    out << "label\tGroup\tnumOtus\tOtu1\tOtu2\tOtu3" << endl;
+    out << "0.03\tA\t3\t5\t3\t0" << endl;
+    out << "0.03\tB\t3\t4\t0\t1" << endl;
+    out << "0.03\tC\t3\t6\t0\t1" << endl;
+    out.close();
+}
+/**************************************************************************************************/
+TestSparseSharedFile::~TestSparseSharedFile() {
+    util.mothurRemove(textFile);
+    util.mothurRemove(sparseFile);
+    m->setControl_pressed(false);
+}
+/**************************************************************************************************/
+vector<SharedRAbundVectors*> TestSparseSharedFile::readAll(string filename, vector<string> groups) {
+    vector<SharedRAbundVectors*> labels;
+    
+    InputData input(filename, "sharedfile", groups);
+    SharedRAbundVectors* shared = input.getSharedRAbundVectors();
+    while (shared != NULL) {
+        labels.push_back(shared);
+        shared = input.getSharedRAbundVectors();
+    }
+    
+    return labels;
+}
+/**************************************************************************************************/
+void TestSparseSharedFile::writeSparse(string filename, string sparseFilename) {
+    vector<SharedRAbundVectors*> labels = readAll(filename, nullVector);
+    
+    SparseSharedFile sparse;
+    sparse.openOutput(sparseFilename);
+    for (int i = 0; i < labels.size(); i++) { sparse.write(labels[i]); delete labels[i]; }
+    sparse.closeOutput();
+}
+/**************************************************************************************************/
+void TestSparseSharedFile::compare(vector<SharedRAbundVectors*>& expected, vector<SharedRAbundVectors*>& found) {
+    ASSERT_EQ(expected.size(), found.size());
+    
+    for (int i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(expected[i]->getLabel(), found[i]->getLabel());
+        ASSERT_EQ(expected[i]->getNumBins(), found[i]->getNumBins());
+        EXPECT_EQ(expected[i]->getOTUNames(), found[i]->getOTUNames());
+        
+        vector<string> groups = expected[i]->getNamesGroups();
+        ASSERT_EQ(groups, found[i]->getNamesGroups());
+        
+        for (int j = 0; j < groups.size(); j++) {
+            EXPECT_EQ(expected[i]->getNumSeqs(groups[j]), found[i]->getNumSeqs(groups[j]));
+            for (int k = 0; k < expected[i]->getNumBins(); k++) { EXPECT_EQ(expected[i]->get(k, groups[j]), found[i]->get(k, groups[j])); }
+        }
+    }
+}
+/**************************************************************************************************/
+//every label of a text shared file with a header line before each label
+TEST(TestSparseSharedFile, readTextLabels) {
+    TestSparseSharedFile test;
+    
+    vector<SharedRAbundVectors*> labels = test.readAll(test.textFile, nullVector);
+    
+    ASSERT_EQ(3, labels.size());
+    EXPECT_EQ("0.01", labels[0]->getLabel()); EXPECT_EQ(5, labels[0]->getNumBins());
+    EXPECT_EQ("0.02", labels[1]->getLabel()); EXPECT_EQ(4, labels[1]->getNumBins());
+    EXPECT_EQ("0.03", labels[2]->getLabel()); EXPECT_EQ(3, labels[2]->getNumBins());
+    EXPECT_EQ(6, labels[1]->get(1, "C"));
+    EXPECT_EQ(1, labels[2]->get(2, "B"));
+    
+    for (int i = 0; i < labels.size(); i++) { delete labels[i]; }
+}
+/**************************************************************************************************/
+//text -> sparse -> InputData gives what InputData reads from the text file
+TEST(TestSparseSharedFile, roundTrip) {
+    TestSparseSharedFile test;
+    test.writeSparse(test.textFile, test.sparseFile);
+    
+    SparseSharedFile sparse;
+    EXPECT_TRUE(sparse.isSparse(test.sparseFile));
+    EXPECT_FALSE(sparse.isSparse(test.textFile));
+    
+    vector<SharedRAbundVectors*> expected = test.readAll(test.textFile, nullVector);
+    vector<SharedRAbundVectors*> found = test.readAll(test.sparseFile, nullVector);
+    test.compare(expected, found);
+    
+    for (int i = 0; i < expected.size(); i++) { delete expected[i]; }
+    for (int i = 0; i < found.size(); i++) { delete found[i]; }
+}
+/**************************************************************************************************/
+//choosing groups drops the OTUs none of them were seen in, from both formats
+TEST(TestSparseSharedFile, roundTripGroups) {
+    TestSparseSharedFile test;
+    test.writeSparse(test.textFile, test.sparseFile);
+    
+    vector<string> groups; groups.push_back("A"); groups.push_back("C");
+    vector<SharedRAbundVectors*> expected = test.readAll(test.textFile, groups);
+    vector<SharedRAbundVectors*> found = test.readAll(test.sparseFile, groups);
+    
+    ASSERT_EQ(3, found.size());
+    EXPECT_EQ(4, found[0]->getNumBins());
+    EXPECT_EQ(3, found[1]->getNumBins());
+    EXPECT_EQ(3, found[2]->getNumBins());
+    test.compare(expected, found);
+    
+    for (int i = 0; i < expected.size(); i++) { delete expected[i]; }
+    for (int i = 0; i < found.size(); i++) { delete found[i]; }
+}
+/**************************************************************************************************/
+//a label can be read on its own, without the ones before it
+TEST(TestSparseSharedFile, readLabel) {
+    TestSparseSharedFile test;
+    test.writeSparse(test.textFile, test.sparseFile);
+    
+    InputData text(test.textFile, "sharedfile", nullVector);
+    InputData sparse(test.sparseFile, "sharedfile", nullVector);
+    
+    vector<SharedRAbundVectors*> expected, found;
+    expected.push_back(text.getSharedRAbundVectors("0.02"));
+    found.push_back(sparse.getSharedRAbundVectors("0.02"));
+    ASSERT_TRUE(found[0] != NULL);
+    test.compare(expected, found);
+    
+    delete expected[0]; delete found[0];
+}
+/**************************************************************************************************/
+//a file cut short loses its footer, which must be reported instead of read
+TEST(TestSparseSharedFile, truncatedFooter) {
+    TestSparseSharedFile test;
+    test.writeSparse(test.textFile, test.sparseFile);
+    
+    ifstream in(test.sparseFile.c_str(), ios::binary);
+    string contents((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    in.close();
+    
+    ofstream out(test.sparseFile.c_str(), ios::binary);
+    out.write(contents.c_str(), contents.length() - 12);
+    out.close();
+    
+    SparseSharedFile sparse;
+    EXPECT_TRUE(sparse.isSparse(test.sparseFile));
+    EXPECT_FALSE(sparse.openInput(test.sparseFile));
+    EXPECT_TRUE(MothurOut::getInstance()->getControl_pressed());
+}
+/**************************************************************************************************/
+//damaged cells, row starts or sizes inside a label are reported instead of trusted. The first label starts at byte 8:
+//its label at 8, numBins at 16, numGroups at 20, the group names at 24, the row starts (0,3,5,7) at 39 and the OTUs at 71
+TEST(TestSparseSharedFile, damagedLabel) {
+    TestSparseSharedFile test;
+    test.writeSparse(test.textFile, test.sparseFile);
+    
+    ifstream in(test.sparseFile.c_str(), ios::binary);
+    string contents((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    in.close();
+    
+    int otuPastEnd = 5; long long decreasing = 2; int hugeGroups = 2000000000;
+    vector<string> damaged(3, contents);
+    damaged[0].replace(71, sizeof(int), (char*)&otuPastEnd, sizeof(int));
+    damaged[1].replace(55, sizeof(long long), (char*)&decreasing, sizeof(long long));
+    damaged[2].replace(20, sizeof(int), (char*)&hugeGroups, sizeof(int));
+    
+    for (int i = 0; i < damaged.size(); i++) {
+        ofstream out(test.sparseFile.c_str(), ios::binary);
+        out.write(damaged[i].c_str(), damaged[i].length());
+        out.close();
+        
+        MothurOut::getInstance()->setControl_pressed(false);
+        SparseSharedFile sparse;
+        ASSERT_TRUE(sparse.openInput(test.sparseFile));
+        
+        vector<string> groups;
+        EXPECT_TRUE(sparse.getSharedRAbundVectors("0.01", groups) == NULL) << "damage " << i;
+        EXPECT_TRUE(MothurOut::getInstance()->getControl_pressed()) << "damage " << i;
+        
+        //the other labels are untouched
+        MothurOut::getInstance()->setControl_pressed(false);
+        SharedRAbundVectors* other = sparse.getSharedRAbundVectors("0.02", groups);
+        EXPECT_TRUE(other != NULL) << "damage " << i;
+        delete other;
+        sparse.closeInput();
+    }
+}
+/**************************************************************************************************/
@@ -0,0 +1,33 @@
+//
+//  testsparsesharedfile.h
+//  Mothur
+//
+//
+
+#ifndef testsparsesharedfile_h
+#define testsparsesharedfile_h
+
+#include "gtest.h"
+#include "sparsesharedfile.h"
+#include "inputdata.h"
+
+class TestSparseSharedFile {
+    
+public:
+    
+    TestSparseSharedFile();
+    ~TestSparseSharedFile();
+    
+    string textFile, sparseFile;
+    
+    vector<SharedRAbundVectors*> readAll(string, vector<string>); //filename, groups. every label InputData returns
+    void writeSparse(string, string); //text shared file, sparse shared file
+    void compare(vector<SharedRAbundVectors*>&, vector<SharedRAbundVectors*>&);
+    
+private:
+    MothurOut* m;
+    Utils util;
+    
+};
+
+#endif /* testsparsesharedfile_h */
@@ -0,0 +1,214 @@
+//
+//  testlinearalgebra.cpp
+//  Mothur
+//
+//
+
+#include "testlinearalgebra.h"
+
+/**************************************************************************************************/
+TestLinearAlgebra::TestLinearAlgebra() {  //setup
+    m = MothurOut::getInstance();
+    
+    int numSeqs = 14;
+    distances.resize(numSeqs, vector<double>(numSeqs, 0.0));
+    for (int i = 0; i < numSeqs; i++) {
+        for (int j = 0; j < i; j++) {
+            distances[i][j] = 0.1 + ((i * 13 + j * 7 + i * j) % 17) / 20.0;
+            distances[j][i] = distances[i][j];
+        }
+    }
+    
+    int numSamples = 10; int numOTUs = 16;
+    abundances.resize(numSamples, vector<double>(numOTUs, 0.0));
+    for (int i = 0; i < numSamples; i++) {
+        for (int j = 0; j < numOTUs; j++) { abundances[i][j] = ((i * 5 + j * 11 + i * j * 3) % 23) * ((j % 3) + 1); }
+    }
+}
+/**************************************************************************************************/
+TestLinearAlgebra::~TestLinearAlgebra() { }
+/**************************************************************************************************/
+void TestLinearAlgebra::writePhylip(string filename) {
+    ofstream out;
+    util.openOutputFile(filename, out);
+    out << distances.size() << endl;
+    for (int i = 0; i < distances.size(); i++) {
+        out << "seq" << i;
+        for (int j = 0; j < i; j++) { out << '\t' << distances[i][j]; }
+        out << endl;
+    }
+    out.close();
+}
+/**************************************************************************************************/
+void TestLinearAlgebra::writeShared(string filename) {
+    ofstream out;
+    util.openOutputFile(filename, out);
+    out << "label\tGroup\tnumOtus";
+    for (int j = 0; j < abundances[0].size(); j++) { out << "\tOtu" << j+1; }
+    out << endl;
+    for (int i = 0; i < abundances.size(); i++) {
+        out << "0.03\tsample" << i << '\t' << abundances[i].size();
+        for (int j = 0; j < abundances[i].size(); j++) { out << '\t' << (int) abundances[i][j]; }
+        out << endl;
+    }
+    out.close();
+}
+/**************************************************************************************************/
+//group axis1 axis2 ..., with absolute values since the sign of an axis is arbitrary
+vector< vector<double> > TestLinearAlgebra::readAxes(string filename) {
+    ifstream in;
+    util.openInputFile(filename, in);
+    util.getline(in); util.gobble(in);
+    
+    vector< vector<double> > axes;
+    while (!in.eof()) {
+        string line = util.getline(in); util.gobble(in);
+        vector<string> pieces = util.splitWhiteSpace(line);
+        vector<double> values;
+        for (int i = 1; i < pieces.size(); i++) { double value = 0; util.mothurConvert(pieces[i], value); values.push_back(fabs(value)); }
+        axes.push_back(values);
+    }
+    in.close();
+    
+    return axes;
+}
+/**************************************************************************************************/
+vector<double> TestLinearAlgebra::readLoadings(string filename) {
+    ifstream in;
+    util.openInputFile(filename, in);
+    util.getline(in); util.gobble(in);
+    
+    vector<double> loadings;
+    while (!in.eof()) {
+        int axis; double loading;
+        in >> axis >> loading; util.gobble(in);
+        loadings.push_back(loading);
+    }
+    in.close();
+    
+    return loadings;
+}
+/**************************************************************************************************/
+void TestLinearAlgebra::removeFiles(Command* command) {
+    map<string, vector<string> > outputs = command->getOutputFiles();
+    for (map<string, vector<string> >::iterator it = outputs.begin(); it != outputs.end(); it++) {
+        for (int i = 0; i < it->second.size(); i++) { util.mothurRemove(it->second[i]); }
+    }
+}
+/**************************************************************************************************/
+//the largest eigenpairs of CAC from lanczos against the full decomposition pcoa uses with axes=0
+TEST(TestLinearAlgebra, lanczosDoubleCentered) {
+    TestLinearAlgebra test;
+    int rank = test.distances.size();
+    int numAxes = 3;
+    
+    vector< vector<double> > G = test.distances;
+    vector<double> d, e;
+    test.linear.recenter(0.0, test.distances, G);
+    test.linear.tred2(G, d, e);
+    test.linear.qtli(d, e, G);
+    ASSERT_LT(d[rank-1], -0.01); //not euclidean
+    
+    RowMajorMatrix A(rank, rank);
+    for (int i = 0; i < rank; i++) {
+        for (int j = 0; j < rank; j++) { A.row(i)[j] = -0.5 * test.distances[i][j] * test.distances[i][j]; }
+    }
+    DoubleCenteredOperator centered(A, 1);
+    
+    vector<double> values; vector< vector<double> > vectors; double smallest = 0.0;
+    test.linear.lanczos(centered, numAxes, values, vectors, smallest, true);
+    
+    ASSERT_EQ(numAxes, values.size());
+    for (int j = 0; j < numAxes; j++) {
+        EXPECT_NEAR(d[j], values[j], 1e-8);
+        for (int i = 0; i < rank; i++) { EXPECT_NEAR(fabs(G[i][j]), fabs(vectors[i][j]), 1e-6); }
+    }
+    EXPECT_NEAR(d[rank-1], smallest, 1e-8);
+}
+/**************************************************************************************************/
+//the largest eigenpairs of XX' from lanczos against the full decomposition
+TEST(TestLinearAlgebra, lanczosGram) {
+    TestLinearAlgebra test;
+    int numSamples = test.abundances.size();
+    int numOTUs = test.abundances[0].size();
+    int numAxes = 4;
+    
+    RowMajorMatrix X(numSamples, numOTUs);
+    vector< vector<double> > centered = test.abundances;
+    for (int j = 0; j < numOTUs; j++) {
+        double mean = 0.0;
+        for (int i = 0; i < numSamples; i++) { mean += centered[i][j]; }
+        mean /= (double) numSamples;
+        for (int i = 0; i < numSamples; i++) { centered[i][j] -= mean; X.row(i)[j] = centered[i][j]; }
+    }
+    
+    vector< vector<double> > G = test.linear.matrix_mult(centered, test.linear.transpose(centered));
+    vector<double> d, e;
+    test.linear.tred2(G, d, e);
+    test.linear.qtli(d, e, G);
+    
+    GramOperator gram(X, 1);
+    vector<double> values; vector< vector<double> > vectors; double smallest = 0.0;
+    test.linear.lanczos(gram, numAxes, values, vectors, smallest, false);
+    
+    ASSERT_EQ(numAxes, values.size());
+    for (int j = 0; j < numAxes; j++) {
+        EXPECT_NEAR(d[j], values[j], 1e-6 * d[0]);
+        for (int i = 0; i < numSamples; i++) { EXPECT_NEAR(fabs(G[i][j]), fabs(vectors[i][j]), 1e-6); }
+    }
+}
+/**************************************************************************************************/
+//pcoa with axes set must write the same leading axes and loadings as the full solver, up to the sign of each axis
+TEST(TestLinearAlgebra, pcoaAxes) {
+    TestLinearAlgebra test;
+    test.writePhylip("testlinearalgebra.full.dist");
+    test.writePhylip("testlinearalgebra.axes.dist");
+    
+    PCOACommand full("phylip=testlinearalgebra.full.dist, metric=f");
+    full.execute();
+    PCOACommand truncated("phylip=testlinearalgebra.axes.dist, axes=3, metric=f");
+    truncated.execute();
+    
+    vector<double> fullLoadings = test.readLoadings(full.getOutputFiles()["loadings"][0]);
+    vector<double> loadings = test.readLoadings(truncated.getOutputFiles()["loadings"][0]);
+    vector< vector<double> > fullAxes = test.readAxes(full.getOutputFiles()["pcoa"][0]);
+    vector< vector<double> > axes = test.readAxes(truncated.getOutputFiles()["pcoa"][0]);
+    
+    ASSERT_EQ(3, loadings.size());
+    ASSERT_EQ(fullAxes.size(), axes.size());
+    for (int j = 0; j < 3; j++) {
+        EXPECT_NEAR(fullLoadings[j], loadings[j], 1e-5);
+        for (int i = 0; i < axes.size(); i++) { EXPECT_NEAR(fullAxes[i][j], axes[i][j], 1e-5); }
+    }
+    
+    test.removeFiles(&full); test.removeFiles(&truncated);
+    Utils util; util.mothurRemove("testlinearalgebra.full.dist"); util.mothurRemove("testlinearalgebra.axes.dist");
+}
+/**************************************************************************************************/
+//pca with axes set must write the same leading axes and loadings as the full solver, up to the sign of each axis
+TEST(TestLinearAlgebra, pcaAxes) {
+    TestLinearAlgebra test;
+    test.writeShared("testlinearalgebra.full.shared");
+    test.writeShared("testlinearalgebra.axes.shared");
+    
+    PCACommand full("shared=testlinearalgebra.full.shared, metric=f");
+    full.execute();
+    PCACommand truncated("shared=testlinearalgebra.axes.shared, axes=4, metric=f");
+    truncated.execute();
+    
+    vector<double> fullLoadings = test.readLoadings(full.getOutputFiles()["loadings"][0]);
+    vector<double> loadings = test.readLoadings(truncated.getOutputFiles()["loadings"][0]);
+    vector< vector<double> > fullAxes = test.readAxes(full.getOutputFiles()["pca"][0]);
+    vector< vector<double> > axes = test.readAxes(truncated.getOutputFiles()["pca"][0]);
+    
+    ASSERT_EQ(4, loadings.size());
+    ASSERT_EQ(fullAxes.size(), axes.size());
+    for (int j = 0; j < 4; j++) {
+        EXPECT_NEAR(fullLoadings[j], loadings[j], 1e-5);
+        for (int i = 0; i < axes.size(); i++) { EXPECT_NEAR(fullAxes[i][j], axes[i][j], 1e-5); }
+    }
+    
+    test.removeFiles(&full); test.removeFiles(&truncated);
+    Utils util; util.mothurRemove("testlinearalgebra.full.shared"); util.mothurRemove("testlinearalgebra.axes.shared");
+}
+/**************************************************************************************************/
@@ -0,0 +1,40 @@
+//
+//  testlinearalgebra.h
+//  Mothur
+//
+//
+
+#ifndef testlinearalgebra_h
+#define testlinearalgebra_h
+
+#include "gtest.h"
+#include "linearalgebra.h"
+#include "pcoacommand.h"
+#include "pcacommand.h"
+
+
+class TestLinearAlgebra {
+    
+public:
+    
+    TestLinearAlgebra();
+    ~TestLinearAlgebra();
+    
+    LinearAlgebra linear;
+    vector< vector<double> > distances;    //not euclidean, so the double centered matrix has negative eigenvalues
+    vector< vector<double> > abundances;   //samples by OTUs
+    
+    void writePhylip(string);
+    void writeShared(string);
+    vector< vector<double> > readAxes(string);
+    vector<double> readLoadings(string);
+    void removeFiles(Command*);
+    
+private:
+    MothurOut* m;
+    Utils util;
+    
+};
+
+
+#endif /* testlinearalgebra_h */
@@ -11,14 +11,55 @@
 #include "dataset.h"
 
 /**************************************************************************************************/
-TestOptiCluster::TestOptiCluster()  {  //setup
+TestOptiCluster::TestOptiCluster(bool overlap) : overlapMatrix(true) {  //setup
     m = MothurOut::getInstance();
     metric = new MCC();
-    setVariables(&testMatrix, metric);
+    if (overlap) { setVariables(&overlapMatrix, metric); }
+    else { setVariables(&testMatrix, metric); }
 }
 /**************************************************************************************************/
 TestOptiCluster::~TestOptiCluster() { delete metric; }
 /**************************************************************************************************/
+vector< set<string> > TestOptiCluster::getOTUs() {
+    ListVector* list = getList();
+    
+    vector<string> otus;
+    for (int i = 0; i < list->getNumBins(); i++) { otus.push_back(list->get(i)); }
+    delete list;
+    
+    return toOTUs(otus);
+}
+/**************************************************************************************************/
+vector< set<string> > TestOptiCluster::toOTUs(vector<string> otus) {
+    vector< set<string> > results;
+    for (int i = 0; i < otus.size(); i++) {
+        vector<string> names; util.splitAtComma(otus[i], names);
+        results.push_back(set<string>(names.begin(), names.end()));
+    }
+    return results;
+}
+/**************************************************************************************************/
+bool TestOptiCluster::countsMatchBins() {
+    long long tp = 0; long long tn = 0; long long fp = 0; long long fn = 0;
+    
+    for (int i = 0; i < matrix->getNumSeqs(); i++) {
+        for (int j = i+1; j < matrix->getNumSeqs(); j++) {
+            bool sameBin = (seqBin[i] == seqBin[j]);
+            bool close = matrix->isClose(i, j);
+            
+            if (sameBin && close)       { tp++; }
+            else if (sameBin)           { fp++; }
+            else if (close)             { fn++; }
+            else                        { tn++; }
+        }
+    }
+    
+    //every seq is found where seqPosition says it is
+    for (int i = 0; i < matrix->getNumSeqs(); i++) { if (bins[seqBin[i]][seqPosition[i]] != i) { return false; } }
+    
+    return ((tp == truePositives) && (tn == trueNegatives) && (fp == falsePositives) && (fn == falseNegatives));
+}
+/**************************************************************************************************/
 TEST(TestOptiCluster, myInitialize) {
     TestOptiCluster test;
     double initialMetricValue;
@@ -52,4 +93,139 @@ TEST(TestOptiCluster, getCloseFarCounts) {
     ASSERT_EQ(results[0], 0); //number of close sequences in bin 31 to seq 0
     ASSERT_EQ(results[1], 10); //number of far sequences in bin 31 to seq 0
 }
+
+//otus and counts found by the update before seqBin and seqPosition replaced the map and the bin searches
+TEST(TestOptiCluster, sameAsOldCode) {
+    MothurOut::getInstance()->setRandomSeed(19760620);
+    long long tp, tn, fp, fn;
+    double metricValue;
+    
+    vector<string> singletons; for (int i = 90; i < 100; i++) { singletons.push_back(toString(i)); }
+    
+    TestOptiCluster test(true);
+    test.initialize(metricValue, true, "singleton");
+    test.update(metricValue);
+    
+    test.getStats(tp, tn, fp, fn);
+    EXPECT_EQ(371, tp); EXPECT_EQ(4522, tn); EXPECT_EQ(8, fp); EXPECT_EQ(49, fn);
+    ASSERT_NEAR(0.922278, metricValue, 0.00001);
+    
+    vector<string> expected = singletons;
+    expected.push_back("0,1,2,3,4,5,6,7,8,9"); expected.push_back("10,11,12,13,14,15,16,17,18,19"); expected.push_back("20,21,22,23,24,25,26,27,29");
+    expected.push_back("31"); expected.push_back("32"); expected.push_back("28"); expected.push_back("30,33,34,35,36,37,38,39");
+    expected.push_back("40,41,42,43,44,45,46,47,48,49"); expected.push_back("50,51,52,53,54,55,56,57,58,59"); expected.push_back("60,61,62,63,64,65,66,67,68,69");
+    expected.push_back("70,71,72,73,74,75,76,77,78,79"); expected.push_back("80,81,82,83,84,85,86,87,88,89");
+    EXPECT_EQ(test.toOTUs(expected), test.getOTUs());
+    
+    test.update(metricValue);
+    test.getStats(tp, tn, fp, fn);
+    EXPECT_EQ(396, tp); EXPECT_EQ(4521, tn); EXPECT_EQ(9, fp); EXPECT_EQ(24, fn);
+    ASSERT_NEAR(0.955605, metricValue, 0.00001);
+    
+    //everyone starts in one otu, so the first rounds move most of the seqs
+    TestOptiCluster test2(true);
+    test2.initialize(metricValue, true, "oneotu");
+    test2.update(metricValue);
+    
+    test2.getStats(tp, tn, fp, fn);
+    EXPECT_EQ(364, tp); EXPECT_EQ(3875, tn); EXPECT_EQ(655, fp); EXPECT_EQ(56, fn);
+    
+    expected = singletons;
+    expected.push_back("1,10,20,21,22,23,24,25,27,28,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,57,58,59,72");
+    expected.push_back("11,12,13,14,15,16,17,18,19"); expected.push_back("70,71,73,74,75,76,77,78,79"); expected.push_back("80,81,82,83,84,85,86,87,88,89");
+    expected.push_back("0,2,3,4,5,6,7,8,9"); expected.push_back("26,29"); expected.push_back("60,61,62,63,64,65,66,67,68,69");
+    EXPECT_EQ(test2.toOTUs(expected), test2.getOTUs());
+    
+    test2.update(metricValue);
+    
+    test2.getStats(tp, tn, fp, fn);
+    EXPECT_EQ(353, tp); EXPECT_EQ(4415, tn); EXPECT_EQ(115, fp); EXPECT_EQ(67, fn);
+    
+    expected = singletons;
+    expected.push_back("30,31,32,33,34,35,36,37,38,39,41,44,47,50,51,52,53,55,57"); expected.push_back("10,11,12,13,14,15,16,17,18,19");
+    expected.push_back("70,71,72,73,74,75,76,77,78,79"); expected.push_back("80,81,82,83,84,85,86,87,88,89"); expected.push_back("0,1,2,3,4,5,6,7,8,9");
+    expected.push_back("20,21,22,23,24,25,26,27,28,29"); expected.push_back("40,42,43,45,46,48,49"); expected.push_back("54,56,58,59");
+    expected.push_back("60,61,62,63,64,65,66,67,68,69");
+    EXPECT_EQ(test2.toOTUs(expected), test2.getOTUs());
+    EXPECT_TRUE(test2.countsMatchBins());
+}
+
+TEST(TestOptiCluster, updateDeterministic) {
+    double metricValue, metricValue2;
+    
+    MothurOut::getInstance()->setRandomSeed(19760620);
+    TestOptiCluster test(true);
+    test.initialize(metricValue, true, "oneotu");
+    
+    MothurOut::getInstance()->setRandomSeed(19760620);
+    TestOptiCluster test2(true);
+    test2.initialize(metricValue2, true, "oneotu");
+    
+    for (int i = 0; i < 4; i++) {
+        test.update(metricValue);
+        test2.update(metricValue2);
+        
+        ASSERT_EQ(metricValue, metricValue2);
+        ASSERT_EQ(test.bins, test2.bins); //same otus with the names in the same order
+        ASSERT_TRUE(test.countsMatchBins());
+    }
+}
+
+//moving seqs reorders the bins, the list names each otu's seqs in the order they were read
+TEST(TestOptiCluster, listInReadOrder) {
+    double metricValue;
+    Utils util;
+    
+    MothurOut::getInstance()->setRandomSeed(19760620);
+    TestOptiCluster test(true);
+    test.initialize(metricValue, true, "oneotu");
+    
+    for (int i = 0; i < 3; i++) {
+        test.update(metricValue);
+        
+        ListVector* list = test.getList();
+        for (int j = 0; j < list->getNumBins(); j++) {
+            string otu = list->get(j);
+            vector<int> seqs; util.splitAtComma(otu, seqs);
+            EXPECT_TRUE(is_sorted(seqs.begin(), seqs.end())) << list->get(j);
+        }
+        delete list;
+    }
+}
+
+//the batches don't depend on the number of processors
+TEST(TestOptiCluster, updateBatches) {
+    double metricValue, metricValue2;
+    
+    for (int seed = 1; seed < 5; seed++) {
+        MothurOut::getInstance()->setRandomSeed(seed);
+        TestOptiCluster test(true);
+        test.setProcessors(2);
+        test.initialize(metricValue, true, "oneotu");
+        
+        MothurOut::getInstance()->setRandomSeed(seed);
+        TestOptiCluster test2(true);
+        test2.setProcessors(3);
+        test2.initialize(metricValue2, true, "oneotu");
+        
+        for (int i = 0; i < 4; i++) {
+            test.update(metricValue);
+            test2.update(metricValue2);
+            
+            ASSERT_EQ(metricValue, metricValue2);
+            ASSERT_EQ(test.bins, test2.bins);
+            ASSERT_TRUE(test.countsMatchBins());
+        }
+    }
+    
+    //from singletons the sets in FakeOptiMatrix are found as they are with 1 processor
+    MothurOut::getInstance()->setRandomSeed(19760620);
+    TestOptiCluster test;
+    test.setProcessors(4);
+    test.initialize(metricValue, true, "singleton");
+    for (int i = 0; i < 3; i++) { test.update(metricValue); }
+    
+    ASSERT_NEAR(1, metricValue, 0.00001);
+    ASSERT_TRUE(test.countsMatchBins());
+}
 /**************************************************************************************************/
@@ -19,13 +19,18 @@ class TestOptiCluster : public OptiCluster   {
     
 public:
     
-    TestOptiCluster();
+    TestOptiCluster(bool overlap = false); //overlap clusters FakeOptiMatrix(true)
     ~TestOptiCluster();
     
 protected:
     MothurOut* m;
     ClusterMetric* metric;
     FakeOptiMatrix testMatrix;
+    FakeOptiMatrix overlapMatrix;
+    
+    vector< set<string> > getOTUs(); //otus from getList in order, the order of the names in an otu is ignored
+    vector< set<string> > toOTUs(vector<string>); //comma separated otus
+    bool countsMatchBins(); //tp, tn, fp and fn counted pair by pair from seqBin match the running counts
     
     using OptiCluster::setVariables;
     using OptiCluster::initialize;
@@ -35,6 +40,10 @@ protected:
     FRIEND_TEST(TestOptiCluster, myInitialize);
     FRIEND_TEST(TestOptiCluster, getCloseFarCounts);
     FRIEND_TEST(TestOptiCluster, myUpdate);
+    FRIEND_TEST(TestOptiCluster, sameAsOldCode);
+    FRIEND_TEST(TestOptiCluster, updateDeterministic);
+    FRIEND_TEST(TestOptiCluster, updateBatches);
+    FRIEND_TEST(TestOptiCluster, listInReadOrder);
 
 };
 
@@ -0,0 +1,145 @@
+//
+//  testpermutationtest.cpp
+//  Mothur
+//
+//
+
+#include "testpermutationtest.h"
+
+/**************************************************************************************************/
+TestPermutationTest::TestPermutationTest() {  //setup
+    m = MothurOut::getInstance();
+    
+    int numSamples = 9;
+    distances.resize(numSamples, vector<double>(numSamples, 0.0));
+    otherDistances.resize(numSamples, vector<double>(numSamples, 0.0));
+    for (int i = 0; i < numSamples; i++) {
+        for (int j = 0; j < i; j++) {
+            distances[i][j] = ((i * 7 + j * 3) % 4 + 1) / 10.0;
+            distances[j][i] = distances[i][j];
+            otherDistances[i][j] = ((i * 5 + j * 11 + i * j) % 5 + 1) / 10.0;
+            otherDistances[j][i] = otherDistances[i][j];
+        }
+    }
+    
+    groupSampleMap["A"].push_back(0); groupSampleMap["A"].push_back(5); groupSampleMap["A"].push_back(3);
+    groupSampleMap["B"].push_back(7); groupSampleMap["B"].push_back(1); groupSampleMap["B"].push_back(2); groupSampleMap["B"].push_back(8);
+    groupSampleMap["C"].push_back(6); groupSampleMap["C"].push_back(4);
+    
+    amova.distanceMatrix = distances;
+    homova.distanceMatrix = distances;
+}
+/**************************************************************************************************/
+TestPermutationTest::~TestPermutationTest() { }
+/**************************************************************************************************/
+//the group statistics number the samples in group order, so position i of the order holds the ith sample of that list
+map<string, vector<int> > TestPermutationTest::getShuffledGroups(vector<int>& order) {
+    vector<int> indexes;
+    for (map<string, vector<int> >::iterator it = groupSampleMap.begin(); it != groupSampleMap.end(); it++) {
+        indexes.insert(indexes.end(), it->second.begin(), it->second.end());
+    }
+    
+    map<string, vector<int> > shuffled = groupSampleMap; int position = 0;
+    for (map<string, vector<int> >::iterator it = shuffled.begin(); it != shuffled.end(); it++) {
+        for (int i = 0; i < it->second.size(); i++) { it->second[i] = indexes[order[position++]]; }
+    }
+    
+    return shuffled;
+}
+/**************************************************************************************************/
+vector< vector<double> > TestPermutationTest::getShuffledRows(vector<int>& order) {
+    vector< vector<double> > shuffled;
+    for (int i = 0; i < order.size(); i++) { shuffled.push_back(otherDistances[order[i]]); }
+    return shuffled;
+}
+/**************************************************************************************************/
+double TestPermutationTest::getAmovaSSWithin(map<string, vector<int> > groups) { return amova.calcSSWithin(groups); }
+/**************************************************************************************************/
+double TestPermutationTest::getHomovaB(map<string, vector<int> > groups) { vector<double> ssWithin; return homova.calcBValue(groups, ssWithin); }
+/**************************************************************************************************/
+double TestPermutationTest::getAnosimR(map<string, vector<int> > groups) { return anosim.calcR(getAnosimRanks(), groups); }
+/**************************************************************************************************/
+vector< vector<double> > TestPermutationTest::getAnosimRanks() { return anosim.convertToRanks(distances); }
+/**************************************************************************************************/
+//the observed and shuffled statistics against the commands' own calculations
+TEST(TestPermutationTest, groupStatisticsSameAsCommands) {
+    TestPermutationTest test;
+    
+    AmovaStatistic amova(test.distances, test.groupSampleMap);
+    HomovaStatistic homova(test.distances, test.groupSampleMap);
+    vector< vector<double> > ranks = test.getAnosimRanks();
+    AnosimStatistic anosim(ranks, test.groupSampleMap);
+    
+    EXPECT_NEAR(test.getAmovaSSWithin(test.groupSampleMap), amova.getObserved(), 1e-9);
+    EXPECT_NEAR(test.getHomovaB(test.groupSampleMap), homova.getObserved(), 1e-9);
+    EXPECT_NEAR(test.getAnosimR(test.groupSampleMap), anosim.getObserved(), 1e-9);
+    
+    vector<int> order(test.distances.size());
+    for (int i = 0; i < order.size(); i++) { order[i] = i; }
+    
+    mt19937_64 randomGenerator(19760620);
+    for (int i = 0; i < 20; i++) {
+        shuffle(order.begin(), order.end(), randomGenerator);
+        map<string, vector<int> > shuffled = test.getShuffledGroups(order);
+        
+        EXPECT_NEAR(test.getAmovaSSWithin(shuffled), amova.getStatistic(order), 1e-9);
+        EXPECT_NEAR(test.getHomovaB(shuffled), homova.getStatistic(order), 1e-9);
+        EXPECT_NEAR(test.getAnosimR(shuffled), anosim.getStatistic(order), 1e-9);
+    }
+}
+/**************************************************************************************************/
+//pearson, spearman with tied ranks, and kendall counted with the fenwick tree, against LinearAlgebra
+TEST(TestPermutationTest, mantelSameAsLinearAlgebra) {
+    TestPermutationTest test;
+    
+    MantelStatistic pearson(test.distances, test.otherDistances, "pearson");
+    MantelStatistic spearman(test.distances, test.otherDistances, "spearman");
+    MantelStatistic kendall(test.distances, test.otherDistances, "kendall");
+    
+    EXPECT_NEAR(test.linear.calcPearson(test.distances, test.otherDistances), pearson.getObserved(), 1e-6);
+    EXPECT_NEAR(test.linear.calcSpearman(test.distances, test.otherDistances), spearman.getObserved(), 1e-6);
+    EXPECT_NEAR(test.linear.calcKendall(test.distances, test.otherDistances), kendall.getObserved(), 1e-6);
+    
+    vector<int> order(test.otherDistances.size());
+    for (int i = 0; i < order.size(); i++) { order[i] = i; }
+    
+    mt19937_64 randomGenerator(19760620);
+    for (int i = 0; i < 20; i++) {
+        shuffle(order.begin(), order.end(), randomGenerator);
+        vector< vector<double> > shuffled = test.getShuffledRows(order);
+        
+        EXPECT_NEAR(test.linear.calcPearson(test.distances, shuffled), pearson.getStatistic(order), 1e-6);
+        EXPECT_NEAR(test.linear.calcSpearman(test.distances, shuffled), spearman.getStatistic(order), 1e-6);
+        EXPECT_NEAR(test.linear.calcKendall(test.distances, shuffled), kendall.getStatistic(order), 1e-6);
+    }
+}
+/**************************************************************************************************/
+//each block of iters has its own stream, so the counts don't depend on how the blocks are split between threads.
+//1050 iters leaves a short last block.
+TEST(TestPermutationTest, countSameForAnyProcessors) {
+    TestPermutationTest test;
+    MothurOut::getInstance()->setRandomSeed(19760620);
+    
+    AmovaStatistic amova(test.distances, test.groupSampleMap);
+    vector< vector<double> > ranks = test.getAnosimRanks();
+    AnosimStatistic anosim(ranks, test.groupSampleMap);
+    MantelStatistic kendall(test.distances, test.otherDistances, "kendall");
+    
+    vector<PermutationStatistic*> statistics; statistics.push_back(&amova); statistics.push_back(&anosim); statistics.push_back(&kendall);
+    vector<bool> greater; greater.push_back(false); greater.push_back(true); greater.push_back(true);
+    
+    for (int i = 0; i < statistics.size(); i++) {
+        double observed = statistics[i]->getObserved();
+        
+        PermutationTest oneProcessor(1050, 1);
+        int count = oneProcessor.getCount(statistics[i], observed, greater[i]);
+        
+        PermutationTest fourProcessors(1050, 4);
+        EXPECT_EQ(count, fourProcessors.getCount(statistics[i], observed, greater[i]));
+        
+        //some shuffles land on each side of the observed statistic
+        EXPECT_LT(0, count);
+        EXPECT_GT(1050, count);
+    }
+}
+/**************************************************************************************************/
@@ -0,0 +1,45 @@
+//
+//  testpermutationtest.h
+//  Mothur
+//
+//
+
+#ifndef testpermutationtest_h
+#define testpermutationtest_h
+
+#include "gtest.h"
+#include "permutationtest.h"
+#include "linearalgebra.h"
+#include "amovacommand.h"
+#include "anosimcommand.h"
+#include "homovacommand.h"
+
+class TestPermutationTest {
+    
+public:
+    
+    TestPermutationTest();
+    ~TestPermutationTest();
+    
+    LinearAlgebra linear;
+    vector< vector<double> > distances, otherDistances;    //both with tied distances
+    map<string, vector<int> > groupSampleMap;              //group -> indexes into distances, not in index order
+    
+    //the groups after the samples are put in this order, the way the statistics see an order
+    map<string, vector<int> > getShuffledGroups(vector<int>&);
+    vector< vector<double> > getShuffledRows(vector<int>&);
+    
+    //the statistics as the commands calculate them
+    double getAmovaSSWithin(map<string, vector<int> >);
+    double getHomovaB(map<string, vector<int> >);
+    double getAnosimR(map<string, vector<int> >);
+    vector< vector<double> > getAnosimRanks();
+    
+private:
+    MothurOut* m;
+    AmovaCommand amova;
+    HomovaCommand homova;
+    AnosimCommand anosim;
+};
+
+#endif /* testpermutationtest_h */
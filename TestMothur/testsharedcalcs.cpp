@@ -0,0 +1,114 @@
+//
+//  testsharedcalcs.cpp
+//  Mothur
+//
+//
+
+#include "testsharedcalcs.h"
+
+/**************************************************************************************************/
+//OTUs 4 and 8 are empty in A and B, A has OTUs B doesn't and B has OTUs A doesn't, and the shared OTUs include
+//abundances of 1 and 2 for the estimators. A and C share no OTUs.
+TestSharedCalcs::TestSharedCalcs() {  //setup
+    m = MothurOut::getInstance();
+    
+    int abundsA[] = { 3, 1, 0, 2, 0, 5, 1, 0, 0, 2 };
+    int abundsB[] = { 1, 0, 4, 2, 0, 1, 2, 1, 0, 0 };
+    int abundsC[] = { 0, 0, 6, 0, 0, 0, 0, 1, 2, 0 };
+    
+    shared.push_back(new SharedRAbundVector(vector<int>(abundsA, abundsA+10))); shared[0]->setGroup("A");
+    shared.push_back(new SharedRAbundVector(vector<int>(abundsB, abundsB+10))); shared[1]->setGroup("B");
+    shared.push_back(new SharedRAbundVector(vector<int>(abundsC, abundsC+10))); shared[2]->setGroup("C");
+    
+    calcs.push_back(new Canberra()); calcs.push_back(new Hamming()); calcs.push_back(new Hellinger()); calcs.push_back(new Manhattan());
+    calcs.push_back(new MemChord()); calcs.push_back(new MemEuclidean()); calcs.push_back(new Odum()); calcs.push_back(new SharedAce());
+    calcs.push_back(new Anderberg()); calcs.push_back(new BrayCurtis()); calcs.push_back(new SharedChao1()); calcs.push_back(new JAbund());
+    calcs.push_back(new Jclass()); calcs.push_back(new Jest()); calcs.push_back(new JSD()); calcs.push_back(new Kulczynski());
+    calcs.push_back(new KulczynskiCody()); calcs.push_back(new Lennon()); calcs.push_back(new MorHorn()); calcs.push_back(new SharedNSeqs());
+    calcs.push_back(new Ochiai()); calcs.push_back(new RJSD()); calcs.push_back(new SharedSobsCS()); calcs.push_back(new SorAbund());
+    calcs.push_back(new SorClass()); calcs.push_back(new SorEst()); calcs.push_back(new ThetaN()); calcs.push_back(new ThetaYC());
+    calcs.push_back(new Soergel()); calcs.push_back(new SpeciesProfile()); calcs.push_back(new StructChord()); calcs.push_back(new StructEuclidean());
+    calcs.push_back(new StructKulczynski()); calcs.push_back(new Whittaker());
+
+    //from the calculators before they had sparse versions
+    oldAB["canberra"] = {0.55000001117587094}; oldAC["canberra"] = {0.90000001341104507};
+    oldAB["hamming"] = {4}; oldAC["hamming"] = {9};
+    oldAB["hellinger"] = {0.90012744279507839}; oldAC["hellinger"] = {1.4142135623730949};
+    oldAB["manhattan"] = {15}; oldAC["manhattan"] = {23};
+    oldAB["memchord"] = {0.81649658092772615}; oldAC["memchord"] = {1.4142135623730951};
+    oldAB["memeuclidean"] = {2}; oldAC["memeuclidean"] = {3};
+    oldAB["odum"] = {0.59999999999999998}; oldAC["odum"] = {1};
+    oldAB["sharedace"] = {20.045453507791894}; oldAC["sharedace"] = {0};
+    oldAB["anderberg"] = {0.66666666666666674}; oldAC["anderberg"] = {1};
+    oldAB["braycurtis"] = {0.59999999999999998}; oldAC["braycurtis"] = {1};
+    oldAB["sharedchao"] = {5.5}; oldAC["sharedchao"] = {0};
+    oldAB["jabund"] = {0.37012982368469238}; oldAC["jabund"] = {0};
+    oldAB["jclass"] = {0.5}; oldAC["jclass"] = {1};
+    oldAB["jest"] = {0.29787235467236384}; oldAC["jest"] = {1};
+    oldAB["jsd"] = {0.30050791332203686}; oldAC["jsd"] = {0.69309155329187933};
+    oldAB["kulczynski"] = {0}; oldAC["kulczynski"] = {1};
+    oldAB["kulczynskicody"] = {0.33333333333333337}; oldAC["kulczynskicody"] = {1};
+    oldAB["lennon"] = {0.33333333333333337}; oldAC["lennon"] = {1};
+    oldAB["morisitahorn"] = {0.5938206445694818}; oldAC["morisitahorn"] = {1};
+    oldAB["sharednseqs"] = {25}; oldAC["sharednseqs"] = {23};
+    oldAB["ochiai"] = {0.66666666666666663}; oldAC["ochiai"] = {0};
+    oldAB["rjsd"] = {0.54818602072839917}; oldAC["rjsd"] = {0.8325212029082979};
+    oldAB["sharedsobs"] = {4}; oldAC["sharedsobs"] = {0};
+    oldAB["sorabund"] = {0.22709159849863325}; oldAC["sorabund"] = {1};
+    oldAB["sorclass"] = {0.33333333333333337}; oldAC["sorclass"] = {1};
+    oldAB["sorest"] = {0.17499998033046671}; oldAC["sorest"] = {1};
+    oldAB["thetan"] = {0.52517985611510798}; oldAC["thetan"] = {1};
+    oldAB["thetayc"] = {0.74515366430260044, 0.41561997948535978, 1.0746873491198412}; oldAC["thetayc"] = {1, 1, 1};
+    oldAB["soergel"] = {0.75}; oldAC["soergel"] = {1};
+    oldAB["speciesprofile"] = {0.51556969457868074}; oldAC["speciesprofile"] = {0.85478806462452439};
+    oldAB["structchord"] = {1.0897878718081224}; oldAC["structchord"] = {1.4142135623730951};
+    oldAB["structeuclidean"] = {6.5574385243020004}; oldAC["structeuclidean"] = {9.2195444572928871};
+    oldAB["structkulczynski"] = {0.5941558441558441}; oldAC["structkulczynski"] = {1};
+    oldAB["whittaker"] = {0.33333337306976318}; oldAC["whittaker"] = {-0.22222232818603516};
+}
+/**************************************************************************************************/
+TestSharedCalcs::~TestSharedCalcs() {
+    for (int i = 0; i < shared.size(); i++) { delete shared[i]; }
+    for (int i = 0; i < calcs.size(); i++) { delete calcs[i]; }
+}
+/**************************************************************************************************/
+//the sparse getValues against the dense values, for a pair with shared OTUs and a pair without
+TEST(TestSharedCalcs, sparseSameAsOldDense) {
+    TestSharedCalcs test;
+    
+    SparseRAbund A(test.shared[0]); SparseRAbund B(test.shared[1]); SparseRAbund C(test.shared[2]);
+    
+    for (int i = 0; i < test.calcs.size(); i++) {
+        string name = test.calcs[i]->getName();
+        EXPECT_TRUE(test.calcs[i]->hasSparse()) << name;
+        
+        EstOutput found = test.calcs[i]->getValues(&A, &B);
+        ASSERT_EQ(test.oldAB[name].size(), found.size()) << name;
+        for (int j = 0; j < found.size(); j++) { EXPECT_DOUBLE_EQ(test.oldAB[name][j], found[j]) << name; }
+        
+        found = test.calcs[i]->getValues(&A, &C);
+        ASSERT_EQ(test.oldAC[name].size(), found.size()) << name;
+        for (int j = 0; j < found.size(); j++) { EXPECT_DOUBLE_EQ(test.oldAC[name][j], found[j]) << name; }
+    }
+}
+/**************************************************************************************************/
+//the dense getValues build the sparse vectors, so they give the same values
+TEST(TestSharedCalcs, denseSameAsOldDense) {
+    TestSharedCalcs test;
+    
+    vector<SharedRAbundVector*> AB; AB.push_back(test.shared[0]); AB.push_back(test.shared[1]);
+    vector<SharedRAbundVector*> AC; AC.push_back(test.shared[0]); AC.push_back(test.shared[2]);
+    
+    for (int i = 0; i < test.calcs.size(); i++) {
+        string name = test.calcs[i]->getName();
+        
+        EstOutput found = test.calcs[i]->getValues(AB);
+        ASSERT_EQ(test.oldAB[name].size(), found.size()) << name;
+        for (int j = 0; j < found.size(); j++) { EXPECT_DOUBLE_EQ(test.oldAB[name][j], found[j]) << name; }
+        
+        found = test.calcs[i]->getValues(AC);
+        ASSERT_EQ(test.oldAC[name].size(), found.size()) << name;
+        for (int j = 0; j < found.size(); j++) { EXPECT_DOUBLE_EQ(test.oldAC[name][j], found[j]) << name; }
+    }
+}
+/**************************************************************************************************/
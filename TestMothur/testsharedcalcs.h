@@ -0,0 +1,63 @@
+//
+//  testsharedcalcs.h
+//  Mothur
+//
+//
+
+#ifndef testsharedcalcs_h
+#define testsharedcalcs_h
+
+#include "gtest.h"
+#include "canberra.h"
+#include "hamming.h"
+#include "hellinger.h"
+#include "manhattan.h"
+#include "memchord.h"
+#include "memeuclidean.h"
+#include "odum.h"
+#include "sharedace.h"
+#include "sharedanderbergs.h"
+#include "sharedbraycurtis.h"
+#include "sharedchao1.h"
+#include "sharedjabund.h"
+#include "sharedjclass.h"
+#include "sharedjest.h"
+#include "sharedjsd.h"
+#include "sharedkulczynski.h"
+#include "sharedkulczynskicody.h"
+#include "sharedlennon.h"
+#include "sharedmorisitahorn.h"
+#include "sharednseqs.h"
+#include "sharedochiai.h"
+#include "sharedrjsd.h"
+#include "sharedsobscollectsummary.h"
+#include "sharedsorabund.h"
+#include "sharedsorclass.h"
+#include "sharedsorest.h"
+#include "sharedthetan.h"
+#include "sharedthetayc.h"
+#include "soergel.h"
+#include "speciesprofile.h"
+#include "structchord.h"
+#include "structeuclidean.h"
+#include "structkulczynski.h"
+#include "whittaker.h"
+
+
+class TestSharedCalcs {
+    
+public:
+    
+    TestSharedCalcs();
+    ~TestSharedCalcs();
+    
+    vector<SharedRAbundVector*> shared;     //A, B and C
+    vector<Calculator*> calcs;              //the calculators with a sparse version
+    map<string, EstOutput> oldAB, oldAC;    //calculator name -> what the dense calculators gave
+    
+private:
+    MothurOut* m;
+    
+};
+
+#endif /* testsharedcalcs_h */
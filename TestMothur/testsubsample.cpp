@@ -0,0 +1,44 @@
+//
+//  testsubsample.cpp
+//  Mothur
+//
+//
+
+#include "testsubsample.h"
+
+/**************************************************************************************************/
+//draws size reads without replacement, so nothing is drawn from a bin more times than it has reads
+TEST(TestSubSample, abundsSample) {
+    MothurOut::getInstance()->setRandomSeed(19760620);
+    SubSample sample;
+    
+    int values[] = { 10, 0, 1, 250, 3, 0, 40, 7 };
+    vector<int> abunds(values, values+8);
+    
+    int sizes[] = { 1, 50, 200, 300, 310 };
+    for (int i = 0; i < 5; i++) {
+        vector<int> drawn = sample.getSample(abunds, sizes[i]);
+        
+        ASSERT_EQ(abunds.size(), drawn.size());
+        int total = 0;
+        for (int j = 0; j < drawn.size(); j++) {
+            EXPECT_GE(drawn[j], 0); EXPECT_LE(drawn[j], abunds[j]);
+            total += drawn[j];
+        }
+        EXPECT_EQ(min(sizes[i], 311), total);
+    }
+}
+/**************************************************************************************************/
+//more reads than an int holds, the reads past INT_MAX can be drawn
+TEST(TestSubSample, abundsPastIntMax) {
+    MothurOut::getInstance()->setRandomSeed(19760620);
+    SubSample sample;
+    
+    vector<int> abunds(3, 1000000000);
+    vector<int> drawn = sample.getSample(abunds, 300);
+    
+    EXPECT_EQ(300, drawn[0] + drawn[1] + drawn[2]);
+    EXPECT_GT(drawn[2], 0); //every read of the last bin is past INT_MAX
+    for (int i = 0; i < 3; i++) { EXPECT_GT(drawn[i], 50); EXPECT_LT(drawn[i], 150); }
+}
+/**************************************************************************************************/
@@ -0,0 +1,13 @@
+//
+//  testsubsample.h
+//  Mothur
+//
+//
+
+#ifndef testsubsample_h
+#define testsubsample_h
+
+#include "gtest.h"
+#include "subsample.h"
+
+#endif /* testsubsample_h */
@@ -25,19 +25,47 @@ TestTrimOligos::~TestTrimOligos() {
     
 }
 /**************************************************************************************************/
-
-TEST_CASE("Testing TrimOligos Class") {
+//couldMatch must never skip an oligo countDiffs would find, so a read carrying the same IUPAC code as the oligo is not a difference
+TEST(TestTrimOligos, couldMatchIUPAC) {
     TestTrimOligos testTrim;
     
+    string oligo = "ACGRTACGAT";
+    testTrim.addOligoMasks(oligo);
     
-    //Create trimoligos classes with various constructors
-    
+    string read = "ACGRTACGATGG";
+    EXPECT_EQ(0, testTrim.countDiffs(oligo, read.substr(0, oligo.length())));
+    EXPECT_TRUE(testTrim.couldMatch(oligo, read, 0));
     
-    //run all public strip functions
+    //one substitution
+    read = "ACGRTACCATGG";
+    EXPECT_EQ(1, testTrim.countDiffs(oligo, read.substr(0, oligo.length())));
+    EXPECT_TRUE(testTrim.couldMatch(oligo, read, 1));
+    EXPECT_FALSE(testTrim.couldMatch(oligo, read, 0));
     
+    //a read code the oligo's base doesn't match is still a difference
+    oligo = "ACGATACGAT";
+    testTrim.addOligoMasks(oligo);
+    read = "ACGRTACGATGG";
+    EXPECT_EQ(1, testTrim.countDiffs(oligo, read.substr(0, oligo.length())));
+    EXPECT_TRUE(testTrim.couldMatch(oligo, read, 1));
+    EXPECT_FALSE(testTrim.couldMatch(oligo, read, 0));
+}
+/**************************************************************************************************/
+//the read is one difference from both primers, so it can't be assigned to either of them
+TEST(TestTrimOligos, stripForwardIUPACTie) {
+    map<string, int> primers; map<string, int> barcodes;
+    primers["ACGRTACGAT"] = 0;
+    primers["ACGATACCAT"] = 1;
+    vector<string> revPrimers, linker, spacer;
     
-    //run private functions
+    int pdiffs = 1;
+    TrimOligos trim(pdiffs, 0, 0, 0, primers, barcodes, revPrimers, linker, spacer);
     
+    Sequence seq("read1", "ACGRTACCATGGTTAACCGGTTAACC");
+    int group = -1;
+    vector<int> results = trim.stripForward(seq, group);
     
+    EXPECT_EQ(pdiffs + 10000, results[1]);
+    EXPECT_EQ(-1, group);
 }
 /**************************************************************************************************/
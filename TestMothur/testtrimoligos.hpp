@@ -9,6 +9,7 @@
 #ifndef testtrimoligos_hpp
 #define testtrimoligos_hpp
 
+#include "gtest.h"
 #include "trimoligos.h"
 
 
@@ -24,7 +25,13 @@ public:
     
     Sequence* fseq;
     //using TrimOligos::compareDNASeq(string, string);
-    //using TrimOligos::countDiffs(string, string);
+    
+protected:
+    using TrimOligos::countDiffs;
+    using TrimOligos::addOligoMasks;
+    using TrimOligos::couldMatch;
+    
+    FRIEND_TEST(TestTrimOligos, couldMatchIUPAC);
     
 };
 
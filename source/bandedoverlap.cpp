@@ -0,0 +1,300 @@
+/*
+ *  bandedoverlap.cpp
+ *  Mothur
+ *
+ *	This class is an Alignment child class that implements the Gotoh pairwise alignment algorithm over a diagonal band
+ *	of the dynamic programming matrix (see bandedoverlap.hpp).  The recursion, the tie breaking and the handling of the
+ *	end gaps are the same as in GotohOverlap, so when the band covers the whole matrix the alignments are the same.
+ *
+ *		Gotoh O. 1982.  An improved algorithm for matching biological sequences.  J. Mol. Biol.  162:705-8.
+ *		Farrar M. 2007.  Striped Smith-Waterman speeds database searches six times over other SIMD implementations.
+ *			Bioinformatics.  23:156-61.
+ *
+ */
+
+#include "alignment.hpp"
+#include "kmer.hpp"
+#include "bandedoverlap.hpp"
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+	#include <immintrin.h>
+#endif
+
+#define DIAGONAL	0
+#define UP			1
+#define LEFT		2
+
+static const int NEGATIVE_INFINITY = numeric_limits<int>::min() / 4;
+
+/**************************************************************************************************/
+
+BandedOverlap::BandedOverlap(float gO, float gE, float f, float mm, int r) : Alignment() {
+	try {
+		nRows = r;	nCols = r;			//	there is no matrix to allocate, but the drivers check nRows
+
+		//	use integer scores, keeping two decimal places if any of the parameters need them
+		scale = 1;
+		if ((gO != floor(gO)) || (gE != floor(gE)) || (f != floor(f)) || (mm != floor(mm))) { scale = 100; }
+
+		gapOpen = (int)round(gO * scale);
+		gapExtend = (int)round(gE * scale);
+		match = (int)round(f * scale);
+		mismatch = (int)round(mm * scale);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BandedOverlap", "BandedOverlap");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+void BandedOverlap::resize(int A) {	nRows = A;	nCols = A;	}
+
+/**************************************************************************************************/
+//	finds the range of diagonals (column - row) to fill.  The band is centered on the diagonal with the most shared
+//	8mers between the two sequences.
+void BandedOverlap::findBand(const string& A, const string& B, int& lowDiagonal, int& highDiagonal){
+	try {
+		int kmerSize = 8;
+		int nKmer = 65536;
+
+		lowDiagonal = -(lB-1);		//	the whole matrix
+		highDiagonal = lA-1;
+
+		if ((A.length() < kmerSize) || (B.length() < kmerSize)) { return; }
+
+		Kmer kmer(kmerSize);
+		kmer.getKmerNumbers(A, kmersA);
+		kmer.getKmerNumbers(B, kmersB);
+
+		if (lastKmerPos.size() != (nKmer+1)) { lastKmerPos.assign(nKmer+1, -1); }
+		for (int j = 0; j < kmersA.size(); j++) { lastKmerPos[kmersA[j]] = j; }
+
+		int offset = B.length();
+		diagonalVotes.assign(A.length() + B.length() + 1, 0);
+		for (int i = 0; i < kmersB.size(); i++) {
+			if (kmersB[i] == nKmer) { continue; }
+			int j = lastKmerPos[kmersB[i]];
+			if (j != -1) { diagonalVotes[j - i + offset]++; }
+		}
+		for (int j = 0; j < kmersA.size(); j++) { lastKmerPos[kmersA[j]] = -1; }
+
+		int best = 0;
+		for (int d = 1; d < diagonalVotes.size(); d++) { if (diagonalVotes[d] > diagonalVotes[best]) { best = d; } }
+		if (diagonalVotes[best] == 0) { return; }
+
+		int center = best - offset;
+		int halfWidth = max(64, max(lA, lB) / 10);
+
+		lowDiagonal = max(lowDiagonal, center - halfWidth);
+		highDiagonal = min(highDiagonal, center + halfWidth);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BandedOverlap", "findBand");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//	fills columns first to last of row i.  The diagonal and vertical moves only depend on the previous row, so they
+//	are done first for the whole row, then a second pass adds the horizontal moves and sets the traceback pointers.
+void BandedOverlap::fillRow(int i, int first, int last){
+	try {
+		int b = (unsigned char)seqB[i];
+		int j = first;
+
+#if defined(__AVX2__)
+		__m256i vB = _mm256_set1_epi32(b);
+		__m256i vMatch = _mm256_set1_epi32(match);
+		__m256i vMismatch = _mm256_set1_epi32(mismatch);
+		__m256i vGapOpen = _mm256_set1_epi32(gapOpen);
+		__m256i vGapExtend = _mm256_set1_epi32(gapExtend);
+
+		for (; j + 8 <= last + 1; j += 8) {
+			__m256i same = _mm256_cmpeq_epi32(_mm256_loadu_si256((__m256i*)&codesA[j]), vB);
+			__m256i diagonal = _mm256_add_epi32(_mm256_loadu_si256((__m256i*)&prevC[j-1]), _mm256_blendv_epi8(vMismatch, vMatch, same));
+			__m256i up = _mm256_max_epi32(_mm256_loadu_si256((__m256i*)&prevD[j]), _mm256_add_epi32(_mm256_loadu_si256((__m256i*)&prevC[j]), vGapOpen));
+			up = _mm256_add_epi32(up, vGapExtend);
+
+			_mm256_storeu_si256((__m256i*)&currD[j], up);
+			_mm256_storeu_si256((__m256i*)&diagOrUp[j], _mm256_max_epi32(diagonal, up));
+			_mm256_storeu_si256((__m256i*)&upWins[j], _mm256_cmpgt_epi32(up, diagonal));
+		}
+#elif defined(__SSE4_1__)
+		__m128i vB = _mm_set1_epi32(b);
+		__m128i vMatch = _mm_set1_epi32(match);
+		__m128i vMismatch = _mm_set1_epi32(mismatch);
+		__m128i vGapOpen = _mm_set1_epi32(gapOpen);
+		__m128i vGapExtend = _mm_set1_epi32(gapExtend);
+
+		for (; j + 4 <= last + 1; j += 4) {
+			__m128i same = _mm_cmpeq_epi32(_mm_loadu_si128((__m128i*)&codesA[j]), vB);
+			__m128i diagonal = _mm_add_epi32(_mm_loadu_si128((__m128i*)&prevC[j-1]), _mm_blendv_epi8(vMismatch, vMatch, same));
+			__m128i up = _mm_max_epi32(_mm_loadu_si128((__m128i*)&prevD[j]), _mm_add_epi32(_mm_loadu_si128((__m128i*)&prevC[j]), vGapOpen));
+			up = _mm_add_epi32(up, vGapExtend);
+
+			_mm_storeu_si128((__m128i*)&currD[j], up);
+			_mm_storeu_si128((__m128i*)&diagOrUp[j], _mm_max_epi32(diagonal, up));
+			_mm_storeu_si128((__m128i*)&upWins[j], _mm_cmpgt_epi32(up, diagonal));
+		}
+#endif
+		for (; j <= last; j++) {
+			int diagonal = prevC[j-1];
+			if (codesA[j] == b)	{	diagonal += match;		}
+			else				{	diagonal += mismatch;	}
+
+			int up = max(prevD[j], prevC[j] + gapOpen) + gapExtend;
+
+			currD[j] = up;
+			diagOrUp[j] = max(diagonal, up);
+			upWins[j] = (up > diagonal) ? -1 : 0;
+		}
+
+		//	the first column is free, anything else left of the band can't be used
+		int left = NEGATIVE_INFINITY;
+		int leftGap = NEGATIVE_INFINITY;
+		if (first == 1) { left = 0; leftGap = 0; }
+
+		long long cell = rowOffset[i];
+		for (j = first; j <= last; j++) {
+			leftGap = max(leftGap, left + gapOpen) + gapExtend;
+
+			if (leftGap > diagOrUp[j])	{	left = leftGap;		setDirection(cell, LEFT);	}
+			else if (upWins[j] != 0)	{	left = diagOrUp[j];	setDirection(cell, UP);		}
+			else						{	left = diagOrUp[j];	/* DIAGONAL is 0 */			}
+
+			currC[j] = left;
+			cell++;
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BandedOverlap", "fillRow");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+void BandedOverlap::align(string A, string B){
+	try {
+		seqA = ' ' + A;	lA = seqA.length();		//	the algorithm requires that the first character be a dummy value
+		seqB = ' ' + B;	lB = seqB.length();		//	the algorithm requires that the first character be a dummy value
+
+		int lowDiagonal, highDiagonal;
+		findBand(A, B, lowDiagonal, highDiagonal);
+
+		codesA.resize(lA);
+		for (int j = 0; j < lA; j++) { codesA[j] = (unsigned char)seqA[j]; }
+
+		//	the first row and column have scores of zero so the alignment can start anywhere
+		prevC.assign(lA+1, 0);	prevD.assign(lA+1, 0);
+		currC.assign(lA+1, 0);	currD.assign(lA+1, 0);
+		diagOrUp.resize(lA+1);	upWins.resize(lA+1);
+		lastColumn.assign(lB, NEGATIVE_INFINITY);
+		lastColumn[0] = 0;
+
+		rowStart.assign(lB, 1);
+		rowOffset.assign(lB+1, 0);
+		long long numCells = 0;
+		for (int i = 1; i < lB; i++) {
+			int first = max(1, i + lowDiagonal);
+			int last = min(lA-1, i + highDiagonal);
+			rowStart[i] = first;
+			rowOffset[i] = numCells;
+			if (last >= first) { numCells += (last - first + 1); }
+		}
+		rowOffset[lB] = numCells;
+		directions.assign((numCells + 3) / 4, 0);
+
+		for (int i = 1; i < lB; i++) {
+			if (m->getControl_pressed()) { break; }
+
+			int first = rowStart[i];
+			int last = min(lA-1, i + highDiagonal);
+
+			if (first <= last) { fillRow(i, first, last); }
+
+			//	the cell right of the band is read by the next row, so it can't be left over from an earlier row
+			if ((last + 1 >= 1) && (last + 1 <= lA-1)) { currC[last+1] = NEGATIVE_INFINITY; currD[last+1] = NEGATIVE_INFINITY; }
+			currC[0] = 0;
+
+			if (lA == 1)													{	lastColumn[i] = 0;				}
+			else if ((last == lA-1) && (first <= last))						{	lastColumn[i] = currC[lA-1];	}
+
+			prevC.swap(currC);
+			prevD.swap(currD);
+		}
+
+		//	prevC is now the last row, see Overlap::setOverlap for how the gaps at the 3' end are fixed
+		int row = lB-1;
+		int column = lA-1;
+		int lastRowFirst = rowStart[row];
+		int lastRowLast = min(lA-1, row + highDiagonal);
+
+		vector<int>& lastRow = prevC;
+		#define LASTROW(j) (((row == 0) || (j == 0)) ? 0 : (((j >= lastRowFirst) && (j <= lastRowLast)) ? lastRow[j] : NEGATIVE_INFINITY))
+
+		int best = -100 * scale;
+		int rowIndex = row;
+		for (int i = 0; i < lB; i++) {	if (lastColumn[i] >= best) { rowIndex = i; best = lastColumn[i]; }	}
+
+		best = -100 * scale;
+		int colIndex = column;
+		for (int j = 0; j < lA; j++) {	if (LASTROW(j) >= best) { colIndex = j; best = LASTROW(j); }	}
+
+		int upTo = row;
+		int leftTo = column;
+		if ((colIndex == column) && (rowIndex == row))		{}
+		else if (LASTROW(colIndex) < lastColumn[rowIndex])	{	upTo = rowIndex;	}
+		else												{	leftTo = colIndex;	}
+		#undef LASTROW
+
+		//	traceback, building the alignment backwards
+		BBaseMap.clear();
+		ABaseMap.clear();
+		seqAaln = "";
+		seqBaln = "";
+
+		if ((row == 0) && (column == 0)) {	seqAaln = seqBaln = "NOALIGNMENT";	}
+		else {
+			int count = 0;
+			while ((row != 0) || (column != 0)) {
+				int direction;
+				if ((column == lA-1) && (row > upTo))		{	direction = UP;		}
+				else if ((row == lB-1) && (column > leftTo))	{	direction = LEFT;	}
+				else if (row == 0)							{	direction = LEFT;	}
+				else if (column == 0)						{	direction = UP;		}
+				else										{	direction = getDirection(rowOffset[row] + column - rowStart[row]);	}
+
+				if (direction == UP) {
+					seqAaln += '-';
+					seqBaln += seqB[row];
+					BBaseMap[row] = count;
+					row--;
+				}
+				else if (direction == LEFT) {
+					seqBaln += '-';
+					seqAaln += seqA[column];
+					ABaseMap[column] = count;
+					column--;
+				}
+				else {
+					seqAaln += seqA[column];
+					seqBaln += seqB[row];
+					BBaseMap[row] = count;
+					ABaseMap[column] = count;
+					row--;
+					column--;
+				}
+				count++;
+			}
+			reverse(seqAaln.begin(), seqAaln.end());
+			reverse(seqBaln.begin(), seqBaln.end());
+		}
+
+		finishTraceBack();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BandedOverlap", "align");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
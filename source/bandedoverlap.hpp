@@ -0,0 +1,58 @@
+#ifndef BANDEDOVERLAP_H
+#define BANDEDOVERLAP_H
+
+/*
+ *  bandedoverlap.hpp
+ *  Mothur
+ *
+ *	This class is an Alignment child class that implements the same affine gap recursion and end gap handling as
+ *	GotohOverlap, but only fills a diagonal band of the dynamic programming matrix and never stores the matrix itself:
+ *
+ *	-	the center of the band is the diagonal shared by the most 8mers of the two sequences, and its half width is
+ *		the larger of 64 and a tenth of the longer sequence.  If the sequences share no 8mers the whole matrix is used.
+ *	-	scores are integers (multiplied by 100 if any of the scoring parameters have a fractional part) and only the
+ *		previous row is kept, so the memory used for scores is linear in the length of the candidate.
+ *	-	the traceback pointers are packed 2 bits per cell and only stored for cells inside the band.
+ *	-	the diagonal and vertical moves of a row don't depend on each other so they are computed with SSE4.1 or AVX2
+ *		when the compiler targets them, the horizontal moves are then resolved in a second scalar pass.
+ *
+ */
+
+#include "mothur.h"
+#include "alignment.hpp"
+
+/**************************************************************************************************/
+
+class BandedOverlap : public Alignment {
+
+public:
+	BandedOverlap(float, float, float, float, int);
+	~BandedOverlap() {}
+	void align(string, string);
+	void resize(int);
+
+private:
+	int gapOpen;
+	int gapExtend;
+	int match;
+	int mismatch;
+	int scale;
+
+	vector<int> codesA;						//	bases of seqA as ints, so they can be compared a vector at a time
+	vector<int> prevC, prevD, currC, currD;	//	scores for the previous and current row
+	vector<int> diagOrUp, upWins;			//	best of the diagonal and vertical moves for the current row
+	vector<int> lastColumn;					//	score of the last column in each row, used for the overlap
+	vector<int> rowStart;					//	first column of each row inside the band
+	vector<long long> rowOffset;			//	position of each row's first cell in directions
+	vector<unsigned char> directions;		//	2 bit traceback pointers
+	vector<int> kmersA, kmersB, lastKmerPos, diagonalVotes;
+
+	void findBand(const string&, const string&, int&, int&);
+	void fillRow(int, int, int);
+	inline void setDirection(long long cell, int dir) { directions[cell >> 2] |= (dir << ((cell & 3) << 1)); }
+	inline int getDirection(long long cell) { return (directions[cell >> 2] >> ((cell & 3) << 1)) & 3; }
+};
+
+/**************************************************************************************************/
+
+#endif
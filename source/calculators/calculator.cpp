@@ -0,0 +1,48 @@
+/*
+ *  calculator.cpp
+ *  Mothur
+ *
+ */
+
+#include "calculator.h"
+
+/***********************************************************************/
+//these are out of the header because sabundvector.hpp includes calculator.h before the vectors are defined
+SparseRAbund::SparseRAbund(SharedRAbundVector* shared) : numBins(shared->getNumBins()), numSeqs(shared->getNumSeqs()), maxRank(shared->getMaxRank()), label(shared->getLabel()) {
+	for (int i = 0; i < numBins; i++) {
+		int abund = shared->get(i);
+		if (abund != 0) { otus.push_back(i); abunds.push_back(abund); }
+	}
+}
+/***********************************************************************/
+
+SAbundVector SparseRAbund::getSAbundVector() {
+	SAbundVector sav(maxRank+1);
+	for (int i = 0; i < abunds.size(); i++) { sav.set(abunds[i], sav.get(abunds[i]) + 1); }
+	sav.setLabel(label);
+	return sav;
+}
+/***********************************************************************/
+
+SharedRAbundVector* SparseRAbund::getSharedRAbundVector() {
+	vector<int> data(numBins, 0);
+	for (int i = 0; i < otus.size(); i++) { data[otus[i]] = abunds[i]; }
+	SharedRAbundVector* shared = new SharedRAbundVector(data, maxRank, numBins, numSeqs);
+	shared->setLabel(label);
+	return shared;
+}
+/***********************************************************************/
+//the calculators without a sparse version are given the full vectors
+EstOutput Calculator::getValues(SparseRAbund* A, SparseRAbund* B) {
+	try {
+		vector<SharedRAbundVector*> shared; shared.push_back(A->getSharedRAbundVector()); shared.push_back(B->getSharedRAbundVector());
+		data = getValues(shared);
+		delete shared[0]; delete shared[1];
+		return data;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Calculator", "getValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
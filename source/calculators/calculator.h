@@ -7,6 +7,7 @@
 #include "sequence.hpp"
 #include "mothurout.h"
 #include "utils.hpp"
+#include "gapdistkernels.h"
 
 /* The calculator class is the parent class for all the different estimators implemented in mothur except the tree calculators.
 It has 2 pure functions EstOutput getValues(SAbundVector*), which works on a single group, and 
@@ -15,6 +16,50 @@ EstOutput getValues(SharedRAbundVector* shared1, SharedRAbundVector* shared2), w
 
 typedef vector<double> EstOutput;
 
+/***********************************************************************/
+//The OTUs a group was seen in, in OTU order, and their abundances. The calculators that compare 2 groups walk the
+//OTUs seen in either group instead of every OTU in the shared file, so a pair costs the size of the 2 groups.
+
+struct SparseRAbund {
+	vector<int> otus;
+	vector<int> abunds;
+	int numBins, numSeqs, maxRank;
+	string label;
+	
+	SparseRAbund() : numBins(0), numSeqs(0), maxRank(0), label("") {}
+	SparseRAbund(SharedRAbundVector*);
+	
+	SAbundVector getSAbundVector();
+	SharedRAbundVector* getSharedRAbundVector();	//dense copy, caller deletes
+};
+
+/***********************************************************************/
+//walks the OTUs seen in either of 2 groups in OTU order. an OTU missing from a group has abundance 0.
+
+class SparseRAbundPair {
+	
+public:
+	SparseRAbundPair(SparseRAbund* a, SparseRAbund* b) : A(a), B(b), indexA(0), indexB(0) {}
+	
+	bool next(int& abundA, int& abundB) {
+		bool moreA = (indexA < A->otus.size());
+		bool moreB = (indexB < B->otus.size());
+		
+		if (!moreA && !moreB) { return false; }
+		
+		if (!moreB || (moreA && (A->otus[indexA] < B->otus[indexB]))) { abundA = A->abunds[indexA]; abundB = 0; indexA++; }
+		else if (!moreA || (B->otus[indexB] < A->otus[indexA])) { abundA = 0; abundB = B->abunds[indexB]; indexB++; }
+		else { abundA = A->abunds[indexA]; abundB = B->abunds[indexB]; indexA++; indexB++; }
+		
+		return true;
+	}
+	
+private:
+	SparseRAbund* A;
+	SparseRAbund* B;
+	int indexA, indexB;
+};
+
 /***********************************************************************/
 
 class Calculator {
@@ -29,6 +74,10 @@ public:
 	virtual EstOutput getValues(vector<SharedRAbundVector*>) = 0;
     //optional calc that returns the otus labels of shared otus
     virtual EstOutput getValues(vector<SharedRAbundVector*> sv , vector<string>&) { data = getValues(sv); return data; }
+    //compares 2 groups. the calculators that only need the OTUs seen in one of the groups override this and hasSparse,
+    //the rest are given the full vectors.
+    virtual EstOutput getValues(SparseRAbund*, SparseRAbund*);
+    virtual bool hasSparse()        {   return false;       }
 	virtual void print(ostream& f)	{ f.setf(ios::fixed, ios::floatfield); f.setf(ios::showpoint);
 									  f << data[0]; for(int i=1;i<data.size();i++){	f << '\t' << data[i];	}}
     
@@ -79,14 +128,37 @@ protected:
 class DistCalc {
     
 public:
-    DistCalc(){ dist = 0; m = MothurOut::getInstance(); }
-    DistCalc(const DistCalc& d) : dist(d.dist) { m = MothurOut::getInstance(); }
+    DistCalc(){ dist = 0; cutoff = 1.0; m = MothurOut::getInstance(); }
+    DistCalc(const DistCalc& d) : dist(d.dist), cutoff(d.cutoff) { m = MothurOut::getInstance(); }
     virtual ~DistCalc() {}
-    virtual double calcDist(Sequence, Sequence) = 0;
     
+    //once a cutoff is set the calculators stop as soon as the distance can't be at or below it and return 1.0.
+    //only set it when the distances above the cutoff are thrown away.
+    void setCutoff(double c) { cutoff = c; }
+
+    //the calculators work on the aligned bases directly so callers that keep their alignments in one place (SequenceDB)
+    //don't have to copy them for each pair. the Sequence version is for everyone else.
+    //seqA, seqB, alignment length of seqA, then the first and one past the last column of seqA and seqB that aren't '.'
+    virtual double calcDist(const char*, const char*, int, int, int, int, int) = 0;
+    virtual double calcDist(const char* seqA, const char* seqB, int alignLength) {
+        return calcDist(seqA, seqB, alignLength, findFirstBase(seqA, alignLength), findLastBase(seqA, alignLength), findFirstBase(seqB, alignLength), findLastBase(seqB, alignLength));
+    }
+    virtual double calcDist(Sequence A, Sequence B) {
+        string seqA = A.getAligned(); string seqB = B.getAligned();
+        if (seqB.length() < seqA.length()) { seqB.resize(seqA.length(), '\0'); }
+        return calcDist(seqA.c_str(), seqB.c_str(), seqA.length());
+    }
+
 protected:
     double dist;
+    double cutoff;
     MothurOut* m;
+    
+    //true if the distance would be above the cutoff even if all the remaining columns were counted and the same
+    bool pastCutoff(int differences, int length, int remainingColumns) {
+        if ((cutoff >= 1.0) || (differences == 0)) { return false; }
+        return (((double)differences / (double)(length + remainingColumns)) > cutoff);
+    }
 };
 
 /**************************************************************************************************/
@@ -12,6 +12,17 @@
 /***********************************************************************/
 
 EstOutput Canberra::getValues(vector<SharedRAbundVector*> shared) {
+	try {
+		SparseRAbund A(shared[0]); SparseRAbund B(shared[1]);
+		return getValues(&A, &B);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Canberra", "getValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
+EstOutput Canberra::getValues(SparseRAbund* sharedA, SparseRAbund* sharedB) {
 	try {
 		data.resize(1,0);
 		
@@ -19,10 +30,12 @@ EstOutput Canberra::getValues(vector<SharedRAbundVector*> shared) {
 		
 		double sum = 0.0;
 		
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
+		int abundA, abundB;
+		SparseRAbundPair otus(sharedA, sharedB);
+		while (otus.next(abundA, abundB)) { 
 			
-			int Aij = shared[0]->get(i);
-			int Bij = shared[1]->get(i);
+			int Aij = abundA;
+			int Bij = abundB;
 			
 			//is this otu shared
 			if ((Aij != 0) && (Bij != 0)) { numSharedOTUS++; }
@@ -32,7 +45,7 @@ EstOutput Canberra::getValues(vector<SharedRAbundVector*> shared) {
 			}
 		}
 		
-		data[0] = (1 / (float) shared[0]->getNumBins()) * sum;
+		data[0] = (1 / (float) sharedA->numBins) * sum;
 		
 		if (isnan(data[0]) || isinf(data[0])) { data[0] = 0; }
 		
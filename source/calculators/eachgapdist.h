@@ -17,37 +17,34 @@
 class eachGapDist : public DistCalc {
 	
 public:
+	using DistCalc::calcDist;
 	
 	eachGapDist() {}
 	
-	double calcDist(Sequence A, Sequence B){
+	double calcDist(const char* seqA, const char* seqB, int alignLength, int startA, int endA, int startB, int endB){
 		int diff = 0;
 		int length = 0;
-		int start = 0;
 		
-		string seqA = A.getAligned();
-		string seqB = B.getAligned();
-
-		int alignLength = seqA.length();
-		
-		for(int i=0; i<alignLength; i++){
-			if(seqA[i] != '.' || seqB[i] != '.'){
-				start = i;
-				break;
-			}
-		}
-
-		for(int i=start;i<alignLength;i++){
-			if(seqA[i] == '.' && seqB[i] == '.'){
-				break;	
-			}
-			else if((seqA[i] == '-' && seqB[i] == '-') || (seqA[i] == '-' && seqB[i] == '.') || (seqA[i] == '.' && seqB[i] == '-')){;}
-			else{
-				if(seqA[i] != seqB[i]){
-					diff++;
-				}
-				length++;
-			}
+		//start at the first column where either sequence has a base
+		int start = min(startA, startB);
+		int end = max(endA, endB);
+
+		for(int i=start;i<end;i+=32){
+			int numColumns = min(32, end-i);
+			columnMasks columns; getColumnMasks(seqA+i, seqB+i, numColumns, columns);
+			unsigned int valid = columnsMask(numColumns);
+			
+			//stop at the first column where both are '.'
+			unsigned int stop = columns.dotA & columns.dotB & valid;
+			if (stop != 0) { valid &= columnsMask(firstColumn(stop)); }
+			
+			//columns where both sequences have a gap don't count
+			unsigned int counted = valid & ~((columns.dotA | columns.dashA) & (columns.dotB | columns.dashB));
+			diff += countColumns(counted & ~columns.same);
+			length += countColumns(counted);
+			
+			if (stop != 0) { break; }
+			if (pastCutoff(diff, length, end-i-numColumns)) { dist = 1.0000; return dist; }
 		}
 		
 		if(length == 0)	{	dist = 1.0000;								}
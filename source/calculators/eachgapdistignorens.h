@@ -18,34 +18,29 @@
 class eachGapDistIgnoreNs : public DistCalc {
 	
 public:
-	double calcDist(Sequence A, Sequence B){
+	using DistCalc::calcDist;
+	double calcDist(const char* seqA, const char* seqB, int alignLength, int startA, int endA, int startB, int endB){
 		int diff = 0;
 		int length = 0;
-		int start = 0;
 		
-		string seqA = A.getAligned();
-		string seqB = B.getAligned();
+		int start = min(startA, startB);
+		int end = max(endA, endB);
 		
-		int alignLength = seqA.length();
-		
-		for(int i=0; i<alignLength; i++){
-			if(seqA[i] != '.' || seqB[i] != '.'){
-				start = i;
-				break;
-			}
-		}
-		
-		for(int i=start;i<alignLength;i++){
-			if(seqA[i] == '.' && seqB[i] == '.'){
-				break;	
-			}
-			else if((seqA[i] == '-' && seqB[i] == '-') || (seqA[i] == '-' && seqB[i] == '.') || (seqA[i] == '.' && seqB[i] == '-') || seqA[i] == 'N' || seqB[i] == 'N'){;}
-			else{
-				if(seqA[i] != seqB[i]){
-					diff++;
-				}
-				length++;
-			}
+		for(int i=start;i<end;i+=32){
+			int numColumns = min(32, end-i);
+			columnMasks columns; getColumnMasks(seqA+i, seqB+i, numColumns, columns);
+			unsigned int valid = columnsMask(numColumns);
+			
+			unsigned int stop = columns.dotA & columns.dotB & valid;
+			if (stop != 0) { valid &= columnsMask(firstColumn(stop)); }
+			
+			//same as eachGapDist, but columns with an N in either sequence don't count either
+			unsigned int counted = valid & ~((columns.dotA | columns.dashA) & (columns.dotB | columns.dashB)) & ~(columns.nA | columns.nB);
+			diff += countColumns(counted & ~columns.same);
+			length += countColumns(counted);
+			
+			if (stop != 0) { break; }
+			if (pastCutoff(diff, length, end-i-numColumns)) { dist = 1.0000; return dist; }
 		}
 		
 		if(length == 0)	{	dist = 1.0000;								}
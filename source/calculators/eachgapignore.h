@@ -17,51 +17,34 @@
 class eachGapIgnoreTermGapDist : public DistCalc {
 	
 public:
+	using DistCalc::calcDist;
 	eachGapIgnoreTermGapDist() {}
 	eachGapIgnoreTermGapDist(const eachGapIgnoreTermGapDist& ddb) {}
 	
-	double calcDist(Sequence A, Sequence B){
+	double calcDist(const char* seqA, const char* seqB, int alignLength, int startA, int endA, int startB, int endB){
 		int diff = 0;
 		int length = 0;
 		int start = 0;
 		int end = 0;
-		bool overlap = false;
 		
-		string seqA = A.getAligned();
-		string seqB = B.getAligned();
-		int alignLength = seqA.length();
+		if (!findOverlap(seqA, seqB, max(startA, startB), min(endA, endB), start, end)) { dist = 1.0000; return dist; }
 		
-		for(int i=0;i<alignLength;i++){
-			if(seqA[i] != '.' && seqB[i] != '.' && seqA[i] != '-' && seqB[i] != '-' ){
-				start = i;
-//				cout << "start: " << start << endl;
-				overlap = true;
-				break;
-			}
+		for(int i=start;i<=end;i+=32){
+			int numColumns = min(32, end-i+1);
+			columnMasks columns; getColumnMasks(seqA+i, seqB+i, numColumns, columns);
+			unsigned int valid = columnsMask(numColumns);
+			
+			//stop at the first '.' in either sequence
+			unsigned int stop = (columns.dotA | columns.dotB) & valid;
+			if (stop != 0) { valid &= columnsMask(firstColumn(stop)); }
+			
+			unsigned int counted = valid & ~(columns.dashA & columns.dashB);
+			diff += countColumns(counted & ~columns.same);
+			length += countColumns(counted);
+			
+			if (stop != 0) { break; }
+			if (pastCutoff(diff, length, end-i-numColumns+1)) { dist = 1.0000; return dist; }
 		}
-		for(int i=alignLength-1;i>=0;i--){
-			if(seqA[i] != '.' && seqB[i] != '.' && seqA[i] != '-' && seqB[i] != '-' ){
-				end = i;
-//				cout << "end: " << end << endl;
-				overlap = true;
-				break;
-			}
-		}
-		
-		for(int i=start;i<=end;i++){
-			if(seqA[i] == '.' || seqB[i] == '.'){
-				break;	
-			}
-			else if(seqA[i] != '-' || seqB[i] != '-'){
-				if(seqA[i] != seqB[i]){
-					diff++;
-				}
-				length++;
-			}
-		}
-		
-		//non-overlapping sequences
-		if (!overlap) { length = 0; }
 		
 		if(length == 0)	{	dist = 1.0000;								}
 		else			{	dist = ((double)diff  / (double)length);	}
@@ -0,0 +1,130 @@
+/*
+ *  gapdistkernels.cpp
+ *  Mothur
+ *
+ */
+
+#include "gapdistkernels.h"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+	#include <immintrin.h>
+#endif
+
+/**************************************************************************************************/
+
+void getColumnMasks(const char* seqA, const char* seqB, int numColumns, columnMasks& masks) {
+
+#if defined(__AVX2__)
+	if (numColumns == 32) {
+		__m256i a = _mm256_loadu_si256((const __m256i*)seqA);
+		__m256i b = _mm256_loadu_si256((const __m256i*)seqB);
+		__m256i dot = _mm256_set1_epi8('.');
+		__m256i dash = _mm256_set1_epi8('-');
+		__m256i n = _mm256_set1_epi8('N');
+
+		masks.dotA = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, dot));
+		masks.dotB = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(b, dot));
+		masks.dashA = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, dash));
+		masks.dashB = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(b, dash));
+		masks.nA = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, n));
+		masks.nB = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(b, n));
+		masks.same = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b));
+		return;
+	}
+#elif defined(__SSE2__)
+	if (numColumns == 32) {
+		__m128i dot = _mm_set1_epi8('.');
+		__m128i dash = _mm_set1_epi8('-');
+		__m128i n = _mm_set1_epi8('N');
+		unsigned int half[2][7];
+
+		for (int h = 0; h < 2; h++) {
+			__m128i a = _mm_loadu_si128((const __m128i*)(seqA + 16*h));
+			__m128i b = _mm_loadu_si128((const __m128i*)(seqB + 16*h));
+
+			half[h][0] = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(a, dot));
+			half[h][1] = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(b, dot));
+			half[h][2] = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(a, dash));
+			half[h][3] = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(b, dash));
+			half[h][4] = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(a, n));
+			half[h][5] = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(b, n));
+			half[h][6] = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(a, b));
+		}
+
+		masks.dotA = half[0][0] | (half[1][0] << 16);
+		masks.dotB = half[0][1] | (half[1][1] << 16);
+		masks.dashA = half[0][2] | (half[1][2] << 16);
+		masks.dashB = half[0][3] | (half[1][3] << 16);
+		masks.nA = half[0][4] | (half[1][4] << 16);
+		masks.nB = half[0][5] | (half[1][5] << 16);
+		masks.same = half[0][6] | (half[1][6] << 16);
+		return;
+	}
+#endif
+
+	//	partial blocks are done one column at a time so we never read past the end of the alignments
+	masks.dotA = 0; masks.dotB = 0; masks.dashA = 0; masks.dashB = 0; masks.nA = 0; masks.nB = 0; masks.same = 0;
+	for (int i = 0; i < numColumns; i++) {
+		unsigned int bit = 1u << i;
+		char a = seqA[i]; char b = seqB[i];
+
+		if (a == '.')	{ masks.dotA |= bit;	}
+		if (b == '.')	{ masks.dotB |= bit;	}
+		if (a == '-')	{ masks.dashA |= bit;	}
+		if (b == '-')	{ masks.dashB |= bit;	}
+		if (a == 'N')	{ masks.nA |= bit;		}
+		if (b == 'N')	{ masks.nB |= bit;		}
+		if (a == b)		{ masks.same |= bit;	}
+	}
+}
+/**************************************************************************************************/
+//	a column opens a gap if it is in gap and the last column before it that is not in skip isn't.  The block is moved
+//	up one bit so bit 0 can hold the run left open by the last block, then every run of skip columns sitting on top of
+//	a gap column is filled in by adding the bit under the run, which carries through it.
+int countGapOpens(unsigned int gap, unsigned int skip, int numColumns, int& open) {
+
+	unsigned long long inGap = ((unsigned long long)gap << 1) | (unsigned long long)open;
+	unsigned long long skipped = (unsigned long long)skip << 1;
+
+	unsigned long long seeds = (inGap << 1) & skipped;
+	unsigned long long filled = inGap | (skipped & ~(skipped + seeds));
+	unsigned long long opens = inGap & ~(filled << 1) & ~1ULL;
+
+	open = (int)((filled >> numColumns) & 1);
+
+	return __builtin_popcountll(opens);
+}
+/**************************************************************************************************/
+
+bool findOverlap(const char* seqA, const char* seqB, int start, int end, int& first, int& last) {
+	first = -1;
+	for (int i = start; i < end; i += 32) {
+		int numColumns = min(32, end - i);
+		columnMasks columns; getColumnMasks(seqA + i, seqB + i, numColumns, columns);
+		unsigned int bases = columnsMask(numColumns) & ~(columns.dotA | columns.dotB | columns.dashA | columns.dashB);
+		if (bases != 0) { first = i + firstColumn(bases); break; }
+	}
+	if (first == -1) { return false; }
+
+	//	there is at least one, so searching back from the end stops by first
+	for (int i = end; i > first; i -= 32) {
+		int blockStart = max(first, i - 32);
+		columnMasks columns; getColumnMasks(seqA + blockStart, seqB + blockStart, i - blockStart, columns);
+		unsigned int bases = columnsMask(i - blockStart) & ~(columns.dotA | columns.dotB | columns.dashA | columns.dashB);
+		if (bases != 0) { last = blockStart + lastColumn(bases); break; }
+	}
+	return true;
+}
+/**************************************************************************************************/
+
+int findFirstBase(const char* seq, int length) {
+	for (int i = 0; i < length; i++) { if (seq[i] != '.') { return i; } }
+	return length;
+}
+/**************************************************************************************************/
+
+int findLastBase(const char* seq, int length) {
+	for (int i = length - 1; i >= 0; i--) { if (seq[i] != '.') { return i + 1; } }
+	return 0;
+}
+/**************************************************************************************************/
@@ -0,0 +1,48 @@
+#ifndef GAPDISTKERNELS_H
+#define GAPDISTKERNELS_H
+
+/*
+ *  gapdistkernels.h
+ *  Mothur
+ *
+ *	Helpers shared by the sequence distance calculators.  Instead of branching on every column, the calculators ask
+ *	for the state of 32 columns at a time as bitmasks (bit i is column i) and do the counting with bit operations.
+ *	The masks are built with AVX2 or SSE2 compares when the compiler targets them and one column at a time otherwise.
+ *
+ */
+
+#include "mothurout.h"
+
+/**************************************************************************************************/
+
+struct columnMasks {
+	unsigned int dotA, dotB;		//	'.'
+	unsigned int dashA, dashB;		//	'-'
+	unsigned int nA, nB;			//	'N'
+	unsigned int same;				//	seqA[i] == seqB[i]
+};
+
+/**************************************************************************************************/
+
+//	fills the masks for the first numColumns (at most 32) columns of seqA and seqB. bits above numColumns are 0.
+void getColumnMasks(const char* seqA, const char* seqB, int numColumns, columnMasks& masks);
+
+//	number of columns of a gap run that start in this block. gap and skip are the masks of the columns that are part
+//	of the run and the columns that don't break it, open is 1 if the run was open at the end of the last block and is
+//	updated for the next one.
+int countGapOpens(unsigned int gap, unsigned int skip, int numColumns, int& open);
+
+//	finds the first and last columns in [start, end) where neither sequence has a '.' or '-', false if there are none
+bool findOverlap(const char* seqA, const char* seqB, int start, int end, int& first, int& last);
+
+int findFirstBase(const char* seq, int length);		//	first column that is not '.', length if there are none
+int findLastBase(const char* seq, int length);		//	one past the last column that is not '.', 0 if there are none
+
+inline unsigned int columnsMask(int numColumns)			{ return (numColumns >= 32) ? 0xFFFFFFFFu : ((1u << numColumns) - 1); }
+inline int countColumns(unsigned int mask)				{ return __builtin_popcount(mask);	}
+inline int firstColumn(unsigned int mask)				{ return __builtin_ctz(mask);		}	//	mask must not be 0
+inline int lastColumn(unsigned int mask)				{ return 31 - __builtin_clz(mask);	}	//	mask must not be 0
+
+/**************************************************************************************************/
+
+#endif
@@ -11,6 +11,17 @@
 
 /***********************************************************************/
 EstOutput Hamming::getValues(vector<SharedRAbundVector*> shared) {
+	try {
+		SparseRAbund A(shared[0]); SparseRAbund B(shared[1]);
+		return getValues(&A, &B);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Hamming", "getValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
+EstOutput Hamming::getValues(SparseRAbund* sharedA, SparseRAbund* sharedB) {
 	try {
 		data.resize(1,0);
 		
@@ -19,9 +30,11 @@ EstOutput Hamming::getValues(vector<SharedRAbundVector*> shared) {
 		int numShared = 0;
 		
 		//calc the 2 denominators
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
-			int A = shared[0]->get(i);
-			int B = shared[1]->get(i);
+		int abundA, abundB;
+		SparseRAbundPair otus(sharedA, sharedB);
+		while (otus.next(abundA, abundB)) { 
+			int A = abundA;
+			int B = abundB;
 			
 			if (A != 0) { numA++; }
 			if (B != 0) { numB++; }
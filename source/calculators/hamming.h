@@ -22,6 +22,8 @@ public:
 	Hamming() :  Calculator("hamming", 1, false) {};
 	EstOutput getValues(SAbundVector*) {return data;};
 	EstOutput getValues(vector<SharedRAbundVector*>);
+	EstOutput getValues(SparseRAbund*, SparseRAbund*);
+	bool hasSparse() { return true; }
 	string getCitation() { return "http://www.mothur.org/wiki/Hamming"; }
 private:
 	
@@ -11,6 +11,17 @@
 
 /***********************************************************************/
 EstOutput Hellinger::getValues(vector<SharedRAbundVector*> shared) {
+	try {
+		SparseRAbund A(shared[0]); SparseRAbund B(shared[1]);
+		return getValues(&A, &B);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Hellinger", "getValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
+EstOutput Hellinger::getValues(SparseRAbund* sharedA, SparseRAbund* sharedB) {
 	try {
 		data.resize(1,0);
 		
@@ -18,18 +29,21 @@ EstOutput Hellinger::getValues(vector<SharedRAbundVector*> shared) {
 		double sumB = 0.0;
 		
 		//calc the 2 denominators
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
-			sumA += shared[0]->get(i);
-			sumB += shared[1]->get(i);
+		int abundA, abundB;
+		SparseRAbundPair totals(sharedA, sharedB);
+		while (totals.next(abundA, abundB)) { 
+			sumA += abundA;
+			sumB += abundB;
 		}
 		
 		
 		//calc sum
 		double sum = 0.0;
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
+		SparseRAbundPair otus(sharedA, sharedB);
+		while (otus.next(abundA, abundB)) { 
 			
-			int Aij = shared[0]->get(i);
-			int Bij = shared[1]->get(i);
+			int Aij = abundA;
+			int Bij = abundB;
 			
 			double term1 = sqrt((Aij / sumA));
 			double term2 = sqrt((Bij / sumB));
@@ -19,41 +19,44 @@
 class ignoreGaps : public DistCalc {
 	
 public:
+	using DistCalc::calcDist;
 	
 	ignoreGaps() {}
 	
-	double calcDist(Sequence A, Sequence B){
+	double calcDist(const char* seqA, const char* seqB, int alignLength, int startA, int endA, int startB, int endB){
 		int diff = 0;
 		int length = 0;
-		int start = 0;
 		bool overlap = false;
 		
-		string seqA = A.getAligned();
-		string seqB = B.getAligned();
-		int alignLength = seqA.length();
+		//both sequences need bases, so only the columns where they overlap can count
+		int start = max(startA, startB);
+		int end = min(endA, endB);
 		
-		for(int i=0;i<alignLength;i++){
-			if(seqA[i] != '.' && seqB[i] != '.'){
-				start = i;
+		for(int i=start;i<end;i+=32){
+			int numColumns = min(32, end-i);
+			columnMasks columns; getColumnMasks(seqA+i, seqB+i, numColumns, columns);
+			unsigned int valid = columnsMask(numColumns);
+			unsigned int dots = columns.dotA | columns.dotB;
+			
+			//skip to the first column without a '.'
+			if (!overlap) {
+				unsigned int bases = valid & ~dots;
+				if (bases == 0) { continue; }
 				overlap = true;
-				break;
+				valid &= ~columnsMask(firstColumn(bases));
 			}
+			
+			//stop at the next '.'
+			unsigned int stop = dots & valid;
+			if (stop != 0) { valid &= columnsMask(firstColumn(stop)); }
+			
+			unsigned int counted = valid & ~(columns.dashA | columns.dashB);
+			diff += countColumns(counted & ~columns.same);
+			length += countColumns(counted);
+			
+			if (stop != 0) { break; }
+			if (pastCutoff(diff, length, end-i-numColumns)) { dist = 1.0000; return dist; }
 		}
-		
-		for(int i=start; i<alignLength; i++){
-			if(seqA[i] == '.' || seqB[i] == '.'){
-				break;
-			}
-			else if((seqA[i] != '-' && seqB[i] != '-')){
-				if(seqA[i] != seqB[i]){
-					diff++;
-				}
-				length++;
-			}
-		}
-		
-		//non-overlapping sequences
-		if (!overlap) { length = 0; }
 
 		if(length == 0)		{	dist = 1.0000;								}
 		else				{	dist = ((double)diff  / (double)length);	}
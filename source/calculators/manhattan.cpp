@@ -11,15 +11,28 @@
 
 /***********************************************************************/
 EstOutput Manhattan::getValues(vector<SharedRAbundVector*> shared) {
+	try {
+		SparseRAbund A(shared[0]); SparseRAbund B(shared[1]);
+		return getValues(&A, &B);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Manhattan", "getValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
+EstOutput Manhattan::getValues(SparseRAbund* sharedA, SparseRAbund* sharedB) {
 	try {
 		data.resize(1,0);
 		
 		double sum = 0.0;
 		
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
+		int abundA, abundB;
+		SparseRAbundPair otus(sharedA, sharedB);
+		while (otus.next(abundA, abundB)) { 
 			
-			int Aij = shared[0]->get(i);
-			int Bij = shared[1]->get(i);
+			int Aij = abundA;
+			int Bij = abundB;
 			
 			sum += abs((Aij - Bij));
 		}
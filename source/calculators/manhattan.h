@@ -21,6 +21,8 @@ public:
 	Manhattan() :  Calculator("manhattan", 1, false) {};
 	EstOutput getValues(SAbundVector*) {return data;};
 	EstOutput getValues(vector<SharedRAbundVector*>);
+	EstOutput getValues(SparseRAbund*, SparseRAbund*);
+	bool hasSparse() { return true; }
 	string getCitation() { return "http://www.mothur.org/wiki/Manhattan"; }
 private:
 	
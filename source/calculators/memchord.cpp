@@ -11,6 +11,17 @@
 
 /***********************************************************************/
 EstOutput MemChord::getValues(vector<SharedRAbundVector*> shared) {
+	try {
+		SparseRAbund A(shared[0]); SparseRAbund B(shared[1]);
+		return getValues(&A, &B);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "MemChord", "getValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
+EstOutput MemChord::getValues(SparseRAbund* sharedA, SparseRAbund* sharedB) {
 	try {
 		data.resize(1,0);
 		
@@ -18,18 +29,21 @@ EstOutput MemChord::getValues(vector<SharedRAbundVector*> shared) {
 		double nonZeroB = 0;
 		
 		//for each otu
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
-			if (shared[0]->get(i) != 0) { nonZeroA++; }
-			if (shared[1]->get(i) != 0) { nonZeroB++; }
+		int abundA, abundB;
+		SparseRAbundPair totals(sharedA, sharedB);
+		while (totals.next(abundA, abundB)) {
+			if (abundA != 0) { nonZeroA++; }
+			if (abundB != 0) { nonZeroB++; }
 		}
 		
 		nonZeroA = sqrt(nonZeroA);
 		nonZeroB = sqrt(nonZeroB);
 		
 		double sum = 0.0;
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
-			int A = shared[0]->get(i);
-			int B = shared[1]->get(i);
+		SparseRAbundPair otus(sharedA, sharedB);
+		while (otus.next(abundA, abundB)) {
+			int A = abundA;
+			int B = abundB;
 			
 			if (A > 0) { A = 1; }
 			if (B > 0) { B = 1; }
@@ -11,13 +11,26 @@
 
 /***********************************************************************/
 EstOutput MemEuclidean::getValues(vector<SharedRAbundVector*> shared) {
+	try {
+		SparseRAbund A(shared[0]); SparseRAbund B(shared[1]);
+		return getValues(&A, &B);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "MemEuclidean", "getValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
+EstOutput MemEuclidean::getValues(SparseRAbund* sharedA, SparseRAbund* sharedB) {
 	try {
 		data.resize(1,0);
 		
 		double sum = 0.0;
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
-			int A = shared[0]->get(i);
-			int B = shared[1]->get(i);
+		int abundA, abundB;
+		SparseRAbundPair otus(sharedA, sharedB);
+		while (otus.next(abundA, abundB)) {
+			int A = abundA;
+			int B = abundB;
 			
 			if (A > 0) { A = 1; }
 			if (B > 0) { B = 1; }
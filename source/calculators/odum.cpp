@@ -12,16 +12,29 @@
 /***********************************************************************/
 
 EstOutput Odum::getValues(vector<SharedRAbundVector*> shared) {
+	try {
+		SparseRAbund A(shared[0]); SparseRAbund B(shared[1]);
+		return getValues(&A, &B);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Odum", "getValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
+EstOutput Odum::getValues(SparseRAbund* sharedA, SparseRAbund* sharedB) {
 	try {
 		data.resize(1,0);
 		
 		double sumNum = 0.0;
 		double sumDenom = 0.0;
 		
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
+		int abundA, abundB;
+		SparseRAbundPair otus(sharedA, sharedB);
+		while (otus.next(abundA, abundB)) { 
 			
-			int Aij = shared[0]->get(i);
-			int Bij = shared[1]->get(i);
+			int Aij = abundA;
+			int Bij = abundB;
 			
 			sumNum += abs(Aij - Bij);
 			sumDenom += (Aij + Bij);
@@ -17,62 +17,42 @@
 class oneGapDist : public DistCalc {
 	
 public:
+	using DistCalc::calcDist;
 	
 	oneGapDist() {}
 	
-	double calcDist(Sequence A, Sequence B){
+	double calcDist(const char* seqA, const char* seqB, int alignLength, int startA, int endA, int startB, int endB){
 		
 		int difference = 0;
 		int minLength = 0;
 		int openGapA = 0;
 		int openGapB = 0;
-		int start = 0;
 		
-		string seqA = A.getAligned();
-		string seqB = B.getAligned();
-		int alignLength = seqA.length();
+		int start = min(startA, startB);
+		int end = max(endA, endB);
 		
-		for(int i=0;i<alignLength;i++){
-			if((seqA[i] != '.' || seqB[i] != '.')){
-				start = i;
-				break;
-			}
-		}
-
-		for(int i=start;i<alignLength;i++){
-			if((seqA[i] == '-' && seqB[i] == '-') || (seqA[i] == '.' && seqB[i] == '-') || (seqA[i] == '-' && seqB[i] == '.')){	;	}
-			else if(seqA[i] == '.' && seqB[i] == '.'){
-				break;
-			}
-			else if(seqB[i] != '-' && (seqA[i] == '-' || seqA[i] == '.')){
-				if(openGapA == 0){
-					difference++;
-					minLength++;
-					openGapA = 1;
-					openGapB = 0;
-				}
-			}
-			else if(seqA[i] != '-' && (seqB[i] == '-' || seqB[i] == '.')){
-				if(openGapB == 0){
-					difference++;
-					minLength++;
-					openGapA = 0;
-					openGapB = 1;
-				}
-			}
-			else if(seqA[i] != '-' && seqB[i] != '-'){
-				if(seqA[i] != seqB[i]){
-					difference++;
-					minLength++;
-					openGapA = 0;
-					openGapB = 0;
-				}
-				else{
-					minLength++;
-					openGapA = 0;
-					openGapB = 0;
-				}
-			}
+		for(int i=start;i<end;i+=32){
+			int numColumns = min(32, end-i);
+			columnMasks columns; getColumnMasks(seqA+i, seqB+i, numColumns, columns);
+			unsigned int valid = columnsMask(numColumns);
+			
+			//stop at the first column where both are '.'
+			unsigned int stop = columns.dotA & columns.dotB & valid;
+			if (stop != 0) { valid &= columnsMask(firstColumn(stop)); }
+			
+			unsigned int gapA = (columns.dotA | columns.dashA) & valid;
+			unsigned int gapB = (columns.dotB | columns.dashB) & valid;
+			unsigned int bothGaps = gapA & gapB;
+			unsigned int bothBases = valid & ~(gapA | gapB);
+			
+			//a run of gaps in one sequence counts as one difference, columns where both have a gap don't end the run
+			int gapOpens = countGapOpens(gapA & ~gapB, bothGaps, numColumns, openGapA) + countGapOpens(gapB & ~gapA, bothGaps, numColumns, openGapB);
+			
+			difference += gapOpens + countColumns(bothBases & ~columns.same);
+			minLength += gapOpens + countColumns(bothBases);
+			
+			if (stop != 0) { break; }
+			if (pastCutoff(difference, minLength, end-i-numColumns)) { dist = 1.0000; return dist; }
 		}
 	
 		if(minLength == 0)	{	dist = 1.0000;							}
@@ -17,10 +17,11 @@
 class oneGapIgnoreTermGapDist : public DistCalc {
 	
 public:
+	using DistCalc::calcDist;
 	
 	oneGapIgnoreTermGapDist() {}
 	
-	double calcDist(Sequence A, Sequence B){
+	double calcDist(const char* seqA, const char* seqB, int alignLength, int startA, int endA, int startB, int endB){
 		
 		int difference = 0;
 		int openGapA = 0;
@@ -28,61 +29,28 @@ public:
 		int minLength = 0;
 		int start = 0;
 		int end = 0;
-		bool overlap = false;
 		
-		string seqA = A.getAligned();
-		string seqB = B.getAligned();
-		int alignLength = seqA.length();
-
 		// this assumes that sequences start and end with '.'s instead of'-'s.
-		for(int i=0;i<alignLength;i++){
-			if(seqA[i] != '.' && seqB[i] != '.' && seqA[i] != '-' && seqB[i] != '-' ){
-				start = i;
-//				cout << "start: " << start << endl;
-				overlap = true;
-				break;
-			}
-		}
-		for(int i=alignLength-1;i>=0;i--){
-			if(seqA[i] != '.' && seqB[i] != '.' && seqA[i] != '-' && seqB[i] != '-' ){
-				end = i;
-//				cout << "end: " << end << endl;
-				overlap = true;
-				break;
-			}
-		}
+		if (!findOverlap(seqA, seqB, max(startA, startB), min(endA, endB), start, end)) { dist = 1.0000; return dist; }
 		
-		for(int i=start;i<=end;i++){
-			if(seqA[i] == '-' && seqB[i] == '-'){	;	}
-			else if(seqB[i] != '-' && seqA[i] == '-'){
-				if(openGapA == 0){
-					difference++;
-					minLength++;
-					openGapA = 1;
-					openGapB = 0;
-				}
-			}
-			else if(seqA[i] != '-' && seqB[i] == '-'){
-				if(openGapB == 0){
-					difference++;
-					minLength++;
-					openGapA = 0;
-					openGapB = 1;
-				}
-			}
-			else if(seqA[i] != '-' && seqB[i] != '-'){
-				if(seqA[i] != seqB[i]){
-					difference++;
-				}
-				minLength++;
-				openGapA = 0;
-				openGapB = 0;
-			}
+		for(int i=start;i<=end;i+=32){
+			int numColumns = min(32, end-i+1);
+			columnMasks columns; getColumnMasks(seqA+i, seqB+i, numColumns, columns);
+			unsigned int valid = columnsMask(numColumns);
+			
+			unsigned int dashA = columns.dashA & valid;
+			unsigned int dashB = columns.dashB & valid;
+			unsigned int bothDashes = dashA & dashB;
+			unsigned int noDashes = valid & ~(dashA | dashB);
+			
+			int gapOpens = countGapOpens(dashA & ~dashB, bothDashes, numColumns, openGapA) + countGapOpens(dashB & ~dashA, bothDashes, numColumns, openGapB);
+			
+			difference += gapOpens + countColumns(noDashes & ~columns.same);
+			minLength += gapOpens + countColumns(noDashes);
+			
+			if (pastCutoff(difference, minLength, end-i-numColumns+1)) { dist = 1.0000; return dist; }
 		}
 		
-		//non-overlapping sequences
-		if (!overlap) { minLength = 0; }
-		
 		if(minLength == 0)	{	dist = 1.0000;							}
 		else				{	dist = (double)difference / minLength;	}
         
@@ -13,10 +13,21 @@
 /***********************************************************************/
 
 EstOutput SharedAce::getValues(vector<SharedRAbundVector*> shared) {
+	try {
+		SparseRAbund A(shared[0]); SparseRAbund B(shared[1]);
+		return getValues(&A, &B);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SharedAce", "getValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
+EstOutput SharedAce::getValues(SparseRAbund* sharedA, SparseRAbund* sharedB) {
 	try {
 		data.resize(1,0);
 		string label;
-		label = shared[0]->getLabel();
+		label = sharedA->label;
 
 		double fARare, fBRare, S12Rare, S12Abund, S12, f11, tempA, tempB, t10, t01, t11, t21, t12, t22, C12Numerator;
 		fARare = 0; fBRare = 0; S12Rare = 0; S12Abund = 0; S12 = 0; f11 = 0; t10 = 0; t01 = 0; t11= 0; t21= 0; t12= 0; t22= 0; C12Numerator = 0;
@@ -32,10 +43,12 @@ EstOutput SharedAce::getValues(vector<SharedRAbundVector*> shared) {
 		S12 = number of shared OTUs in A and B
 		This estimator was changed to reflect Caldwell's changes, eliminating the nrare / nrare - 1 */
 
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
+		int abundA, abundB;
+		SparseRAbundPair otus(sharedA, sharedB);
+		while (otus.next(abundA, abundB)) {
 			//store in temps to avoid multiple repetitive function calls
-			tempA = shared[0]->get(i);
-			tempB = shared[1]->get(i);
+			tempA = abundA;
+			tempB = abundB;
 			if ((tempA != 0) && (tempB != 0)) {//they are shared
 				S12++;
 				//do both A and B have one
@@ -22,6 +22,8 @@ public:
 	SharedAce(int n=10) : abund(n),  Calculator("sharedace", 1, false) {};
 	EstOutput getValues(SAbundVector*) {return data;};
 	EstOutput getValues(vector<SharedRAbundVector*>);
+	EstOutput getValues(SparseRAbund*, SparseRAbund*);
+	bool hasSparse() { return true; }
 	string getCitation() { return "http://www.mothur.org/wiki/SharedAce"; }
 private:
 	int abund;
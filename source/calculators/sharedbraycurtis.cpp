@@ -12,6 +12,17 @@
 /***********************************************************************/
 //This is used by SharedJAbund and SharedSorAbund
 EstOutput BrayCurtis::getValues(vector<SharedRAbundVector*> shared) {
+	try {
+		SparseRAbund A(shared[0]); SparseRAbund B(shared[1]);
+		return getValues(&A, &B);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BrayCurtis", "getValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
+EstOutput BrayCurtis::getValues(SparseRAbund* sharedA, SparseRAbund* sharedB) {
 	try {	
 		data.resize(1,0);
 		
@@ -24,10 +35,12 @@ EstOutput BrayCurtis::getValues(vector<SharedRAbundVector*> shared) {
 		sumSharedAB = the sum of the minimum otus int all shared otus in AB.
 		*/
 		
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
+		int abundA, abundB;
+		SparseRAbundPair otus(sharedA, sharedB);
+		while (otus.next(abundA, abundB)) {
 			//store in temps to avoid multiple repetitive function calls
-			tempA = shared[0]->get(i);
-			tempB = shared[1]->get(i);
+			tempA = abundA;
+			tempB = abundB;
 			
 			sumSharedA += tempA;
 			sumSharedB += tempB;
@@ -15,7 +15,6 @@ EstOutput SharedChao1::getValues(vector<SharedRAbundVector*> shared){
 		data.resize(1,0);		
 		vector<int> temp; 
 		int numGroups = shared.size();
-		float Chao = 0.0; float leftvalue, rightvalue;
 				
 		// IntNode is defined in mothur.h
 		// The tree used here is a binary tree used to represent the f1+++, f+1++, f++1+, f+++1, f11++, f1+1+... 
@@ -44,7 +43,47 @@ EstOutput SharedChao1::getValues(vector<SharedRAbundVector*> shared){
 				updateTree(temp);
 			}
 		}
+		
+		data[0] = getChao();
+		return data;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SharedChao1", "getValues");
+		exit(1);
+	}
+}
 
+/***********************************************************************/
+//only OTUs seen in both groups are added to the trees
+EstOutput SharedChao1::getValues(SparseRAbund* sharedA, SparseRAbund* sharedB){
+	try {
+		data.resize(1,0);
+		vector<int> temp(2, 0);
+		
+		initialTree(2);
+		
+		int abundA, abundB;
+		SparseRAbundPair otus(sharedA, sharedB);
+		while (otus.next(abundA, abundB)) {
+			if ((abundA != 0) && (abundB != 0)) {
+				temp[0] = abundA; temp[1] = abundB;
+				updateTree(temp);
+			}
+		}
+		
+		data[0] = getChao();
+		return data;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SharedChao1", "getValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//calculates the estimate from the filled trees and frees them
+float SharedChao1::getChao() {
+	try {
+		float Chao = 0.0; float leftvalue, rightvalue;
 		
 		//calculate chao1, (numleaves-1) because numleaves contains the ++ values.
 		bool bias = false;
@@ -86,11 +125,10 @@ EstOutput SharedChao1::getValues(vector<SharedRAbundVector*> shared){
 		}
 		
 		
-		data[0] = Chao;
-		return data;
+		return Chao;
 	}
 	catch(exception& e) {
-		m->errorOut(e, "SharedChao1", "getValues");
+		m->errorOut(e, "SharedChao1", "getChao");
 		exit(1);
 	}
 }
@@ -24,6 +24,8 @@ class SharedChao1 : public Calculator  {
 		SharedChao1() : Calculator("sharedchao", 1, true) {};
 		EstOutput getValues(SAbundVector*) {return data;};
 		EstOutput getValues(vector<SharedRAbundVector*>);
+		EstOutput getValues(SparseRAbund*, SparseRAbund*);
+		bool hasSparse() { return true; }
 		string getCitation() { return "http://www.mothur.org/wiki/Sharedchao"; }
 	private:
 		IntNode* f1root;
@@ -33,6 +35,7 @@ class SharedChao1 : public Calculator  {
 		int numLeaves;
 		int numNodes;
 
+		float getChao();		//calculates the estimate from the filled trees and deletes them
 		void initialTree(int);  //builds trees structure with n leaf nodes initialized to 0.
 		void setCoef(IntNode*, int);
 		void updateTree(vector<int>); //take vector containing the abundance info. for a bin and updates trees.
@@ -15,6 +15,17 @@
 /***********************************************************************/
 
 EstOutput Jest::getValues(vector<SharedRAbundVector*> shared) {
+	try {
+		SparseRAbund A(shared[0]); SparseRAbund B(shared[1]);
+		return getValues(&A, &B);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Jest", "getValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
+EstOutput Jest::getValues(SparseRAbund* sharedA, SparseRAbund* sharedB) {
 	try {
 		EstOutput S1, S2, S12;
 		S12.resize(1,0);
@@ -32,13 +43,13 @@ EstOutput Jest::getValues(vector<SharedRAbundVector*> shared) {
 		SAbundVector* chaoS1Sabund = new SAbundVector();
 		SAbundVector* chaoS2Sabund = new SAbundVector();
 		
-		*chaoS1Sabund = shared[0]->getSAbundVector();
-		*chaoS2Sabund = shared[1]->getSAbundVector();
+		*chaoS1Sabund = sharedA->getSAbundVector();
+		*chaoS2Sabund = sharedB->getSAbundVector();
         
         //chaoS1Sabund->print(cout);
         //chaoS2Sabund->print(cout);
 		
-		S12 = sharedChao->getValues(shared);
+		S12 = sharedChao->getValues(sharedA, sharedB);
 		S1 = chaoS1->getValues(chaoS1Sabund);
 		S2 = chaoS2->getValues(chaoS2Sabund);
         
@@ -12,6 +12,17 @@
 /***********************************************************************/
 
 EstOutput KulczynskiCody::getValues(vector<SharedRAbundVector*> shared) {
+	try {
+		SparseRAbund A(shared[0]); SparseRAbund B(shared[1]);
+		return getValues(&A, &B);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "KulczynskiCody", "getValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
+EstOutput KulczynskiCody::getValues(SparseRAbund* sharedA, SparseRAbund* sharedB) {
 	try {
 		double S1, S2, S12, tempA, tempB;
 		S1 = 0; S2 = 0; S12 = 0; tempA = 0; tempB = 0; 
@@ -21,10 +32,12 @@ EstOutput KulczynskiCody::getValues(vector<SharedRAbundVector*> shared) {
 
 		data.resize(1,0);
 		
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
+		int abundA, abundB;
+		SparseRAbundPair otus(sharedA, sharedB);
+		while (otus.next(abundA, abundB)) {
 			//store in temps to avoid multiple repetitive function calls
-			tempA = shared[0]->get(i);
-			tempB = shared[1]->get(i);
+			tempA = abundA;
+			tempB = abundB;
 			
 			if (tempA != 0) { S1++; }
 			if (tempB != 0) { S2++; } 
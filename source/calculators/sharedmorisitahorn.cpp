@@ -11,6 +11,17 @@
 
 /***********************************************************************/
 EstOutput MorHorn::getValues(vector<SharedRAbundVector*> shared) {
+	try {
+		SparseRAbund A(shared[0]); SparseRAbund B(shared[1]);
+		return getValues(&A, &B);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "MorHorn", "getValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
+EstOutput MorHorn::getValues(SparseRAbund* sharedA, SparseRAbund* sharedB) {
 	try {	
 		data.resize(1,0);
 		
@@ -20,17 +31,20 @@ EstOutput MorHorn::getValues(vector<SharedRAbundVector*> shared) {
 		morhorn = 0.0; sumSharedA = 0.0; sumSharedB = 0.0; a = 0.0; b = 0.0; d = 0.0;
 		
 		//get the total values we need to calculate the theta denominator sums
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
+		int abundA, abundB;
+		SparseRAbundPair totals(sharedA, sharedB);
+		while (totals.next(abundA, abundB)) {
 			//store in temps to avoid multiple repetitive function calls
-			Atotal += shared[0]->get(i);
-			Btotal += shared[1]->get(i);
+			Atotal += abundA;
+			Btotal += abundB;
 		}
 		
 		//calculate the denominator sums
-		for (int j = 0; j < shared[0]->getNumBins(); j++) {
+		SparseRAbundPair otus(sharedA, sharedB);
+		while (otus.next(abundA, abundB)) {
 			//store in temps to avoid multiple repetitive function calls
-			tempA = shared[0]->get(j);
-			tempB = shared[1]->get(j);
+			tempA = abundA;
+			tempB = abundB;
 			float relA = tempA / Atotal;
 			float relB = tempB / Btotal;
 			
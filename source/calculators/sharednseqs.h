@@ -23,6 +23,12 @@ public:
 		data[0] = (double)shared[0]->getNumSeqs() + (double)shared[1]->getNumSeqs();
 		return data;
 	}
+	EstOutput getValues(SparseRAbund* sharedA, SparseRAbund* sharedB) {
+		data.resize(1,0);
+		data[0] = (double)sharedA->numSeqs + (double)sharedB->numSeqs;
+		return data;
+	}
+	bool hasSparse() { return true; }
 	string getCitation() { return "http://www.mothur.org/wiki/Sharednseqs"; }
 };
 
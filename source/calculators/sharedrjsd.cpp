@@ -12,6 +12,17 @@
 //KLD <- function(x,y) sum(x *log(x/y))
 //JSD<- function(x,y) sqrt(0.5 * KLD(x, (x+y)/2) + 0.5 * KLD(y, (x+y)/2))
 EstOutput RJSD::getValues(vector<SharedRAbundVector*> shared) {
+	try {
+		SparseRAbund A(shared[0]); SparseRAbund B(shared[1]);
+		return getValues(&A, &B);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "RJSD", "getValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
+EstOutput RJSD::getValues(SparseRAbund* sharedA, SparseRAbund* sharedB) {
 	try {
         
 		data.resize(1,0);
@@ -19,15 +30,17 @@ EstOutput RJSD::getValues(vector<SharedRAbundVector*> shared) {
         double KLD1 = 0.0;
         double KLD2 = 0.0;
         
-        double totalA = shared[0]->getNumSeqs();
-        double totalB = shared[1]->getNumSeqs();
+        double totalA = sharedA->numSeqs;
+        double totalB = sharedB->numSeqs;
         
-        for (int i = 0; i < shared[0]->getNumBins(); i++) {
-            double tempA = shared[0]->get(i) / totalA;
-            double tempB = shared[1]->get(i) / totalB;
+        int abundA, abundB;
+        SparseRAbundPair otus(sharedA, sharedB);
+        while (otus.next(abundA, abundB)) {
+            double tempA = abundA / totalA;
+            double tempB = abundB / totalB;
             
-            tempA = shared[0]->get(i) / totalA;
-            tempB = shared[1]->get(i) / totalB;
+            tempA = abundA / totalA;
+            tempB = abundB / totalB;
             
             if (tempA == 0) { tempA = 0.000001; }
             if (tempB == 0) { tempB = 0.000001; }
@@ -39,4 +39,25 @@ EstOutput SharedSobsCS::getValues(vector<SharedRAbundVector*> shared){
 	}
 }
 /***********************************************************************/
+//only an OTU seen in both groups can be shared
+EstOutput SharedSobsCS::getValues(SparseRAbund* sharedA, SparseRAbund* sharedB){
+	try {
+		data.resize(1,0);
+		double observed = 0;
+
+		int abundA, abundB;
+		SparseRAbundPair otus(sharedA, sharedB);
+		while (otus.next(abundA, abundB)) {
+			if ((abundA != 0) && (abundB != 0)) {  observed++;  }
+		}
+
+		data[0] = observed;
+		return data;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SharedSobsCS", "getValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
 
@@ -13,13 +13,24 @@
 /***********************************************************************/
 
 EstOutput SorAbund::getValues(vector<SharedRAbundVector*> shared) {
+	try {
+		SparseRAbund A(shared[0]); SparseRAbund B(shared[1]);
+		return getValues(&A, &B);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SorAbund", "getValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
+EstOutput SorAbund::getValues(SparseRAbund* sharedA, SparseRAbund* sharedB) {
 	try {
 		EstOutput UVest;
 		UVest.resize(2,0);
 		data.resize(1,0);
 		
         UVEst uv;
-        UVest = uv.getUVest(shared);
+        UVest = uv.getUVest(sharedA, sharedB);
 		
 		//UVest[0] is Uest, UVest[1] is Vest
 		data[0] = (2 * UVest[0] * UVest[1]) / ((float)(UVest[0] + UVest[1]));
@@ -11,6 +11,17 @@
 
 /***********************************************************************/
 EstOutput ThetaYC::getValues(vector<SharedRAbundVector*> shared) {
+	try {
+		SparseRAbund A(shared[0]); SparseRAbund B(shared[1]);
+		return getValues(&A, &B);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ThetaYC", "getValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
+EstOutput ThetaYC::getValues(SparseRAbund* sharedA, SparseRAbund* sharedB) {
 	try {	
 		data.resize(3,0.0000);
 		
@@ -29,17 +40,20 @@ EstOutput ThetaYC::getValues(vector<SharedRAbundVector*> shared) {
 		double sumPsqQ = 0;
 		
 		//get the total values we need to calculate the theta denominator sums
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
+		int abundA, abundB;
+		SparseRAbundPair totals(sharedA, sharedB);
+		while (totals.next(abundA, abundB)) {
 			//store in temps to avoid multiple repetitive function calls
-			Atotal += (double)shared[0]->get(i);
-			Btotal += (double)shared[1]->get(i);
+			Atotal += (double)abundA;
+			Btotal += (double)abundB;
 		}
 		
 		//calculate the theta denominator sums
-		for (int j = 0; j < shared[0]->getNumBins(); j++) {
+		SparseRAbundPair otus(sharedA, sharedB);
+		while (otus.next(abundA, abundB)) {
 			//store in temps to avoid multiple repetitive function calls
-			pi = shared[0]->get(j) / Atotal;
-			qi = shared[1]->get(j) / Btotal;
+			pi = abundA / Atotal;
+			qi = abundB / Btotal;
 					
 			a += pi * pi;
 			b += qi * qi;
@@ -11,6 +11,17 @@
 
 /***********************************************************************/
 EstOutput Soergel::getValues(vector<SharedRAbundVector*> shared) {
+	try {
+		SparseRAbund A(shared[0]); SparseRAbund B(shared[1]);
+		return getValues(&A, &B);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Soergel", "getValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
+EstOutput Soergel::getValues(SparseRAbund* sharedA, SparseRAbund* sharedB) {
 	try {
 		data.resize(1,0);
 		
@@ -18,10 +29,12 @@ EstOutput Soergel::getValues(vector<SharedRAbundVector*> shared) {
 		double sumMax = 0.0;
 		
 		//calc the 2 denominators
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
+		int abundA, abundB;
+		SparseRAbundPair otus(sharedA, sharedB);
+		while (otus.next(abundA, abundB)) { 
 			
-			int Aij = shared[0]->get(i);
-			int Bij = shared[1]->get(i);
+			int Aij = abundA;
+			int Bij = abundB;
 			
 			sumNum += abs((Aij - Bij));
 			sumMax += max(Aij, Bij);
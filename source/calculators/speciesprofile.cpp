@@ -11,21 +11,35 @@
 
 /***********************************************************************/
 EstOutput SpeciesProfile::getValues(vector<SharedRAbundVector*> shared) {
+	try {
+		SparseRAbund A(shared[0]); SparseRAbund B(shared[1]);
+		return getValues(&A, &B);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SpeciesProfile", "getValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
+EstOutput SpeciesProfile::getValues(SparseRAbund* sharedA, SparseRAbund* sharedB) {
 	try {
 		data.resize(1,0);
 		
 		double sumA = 0.0;
 		double sumB = 0.0;
 		
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
-			sumA += shared[0]->get(i);
-			sumB += shared[1]->get(i);
+		int abundA, abundB;
+		SparseRAbundPair totals(sharedA, sharedB);
+		while (totals.next(abundA, abundB)) { 
+			sumA += abundA;
+			sumB += abundB;
 		}
 		
 		double sum = 0.0;
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
-			int A = shared[0]->get(i);
-			int B = shared[1]->get(i);
+		SparseRAbundPair otus(sharedA, sharedB);
+		while (otus.next(abundA, abundB)) { 
+			int A = abundA;
+			int B = abundB;
 			
 			sum += (((A / sumA) - (B / sumB)) * ((A / sumA) - (B / sumB)));
 		}
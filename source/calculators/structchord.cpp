@@ -11,6 +11,17 @@
 
 /***********************************************************************/
 EstOutput StructChord::getValues(vector<SharedRAbundVector*> shared) {
+	try {
+		SparseRAbund A(shared[0]); SparseRAbund B(shared[1]);
+		return getValues(&A, &B);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "StructChord", "getValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
+EstOutput StructChord::getValues(SparseRAbund* sharedA, SparseRAbund* sharedB) {
 	try {
 		data.resize(1,0);
 		
@@ -18,10 +29,12 @@ EstOutput StructChord::getValues(vector<SharedRAbundVector*> shared) {
 		double sumBj2 = 0.0;
 		
 		//calc the 2 denominators
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
+		int abundA, abundB;
+		SparseRAbundPair totals(sharedA, sharedB);
+		while (totals.next(abundA, abundB)) { 
 			
-			int Aij = shared[0]->get(i);
-			int Bij = shared[1]->get(i);
+			int Aij = abundA;
+			int Bij = abundB;
 			
 			//(Aij) ^ 2
 			sumAj2 += (Aij * Aij);
@@ -33,10 +46,11 @@ EstOutput StructChord::getValues(vector<SharedRAbundVector*> shared) {
 		
 		//calc sum
 		double sum = 0.0;
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
+		SparseRAbundPair otus(sharedA, sharedB);
+		while (otus.next(abundA, abundB)) { 
 			
-			int Aij = shared[0]->get(i);
-			int Bij = shared[1]->get(i);
+			int Aij = abundA;
+			int Bij = abundB;
 			
 			sum += (((Aij / sumAj2) - (Bij / sumBj2)) * ((Aij / sumAj2) - (Bij / sumBj2)));
 		}
@@ -11,6 +11,17 @@
 
 /***********************************************************************/
 EstOutput StructKulczynski::getValues(vector<SharedRAbundVector*> shared) {
+	try {
+		SparseRAbund A(shared[0]); SparseRAbund B(shared[1]);
+		return getValues(&A, &B);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "StructKulczynski", "getValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
+EstOutput StructKulczynski::getValues(SparseRAbund* sharedA, SparseRAbund* sharedB) {
 	try {
 		data.resize(1,0);
 		
@@ -18,10 +29,12 @@ EstOutput StructKulczynski::getValues(vector<SharedRAbundVector*> shared) {
 		double sumB = 0.0;
 		double sumMin = 0.0;
 		
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
+		int abundA, abundB;
+		SparseRAbundPair otus(sharedA, sharedB);
+		while (otus.next(abundA, abundB)) { 
 			
-			int A = shared[0]->get(i);
-			int B = shared[1]->get(i);
+			int A = abundA;
+			int B = abundB;
 			
 			sumA += A;
 			sumB += B;
@@ -21,6 +21,8 @@ public:
 	StructKulczynski() :  Calculator("structkulczynski", 1, false) {};
 	EstOutput getValues(SAbundVector*) {return data;};
 	EstOutput getValues(vector<SharedRAbundVector*>);
+	EstOutput getValues(SparseRAbund*, SparseRAbund*);
+	bool hasSparse() { return true; }
 	string getCitation() { return "http://www.mothur.org/wiki/Structkulczynski"; }
 private:
 	
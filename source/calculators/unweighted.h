@@ -13,6 +13,7 @@
 
 #include "treecalculator.h"
 #include "counttable.h"
+#include "unifractree.h"
 
 /***********************************************************************/
 
@@ -20,7 +21,7 @@ class Unweighted : public TreeCalculator  {
 	
 	public:
         Unweighted(bool r, vector<string> g);
-		~Unweighted() {};
+		~Unweighted() { if (randomTree != NULL) { delete randomTree; } }
 		EstOutput getValues(Tree*, int, string);
 		EstOutput getValues(Tree*, vector<vector<int> >&, int, string);
 		
@@ -30,9 +31,10 @@ class Unweighted : public TreeCalculator  {
 		int processors;
 		string outputDir;
 		bool includeRoot;
+		UnifracTree* randomTree;	//the random trees are all scored on the same tree, so its flat copy is kept
+		Tree* randomTreeSource;
 		
-		EstOutput createProcesses(Tree*, CountTable*);
-		EstOutput createProcesses(Tree*, vector<vector<int> >&, CountTable*);
+		EstOutput createProcesses(UnifracTree*, vector<vector<int> >&);
 };
 
 /**************************************************************************************************/
@@ -12,6 +12,17 @@
 /***********************************************************************/
 //This is used by SharedJAbund and SharedSorAbund
 EstOutput UVEst::getUVest(vector<SharedRAbundVector*> shared) {
+	try {
+		SparseRAbund A(shared[0]); SparseRAbund B(shared[1]);
+		return getUVest(&A, &B);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "UVEst", "getUVest");
+		exit(1);
+	}
+}
+/***********************************************************************/
+EstOutput UVEst::getUVest(SparseRAbund* sharedA, SparseRAbund* sharedB) {
 	try {	
 		EstOutput results;
 		results.resize(2,0);
@@ -29,10 +40,12 @@ EstOutput UVEst::getUVest(vector<SharedRAbundVector*> shared) {
 		sumSharedA1 = the sum of all shared otus in A where B = 1
 		sumSharedB1 = the sum of all shared otus in B where A = 1 */
 		
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
+		int abundA, abundB;
+		SparseRAbundPair otus(sharedA, sharedB);
+		while (otus.next(abundA, abundB)) {
 			//store in temps to avoid multiple repetitive function calls
-			tempA = shared[0]->get(i);
-			tempB = shared[1]->get(i);
+			tempA = abundA;
+			tempB = abundB;
 
 			Atotal += tempA;
 			Btotal += tempB;
@@ -25,6 +25,7 @@ class UVEst {
         ~UVEst() {}
     
 		EstOutput getUVest(vector<SharedRAbundVector*>);
+		EstOutput getUVest(SparseRAbund*, SparseRAbund*);
     
 	private:
 		MothurOut* m;
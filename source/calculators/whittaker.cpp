@@ -12,16 +12,24 @@
 /***********************************************************************/
 
 EstOutput Whittaker::getValues(vector<SharedRAbundVector*> shared){
+	try{
+		SparseRAbund A(shared[0]); SparseRAbund B(shared[1]);
+		return getValues(&A, &B);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Whittaker", "getValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
+EstOutput Whittaker::getValues(SparseRAbund* sharedA, SparseRAbund* sharedB){
 	try{
 		data.resize(1);
 
-		int countA = 0;
-		int countB = 0;
-		int sTotal = shared[0]->getNumBins();
-		for(int i=0;i<sTotal;i++){
-			if(shared[0]->get(i) != 0){	countA++;	}
-			if(shared[1]->get(i) != 0){	countB++;	}		
-		}
+		//the number of OTUs each group was seen in
+		int countA = sharedA->otus.size();
+		int countB = sharedB->otus.size();
+		int sTotal = sharedA->numBins;
 		
 		data[0] = 2-2*sTotal/(float)(countA+countB);
 		return data;
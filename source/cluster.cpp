@@ -76,32 +76,31 @@ bool Cluster::update(double& cutOFF){
                 search = dMatrix->seqVec[smallRow][i].index;
                 
 				bool merged = false;
-				for (int j=0;j<nColCells;j++) {
-                    
-					if (dMatrix->seqVec[smallCol][j].index != smallRow) {  //if you are not the smallest distance
-						if (dMatrix->seqVec[smallCol][j].index == search) {
-							foundCol[j] = 1;
-							merged = true;
-							changed = updateDistance(dMatrix->seqVec[smallCol][j], dMatrix->seqVec[smallRow][i]);
-                            dMatrix->updateCellCompliment(smallCol, j);
-							break;
-						}else if (dMatrix->seqVec[smallCol][j].index < search) { //we don't have a distance for this cell
-                            if (adjust != -1.0) { //adjust
-                                merged = true;
-                                PDistCell value(search, adjust); //create a distance for the missing value
-                                int location = dMatrix->addCellSorted(smallCol, value);
-                                changed = updateDistance(dMatrix->seqVec[smallCol][location], dMatrix->seqVec[smallRow][i]);
-                                dMatrix->updateCellCompliment(smallCol, location);
-                                nColCells++;
-                                foundCol.push_back(0); //add a new found column
-                                //adjust value
-                                for (int k = foundCol.size()-1; k > location; k--) { foundCol[k] = foundCol[k-1]; }
-                                foundCol[location] = 1;
-                            }
-                            j+=nColCells;
-                        } 
-					}	
-				}
+                
+                //the columns cells are sorted with the largest indexes first, find the first one not larger than search
+                PDistCell searchCell(search, 0);
+                int j = lower_bound(dMatrix->seqVec[smallCol].begin(), dMatrix->seqVec[smallCol].end(), searchCell, compareIndexes) - dMatrix->seqVec[smallCol].begin();
+                if ((j < nColCells) && (dMatrix->seqVec[smallCol][j].index == smallRow)) { j++; } //if you are the smallest distance
+                
+                if (j < nColCells) {
+                    if (dMatrix->seqVec[smallCol][j].index == search) {
+                        foundCol[j] = 1;
+                        merged = true;
+                        changed = updateDistance(dMatrix->seqVec[smallCol][j], dMatrix->seqVec[smallRow][i]);
+                        dMatrix->updateCellCompliment(smallCol, j);
+                    }else if (adjust != -1.0) { //we don't have a distance for this cell, adjust
+                        merged = true;
+                        PDistCell value(search, adjust); //create a distance for the missing value
+                        int location = dMatrix->addCellSorted(smallCol, value);
+                        changed = updateDistance(dMatrix->seqVec[smallCol][location], dMatrix->seqVec[smallRow][i]);
+                        dMatrix->updateCellCompliment(smallCol, location);
+                        nColCells++;
+                        foundCol.push_back(0); //add a new found column
+                        //adjust value
+                        for (int k = foundCol.size()-1; k > location; k--) { foundCol[k] = foundCol[k-1]; }
+                        foundCol[location] = 1;
+                    }
+                }
 				//if not merged it you need it for warning 
 				if ((!merged) && (method == "average" || method == "weighted")) {  
 					if (cutOFF > dMatrix->seqVec[smallRow][i].dist) {  
@@ -144,6 +143,25 @@ bool Cluster::update(double& cutOFF){
 	}
 }
 /***********************************************************************/
+//only the two merged bins change, so the callers keep the previous rabund and list without copying them after each merge
+void Cluster::updateOld(RAbundVector* oldRAbund, ListVector* oldList){
+	try {
+        if (oldRAbund != NULL) {
+            oldRAbund->set(smallCol, rabund->get(smallCol));
+            oldRAbund->set(smallRow, rabund->get(smallRow));
+            oldRAbund->setLabel(rabund->getLabel());
+        }
+        
+        oldList->set(smallCol, list->get(smallCol));
+        oldList->set(smallRow, list->get(smallRow));
+        oldList->setLabel(list->getLabel());
+    }
+	catch(exception& e) {
+		m->errorOut(e, "Cluster", "updateOld");
+		exit(1);
+	}
+}
+/***********************************************************************/
 void Cluster::setMapWanted(bool f)  {  
 	try {
 		mapWanted = f;
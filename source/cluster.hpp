@@ -19,6 +19,7 @@ public:
 	virtual string getTag() = 0;
 	virtual void setMapWanted(bool m);  
 	virtual map<string, int> getSeqtoBin()  {  return seq2Bin;	}
+    virtual void updateOld(RAbundVector*, ListVector*); //copies the last merge into the rabund and list from before it, rabund may be NULL
     
 protected:	    
 	virtual bool updateDistance(PDistCell& colCell, PDistCell& rowCell) = 0;
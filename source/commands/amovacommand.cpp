@@ -10,6 +10,7 @@
 #include "amovacommand.h"
 #include "readphylipvector.h"
 #include "designmap.h"
+#include "permutationtest.h"
 
 
 
@@ -21,6 +22,7 @@ vector<string> AmovaCommand::setParameters(){
 		CommandParameter pphylip("phylip", "InputTypes", "", "", "none", "none", "none","amova",false,true,true); parameters.push_back(pphylip);
 		CommandParameter piters("iters", "Number", "", "1000", "", "", "","",false,false); parameters.push_back(piters);
 		CommandParameter palpha("alpha", "Number", "", "0.05", "", "", "","",false,false); parameters.push_back(palpha);
+		CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
 		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
 		CommandParameter poutputdir("outputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(poutputdir);
@@ -40,11 +42,12 @@ string AmovaCommand::getHelpString(){
 		string helpString = "";
 		helpString += "Referenced: Anderson MJ (2001). A new method for non-parametric multivariate analysis of variance. Austral Ecol 26: 32-46.";
 		helpString += "The amova command outputs a .amova file.";
-		helpString += "The amova command parameters are phylip, iters, sets and alpha.  The phylip and design parameters are required, unless you have valid current files.";
+		helpString += "The amova command parameters are phylip, iters, sets, processors and alpha.  The phylip and design parameters are required, unless you have valid current files.";
 		helpString += "The design parameter allows you to assign your samples to groups when you are running amova. It is required.";
 		helpString += "The design file looks like the group file.  It is a 2 column tab delimited file, where the first column is the sample name and the second column is the group the sample belongs to.";
         helpString += "The sets parameter allows you to specify which of the sets in your designfile you would like to analyze. The set names are separated by dashes. THe default is all sets in the designfile.\n";
 		helpString += "The iters parameter allows you to set number of randomization for the P value.  The default is 1000.";
+		helpString += "The processors parameter allows you to specify the number of processors to use for the randomizations. The default is 1.\n";
 		helpString += "The amova command should be in the following format: amova(phylip=file.dist, design=file.design).";
 		
 		return helpString;
@@ -161,6 +164,9 @@ AmovaCommand::AmovaCommand(string option) {
 			if (temp == "not found") { temp = "0.05"; }
 			util.mothurConvert(temp, experimentwiseAlpha); 
             
+			temp = validParameter.valid(parameters, "processors");	if (temp == "not found"){	temp = current->getProcessors();	}
+			processors = current->setProcessors(temp);
+            
             string sets = validParameter.valid(parameters, "sets");			
 			if (sets == "not found") { sets = ""; }
 			else { 
@@ -236,6 +242,8 @@ int AmovaCommand::execute(){
 		util.openOutputFile(AMOVAFileName, AMOVAFile);
 		outputNames.push_back(AMOVAFileName); outputTypes["amova"].push_back(AMOVAFileName);
 		
+		permutationTest = new PermutationTest(iters, processors);
+		
 		double fullANOVAPValue = runAMOVA(AMOVAFile, origGroupSampleMap, experimentwiseAlpha);
 		if(fullANOVAPValue <= experimentwiseAlpha && numGroups > 2){
 			
@@ -265,7 +273,7 @@ int AmovaCommand::execute(){
 		m->mothurOut("If you have borderline P-values, you should try increasing the number of iterations\n");
 		AMOVAFile.close();
 		
-		delete designMap;
+		delete designMap; delete permutationTest;
 	 
 		m->mothurOut("\nOutput File Names: \n"); 
 		for (int i = 0; i < outputNames.size(); i++) {	m->mothurOut(outputNames[i] +"\n"); 	} m->mothurOutEndLine();
@@ -295,12 +303,8 @@ double AmovaCommand::runAMOVA(ofstream& AMOVAFile, map<string, vector<int> > gro
 		double ssWithinOrig = calcSSWithin(groupSampleMap);
 		double ssAmongOrig = ssTotalOrig - ssWithinOrig;
 		
-		double counter = 0;
-		for(int i=0;i<iters;i++){
-			map<string, vector<int> > randomizedGroup = getRandomizedGroups(groupSampleMap);
-			double ssWithinRand = calcSSWithin(randomizedGroup);
-			if(ssWithinRand <= ssWithinOrig){	counter++;	}
-		}
+		AmovaStatistic ssWithin(distanceMatrix, groupSampleMap);
+		double counter = permutationTest->getCount(&ssWithin, ssWithin.getObserved(), false);
 		
 		double pValue = (double)counter / (double) iters;
 		string pString = "";
@@ -350,38 +354,6 @@ double AmovaCommand::runAMOVA(ofstream& AMOVAFile, map<string, vector<int> > gro
 
 //**********************************************************************************************************************
 
-map<string, vector<int> > AmovaCommand::getRandomizedGroups(map<string, vector<int> > origMapping){
-	try{
-		vector<int> sampleIndices;
-		vector<int> samplesPerGroup;
-		
-		map<string, vector<int> >::iterator it;
-		for(it=origMapping.begin();it!=origMapping.end();it++){
-			vector<int> indices = it->second;
-			samplesPerGroup.push_back(indices.size());
-			sampleIndices.insert(sampleIndices.end(), indices.begin(), indices.end());
-		}
-		
-		util.mothurRandomShuffle(sampleIndices);
-		
-		int index = 0;
-		map<string, vector<int> > randomizedGroups = origMapping;
-		for(it=randomizedGroups.begin();it!=randomizedGroups.end();it++){
-			for(int i=0;i<it->second.size();i++){
-				it->second[i] = sampleIndices[index++];				
-			}
-		}
-
-		return randomizedGroups;		
-	}
-	catch (exception& e) {
-		m->errorOut(e, "AmovaCommand", "getRandomizedGroups");
-		exit(1);
-	}
-}
-
-//**********************************************************************************************************************
-
 double AmovaCommand::calcSSTotal(map<string, vector<int> >& groupSampleMap) {
 	try {
 		
@@ -12,9 +12,14 @@
 
 #include "command.hpp"
 class DesignMap;
+class PermutationTest;
 
 class AmovaCommand : public Command {
 	
+#ifdef UNIT_TEST
+	friend class TestPermutationTest;
+#endif
+	
 public:
 	AmovaCommand(string);
 	AmovaCommand();
@@ -36,15 +41,15 @@ private:
 	double runAMOVA(ofstream&, map<string, vector<int> >, double);
 	double calcSSWithin(map<string, vector<int> >&);
 	double calcSSTotal(map<string, vector<int> >&);
-	map<string, vector<int> > getRandomizedGroups(map<string, vector<int> >);
 
 	bool abort;
 	vector<string> outputNames, Sets;
 
 	string outputDir, inputDir, designFileName, phylipFileName;
 	DesignMap* designMap;
+	PermutationTest* permutationTest;
 	vector< vector<double> > distanceMatrix;
-	int iters;
+	int iters, processors;
 	double experimentwiseAlpha;
 };
 
@@ -11,6 +11,7 @@
 #include "inputdata.h"
 #include "readphylipvector.h"
 #include "designmap.h"
+#include "permutationtest.h"
 
 //**********************************************************************************************************************
 vector<string> AnosimCommand::setParameters(){	
@@ -19,6 +20,7 @@ vector<string> AnosimCommand::setParameters(){
 		CommandParameter pphylip("phylip", "InputTypes", "", "", "none", "none", "none","anosim",false,true,true); parameters.push_back(pphylip);
 		CommandParameter piters("iters", "Number", "", "1000", "", "", "","",false,false); parameters.push_back(piters);
 		CommandParameter palpha("alpha", "Number", "", "0.05", "", "", "","",false,false); parameters.push_back(palpha);
+		CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
 		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
 		CommandParameter poutputdir("outputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(poutputdir);
@@ -38,10 +40,11 @@ string AnosimCommand::getHelpString(){
 		string helpString = "";
 		helpString += "Referenced: Clarke, K. R. (1993). Non-parametric multivariate analysis of changes in community structure.   _Australian Journal of Ecology_ 18, 117-143.\n";
 		helpString += "The anosim command outputs a .anosim file. \n";
-		helpString += "The anosim command parameters are phylip, iters, and alpha.  The phylip and design parameters are required, unless you have valid current files.\n";
+		helpString += "The anosim command parameters are phylip, iters, processors and alpha.  The phylip and design parameters are required, unless you have valid current files.\n";
 		helpString += "The design parameter allows you to assign your samples to groups when you are running anosim. It is required. \n";
 		helpString += "The design file looks like the group file.  It is a 2 column tab delimited file, where the first column is the sample name and the second column is the group the sample belongs to.\n";
 		helpString += "The iters parameter allows you to set number of randomization for the P value.  The default is 1000. \n";
+		helpString += "The processors parameter allows you to specify the number of processors to use for the randomizations. The default is 1.\n";
 		helpString += "The anosim command should be in the following format: anosim(phylip=file.dist, design=file.design).\n";
 		return helpString;
 	}
@@ -158,6 +161,9 @@ AnosimCommand::AnosimCommand(string option) {
 			temp = validParameter.valid(parameters, "alpha");
 			if (temp == "not found") { temp = "0.05"; }
 			util.mothurConvert(temp, experimentwiseAlpha); 
+			
+			temp = validParameter.valid(parameters, "processors");	if (temp == "not found"){	temp = current->getProcessors();	}
+			processors = current->setProcessors(temp);
 		}
 		
 	}
@@ -210,6 +216,8 @@ int AnosimCommand::execute(){
 		m->mothurOut("\ncomparison\tR-value\tP-value\n");
 		ANOSIMFile << "comparison\tR-value\tP-value\n";
 		
+		permutationTest = new PermutationTest(iters, processors);
+		
 		
 		double fullANOSIMPValue = runANOSIM(ANOSIMFile, distanceMatrix, origGroupSampleMap, experimentwiseAlpha);
 		
@@ -262,7 +270,7 @@ int AnosimCommand::execute(){
 		m->mothurOut("If you have borderline P-values, you should try increasing the number of iterations\n");
 		ANOSIMFile.close();
 		
-		delete designMap;
+		delete designMap; delete permutationTest;
 				
 		m->mothurOut("\nOutput File Names: \n"); 
 		for (int i = 0; i < outputNames.size(); i++) {	m->mothurOut(outputNames[i] +"\n"); 	} m->mothurOutEndLine();
@@ -282,12 +290,8 @@ double AnosimCommand::runANOSIM(ofstream& ANOSIMFile, vector<vector<double> > dM
 		vector<vector<double> > rankMatrix = convertToRanks(dMatrix);
 		double RValue = calcR(rankMatrix, groupSampleMap);
 		
-		int pCount = 0;
-		for(int i=0;i<iters;i++){
-			map<string, vector<int> > randGroupSampleMap = getRandomizedGroups(groupSampleMap);
-			double RValueRand = calcR(rankMatrix, randGroupSampleMap);
-			if(RValue <= RValueRand){	pCount++;	}
-		}
+		AnosimStatistic rStatistic(rankMatrix, groupSampleMap);
+		int pCount = permutationTest->getCount(&rStatistic, rStatistic.getObserved(), true);
 
 		double pValue = (double)pCount / (double) iters;
 		string pString = "";
@@ -436,37 +440,5 @@ vector<vector<double> > AnosimCommand::convertToRanks(vector<vector<double> > di
 
 //**********************************************************************************************************************
 
-map<string, vector<int> > AnosimCommand::getRandomizedGroups(map<string, vector<int> > origMapping){
-	try{
-		vector<int> sampleIndices;
-		vector<int> samplesPerGroup;
-		
-		map<string, vector<int> >::iterator it;
-		for(it=origMapping.begin();it!=origMapping.end();it++){
-			vector<int> indices = it->second;
-			samplesPerGroup.push_back(indices.size());
-			sampleIndices.insert(sampleIndices.end(), indices.begin(), indices.end());
-		}
-		
-		util.mothurRandomShuffle(sampleIndices);
-		
-		int index = 0;
-		map<string, vector<int> > randomizedGroups = origMapping;
-		for(it=randomizedGroups.begin();it!=randomizedGroups.end();it++){
-			for(int i=0;i<it->second.size();i++){
-				it->second[i] = sampleIndices[index++];				
-			}
-		}
-		
-		return randomizedGroups;		
-	}
-	catch (exception& e) {
-		m->errorOut(e, "AnosimCommand", "randomizeGroups");
-		exit(1);
-	}
-}
-
-//**********************************************************************************************************************
-
 
 
@@ -14,9 +14,14 @@
 #include "command.hpp"
 
 class DesignMap;
+class PermutationTest;
 
 class AnosimCommand : public Command {
 	
+#ifdef UNIT_TEST
+	friend class TestPermutationTest;
+#endif
+	
 public:
 	AnosimCommand(string);
 	AnosimCommand();
@@ -37,16 +42,16 @@ public:
 private:
 	bool abort;
 	DesignMap* designMap;
+	PermutationTest* permutationTest;
 	string outputDir, inputDir, designFileName, phylipFileName;
 	
 	vector<vector<double> > convertToRanks(vector<vector<double> >);
 	double calcR(vector<vector<double> >, map<string, vector<int> >);
-	map<string, vector<int> > getRandomizedGroups(map<string, vector<int> >);
 	double runANOSIM(ofstream&, vector<vector<double> >, map<string, vector<int> >, double);
 	
 	vector< vector<double> > distanceMatrix;
 	vector<string> outputNames;
-	int iters;
+	int iters, processors;
 	double experimentwiseAlpha;
 	vector< vector<string> > namesOfGroupCombos;
 	
@@ -70,6 +70,7 @@ string ChimeraUchimeCommand::getHelpString(){
         helpString += "If the dereplicate parameter is false, then if one group finds the sequence to be chimeric, then all groups find it to be chimeric, default=f.\n";
 		helpString += "The reference parameter allows you to enter a reference file containing known non-chimeric sequences, and is required. You may also set template=self, in this case the abundant sequences will be used as potential parents. \n";
 		helpString += "The processors parameter allows you to specify how many processors you would like to use.  The default is 1. \n";
+		helpString += "With template=self and no groups, uchime checks the sequences in batches split between the processors and gives the same results as with 1 processor. This is not available on Windows.\n";
 		helpString += "The abskew parameter can only be used with template=self. Minimum abundance skew. Default 1.9. Abundance skew is: min [ abund(parent1), abund(parent2) ] / abund(query).\n";
 		helpString += "The chimealns parameter allows you to indicate you would like a file containing multiple alignments of query sequences to parents in human readable format. Alignments show columns with differences that support or contradict a chimeric model.\n";
 		helpString += "The minh parameter - mininum score to report chimera. Default 0.3. Values from 0.1 to 5 might be reasonable. Lower values increase sensitivity but may report more false positives. If you decrease xn you may need to increase minh, and vice versa.\n";
@@ -417,7 +418,7 @@ struct uchimeData {
     string accnos, alns, filename, templatefile, uchimeLocation, countlist;
     string driverAccnos, driverAlns, driverOutputFName;
     
-    int count, numChimeras;
+    int count, numChimeras, threads;
     map<string, string> uniqueNamesMap;
     vector<string> groups;
     uchimeVariables* vars;
@@ -438,6 +439,7 @@ struct uchimeData {
         groups = gr;
         count = 0;
         numChimeras = 0;
+        threads = 1;
         uchimeLocation = uloc;
         countlist = nc;
         vars = vs;
@@ -699,6 +701,16 @@ int driver(uchimeData* params){
             cPara.push_back(tempMaxlen);
         }
         
+        if (params->threads > 1) {
+            char* tempthreads = new char[10];
+            *tempthreads = '\0'; strncat(tempthreads, "--threads", 9);
+            cPara.push_back(tempthreads);
+            string threads = toString(params->threads);
+            char* tempThreads = new char[threads.length()+1];
+            *tempThreads = '\0'; strncat(tempThreads, threads.c_str(), threads.length());
+            cPara.push_back(tempThreads);
+        }
+        
         if (params->vars->ucl) {
             char* tempucl = new char[5];
             strcpy(tempucl, "--ucl");
@@ -832,7 +844,6 @@ int ChimeraUchimeCommand::execute(){
 			
 			if ((templatefile == "self") && (!hasGroup)) { //you want to run uchime with a template=self and no groups
 
-				if (processors != 1) { m->mothurOut("When using template=self, mothur can only use 1 processor, continuing."); m->mothurOutEndLine(); processors = 1; }
 				if (nameFileNames.size() != 0) { //you provided a namefile and we don't need to create one
 					nameFile = nameFileNames[s];
 				}else { nameFile = getNamesFile(fastaFileNames[s]); }
@@ -920,6 +931,7 @@ int ChimeraUchimeCommand::execute(){
 				int numSeqs = 0;
 				int numChimeras = 0;
                 uchimeData* dataBundle = new uchimeData(outputFileName, uchimeLocation, templatefile, fastaFileNames[s], fastaFileNames[s], nameFile, groupFile, accnosFileName, alnsFileName, accnosFileName+".byCount.temp", nullVector, vars);
+                if (templatefile == "self") { dataBundle->threads = processors; } //uchime splits the de novo check between its own processes
 
                 numSeqs = driver(dataBundle);
                 numChimeras = dataBundle->numChimeras;
@@ -78,7 +78,8 @@ string ClusterCommand::getHelpString(){
         helpString += "The initialize parameter allows to select the initial randomization for the opticluster method. Options are singleton, meaning each sequence is randomly assigned to its own OTU, or oneotu meaning all sequences are assigned to one otu. Default=singleton.\n";
         helpString += "The delta parameter allows to set the stable value for the metric in the opticluster method (delta=0.0001). \n";
         helpString += "The method parameter allows you to enter your clustering mothod. Options are furthest, nearest, average, weighted, agc, dgc, unique and opti. Default=opti.  The agc and dgc methods require a fasta file.";
-        helpString += "The processors parameter allows you to specify the number of processors to use. The default is 1.\n";
+        helpString += "The processors parameter allows you to specify the number of processors to use with the opti, agc and dgc methods. The default is 1.\n";
+        helpString += "With the opti method and more than 1 processor, the sequences are moved in batches. A seed gives the same OTUs with any number of processors above 1, but they may differ slightly from the OTUs found with 1 processor.\n";
        helpString += "The cluster command should be in the following format: \n";
 		helpString += "cluster(method=yourMethod, cutoff=yourCutoff, precision=yourPrecision) \n";
 		return helpString;
@@ -334,9 +335,10 @@ ClusterCommand::ClusterCommand(string option)  {
             
             if ((method == "agc") || (method == "dgc")) {
                 if (fastafile == "") { m->mothurOut("[ERROR]: You must provide a fasta file when using the agc or dgc clustering methods, aborting\n."); abort = true;}
-            }else if (setProcessors) {
-                m->mothurOut("[WARNING]: You can only use the processors option when using the agc or dgc clustering methods. Using 1 processor.\n.");
+            }else if (setProcessors && (method != "opti")) {
+                m->mothurOut("[WARNING]: You can only use the processors option when using the opti, agc or dgc clustering methods. Using 1 processor.\n.");
             }
+            if ((method == "opti") && !setProcessors) { processors = 1; } //opti only uses more than 1 if asked, so the OTUs don't depend on the machine
             
             cutOffSet = false;
             temp = validParameter.valid(parameters, "cutoff");
@@ -749,8 +751,7 @@ int ClusterCommand::runMothurCluster(){
             
             previousDist = dist;
             rndPreviousDist = rndDist;
-            oldRAbund = *rabund;
-            oldList = *list;
+            cluster->updateOld(&oldRAbund, &oldList);
         }
         
         if (print_start && util.isTrue(timing)) {
@@ -885,6 +886,7 @@ int ClusterCommand::runOptiCluster(){
         
         
         OptiCluster cluster(&matrix, metric, 0);
+        cluster.setProcessors(processors);
         tag = cluster.getTag();
         
         m->mothurOutEndLine(); m->mothurOut("Clustering " + distfile); m->mothurOutEndLine();
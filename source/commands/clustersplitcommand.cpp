@@ -1387,7 +1387,7 @@ string clusterFile(string thisDistFile, string thisNamefile, double& smallestCut
                 
                 previousDist = dist;
                 rndPreviousDist = rndDist;
-                oldList = *list;
+                cluster->updateOld(NULL, &oldList);
             }
             
             
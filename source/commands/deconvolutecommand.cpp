@@ -9,6 +9,7 @@
 
 #include "deconvolutecommand.h"
 #include "sequence.hpp"
+#include "sequencehashtable.h"
 
 //**********************************************************************************************************************
 vector<string> DeconvoluteCommand::setParameters(){	
@@ -240,11 +241,13 @@ int DeconvoluteCommand::execute() {
 		ofstream outFasta;
 		util.openOutputFile(outFastaFile, outFasta);
 		
-		map<string, string> sequenceStrings; //sequenceString -> list of names.  "atgc...." -> seq1,seq2,seq3.
-		map<string, string>::iterator itStrings;
-		set<string> nameInFastaFile; //for sanity checking
-		set<string>::iterator itname;
-		vector<string> nameFileOrder;
+		//the unique sequences are numbered in the order they are found. each unique has a list of the reads that
+		//have its sequence, the reads are indexes into readNames and nextRead links the reads of a unique.
+		SequenceHashTable uniqueSeqs;
+		SequenceHashTable readNames; //names of the reads in the fasta file, also used for sanity checking
+		vector<int> firstRead, lastRead; //first and last read of each unique in the order they were found
+		vector<int> nextRead; //next read of the same unique, -1 if last
+		vector<int> readNameIndexes; //index into readNames for each read
         CountTable newCt;
 		int count = 0;
 		while (!in.eof()) {
@@ -256,13 +259,16 @@ int DeconvoluteCommand::execute() {
 			if (seq.getName() != "") {
 				
 				//sanity checks
-				itname = nameInFastaFile.find(seq.getName());
-				if (itname == nameInFastaFile.end()) { nameInFastaFile.insert(seq.getName());  }
-				else { m->mothurOut("[ERROR]: You already have a sequence named " + seq.getName() + " in your fasta file, sequence names must be unique, please correct."); m->mothurOutEndLine(); }
+				bool isNewName = true;
+				int nameIndex = readNames.add(seq.getName(), isNewName);
+				if (!isNewName) { m->mothurOut("[ERROR]: You already have a sequence named " + seq.getName() + " in your fasta file, sequence names must be unique, please correct."); m->mothurOutEndLine(); }
 
-				itStrings = sequenceStrings.find(seq.getAligned());
+				bool isUnique = true;
+				int uniqueIndex = uniqueSeqs.add(seq.getAligned(), isUnique);
+				if (isUnique) { firstRead.push_back(-1); lastRead.push_back(-1); }
 				
-				if (itStrings == sequenceStrings.end()) { //this is a new unique sequence
+				bool addRead = true;
+				if (firstRead[uniqueIndex] == -1) { //this is a new unique sequence, or none of the reads before it were in the name file
 					//output to unique fasta file
 					seq.printSequence(outFasta);
 					
@@ -270,61 +276,54 @@ int DeconvoluteCommand::execute() {
 						itNames = nameMap.find(seq.getName());
 						
 						if (itNames == nameMap.end()) { //namefile and fastafile do not match
-							m->mothurOut("[ERROR]: " + seq.getName() + " is in your fasta file, and not in your namefile, please correct."); m->mothurOutEndLine();
+							m->mothurOut("[ERROR]: " + seq.getName() + " is in your fasta file, and not in your namefile, please correct."); m->mothurOutEndLine(); addRead = false;
 						}else {
-                            if (format == "name") { sequenceStrings[seq.getAligned()] = itNames->second;  nameFileOrder.push_back(seq.getAligned());
-                            }else {  newCt.push_back(seq.getName(), util.getNumNames(itNames->second)); sequenceStrings[seq.getAligned()] = seq.getName();	nameFileOrder.push_back(seq.getAligned()); }
+                            if (format != "name") { newCt.push_back(seq.getName(), util.getNumNames(itNames->second)); }
 						}
 					}else if (countfile != "") {
-                        if (format == "name") {
-                            int numSeqs = ct.getNumSeqs(seq.getName());
-                            string expandedName = seq.getName()+"_0";
-                            for (int i = 1; i < numSeqs; i++) {  expandedName += "," + seq.getName() + "_" + toString(i);  }
-                            sequenceStrings[seq.getAligned()] = expandedName;  nameFileOrder.push_back(seq.getAligned());
-                        }else {
-                            ct.getNumSeqs(seq.getName()); //checks to make sure seq is in table
-                            sequenceStrings[seq.getAligned()] = seq.getName();	nameFileOrder.push_back(seq.getAligned());
-                        }
+                        ct.getNumSeqs(seq.getName()); //checks to make sure seq is in table
                     }else {
-                        if (format == "name") { sequenceStrings[seq.getAligned()] = seq.getName();	nameFileOrder.push_back(seq.getAligned()); }
-                        else {  newCt.push_back(seq.getName()); sequenceStrings[seq.getAligned()] = seq.getName();	nameFileOrder.push_back(seq.getAligned()); }
+                        if (format != "name") { newCt.push_back(seq.getName()); }
                     }
 				}else { //this is a dup
+                    string repName = readNames.get(readNameIndexes[firstRead[uniqueIndex]]);
+                    
 					if (namefile != "") {
 						itNames = nameMap.find(seq.getName());
 						
 						if (itNames == nameMap.end()) { //namefile and fastafile do not match
-							m->mothurOut("[ERROR]: " + seq.getName() + " is in your fasta file, and not in your namefile, please correct."); m->mothurOutEndLine();
+							m->mothurOut("[ERROR]: " + seq.getName() + " is in your fasta file, and not in your namefile, please correct."); m->mothurOutEndLine(); addRead = false;
 						}else {
-                            if (format == "name") { sequenceStrings[seq.getAligned()] += "," + itNames->second;  }
-                            else {  int currentReps = newCt.getNumSeqs(itStrings->second);  newCt.setNumSeqs(itStrings->second, currentReps+(util.getNumNames(itNames->second)));  }
+                            if (format != "name") {  int currentReps = newCt.getNumSeqs(repName);  newCt.setNumSeqs(repName, currentReps+(util.getNumNames(itNames->second)));  }
 						}
                     }else if (countfile != "") {
-                        if (format == "name") {
-                            int numSeqs = ct.getNumSeqs(seq.getName());
-                            string expandedName = seq.getName()+"_0";
-                            for (int i = 1; i < numSeqs; i++) {  expandedName += "," + seq.getName() + "_" + toString(i);  }
-                            sequenceStrings[seq.getAligned()] += "," + expandedName;
-                        }else {
-                            int num = ct.getNumSeqs(seq.getName()); //checks to make sure seq is in table
+                        int num = ct.getNumSeqs(seq.getName()); //checks to make sure seq is in table
+                        if (format != "name") {
                             if (num != 0) { //its in the table
-                                ct.mergeCounts(itStrings->second, seq.getName()); //merges counts and saves in uniques name
+                                ct.mergeCounts(repName, seq.getName()); //merges counts and saves in uniques name
                             }
                         }
                     }else {
-                        if (format == "name") {  sequenceStrings[seq.getAligned()] += "," + seq.getName(); }
-                        else {  int currentReps = newCt.getNumSeqs(itStrings->second); newCt.setNumSeqs(itStrings->second, currentReps+1);  }
+                        if (format != "name") {  int currentReps = newCt.getNumSeqs(repName); newCt.setNumSeqs(repName, currentReps+1);  }
                     }
 				}
+				
+				if (addRead) {
+					int readIndex = (int)readNameIndexes.size();
+					readNameIndexes.push_back(nameIndex); nextRead.push_back(-1);
+					if (firstRead[uniqueIndex] == -1) { firstRead[uniqueIndex] = readIndex; }
+					else { nextRead[lastRead[uniqueIndex]] = readIndex; }
+					lastRead[uniqueIndex] = readIndex;
+				}
 				count++;
 			}
 			
 			util.gobble(in);
 			
-			if(count % 1000 == 0)	{ m->mothurOutJustToScreen(toString(count) + "\t" + toString(sequenceStrings.size()) + "\n");	}
+			if(count % 1000 == 0)	{ m->mothurOutJustToScreen(toString(count) + "\t" + toString(uniqueSeqs.size()) + "\n");	}
 		}
 		
-		if(count % 1000 != 0)	{ m->mothurOut(toString(count) + "\t" + toString(sequenceStrings.size())); m->mothurOutEndLine();	}
+		if(count % 1000 != 0)	{ m->mothurOut(toString(count) + "\t" + toString(uniqueSeqs.size())); m->mothurOutEndLine();	}
 		
 		in.close();
 		outFasta.close();
@@ -339,26 +338,42 @@ int DeconvoluteCommand::execute() {
         if ((countfile != "") && (format == "count")) { ct.printHeaders(outNames); }
         else if ((countfile == "") && (format == "count")) { newCt.printHeaders(outNames); }
 		
-		for (int i = 0; i < nameFileOrder.size(); i++) {
+		for (int i = 0; i < firstRead.size(); i++) {
 			if (m->getControl_pressed()) { outputTypes.clear(); util.mothurRemove(outFastaFile); outNames.close(); for (int j = 0; j < outputNames.size(); j++) { util.mothurRemove(outputNames[j]); } return 0; }
 			
-			itStrings = sequenceStrings.find(nameFileOrder[i]);
+			if (firstRead[i] == -1) { continue; } //none of its reads were in the name or count file
 			
-			if (itStrings != sequenceStrings.end()) {
-                if (format == "name") {
-                    //get rep name
-                    int pos = (itStrings->second).find_first_of(',');
+            if (format == "name") {
+                string names = "";
+                for (int read = firstRead[i]; read != -1; read = nextRead[read]) {
+                    string readName = readNames.get(readNameIndexes[read]);
                     
-                    if (pos == string::npos) { // only reps itself
-                        outNames << itStrings->second << '\t' << itStrings->second << endl;
-                    }else {
-                        outNames << (itStrings->second).substr(0, pos) << '\t' << itStrings->second << endl;
+                    string readNameList = readName;
+                    if (namefile != "") { readNameList = nameMap[readName]; }
+                    else if (countfile != "") {
+                        int numSeqs = ct.getNumSeqs(readName);
+                        readNameList = readName+"_0";
+                        for (int j = 1; j < numSeqs; j++) {  readNameList += "," + readName + "_" + toString(j);  }
                     }
+                    
+                    if (names == "") { names = readNameList; }
+                    else { names += "," + readNameList; }
+                }
+                
+                //get rep name
+                int pos = names.find_first_of(',');
+                
+                if (pos == string::npos) { // only reps itself
+                    outNames << names << '\t' << names << endl;
                 }else {
-                    if (countfile != "") {  ct.printSeq(outNames, itStrings->second);  }
-                    else if (format == "count")  {  newCt.printSeq(outNames, itStrings->second);  }
+                    outNames << names.substr(0, pos) << '\t' << names << endl;
                 }
-			}else{ m->mothurOut("[ERROR]: mismatch in namefile print."); m->mothurOutEndLine(); m->setControl_pressed(true); }
+            }else {
+                string repName = readNames.get(readNameIndexes[firstRead[i]]);
+                
+                if (countfile != "") {  ct.printSeq(outNames, repName);  }
+                else if (format == "count")  {  newCt.printSeq(outNames, repName);  }
+            }
 		}
 		outNames.close();
 		
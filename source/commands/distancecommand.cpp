@@ -15,10 +15,11 @@ vector<string> DistanceCommand::setParameters(){
 		CommandParameter pcolumn("column", "InputTypes", "", "", "none", "none", "OldFastaColumn","column",false,false); parameters.push_back(pcolumn);
 		CommandParameter poldfasta("oldfasta", "InputTypes", "", "", "none", "none", "OldFastaColumn","",false,false); parameters.push_back(poldfasta);
 		CommandParameter pfasta("fasta", "InputTypes", "", "", "none", "none", "none","phylip-column",false,true, true); parameters.push_back(pfasta);
-		CommandParameter poutput("output", "Multiple", "column-lt-square-phylip", "column", "", "", "","phylip-column",false,false, true); parameters.push_back(poutput);
+		CommandParameter poutput("output", "Multiple", "column-lt-square-phylip-binary", "column", "", "", "","phylip-column",false,false, true); parameters.push_back(poutput);
 		CommandParameter pcalc("calc", "Multiple", "nogaps-eachgap-onegap", "onegap", "", "", "","",false,false); parameters.push_back(pcalc);
 		CommandParameter pcountends("countends", "Boolean", "", "T", "", "", "","",false,false); parameters.push_back(pcountends);
         CommandParameter pfitcalc("fitcalc", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(pfitcalc);
+        CommandParameter pkmerfilter("kmerfilter", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(pkmerfilter);
 		CommandParameter pcompress("compress", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(pcompress);
 		CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false, true); parameters.push_back(pprocessors);
 		CommandParameter pcutoff("cutoff", "Number", "", "1.0", "", "", "","",false,false, true); parameters.push_back(pcutoff);
@@ -40,13 +41,15 @@ string DistanceCommand::getHelpString(){
 	try {
 		string helpString = "";
 		helpString += "The dist.seqs command reads a file containing sequences and creates a distance file.\n";
-		helpString += "The dist.seqs command parameters are fasta, oldfasta, column, calc, countends, output, compress, cutoff and processors.  \n";
+		helpString += "The dist.seqs command parameters are fasta, oldfasta, column, calc, countends, output, compress, cutoff, kmerfilter and processors.  \n";
 		helpString += "The fasta parameter is required, unless you have a valid current fasta file.\n";
 		helpString += "The oldfasta and column parameters allow you to append the distances calculated to the column file.\n";
 		helpString += "The calc parameter allows you to specify the method of calculating the distances.  Your options are: nogaps, onegap or eachgap. The default is onegap.\n";
 		helpString += "The countends parameter allows you to specify whether to include terminal gaps in distance.  Your options are: T or F. The default is T.\n";
 		helpString += "The cutoff parameter allows you to specify maximum distance to keep. The default is 1.0.\n";
-		helpString += "The output parameter allows you to specify format of your distance matrix. Options are column, lt, and square. The default is column.\n";
+		helpString += "The kmerfilter parameter allows you to skip the pairs whose shared 8mers show they can't be within the cutoff, without aligning them column by column. It can only be used with calc=eachgap, countends=T and column output. The distances found are the same. The default is F.\n";
+		helpString += "The output parameter allows you to specify format of your distance matrix. Options are column, lt, square and binary. The default is column.\n";
+		helpString += "The binary output is a compact form of the column format that the cluster and cluster.split commands can read with the column parameter. It stores each name once and the distances in binary. Other commands can't read it, so it is not set as the current column file.\n";
 		helpString += "The processors parameter allows you to specify number of processors to use.  The default is 1.\n";
 		helpString += "The compress parameter allows you to indicate that you want the resulting distance file compressed.  The default is false.\n";
 		helpString += "The dist.seqs command should be in the following format: \n";
@@ -65,7 +68,10 @@ string DistanceCommand::getOutputPattern(string type) {
         string pattern = "";
         
         if (type == "phylip") {  pattern = "[filename],[outputtag],dist"; } 
-        else if (type == "column") { pattern = "[filename],dist"; }
+        else if (type == "column") {
+            if (output == "binary") { pattern = "[filename],bdist"; }
+            else { pattern = "[filename],dist"; }
+        }
         else { m->mothurOut("[ERROR]: No definition for type " + type + " output pattern.\n"); m->setControl_pressed(true);  }
         
         return pattern;
@@ -197,6 +203,9 @@ DistanceCommand::DistanceCommand(string option) {
             
             temp = validParameter.valid(parameters, "fitcalc");	if(temp == "not found"){	temp = "F";	}
             fitCalc = util.isTrue(temp);
+            
+            temp = validParameter.valid(parameters, "kmerfilter");	if(temp == "not found"){	temp = "F";	}
+            kmerFilter = util.isTrue(temp);
 			
 			temp = validParameter.valid(parameters, "cutoff");		if(temp == "not found"){	temp = "1.0"; }
 			util.mothurConvert(temp, cutoff); 
@@ -214,7 +223,10 @@ DistanceCommand::DistanceCommand(string option) {
 			
 			if ((column != "") && (oldfastafile != "") && (output != "column")) { m->mothurOut("You have provided column and oldfasta, indicating you want to append distances to your column file. Your output must be in column format to do so."); m->mothurOutEndLine(); abort=true; }
 			
-			if ((output != "column") && (output != "lt") && (output != "square")) { m->mothurOut(output + " is not a valid output form. Options are column, lt and square. I will use column."); m->mothurOutEndLine(); output = "column"; }
+			if ((output != "column") && (output != "lt") && (output != "square") && (output != "binary")) { m->mothurOut(output + " is not a valid output form. Options are column, lt, square and binary. I will use column."); m->mothurOutEndLine(); output = "column"; }
+            
+            //the kmer bound only holds when every gap column counts and the distances above the cutoff are not written
+            if (kmerFilter && ((Estimators[0] != "eachgap") || !countends || ((output != "column") && (output != "binary")) || fitCalc)) { m->mothurOut("[WARNING]: kmerfilter can only be used with calc=eachgap, countends=T and column or binary output, ignoring.\n"); kmerFilter = false; }
 
 		}
 				
@@ -255,7 +267,7 @@ int DistanceCommand::execute(){
 			util.mothurRemove(outputFile); outputTypes["phylip"].push_back(outputFile);
 			
 			//output numSeqs to phylip formatted dist file
-		}else if (output == "column") { //user wants column format
+		}else if ((output == "column") || (output == "binary")) { //user wants column format
             if (fitCalc) {  variables["[outputtag]"] = "fit";  }
 			outputFile = getOutputFileName("column", variables);
 			outputTypes["column"].push_back(outputFile);
@@ -273,6 +285,8 @@ int DistanceCommand::execute(){
 			util.mothurRemove(outputFile);
 			outputTypes["phylip"].push_back(outputFile);
 		}
+        if (kmerFilter) { fillKmerSketches(); }
+        
         m->mothurOut("\nSequence\tTime\tNum_Dists_Below_Cutoff\n");
                      
         createProcesses(outputFile);
@@ -310,9 +324,9 @@ int DistanceCommand::execute(){
 			if ((itTypes->second).size() != 0) { currentName = (itTypes->second)[0]; current->setPhylipFile(currentName); }
 		}
 		
-		//set column file as new current columnfile
+		//set column file as new current columnfile. only cluster and cluster.split read the binary file, so it is not made current
 		itTypes = outputTypes.find("column");
-		if (itTypes != outputTypes.end()) {
+		if ((itTypes != outputTypes.end()) && (output != "binary")) {
 			if ((itTypes->second).size() != 0) { currentName = (itTypes->second)[0]; current->setColumnFile(currentName); }
 		}
 		
@@ -335,6 +349,38 @@ int DistanceCommand::execute(){
 	}
 }
 /**************************************************************************************************/
+//lower bound of the eachgap distance between sequences i and j from their shared kmers. every column where they differ
+//changes at most kmerSize of the kmers of each sequence, so there are at least (numKmers - shared) / kmerSize of those
+//columns. with at most min(numBases) matching columns the distance is at least differences / (differences + matches).
+//returns 0 when the bound doesn't apply, because of '.'s between the bases or sequences that don't overlap.
+double kmerDistanceBound(distanceData* params, int i, int j){
+    try {
+        kmerSketch& A = (*params->sketches)[i];
+        kmerSketch& B = (*params->sketches)[j];
+        
+        if (!A.usable || !B.usable) { return 0.0; }
+        if (max(params->alignDB->getFirstBase(i), params->alignDB->getFirstBase(j)) > min(params->alignDB->getLastBase(i), params->alignDB->getLastBase(j))) { return 0.0; }
+        
+        int shared = 0;
+        vector<int>::iterator itA = A.kmers.begin(); vector<int>::iterator itB = B.kmers.begin();
+        while ((itA != A.kmers.end()) && (itB != B.kmers.end())) {
+            if (*itA < *itB)        { itA++; }
+            else if (*itB < *itA)   { itB++; }
+            else                    { shared++; itA++; itB++; }
+        }
+        
+        int lost = max((int)A.kmers.size(), (int)B.kmers.size()) - shared;
+        int differences = (lost + kmerSketchSize - 1) / kmerSketchSize;
+        
+        if (differences <= 0) { return 0.0; }
+        return ((double)differences / (double)(differences + min(A.numBases, B.numBases)));
+    }
+    catch(exception& e) {
+        params->m->errorOut(e, "DistanceCommand", "kmerDistanceBound");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
 void driverColumn(distanceData* params){
     try {
         ValidCalculators validCalculator;
@@ -352,29 +398,38 @@ void driverColumn(distanceData* params){
                 else if (params->Estimator == "onegap")	{	distCalculator = new oneGapIgnoreTermGapDist();		}
             }
         }
+        //only the distances at or below the cutoff are written
+        distCalculator->setCutoff(params->cutoff);
         
         int startTime = time(NULL);
         
         params->count = 0;
         string buffer = "";
+        vector<int> rowColumns; vector<float> rowDists;
         for(int i=params->startLine;i<params->endLine;i++){
             
-            Sequence seqI = params->alignDB.get(i);
+            const char* seqI = params->alignDB->getAligned(i);
+            int alignLength = params->alignDB->getAlignedLength(i);
+            int firstI = params->alignDB->getFirstBase(i); int lastI = params->alignDB->getLastBase(i);
             for(int j=0;j<i;j++){
                 
                 if (params->m->getControl_pressed()) { break;  }
                 
                 if ((i >= params->numNewFasta) && (j >= params->numNewFasta)) { break; }
                 
-                Sequence seqJ = params->alignDB.get(j);
-                double dist = distCalculator->calcDist(seqI, seqJ);
+                if ((params->sketches != NULL) && (kmerDistanceBound(params, i, j) > params->cutoff)) { continue; }
+                
+                double dist = distCalculator->calcDist(seqI, params->alignDB->getAligned(j), alignLength, firstI, lastI, params->alignDB->getFirstBase(j), params->alignDB->getLastBase(j));
                 
                 if(dist <= params->cutoff){
-                    buffer += seqI.getName() + " " + seqJ.getName() + " " + toString(dist) + "\n";
+                    if (params->binary) { rowColumns.push_back(j); rowDists.push_back(dist); }
+                    else { buffer += params->alignDB->getName(i) + " " + params->alignDB->getName(j) + " " + toString(dist) + "\n"; }
                     params->count++;
                 }
             }
             
+            if (params->binary) { BinaryColumnFile::appendRow(buffer, i, rowColumns, rowDists); rowColumns.clear(); rowDists.clear(); }
+            
             if(i % 100 == 0){ params->threadWriter->write(buffer);  buffer = ""; params->m->mothurOutJustToScreen(toString(i) + "\t" + toString(time(NULL) - startTime) + "\t" + toString(params->count) +"\n"); }
             
         }
@@ -407,7 +462,7 @@ void driverLt(distanceData* params){
         }
         
         int startTime = time(NULL);
-        long long numSeqs = params->alignDB.getNumSeqs();
+        long long numSeqs = params->alignDB->getNumSeqs();
         
         //column file
         ofstream outFile;
@@ -421,7 +476,7 @@ void driverLt(distanceData* params){
         params->count = 0;
         for(int i=params->startLine;i<params->endLine;i++){
             
-            string name = params->alignDB.get(i).getName();
+            string name = params->alignDB->getName(i);
             if (name.length() < 10) {  while (name.length() < 10) {  name += " ";  } }
             outFile << name;
             
@@ -431,7 +486,7 @@ void driverLt(distanceData* params){
                 
                 if ((i >= params->numNewFasta) && (j >= params->numNewFasta)) { break; }
                 
-                double dist = distCalculator->calcDist(params->alignDB.get(i), params->alignDB.get(j));
+                double dist = distCalculator->calcDist(params->alignDB->getAligned(i), params->alignDB->getAligned(j), params->alignDB->getAlignedLength(i), params->alignDB->getFirstBase(i), params->alignDB->getLastBase(i), params->alignDB->getFirstBase(j), params->alignDB->getLastBase(j));
                 
                 if(dist <= params->cutoff){ params->count++; }
                 outFile  << '\t' << dist;
@@ -477,13 +532,13 @@ void driverSquare(distanceData* params){
         outFile.setf(ios::fixed, ios::showpoint);
         outFile << setprecision(4);
         
-        long long numSeqs = params->alignDB.getNumSeqs();
+        long long numSeqs = params->alignDB->getNumSeqs();
         if(params->startLine == 0){	outFile << numSeqs << endl;	}
         
         params->count = 0;
         for(int i=params->startLine;i<params->endLine;i++){
             
-            string name = params->alignDB.get(i).getName();
+            string name = params->alignDB->getName(i);
             //pad with spaces to make compatible
             if (name.length() < 10) { while (name.length() < 10) {  name += " ";  } }
             
@@ -493,7 +548,7 @@ void driverSquare(distanceData* params){
                 
                 if (params->m->getControl_pressed()) { break; }
                 
-                double dist = distCalculator->calcDist(params->alignDB.get(i), params->alignDB.get(j));
+                double dist = distCalculator->calcDist(params->alignDB->getAligned(i), params->alignDB->getAligned(j), params->alignDB->getAlignedLength(i), params->alignDB->getFirstBase(i), params->alignDB->getLastBase(i), params->alignDB->getFirstBase(j), params->alignDB->getLastBase(j));
                 
                 if(dist <= params->cutoff){ params->count++; }
                 
@@ -531,22 +586,24 @@ void driverFitCalc(distanceData* params){
                 else if (params->Estimator == "onegap")	{	distCalculator = new oneGapIgnoreTermGapDist();		}
             }
         }
+        distCalculator->setCutoff(params->cutoff);
         
         int startTime = time(NULL);
         params->count = 0;
         string buffer = "";
         for(int i=params->startLine;i<params->endLine;i++){
             
-            Sequence seqI = params->oldFastaDB.get(i);
-            for(int j = 0; j < params->alignDB.getNumSeqs(); j++){
+            const char* seqI = params->oldFastaDB->getAligned(i);
+            int alignLength = params->oldFastaDB->getAlignedLength(i);
+            int firstI = params->oldFastaDB->getFirstBase(i); int lastI = params->oldFastaDB->getLastBase(i);
+            for(int j = 0; j < params->alignDB->getNumSeqs(); j++){
                 
                 if (params->m->getControl_pressed()) { break;  }
                 
-                Sequence seqJ = params->alignDB.get(j);
-                double dist = distCalculator->calcDist(seqI, seqJ);
+                double dist = distCalculator->calcDist(seqI, params->alignDB->getAligned(j), alignLength, firstI, lastI, params->alignDB->getFirstBase(j), params->alignDB->getLastBase(j));
                 
                 if(dist <= params->cutoff){
-                    buffer += seqI.getName() + " " + seqJ.getName() + " " + toString(dist) + "\n";
+                    buffer += params->oldFastaDB->getName(i) + " " + params->alignDB->getName(j) + " " + toString(dist) + "\n";
                     params->count++;
                 }
             }
@@ -595,9 +652,17 @@ void DistanceCommand::createProcesses(string filename) {
             }
         }
         
-        auto synchronizedOutputFile = std::make_shared<SynchronizedOutputFile>(filename);
+        bool columnOutput = ((output == "column") || (output == "binary"));
+        
+        auto synchronizedOutputFile = std::make_shared<SynchronizedOutputFile>(filename, false, (output == "binary"));
         synchronizedOutputFile->setFixedShowPoint(); synchronizedOutputFile->setPrecision(4);
         
+        if (output == "binary") {
+            vector<string> names;
+            for (int i = 0; i < alignDB.getNumSeqs(); i++) { names.push_back(alignDB.getName(i)); }
+            synchronizedOutputFile->write(BinaryColumnFile::getHeader(names));
+        }
+        
         SequenceDB oldFastaDB;
         if (fitCalc) {
             ifstream inFASTA;
@@ -623,15 +688,17 @@ void DistanceCommand::createProcesses(string filename) {
             OutputWriter* threadWriter = NULL;
             distanceData* dataBundle = NULL;
             string extension = toString(i+1) + ".temp";
-            if (output == "column") {
+            if (columnOutput) {
                 threadWriter = new OutputWriter(synchronizedOutputFile);
                 dataBundle = new distanceData(threadWriter);
             }else { dataBundle = new distanceData(filename+extension); }
-            dataBundle->setVariables(lines[i+1].start, lines[i+1].end, cutoff, alignDB, oldFastaDB, Estimators[0], numNewFasta, countends);
+            dataBundle->setVariables(lines[i+1].start, lines[i+1].end, cutoff, &alignDB, &oldFastaDB, Estimators[0], numNewFasta, countends);
+            if (kmerFilter) { dataBundle->sketches = &sketches; }
+            dataBundle->binary = (output == "binary");
             data.push_back(dataBundle);
             
             thread* thisThread = NULL;
-            if (output == "column")     {
+            if (columnOutput)           {
                 if (fitCalc)    { thisThread = new thread(driverFitCalc, dataBundle);   }
                 else            {  thisThread = new thread(driverColumn, dataBundle);   }
             }
@@ -642,13 +709,15 @@ void DistanceCommand::createProcesses(string filename) {
         
         OutputWriter* threadWriter = NULL;
         distanceData* dataBundle = NULL;
-        if (output == "column") {
+        if (columnOutput) {
             threadWriter = new OutputWriter(synchronizedOutputFile);
             dataBundle = new distanceData(threadWriter);
         }else { dataBundle = new distanceData(filename); }
-        dataBundle->setVariables(lines[0].start, lines[0].end, cutoff, alignDB, oldFastaDB, Estimators[0], numNewFasta, countends);
+        dataBundle->setVariables(lines[0].start, lines[0].end, cutoff, &alignDB, &oldFastaDB, Estimators[0], numNewFasta, countends);
+        if (kmerFilter) { dataBundle->sketches = &sketches; }
+        dataBundle->binary = (output == "binary");
         
-        if (output == "column")     {
+        if (columnOutput)           {
             if (fitCalc)    { driverFitCalc(dataBundle);    }
             else            { driverColumn(dataBundle);     }
         }
@@ -661,7 +730,7 @@ void DistanceCommand::createProcesses(string filename) {
             workerThreads[i]->join();
             
             distsBelowCutoff += data[i]->count;
-            if (output == "column") {  delete data[i]->threadWriter; }
+            if (columnOutput) {  delete data[i]->threadWriter; }
             else {
                 string extension = toString(i+1) + ".temp";
                 util.appendFiles((filename+extension), filename);
@@ -670,7 +739,7 @@ void DistanceCommand::createProcesses(string filename) {
             delete data[i];
             delete workerThreads[i];
         }
-        if (output == "column")     { delete threadWriter; }
+        if (columnOutput)           { delete threadWriter; }
         delete dataBundle;
         
         time(&end);
@@ -683,6 +752,34 @@ void DistanceCommand::createProcesses(string filename) {
 	}
 }
 /**************************************************************************************************/
+void DistanceCommand::fillKmerSketches() {
+	try {
+        Kmer kmer(kmerSketchSize);
+        sketches.resize(alignDB.getNumSeqs());
+        
+        for (int i = 0; i < alignDB.getNumSeqs(); i++) {
+            if (m->getControl_pressed()) { break; }
+            
+            const char* aligned = alignDB.getAligned(i);
+            string bases = "";
+            sketches[i].usable = true;
+            for (int j = alignDB.getFirstBase(i); j < alignDB.getLastBase(i); j++) {
+                if (aligned[j] == '.')          { sketches[i].usable = false; break; }
+                else if (aligned[j] != '-')     { bases += aligned[j]; }
+            }
+            if (!sketches[i].usable) { continue; }
+            
+            sketches[i].numBases = bases.length();
+            kmer.getKmerNumbers(bases, sketches[i].kmers);
+            sort(sketches[i].kmers.begin(), sketches[i].kmers.end());
+        }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "DistanceCommand", "fillKmerSketches");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
 //its okay if the column file does not contain all the names in the fasta file, since some distance may have been above a cutoff,
 //but no sequences can be in the column file that are not in oldfasta. also, if a distance is above the cutoff given then remove it.
 //also check to make sure the 2 files have the same alignment length.
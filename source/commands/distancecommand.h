@@ -21,30 +21,46 @@
 #include "onegapdist.h"
 #include "onegapignore.h"
 #include "writer.h"
+#include "kmer.hpp"
+#include "binarycolumn.h"
 
+/**************************************************************************************************/
+//sorted kmers of the bases in a sequence, used by kmerfilter to skip pairs that can't be within the cutoff
+const int kmerSketchSize = 8;
+
+struct kmerSketch {
+    vector<int> kmers;
+    int numBases;
+    bool usable;            //false if the sequence has a '.' between its first and last base
+    
+    kmerSketch() : numBases(0), usable(false) {}
+};
 /**************************************************************************************************/
 struct distanceData {
 	long long startLine, endLine, numNewFasta, count;
 	float cutoff;
-    SequenceDB alignDB;
-    SequenceDB oldFastaDB;
+    SequenceDB* alignDB;        //shared by all the threads, not owned
+    SequenceDB* oldFastaDB;
+    vector<kmerSketch>* sketches;   //NULL unless kmerfilter is on
 	MothurOut* m;
 	OutputWriter* threadWriter;
     string outputFileName, Estimator;
-	bool countends;
+	bool countends, binary;
     Utils util;
 	
-	distanceData(){}
+	distanceData(){ sketches = NULL; binary = false; }
     distanceData(OutputWriter* ofn) {
         threadWriter = ofn;
+        sketches = NULL; binary = false;
         m = MothurOut::getInstance();
     }
     
     distanceData(string ofn) {
         outputFileName = ofn;
+        sketches = NULL; binary = false;
         m = MothurOut::getInstance();
     }
-	void setVariables(int s, int e,  float c, SequenceDB db, SequenceDB oldfn, string Est, long long num, bool cnt) {
+	void setVariables(int s, int e,  float c, SequenceDB* db, SequenceDB* oldfn, string Est, long long num, bool cnt) {
 		startLine = s;
 		endLine = e;
 		cutoff = c;
@@ -80,16 +96,18 @@ public:
 private:
 	
     SequenceDB alignDB;
+    vector<kmerSketch> sketches;
 	string output, fastafile, calc, outputDir, oldfastafile, column, compress;
     int processors;
     long long numNewFasta, numSeqs, numDistsBelowCutoff;
 	float cutoff;
 	
-	bool abort, countends, fitCalc;
+	bool abort, countends, fitCalc, kmerFilter;
 	vector<string>  Estimators, outputNames; //holds estimators to be used
 	
 	void createProcesses(string);
 	bool sanityCheck();
+    void fillKmerSketches();
 };
 
 #endif
@@ -12,6 +12,7 @@
 #include "readphylipvector.h"
 
 #include "designmap.h"
+#include "permutationtest.h"
 
 //**********************************************************************************************************************
 vector<string> HomovaCommand::setParameters(){	
@@ -21,6 +22,7 @@ vector<string> HomovaCommand::setParameters(){
         CommandParameter psets("sets", "String", "", "", "", "", "","",false,false); parameters.push_back(psets);
 		CommandParameter piters("iters", "Number", "", "1000", "", "", "","",false,false); parameters.push_back(piters);
 		CommandParameter palpha("alpha", "Number", "", "0.05", "", "", "","",false,false); parameters.push_back(palpha);
+		CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
 		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
 		CommandParameter poutputdir("outputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(poutputdir);
@@ -40,11 +42,12 @@ string HomovaCommand::getHelpString(){
 		string helpString = "";
 		helpString += "Referenced: Stewart CN, Excoffier L (1996). Assessing population genetic structure and variability with RAPD data: Application to Vaccinium macrocarpon (American Cranberry). J Evol Biol 9: 153-71.\n";
 		helpString += "The homova command outputs a .homova file. \n";
-		helpString += "The homova command parameters are phylip, iters, sets and alpha.  The phylip and design parameters are required, unless valid current files exist.\n";
+		helpString += "The homova command parameters are phylip, iters, sets, processors and alpha.  The phylip and design parameters are required, unless valid current files exist.\n";
 		helpString += "The design parameter allows you to assign your samples to groups when you are running homova. It is required. \n";
 		helpString += "The design file looks like the group file.  It is a 2 column tab delimited file, where the first column is the sample name and the second column is the group the sample belongs to.\n";
         helpString += "The sets parameter allows you to specify which of the sets in your designfile you would like to analyze. The set names are separated by dashes. THe default is all sets in the designfile.\n";
 		helpString += "The iters parameter allows you to set number of randomization for the P value.  The default is 1000. \n";
+		helpString += "The processors parameter allows you to specify the number of processors to use for the randomizations. The default is 1.\n";
 		helpString += "The homova command should be in the following format: homova(phylip=file.dist, design=file.design).\n";
 		return helpString;
 	}
@@ -162,6 +165,9 @@ HomovaCommand::HomovaCommand(string option) {
 			if (temp == "not found") { temp = "0.05"; }
 			util.mothurConvert(temp, experimentwiseAlpha); 
             
+			temp = validParameter.valid(parameters, "processors");	if (temp == "not found"){	temp = current->getProcessors();	}
+			processors = current->setProcessors(temp);
+            
             string sets = validParameter.valid(parameters, "sets");			
 			if (sets == "not found") { sets = ""; }
 			else { 
@@ -237,6 +243,8 @@ int HomovaCommand::execute(){
 		util.openOutputFile(HOMOVAFileName, HOMOVAFile);
 		outputNames.push_back(HOMOVAFileName); outputTypes["homova"].push_back(HOMOVAFileName);
 		
+		permutationTest = new PermutationTest(iters, processors);
+		
 		HOMOVAFile << "HOMOVA\tBValue\tP-value\tSSwithin/(Ni-1)_values" << endl;
 		m->mothurOut("HOMOVA\tBValue\tP-value\tSSwithin/(Ni-1)_values\n");
 		
@@ -269,7 +277,7 @@ int HomovaCommand::execute(){
 		
 		m->mothurOut("If you have borderline P-values, you should try increasing the number of iterations\n");
 		
-		delete designMap;
+		delete designMap; delete permutationTest;
 		
 		m->mothurOut("\nOutput File Names: \n"); 
 		for (int i = 0; i < outputNames.size(); i++) {	m->mothurOut(outputNames[i] +"\n"); 	} m->mothurOutEndLine();
@@ -291,13 +299,8 @@ double HomovaCommand::runHOMOVA(ofstream& HOMOVAFile, map<string, vector<int> >
 		vector<double> ssWithinOrigVector;
 		double bValueOrig = calcBValue(groupSampleMap, ssWithinOrigVector);
 		
-		double counter = 0;
-		for(int i=0;i<iters;i++){
-			vector<double> ssWithinRandVector;
-			map<string, vector<int> > randomizedGroup = getRandomizedGroups(groupSampleMap);
-			double bValueRand = calcBValue(randomizedGroup, ssWithinRandVector);
-			if(bValueRand >= bValueOrig){	counter++;	}
-		}
+		HomovaStatistic bValue(distanceMatrix, groupSampleMap);
+		double counter = permutationTest->getCount(&bValue, bValue.getObserved(), true);
 		
 		double pValue = (double) counter / (double) iters;
 		string pString = "";
@@ -400,35 +403,4 @@ double HomovaCommand::calcBValue(map<string, vector<int> > groupSampleMap, vecto
 }
 //**********************************************************************************************************************
 
-map<string, vector<int> > HomovaCommand::getRandomizedGroups(map<string, vector<int> > origMapping){
-	try{
-		vector<int> sampleIndices;
-		vector<int> samplesPerGroup;
-		
-		for(map<string, vector<int> >::iterator it=origMapping.begin();it!=origMapping.end();it++){
-			vector<int> indices = it->second;
-			samplesPerGroup.push_back(indices.size());
-			sampleIndices.insert(sampleIndices.end(), indices.begin(), indices.end());
-		}
-		
-		util.mothurRandomShuffle(sampleIndices);
-		
-		int index = 0;
-		map<string, vector<int> > randomizedGroups = origMapping;
-		for(map<string, vector<int> >::iterator it=randomizedGroups.begin();it!=randomizedGroups.end();it++){
-			for(int i=0;i<it->second.size();i++){
-				it->second[i] = sampleIndices[index++];				
-			}
-		}
-		
-		return randomizedGroups;		
-	}
-	catch (exception& e) {
-		m->errorOut(e, "AmovaCommand", "randomizeGroups");
-		exit(1);
-	}
-}
-
-//**********************************************************************************************************************
-
 
@@ -14,9 +14,14 @@
 #include "command.hpp"
 
 class DesignMap;
+class PermutationTest;
 
 class HomovaCommand : public Command {
 	
+#ifdef UNIT_TEST
+	friend class TestPermutationTest;
+#endif
+	
 public:
 	HomovaCommand(string);
 	HomovaCommand();
@@ -38,13 +43,13 @@ private:
 	double runHOMOVA(ofstream& , map<string, vector<int> >, double);
 	double calcSigleSSWithin(vector<int>);
 	double calcBValue(map<string, vector<int> >, vector<double>&);
-	map<string, vector<int> > getRandomizedGroups(map<string, vector<int> >);
 
 	bool abort;
 	vector<string> outputNames, Sets;
 	string outputDir, inputDir, designFileName, phylipFileName;
 	vector< vector<double> > distanceMatrix;
-	int iters;
+	PermutationTest* permutationTest;
+	int iters, processors;
 	double experimentwiseAlpha;
 };
 
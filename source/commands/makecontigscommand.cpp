@@ -707,6 +707,66 @@ unsigned long long MakeContigsCommand::processSingleFileOption(string& outFastaF
     }
 }
 /**************************************************************************************************/
+//a forward and reverse read with their index barcodes and quality scores, as read from the gz files
+struct contigsReadPair {
+    Sequence fSeq, rSeq, findexBarcode, rindexBarcode;
+    QualityScores* fQual; QualityScores* rQual;
+    QualityScores* savedFQual; QualityScores* savedRQual;
+    bool ignore;
+
+    contigsReadPair() : findexBarcode("findex", "NONE"), rindexBarcode("rindex", "NONE") {
+        fQual = NULL; rQual = NULL; savedFQual = NULL; savedRQual = NULL;
+        ignore = false;
+    }
+};
+/**************************************************************************************************/
+//decompressing is done by one reader thread, it fills the queue with batches of reads and the workers take them off.
+//the reader waits when there are maxBatches in the queue, so the reads in memory don't grow if the workers are slower.
+struct contigsReadQueue {
+    mutex queueMutex;
+    condition_variable notEmpty, notFull;
+    list< vector<contigsReadPair> > batches;
+    int maxBatches;
+    bool closed;
+
+    contigsReadQueue(int mb) : maxBatches(mb), closed(false) {}
+    ~contigsReadQueue() {
+        for (list< vector<contigsReadPair> >::iterator it = batches.begin(); it != batches.end(); it++) {
+            for (int j = 0; j < it->size(); j++) {
+                delete (*it)[j].fQual; delete (*it)[j].rQual;
+                delete (*it)[j].savedFQual; delete (*it)[j].savedRQual;
+            }
+        }
+    }
+
+    //false if the queue was closed, because the workers quit
+    bool push(vector<contigsReadPair>& batch) {
+        unique_lock<mutex> lock(queueMutex);
+        notFull.wait(lock, [this]{ return (closed || (batches.size() < maxBatches)); });
+        if (closed) { return false; }
+        batches.push_back(vector<contigsReadPair>()); batches.back().swap(batch);
+        notEmpty.notify_one();
+        return true;
+    }
+
+    //false if the queue is closed and empty
+    bool pop(vector<contigsReadPair>& batch) {
+        unique_lock<mutex> lock(queueMutex);
+        notEmpty.wait(lock, [this]{ return (closed || !batches.empty()); });
+        if (batches.empty()) { return false; }
+        batch.swap(batches.front()); batches.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    //called by the reader when it is done, or by a worker that quits
+    void close() {
+        lock_guard<mutex> lock(queueMutex);
+        closed = true;
+        notEmpty.notify_all(); notFull.notify_all();
+    }
+};
+/**************************************************************************************************/
 struct contigsData {
     MothurOut* m;
     Utils util;
@@ -734,9 +794,10 @@ struct contigsData {
     map<string, string> groupMap;
     map<int, oligosPair> pairedBarcodes, reorientedPairedBarcodes;
     map<int, oligosPair> pairedPrimers, reorientedPairedPrimers;
+    contigsReadQueue* readQueue; //gz files only, the reads come from the reader thread
 
 
-    contigsData(){}
+    contigsData(){ readQueue = NULL; }
     contigsData(OutputWriter* tn, OutputWriter* sn, OutputWriter* tqn, OutputWriter* sqn, OutputWriter* mmf) {
         trimFileName = tn;
         scrapFileName = sn;
@@ -745,6 +806,7 @@ struct contigsData {
         misMatchesFile = mmf;
         m = MothurOut::getInstance();
         count = 0;
+        readQueue = NULL;
     }
 
     contigsData(OutputWriter* tn, OutputWriter* sn, OutputWriter* tqn, OutputWriter* sqn, OutputWriter* mmf, vector<string> ifn, vector<string> qif, linePair li, linePair lir, linePair qli, linePair qlir) {
@@ -761,6 +823,7 @@ struct contigsData {
         qlinesInput = qli;
         qlinesInputReverse = qlir;
         count = 0;
+        readQueue = NULL;
     }
     void setVariables(bool isgz, char de, int nt, int offby, map<int, oligosPair> pbr, map<int, oligosPair> ppr, map<int, oligosPair> rpbr, map<int, oligosPair> rppr, vector<string> priNameVector, vector<string> barNameVector, bool ro, int pdf, int bdf, int tdf, string al, float ma, float misMa, float gapO, float gapE, int thr, int delt, double maxe, int km, string form, bool to, bool cfg, string gp) {
         gz = isgz;
@@ -833,14 +896,16 @@ struct groupContigsData {
     map<int, string> file2Groups;
     contigsData* bundle;
     long long count;
+    int processors;
 
     groupContigsData() {}
-    groupContigsData(vector< vector<string> > fi, int s, int e, contigsData* cd, map<int, string> f2g) {
+    groupContigsData(vector< vector<string> > fi, int s, int e, contigsData* cd, map<int, string> f2g, int p) {
         fileInputs = fi;
         start = s;
         end = e;
         bundle = cd;
         file2Groups = f2g;
+        processors = p;
         count = 0;
         m = MothurOut::getInstance();
     }
@@ -1603,21 +1668,13 @@ void driverContigs(contigsData* params){
         if (params->m->getDebug()) {  params->m->mothurOut("[DEBUG]: ffasta = " + thisffastafile + ".\n[DEBUG]: rfasta = " + thisrfastafile + ".\n[DEBUG]: fqualindex = " + thisfqualindexfile + ".\n[DEBUG]: rqualindex = " + thisfqualindexfile + ".\n"); }
 
         ifstream inFFasta, inRFasta, inFQualIndex, inRQualIndex;
-#ifdef USE_BOOST
-        boost::iostreams::filtering_istream inFF, inRF, inFQ, inRQ;
-#endif
         if (!params->gz) { //plain text files
             params->util.openInputFile(thisffastafile, inFFasta);
             params->util.openInputFile(thisrfastafile, inRFasta);
 
             inFFasta.seekg(params->linesInput.start);
             inRFasta.seekg(params->linesInputReverse.start);
-        }else { //compressed files - no need to seekg because compressed files divide workload differently
-#ifdef USE_BOOST
-            params->util.openInputFileBinary(thisffastafile, inFFasta, inFF);
-            params->util.openInputFileBinary(thisrfastafile, inRFasta, inRF);
-#endif
-        }
+        } //compressed files are read by the reader thread, see driverContigsPipeline
 
         ofstream outFasta, outMisMatch, outScrapFasta, outQual, outScrapQual;
         if (thisfqualindexfile != "") {
@@ -1625,22 +1682,14 @@ void driverContigs(contigsData* params){
                 if (!params->gz) { //plain text files
                     params->util.openInputFile(thisfqualindexfile, inFQualIndex);
                     inFQualIndex.seekg(params->qlinesInput.start);
-                }else {
-#ifdef USE_BOOST
-                    params->util.openInputFileBinary(thisfqualindexfile, inFQualIndex, inFQ);
-#endif
-                } //compressed files - no need to seekg because compressed files divide workload differently
+                }
             }
             else {  thisfqualindexfile = ""; }
             if (thisrqualindexfile != "NONE") {
                 if (!params->gz) { //plain text files
                     params->util.openInputFile(thisrqualindexfile, inRQualIndex);
                     inRQualIndex.seekg(params->qlinesInputReverse.start);
-                }else {
-#ifdef USE_BOOST
-                    params->util.openInputFileBinary(thisrqualindexfile, inRQualIndex, inRQ);
-#endif
-                } //compressed files - no need to seekg because compressed files divide workload differently
+                }
             }
             else { thisrqualindexfile = ""; }
         }
@@ -1666,6 +1715,7 @@ void driverContigs(contigsData* params){
         else if(params->align == "needleman")	{	alignment = new NeedlemanOverlap(params->gapOpen, params->match, params->misMatch, longestBase);                        }
         else if(params->align == "kmer")        {   alignment = new KmerAlign(params->kmerSize);                                                                            }
 
+        vector<contigsReadPair> batch; int nextInBatch = 0;
         bool good = true;
         while (good) {
 
@@ -1683,10 +1733,16 @@ void driverContigs(contigsData* params){
             Sequence findexBarcode("findex", "NONE");  Sequence rindexBarcode("rindex", "NONE");
 
             //read from input files
-            if (params->gz) {
-#ifdef USE_BOOST
-                ignore = read(fSeq, rSeq, fQual, rQual, savedFQual, savedRQual, findexBarcode, rindexBarcode, params->delim, inFF, inRF, inFQ, inRQ, thisfqualindexfile, thisrqualindexfile, params->format, params->nameType, params->offByOneTrimLength, params->m);
-#endif
+            if (params->gz) { //take the next read from the reader thread's batches
+                if (nextInBatch == batch.size()) {
+                    if (!params->readQueue->pop(batch)) { break; } //reader is done
+                    nextInBatch = 0;
+                }
+                contigsReadPair& thisPair = batch[nextInBatch]; nextInBatch++;
+                fSeq = thisPair.fSeq; rSeq = thisPair.rSeq;
+                findexBarcode = thisPair.findexBarcode; rindexBarcode = thisPair.rindexBarcode;
+                fQual = thisPair.fQual; rQual = thisPair.rQual; savedFQual = thisPair.savedFQual; savedRQual = thisPair.savedRQual;
+                ignore = thisPair.ignore;
             }else    {
                 ignore = read(fSeq, rSeq, fQual, rQual, savedFQual, savedRQual, findexBarcode, rindexBarcode, params->delim, inFFasta, inRFasta, inFQualIndex, inRQualIndex, thisfqualindexfile, thisrqualindexfile, params->format, params->nameType, params->offByOneTrimLength, params->m);
             }
@@ -1854,22 +1910,15 @@ void driverContigs(contigsData* params){
             }
             params->count++;
 
+            //the reader thread checks for the end of the gz files
 #if defined NON_WINDOWS
             if (!params->gz) {
                 unsigned long long pos = inFFasta.tellg();
                 if ((pos == -1) || (pos >= params->linesInput.end)) { good = false; break; }
-            }else {
-#ifdef USE_BOOST
-                if (inFF.eof() || inRF.eof()) { good = false; break; }
-#endif
             }
 #else
             if (!params->gz) {
                 if (params->count >= params->linesInput.end) { good = false; break; }
-            }else {
-#ifdef USE_BOOST
-                if (inFF.eof() || inRF.eof()) { good = false; break; }
-#endif
             }
 #endif
 
@@ -1880,39 +1929,25 @@ void driverContigs(contigsData* params){
         //report progress
         if((params->count) % 1000 != 0){	params->m->mothurOutJustToScreen(toString(params->count)+"\n"); }
 
+        if (params->gz) {
+            //if you quit early, stop the reader and the other workers. free the reads you didn't get to.
+            params->readQueue->close();
+            for (int i = nextInBatch; i < batch.size(); i++) {
+                delete batch[i].fQual; delete batch[i].rQual; delete batch[i].savedFQual; delete batch[i].savedRQual;
+            }
+        }
+
         //close files
         inFFasta.close();
         inRFasta.close();
-        if (params->gz) {
-#ifdef USE_BOOST
-            inFF.pop(); inRF.pop();
-#endif
-        }
 
         if (params->delim == '@') {
-            if (thisfqualindexfile != "") { inFQualIndex.close();
-                if (params->gz) {
-#ifdef USE_BOOST
-                    inFQ.pop();
-#endif
-                }
-            }
-            if (thisrqualindexfile != "") { inRQualIndex.close();
-                if (params->gz) {
-#ifdef USE_BOOST
-                    inRQ.pop();
-#endif
-                }
-            }
+            if (thisfqualindexfile != "") { inFQualIndex.close(); }
+            if (thisrqualindexfile != "") { inRQualIndex.close(); }
         }else{
             if (hasQuality) {
                 inFQualIndex.close();
                 inRQualIndex.close();
-                if (params->gz) {
-#ifdef USE_BOOST
-                    inFQ.pop(); inRQ.pop();
-#endif
-                }
             }
         }
 
@@ -1926,6 +1961,114 @@ void driverContigs(contigsData* params){
     }
 }
 //**********************************************************************************************************************
+#ifdef USE_BOOST
+//decompresses the gz files and fills the queue with batches of reads until it reaches the end of the files
+void readContigsPairs(contigsData* params, contigsReadQueue* readQueue){
+    try {
+        Utils util; int batchSize = 500;
+        string thisfqualindexfile, thisrqualindexfile, thisffastafile, thisrfastafile;
+        thisfqualindexfile = ""; thisrqualindexfile = "";
+        thisffastafile = params->inputFiles[0]; thisrfastafile = params->inputFiles[1];
+        if (params->qualOrIndexFiles.size() != 0) {
+            thisfqualindexfile = params->qualOrIndexFiles[0];
+            thisrqualindexfile = params->qualOrIndexFiles[1];
+        }
+
+        ifstream inFFasta, inRFasta, inFQualIndex, inRQualIndex;
+        boost::iostreams::filtering_istream inFF, inRF, inFQ, inRQ;
+        util.openInputFileBinary(thisffastafile, inFFasta, inFF);
+        util.openInputFileBinary(thisrfastafile, inRFasta, inRF);
+
+        if (thisfqualindexfile != "") {
+            if (thisfqualindexfile != "NONE")   { util.openInputFileBinary(thisfqualindexfile, inFQualIndex, inFQ); }
+            else                                { thisfqualindexfile = "";                                          }
+            if (thisrqualindexfile != "NONE")   { util.openInputFileBinary(thisrqualindexfile, inRQualIndex, inRQ); }
+            else                                { thisrqualindexfile = "";                                          }
+        }
+
+        bool good = true;
+        while (good) {
+            if (params->m->getControl_pressed()) { break; }
+
+            vector<contigsReadPair> batch(batchSize);
+            int numRead = 0;
+            while (numRead < batchSize) {
+                contigsReadPair& thisPair = batch[numRead]; numRead++;
+                thisPair.ignore = read(thisPair.fSeq, thisPair.rSeq, thisPair.fQual, thisPair.rQual, thisPair.savedFQual, thisPair.savedRQual, thisPair.findexBarcode, thisPair.rindexBarcode, params->delim, inFF, inRF, inFQ, inRQ, thisfqualindexfile, thisrqualindexfile, params->format, params->nameType, params->offByOneTrimLength, params->m);
+
+                if (inFF.eof() || inRF.eof()) { good = false; break; }
+            }
+            batch.resize(numRead);
+
+            if (!readQueue->push(batch)) { //the workers quit
+                for (int i = 0; i < batch.size(); i++) { delete batch[i].fQual; delete batch[i].rQual; delete batch[i].savedFQual; delete batch[i].savedRQual; }
+                break;
+            }
+        }
+        readQueue->close();
+
+        //close files
+        inFFasta.close(); inRFasta.close();
+        inFF.pop(); inRF.pop();
+        if (thisfqualindexfile != "") { inFQualIndex.close(); inFQ.pop(); }
+        if (thisrqualindexfile != "") { inRQualIndex.close(); inRQ.pop(); }
+    }
+    catch(exception& e) {
+        params->m->errorOut(e, "MakeContigsCommand", "readContigsPairs");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+//gz files can't be divided by file position, so one thread reads the file pair and the processors share its reads.
+//params is the main thread's worker, the counts and groups of the other workers are added to it.
+void driverContigsPipeline(contigsData* params, int processors){
+    try {
+        contigsReadQueue readQueue(processors*4);
+        params->readQueue = &readQueue;
+
+        vector<thread*> workerThreads;
+        vector<contigsData*> data;
+
+        //Lauch worker threads - the writers are synchronized, so the workers can share the main thread's
+        for (int i = 0; i < processors-1; i++) {
+            contigsData* dataBundle = new contigsData(params->trimFileName, params->scrapFileName, params->trimQFileName, params->scrapQFileName, params->misMatchesFile, params->inputFiles, params->qualOrIndexFiles, params->linesInput, params->linesInputReverse, params->qlinesInput, params->qlinesInputReverse);
+            dataBundle->copyVariables(params);
+            dataBundle->readQueue = &readQueue;
+            data.push_back(dataBundle);
+
+            workerThreads.push_back(new thread(driverContigs, dataBundle));
+        }
+
+        thread readerThread(readContigsPairs, params, &readQueue);
+
+        driverContigs(params);
+
+        readerThread.join();
+        for (int i = 0; i < processors-1; i++) {
+            workerThreads[i]->join();
+            params->count += data[i]->count;
+
+            params->badNames.insert(data[i]->badNames.begin(), data[i]->badNames.end());
+            params->groupMap.insert(data[i]->groupMap.begin(), data[i]->groupMap.end());
+            //merge counts
+            for (map<string, int>::iterator it = data[i]->groupCounts.begin(); it != data[i]->groupCounts.end(); it++) {
+                map<string, int>::iterator itMine = params->groupCounts.find(it->first);
+                if (itMine != params->groupCounts.end()) { itMine->second += it->second; }
+                else { params->groupCounts[it->first] = it->second; }
+            }
+
+            delete data[i];
+            delete workerThreads[i];
+        }
+        params->readQueue = NULL;
+    }
+    catch(exception& e) {
+        params->m->errorOut(e, "MakeContigsCommand", "driverContigsPipeline");
+        exit(1);
+    }
+}
+#endif
+//**********************************************************************************************************************
 //fileInputs[0] = forward Fasta or Forward Fastq, fileInputs[1] = reverse Fasta or reverse Fastq. if qualOrIndexFiles.size() != 0, then qualOrIndexFiles[0] = forward qual or Forward index, qualOrIndexFiles[1] = reverse qual or reverse index.
 //lines[0] - ffasta, lines[1] - rfasta) - processor1
 //lines[2] - ffasta, lines[3] - rfasta) - processor2
@@ -1942,14 +2085,15 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
         vector<linePair> lines;
         vector<linePair> qLines;
 
+        int numDrivers = processors;
         if (gz)  {
             nameType = setNameType(fileInputs[0], fileInputs[1], delim, offByOneTrimLength,  gz, format);
             for (int i = 0; i < fileInputs.size(); i++) {
-                //fake out lines - we are just going to check for end of file. Work is divided by number of files per processor.
+                //fake out lines - the reader thread checks for end of file and shares the reads with the processors.
                 lines.push_back(linePair(0, 1000));
                 qLines.push_back(linePair(0, 1000));
             }
-            processors = fileInputs.size() / 2;
+            numDrivers = 1; //driverContigsPipeline starts the other processors
         }else        {
             //divides the files so that the processors can share the workload.
             setLines(fileInputs, qualOrIndexFiles, lines, qLines, delim);
@@ -1970,7 +2114,7 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
         auto synchronizedMisMatchFile = std::make_shared<SynchronizedOutputFile>(outputMisMatches);
 
         //Lauch worker threads
-        for (int i = 0; i < processors-1; i++) {
+        for (int i = 0; i < numDrivers-1; i++) {
             OutputWriter* threadFastaTrimWriter = new OutputWriter(synchronizedOutputFastaTrimFile);
             OutputWriter* threadFastaScrapWriter = new OutputWriter(synchronizedOutputFastaScrapFile);
             OutputWriter* threadMismatchWriter = new OutputWriter(synchronizedMisMatchFile);
@@ -2001,7 +2145,11 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
         contigsData* dataBundle = new contigsData(threadFastaTrimWriter, threadFastaScrapWriter, threadQTrimWriter, threadQScrapWriter, threadMisMatchWriter, fileInputs, qualOrIndexFiles, lines[0], lines[1], qLines[0], qLines[1]);
         dataBundle->setVariables(gz, delim, nameType, offByOneTrimLength, pairedBarcodes, pairedPrimers, rpairedBarcodes, rpairedPrimers, primerNames, barcodeNames, reorient, pdiffs, bdiffs, tdiffs, align, match, misMatch, gapOpen, gapExtend, insert, deltaq, maxee, kmerSize, format, trimOverlap, createOligosGroup, group);
 
-        driverContigs(dataBundle);
+        if (gz) {
+#ifdef USE_BOOST
+            driverContigsPipeline(dataBundle, processors);
+#endif
+        }else { driverContigs(dataBundle); }
 
         long long num = dataBundle->count;
         badNames.insert(dataBundle->badNames.begin(), dataBundle->badNames.end());
@@ -2012,7 +2160,7 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
             else { groupCounts[it->first] = it->second; }
         }
 
-        for (int i = 0; i < processors-1; i++) {
+        for (int i = 0; i < numDrivers-1; i++) {
             workerThreads[i]->join();
             num += data[i]->count;
 
@@ -2095,7 +2243,9 @@ void driverContigsGroups(groupContigsData* gparams) {
 
             contigsData* dataBundle = new contigsData(gparams->bundle->trimFileName, gparams->bundle->scrapFileName, gparams->bundle->trimQFileName, gparams->bundle->scrapQFileName, gparams->bundle->misMatchesFile, theseFileInputs, theseQIInputs, thisLines[0], thisLines[1], thisQLines[0], thisQLines[1]);
             dataBundle->copyVariables(gparams->bundle);
-            driverContigs(dataBundle);
+#ifdef USE_BOOST
+            driverContigsPipeline(dataBundle, gparams->processors);
+#endif
 
             gparams->count += dataBundle->count;
             gparams->badNames.insert(dataBundle->badNames.begin(), dataBundle->badNames.end());
@@ -2115,7 +2265,7 @@ void driverContigsGroups(groupContigsData* gparams) {
     }
 }
 //**********************************************************************************************************************
-//only getting here is gz=true
+//only getting here is gz=true. the file pairs are done one at a time, and each one is shared by all the processors
 unsigned long long MakeContigsCommand::createProcessesGroups(vector< vector<string> > fileInputs, string compositeFastaFile, string compositeScrapFastaFile, string compositeQualFile, string compositeScrapQualFile, string compositeMisMatchFile, map<int, string>& file2Groups) {
     try {
         map<int, oligosPair> pairedPrimers, rpairedPrimers, pairedBarcodes, rpairedBarcodes;
@@ -2123,22 +2273,6 @@ unsigned long long MakeContigsCommand::createProcessesGroups(vector< vector<stri
 
         if(oligosfile != "")  {   createOligosGroup = getOligos(pairedPrimers, rpairedPrimers, pairedBarcodes, rpairedBarcodes, barcodeNames, primerNames);    }
 
-        vector<thread*> workerThreads;
-        vector<groupContigsData*> data;
-
-        //divide files between processors
-        vector<linePair> startEndIndexes;
-        int remainingPairs = fileInputs.size();
-        if (remainingPairs < processors) { processors = remainingPairs; }
-        int startIndex = 0;
-        for (int remainingProcessors = processors; remainingProcessors > 0; remainingProcessors--) {
-            int numPairs = remainingPairs; //case for last processor
-            if (remainingProcessors != 1) { numPairs = ceil(remainingPairs / remainingProcessors); }
-            startEndIndexes.push_back(linePair(startIndex, (startIndex+numPairs))); //startIndex, endIndex
-            startIndex = startIndex + numPairs;
-            remainingPairs = remainingPairs - numPairs;
-        }
-
         bool hasQuality = true;
         auto synchronizedOutputFastaTrimFile = std::make_shared<SynchronizedOutputFile>(compositeFastaFile);
         auto synchronizedOutputFastaScrapFile = std::make_shared<SynchronizedOutputFile>(compositeScrapFastaFile);
@@ -2146,26 +2280,6 @@ unsigned long long MakeContigsCommand::createProcessesGroups(vector< vector<stri
         auto synchronizedOutputQScrapFile = std::make_shared<SynchronizedOutputFile>(compositeScrapQualFile);
         auto synchronizedMisMatchFile = std::make_shared<SynchronizedOutputFile>(compositeMisMatchFile);
 
-        //Lauch worker threads
-        for (int i = 0; i < processors-1; i++) {
-            OutputWriter* threadFastaTrimWriter = new OutputWriter(synchronizedOutputFastaTrimFile);
-            OutputWriter* threadFastaScrapWriter = new OutputWriter(synchronizedOutputFastaScrapFile);
-            OutputWriter* threadMismatchWriter = new OutputWriter(synchronizedMisMatchFile);
-            OutputWriter* threadQTrimWriter = NULL;
-            OutputWriter* threadQScrapWriter = NULL;
-            if (hasQuality) {
-                threadQTrimWriter = new OutputWriter(synchronizedOutputQTrimFile);
-                threadQScrapWriter = new OutputWriter(synchronizedOutputQScrapFile);
-            }
-
-            contigsData* dataBundle = new contigsData(threadFastaTrimWriter, threadFastaScrapWriter, threadQTrimWriter, threadQScrapWriter, threadMismatchWriter);
-            dataBundle->setVariables(gz, delim, nameType, offByOneTrimLength, pairedBarcodes, pairedPrimers, rpairedBarcodes, rpairedPrimers, primerNames, barcodeNames, reorient, pdiffs, bdiffs, tdiffs, align, match, misMatch, gapOpen, gapExtend, insert, deltaq, maxee, kmerSize, format, trimOverlap, createOligosGroup, "");
-            groupContigsData* groupDataBundle = new groupContigsData(fileInputs, startEndIndexes[i+1].start, startEndIndexes[i+1].end, dataBundle, file2Groups);
-            data.push_back(groupDataBundle);
-
-            workerThreads.push_back(new thread(driverContigsGroups, groupDataBundle));
-        }
-
         OutputWriter* threadMisMatchWriter = new OutputWriter(synchronizedMisMatchFile);
         OutputWriter* threadFastaTrimWriter = new OutputWriter(synchronizedOutputFastaTrimFile);
         OutputWriter* threadFastaScrapWriter = new OutputWriter(synchronizedOutputFastaScrapFile);
@@ -2177,7 +2291,7 @@ unsigned long long MakeContigsCommand::createProcessesGroups(vector< vector<stri
         }
         contigsData* dataBundle = new contigsData(threadFastaTrimWriter, threadFastaScrapWriter, threadQTrimWriter, threadQScrapWriter, threadMisMatchWriter);
         dataBundle->setVariables(gz, delim, nameType, offByOneTrimLength, pairedBarcodes, pairedPrimers, rpairedBarcodes, rpairedPrimers, primerNames, barcodeNames, reorient, pdiffs, bdiffs, tdiffs, align, match, misMatch, gapOpen, gapExtend, insert, deltaq, maxee, kmerSize, format, trimOverlap, createOligosGroup, "");
-        groupContigsData* groupDataBundle = new groupContigsData(fileInputs, startEndIndexes[0].start, startEndIndexes[0].end, dataBundle, file2Groups);
+        groupContigsData* groupDataBundle = new groupContigsData(fileInputs, 0, fileInputs.size(), dataBundle, file2Groups, processors);
         driverContigsGroups(groupDataBundle);
 
         delete threadFastaTrimWriter;
@@ -2187,40 +2301,16 @@ unsigned long long MakeContigsCommand::createProcessesGroups(vector< vector<stri
             delete threadQTrimWriter;
             delete threadQScrapWriter;
         }
-        long long num = dataBundle->count;
-        badNames.insert(dataBundle->badNames.begin(), dataBundle->badNames.end());
-        groupMap.insert(dataBundle->groupMap.begin(), dataBundle->groupMap.end());
-        for (map<string, int>::iterator it = dataBundle->groupCounts.begin(); it != dataBundle->groupCounts.end(); it++) {
+        long long num = groupDataBundle->count;
+        badNames.insert(groupDataBundle->badNames.begin(), groupDataBundle->badNames.end());
+        groupMap.insert(groupDataBundle->groupMap.begin(), groupDataBundle->groupMap.end());
+        for (map<string, int>::iterator it = groupDataBundle->groupCounts.begin(); it != groupDataBundle->groupCounts.end(); it++) {
             map<string, int>::iterator itMine = groupCounts.find(it->first);
             if (itMine != groupCounts.end()) { itMine->second += it->second; }
             else { groupCounts[it->first] = it->second; }
         }
         delete groupDataBundle;
 
-        for (int i = 0; i < processors-1; i++) {
-            workerThreads[i]->join();
-            num += data[i]->count;
-
-            delete data[i]->bundle->trimFileName;
-            delete data[i]->bundle->scrapFileName;
-            delete data[i]->bundle->misMatchesFile;
-            if (hasQuality) {
-                delete data[i]->bundle->trimQFileName;
-                delete data[i]->bundle->scrapQFileName;
-            }
-            badNames.insert(data[i]->badNames.begin(), data[i]->badNames.end());
-            groupMap.insert(data[i]->groupMap.begin(), data[i]->groupMap.end());
-            //merge counts
-            for (map<string, int>::iterator it = data[i]->groupCounts.begin(); it != data[i]->groupCounts.end(); it++) {
-                map<string, int>::iterator itMine = groupCounts.find(it->first);
-                if (itMine != groupCounts.end()) { itMine->second += it->second; }
-                else { groupCounts[it->first] = it->second; }
-            }
-
-            delete data[i];
-            delete workerThreads[i];
-        }
-
         return num;
     }
     catch(exception& e) {
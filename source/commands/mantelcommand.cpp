@@ -9,6 +9,7 @@
 
 #include "mantelcommand.h"
 #include "readphylipvector.h"
+#include "permutationtest.h"
 
 
 //**********************************************************************************************************************
@@ -17,6 +18,7 @@ vector<string> MantelCommand::setParameters(){
 		CommandParameter pphylip1("phylip1", "InputTypes", "", "", "none", "none", "none","mantel",false,true,true); parameters.push_back(pphylip1);
 		CommandParameter pphylip2("phylip2", "InputTypes", "", "", "none", "none", "none","mantel",false,true,true); parameters.push_back(pphylip2);
 		CommandParameter piters("iters", "Number", "", "1000", "", "", "","",false,false); parameters.push_back(piters);
+		CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
 		CommandParameter pmethod("method", "Multiple", "pearson-spearman-kendall", "pearson", "", "", "","",false,false); parameters.push_back(pmethod);
 		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
@@ -37,9 +39,10 @@ string MantelCommand::getHelpString(){
 		string helpString = "";
 		helpString += "Sokal, R. R., & Rohlf, F. J. (1995). Biometry, 3rd edn. New York: Freeman.\n";
 		helpString += "The mantel command reads two distance matrices and calculates the mantel correlation coefficient.\n";
-		helpString += "The mantel command parameters are phylip1, phylip2, iters and method.  The phylip1 and phylip2 parameters are required.  Matrices must be the same size and contain the same names.\n";
+		helpString += "The mantel command parameters are phylip1, phylip2, iters, processors and method.  The phylip1 and phylip2 parameters are required.  Matrices must be the same size and contain the same names.\n";
 		helpString += "The method parameter allows you to select what method you would like to use. Options are pearson, spearman and kendall. Default=pearson.\n";
 		helpString += "The iters parameter allows you to set number of randomization for the P value.  The default is 1000. \n";
+		helpString += "The processors parameter allows you to specify the number of processors to use for the randomizations. The default is 1.\n";
 		helpString += "The mantel command should be in the following format: mantel(phylip1=veg.dist, phylip2=env.dist).\n";
 		helpString += "The mantel command outputs a .mantel file.\n";
 		return helpString;
@@ -142,6 +145,9 @@ MantelCommand::MantelCommand(string option)  {
 			string temp = validParameter.valid(parameters, "iters");			if (temp == "not found") { temp = "1000"; }
 			util.mothurConvert(temp, iters);
 			
+			temp = validParameter.valid(parameters, "processors");	if (temp == "not found"){	temp = current->getProcessors();	}
+			processors = current->setProcessors(temp);
+			
 			if ((method != "pearson") && (method != "spearman") && (method != "kendall")) { m->mothurOut(method + " is not a valid method. Valid methods are pearson, spearman, and kendall."); m->mothurOutEndLine(); abort = true; }
 		}
 	}
@@ -191,31 +197,12 @@ int MantelCommand::execute(){
 		/***************************************************/
 		
 		//calc mantel coefficient
-		LinearAlgebra linear;
-		double mantel = 0.0;
-		if (method == "pearson")		{  mantel = linear.calcPearson(matrix1, matrix2);	}
-		else if (method == "spearman")	{  mantel = linear.calcSpearman(matrix1, matrix2);	}
-		else if (method == "kendall")	{  mantel = linear.calcKendall(matrix1, matrix2);	}
-		
+		MantelStatistic mantelStatistic(matrix1, matrix2, method);
+		double mantel = mantelStatistic.getObserved();
 		
-		//calc signifigance
-		int count = 0;
-		for (int i = 0; i < iters; i++) {
-			
-			if (m->getControl_pressed()) { return 0; }
-			
-			//randomize matrix2
-			vector< vector<double> > matrix2Copy = matrix2;
-			util.mothurRandomShuffle(matrix2Copy);
-		
-			//calc random mantel
-			double randomMantel = 0.0;
-			if (method == "pearson")		{  randomMantel = linear.calcPearson(matrix1, matrix2Copy);	}
-			else if (method == "spearman")	{  randomMantel = linear.calcSpearman(matrix1, matrix2Copy);	}
-			else if (method == "kendall")	{  randomMantel = linear.calcKendall(matrix1, matrix2Copy);	}
-			
-			if (randomMantel >= mantel) { count++; }
-		}
+		//calc signifigance, randomizes the rows of matrix2
+		PermutationTest permutationTest(iters, processors);
+		int count = permutationTest.getCount(&mantelStatistic, mantel, true);
 		
 		double pValue = count / (float) iters;
 		
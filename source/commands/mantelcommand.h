@@ -35,7 +35,7 @@ private:
 	
 	string phylipfile1, phylipfile2, outputDir, method;
 	bool abort;
-	int iters;
+	int iters, processors;
 	
 	vector<string> outputNames;
 };
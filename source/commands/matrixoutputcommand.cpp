@@ -10,6 +10,9 @@
 #include "matrixoutputcommand.h"
 #include "subsample.h"
 
+//how much of the cache the groups of a tile should take
+static const long long distSharedTileBytes = 256 * 1024;
+
 //**********************************************************************************************************************
 vector<string> MatrixOutputCommand::setParameters(){	
 	try {
@@ -362,193 +365,155 @@ void MatrixOutputCommand::printSims(ostream& out, vector< vector<double> >& simM
     }
 }
 /**************************************************************************************************/
-int driver(vector<SharedRAbundVector*>& thisLookup, vector< vector<seqDist> >& calcDists, vector<Calculator*> matrixCalculators, MothurOut* m) {
-    try {
-        vector<SharedRAbundVector*> subset;
-        
-        for (int k = 0; k < thisLookup.size(); k++) { // pass cdd each set of groups to compare
-            
-            for (int l = 0; l < k; l++) {
-                
-                if (k != l) { //we dont need to similarity of a groups to itself
-                    subset.clear(); //clear out old pair of sharedrabunds
-                    //add new pair of sharedrabunds
-                    subset.push_back(thisLookup[k]); subset.push_back(thisLookup[l]);
-                    
-                    for(int i=0;i<matrixCalculators.size();i++) {
-                        
-                        //if this calc needs all groups to calculate the pair load all groups
-                        if (matrixCalculators[i]->getNeedsAll()) {
-                            //load subset with rest of lookup for those calcs that need everyone to calc for a pair
-                            for (int w = 0; w < thisLookup.size(); w++) {
-                                if ((w != k) && (w != l)) { subset.push_back(thisLookup[w]); }
-                            }
-                        }
-                        
-                        vector<double> tempdata = matrixCalculators[i]->getValues(subset); //saves the calculator outputs
-                        
-                        if (m->getControl_pressed()) { return 1; }
-                        
-                        seqDist temp(l, k, tempdata[0]);
-                        calcDists[i].push_back(temp);
-                    }
-                }
-            }
-        }
-        
-        return 0;
-    }
-    catch(exception& e) {
-        m->errorOut(e, "MatrixOutputCommand", "driver");
-        exit(1);
-    }
-}
-
-/***********************************************************/
-int process(distSharedData* params){
+vector<Calculator*> getMatrixCalculators(vector<string>& Estimators) {
 	try {
         vector<Calculator*> matrixCalculators;
         ValidCalculators validCalculator;
-        for (int i=0; i<params->Estimators.size(); i++) {
-            if (validCalculator.isValidCalculator("matrix", params->Estimators[i]) ) {
-                if (params->Estimators[i] == "sharedsobs") {
+        for (int i=0; i<Estimators.size(); i++) {
+            if (validCalculator.isValidCalculator("matrix", Estimators[i]) ) {
+                if (Estimators[i] == "sharedsobs") {
                     matrixCalculators.push_back(new SharedSobsCS());
-                }else if (params->Estimators[i] == "sharedchao") {
+                }else if (Estimators[i] == "sharedchao") {
                     matrixCalculators.push_back(new SharedChao1());
-                }else if (params->Estimators[i] == "sharedace") {
+                }else if (Estimators[i] == "sharedace") {
                     matrixCalculators.push_back(new SharedAce());
-                }else if (params->Estimators[i] == "jabund") {
+                }else if (Estimators[i] == "jabund") {
                     matrixCalculators.push_back(new JAbund());
-                }else if (params->Estimators[i] == "sorabund") {
+                }else if (Estimators[i] == "sorabund") {
                     matrixCalculators.push_back(new SorAbund());
-                }else if (params->Estimators[i] == "jclass") {
+                }else if (Estimators[i] == "jclass") {
                     matrixCalculators.push_back(new Jclass());
-                }else if (params->Estimators[i] == "sorclass") {
+                }else if (Estimators[i] == "sorclass") {
                     matrixCalculators.push_back(new SorClass());
-                }else if (params->Estimators[i] == "jest") {
+                }else if (Estimators[i] == "jest") {
                     matrixCalculators.push_back(new Jest());
-                }else if (params->Estimators[i] == "sorest") {
+                }else if (Estimators[i] == "sorest") {
                     matrixCalculators.push_back(new SorEst());
-                }else if (params->Estimators[i] == "thetayc") {
+                }else if (Estimators[i] == "thetayc") {
                     matrixCalculators.push_back(new ThetaYC());
-                }else if (params->Estimators[i] == "thetan") {
+                }else if (Estimators[i] == "thetan") {
                     matrixCalculators.push_back(new ThetaN());
-                }else if (params->Estimators[i] == "kstest") {
+                }else if (Estimators[i] == "kstest") {
                     matrixCalculators.push_back(new KSTest());
-                }else if (params->Estimators[i] == "sharednseqs") {
+                }else if (Estimators[i] == "sharednseqs") {
                     matrixCalculators.push_back(new SharedNSeqs());
-                }else if (params->Estimators[i] == "ochiai") {
+                }else if (Estimators[i] == "ochiai") {
                     matrixCalculators.push_back(new Ochiai());
-                }else if (params->Estimators[i] == "anderberg") {
+                }else if (Estimators[i] == "anderberg") {
                     matrixCalculators.push_back(new Anderberg());
-                }else if (params->Estimators[i] == "kulczynski") {
+                }else if (Estimators[i] == "kulczynski") {
                     matrixCalculators.push_back(new Kulczynski());
-                }else if (params->Estimators[i] == "kulczynskicody") {
+                }else if (Estimators[i] == "kulczynskicody") {
                     matrixCalculators.push_back(new KulczynskiCody());
-                }else if (params->Estimators[i] == "lennon") {
+                }else if (Estimators[i] == "lennon") {
                     matrixCalculators.push_back(new Lennon());
-                }else if (params->Estimators[i] == "morisitahorn") {
+                }else if (Estimators[i] == "morisitahorn") {
                     matrixCalculators.push_back(new MorHorn());
-                }else if (params->Estimators[i] == "braycurtis") {
+                }else if (Estimators[i] == "braycurtis") {
                     matrixCalculators.push_back(new BrayCurtis());
-                }else if (params->Estimators[i] == "whittaker") {
+                }else if (Estimators[i] == "whittaker") {
                     matrixCalculators.push_back(new Whittaker());
-                }else if (params->Estimators[i] == "odum") {
+                }else if (Estimators[i] == "odum") {
                     matrixCalculators.push_back(new Odum());
-                }else if (params->Estimators[i] == "canberra") {
+                }else if (Estimators[i] == "canberra") {
                     matrixCalculators.push_back(new Canberra());
-                }else if (params->Estimators[i] == "structeuclidean") {
+                }else if (Estimators[i] == "structeuclidean") {
                     matrixCalculators.push_back(new StructEuclidean());
-                }else if (params->Estimators[i] == "structchord") {
+                }else if (Estimators[i] == "structchord") {
                     matrixCalculators.push_back(new StructChord());
-                }else if (params->Estimators[i] == "hellinger") {
+                }else if (Estimators[i] == "hellinger") {
                     matrixCalculators.push_back(new Hellinger());
-                }else if (params->Estimators[i] == "manhattan") {
+                }else if (Estimators[i] == "manhattan") {
                     matrixCalculators.push_back(new Manhattan());
-                }else if (params->Estimators[i] == "structpearson") {
+                }else if (Estimators[i] == "structpearson") {
                     matrixCalculators.push_back(new StructPearson());
-                }else if (params->Estimators[i] == "soergel") {
+                }else if (Estimators[i] == "soergel") {
                     matrixCalculators.push_back(new Soergel());
-                }else if (params->Estimators[i] == "spearman") {
+                }else if (Estimators[i] == "spearman") {
                     matrixCalculators.push_back(new Spearman());
-                }else if (params->Estimators[i] == "structkulczynski") {
+                }else if (Estimators[i] == "structkulczynski") {
                     matrixCalculators.push_back(new StructKulczynski());
-                }else if (params->Estimators[i] == "speciesprofile") {
+                }else if (Estimators[i] == "speciesprofile") {
                     matrixCalculators.push_back(new SpeciesProfile());
-                }else if (params->Estimators[i] == "hamming") {
+                }else if (Estimators[i] == "hamming") {
                     matrixCalculators.push_back(new Hamming());
-                }else if (params->Estimators[i] == "structchi2") {
+                }else if (Estimators[i] == "structchi2") {
                     matrixCalculators.push_back(new StructChi2());
-                }else if (params->Estimators[i] == "gower") {
+                }else if (Estimators[i] == "gower") {
                     matrixCalculators.push_back(new Gower());
-                }else if (params->Estimators[i] == "memchi2") {
+                }else if (Estimators[i] == "memchi2") {
                     matrixCalculators.push_back(new MemChi2());
-                }else if (params->Estimators[i] == "memchord") {
+                }else if (Estimators[i] == "memchord") {
                     matrixCalculators.push_back(new MemChord());
-                }else if (params->Estimators[i] == "memeuclidean") {
+                }else if (Estimators[i] == "memeuclidean") {
                     matrixCalculators.push_back(new MemEuclidean());
-                }else if (params->Estimators[i] == "mempearson") {
+                }else if (Estimators[i] == "mempearson") {
                     matrixCalculators.push_back(new MemPearson());
-                }else if (params->Estimators[i] == "jsd") {
+                }else if (Estimators[i] == "jsd") {
                     matrixCalculators.push_back(new JSD());
-                }else if (params->Estimators[i] == "rjsd") {
+                }else if (Estimators[i] == "rjsd") {
                     matrixCalculators.push_back(new RJSD());
                 }
             }
         }
         
-        //if the users entered no valid calculators don't execute command
-        if (matrixCalculators.size() == 0) { params->m->mothurOut("No valid calculators."); params->m->mothurOutEndLine();  return 0; }
-        params->Estimators.clear();
-        for (int i=0; i<matrixCalculators.size(); i++) { params->Estimators.push_back(matrixCalculators[i]->getName()); }
+        return matrixCalculators;
+	}
+	catch(exception& e) {
+		MothurOut::getInstance()->errorOut(e, "MatrixOutputCommand", "getMatrixCalculators");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//takes tiles until there are none left and runs every calculator on a pair while its groups are in cache
+int process(distSharedData* params){
+	try {
+        vector<Calculator*> matrixCalculators = getMatrixCalculators(params->Estimators);
+        vector<SharedRAbundVector*> subset;
         
-        vector< vector<seqDist>  > calcDists; calcDists.resize(matrixCalculators.size()); 		
-        SubSample sample;
-        for (int thisIter = 0; thisIter < params->numIters; thisIter++) {
-            
-            SharedRAbundVectors* thisItersLookup = new SharedRAbundVectors(*params->thisLookup);
-            vector<string> namesOfGroups = thisItersLookup->getNamesGroups();
+        distSharedTile tile;
+        while (params->tiles->pop(tile)) {
             
-            if ((params->subsample && (!params->mainThread)) || (params->mainThread && (thisIter != 0) ) ) { sample.getSample(thisItersLookup, params->subsampleSize); }
+            if (params->m->getControl_pressed()) { break; }
             
-            vector<SharedRAbundVector*> thisItersRabunds = thisItersLookup->getSharedRAbundVectors();
-            vector<string> thisItersGroupNames = params->thisLookup->getNamesGroups();
-
-            driver(thisItersRabunds, calcDists, matrixCalculators, params->m);
+            vector<SharedRAbundVector*>& thisLookup = (*params->lookups)[tile.iter];
+            vector<SparseRAbund>& sparseLookup = (*params->sparseLookups)[tile.iter];
+            vector< vector<double> >& calcDists = (*params->dists)[tile.iter];
             
-            for (int i = 0; i < thisItersRabunds.size(); i++) { delete thisItersRabunds[i]; }
-            if ((params->subsample && (!params->mainThread)) || (params->mainThread && (thisIter != 0) ) ){
-                if((thisIter+1) % 100 == 0){	params->m->mothurOutJustToScreen(toString(thisIter+1)+"\n"); 		}
-                params->calcDistsTotals.push_back(calcDists);
-                for (int i = 0; i < calcDists.size(); i++) {
-                    for (int j = 0; j < calcDists[i].size(); j++) {
-                        if (params->m->getDebug()) {  params->m->mothurOut("[DEBUG]: Results: iter = " + toString(thisIter) + ", " + thisItersGroupNames[calcDists[i][j].seq1] + " - " + thisItersGroupNames[calcDists[i][j].seq2] + " distance = " + toString(calcDists[i][j].dist) + ".\n");  }
-                    } 
-                }
-            }else { //print results for whole dataset
-                for (int i = 0; i < calcDists.size(); i++) {
-                    if (params->m->getControl_pressed()) { break; }
+            for (int k = tile.rowStart; k < tile.rowEnd; k++) {
+                
+                for (int l = tile.colStart; (l < tile.colEnd) && (l < k); l++) { //we dont need to similarity of a groups to itself
                     
-                    //initialize matrix
-                    vector< vector<double> > matrix; //square matrix to represent the distance
-                    matrix.resize(thisItersLookup->size());
-                    for (int k = 0; k < thisItersLookup->size(); k++) {  matrix[k].resize(thisItersLookup->size(), 0.0); }
+                    long long index = ((long long)k * (k-1)) / 2 + l;
                     
-                    for (int j = 0; j < calcDists[i].size(); j++) {
-                        int row = calcDists[i][j].seq1;
-                        int column = calcDists[i][j].seq2;
-                        double dist = calcDists[i][j].dist;
+                    for(int i=0;i<matrixCalculators.size();i++) {
+                        
+                        vector<double> tempdata;
+                        if (matrixCalculators[i]->hasSparse() && !matrixCalculators[i]->getNeedsAll()) {
+                            tempdata = matrixCalculators[i]->getValues(&sparseLookup[k], &sparseLookup[l]);
+                        }else {
+                            subset.clear(); //clear out old pair of sharedrabunds
+                            //add new pair of sharedrabunds
+                            subset.push_back(thisLookup[k]); subset.push_back(thisLookup[l]);
+                            
+                            //if this calc needs all groups to calculate the pair load all groups
+                            if (matrixCalculators[i]->getNeedsAll()) {
+                                //load subset with rest of lookup for those calcs that need everyone to calc for a pair
+                                for (int w = 0; w < thisLookup.size(); w++) {
+                                    if ((w != k) && (w != l)) { subset.push_back(thisLookup[w]); }
+                                }
+                            }
+                            
+                            tempdata = matrixCalculators[i]->getValues(subset); //saves the calculator outputs
+                        }
                         
-                        matrix[row][column] = dist;
-                        matrix[column][row] = dist;
+                        calcDists[i][index] = tempdata[0];
                     }
-                    params->matrices.push_back(matrix);
                 }
             }
-            for (int i = 0; i < calcDists.size(); i++) {  calcDists[i].clear(); }
-            delete thisItersLookup;
-		}
-		if((params->numIters) % 100 != 0){	params->m->mothurOutJustToScreen(toString(params->numIters)+"\n"); 		}
+        }
+        
+        for (int i = 0; i < matrixCalculators.size(); i++) { delete matrixCalculators[i]; }
         
 		return 0;
 	}
@@ -558,44 +523,46 @@ int process(distSharedData* params){
 	}
 }
 /***********************************************************/
-int MatrixOutputCommand::createProcesses(SharedRAbundVectors*& thisLookup){
+//the groups of a tile should stay in cache while all of its pairs are run, but there must be enough tiles to keep
+//every processor busy when there are only a few iterations
+int MatrixOutputCommand::getTileSize(vector<SparseRAbund>& sparseLookup, int numBatchIters){
     try {
+        long long numOTUs = 0;
+        for (int k = 0; k < sparseLookup.size(); k++) { numOTUs += sparseLookup[k].otus.size(); }
         
-        vector<string> groupNames = thisLookup->getNamesGroups();
-        
-        vector<int> lines;
-        if (processors > (iters+1)) { processors = iters+1; }
+        long long bytesPerGroup = sizeof(SparseRAbund) + ((2 * sizeof(int) * numOTUs) / sparseLookup.size());
+        int tileSize = max(1LL, distSharedTileBytes / (2 * bytesPerGroup)); //rows and columns
+        tileSize = min(tileSize, numGroups);
         
-        //figure out how many sequences you have to process
-        int numItersPerProcessor = (iters+1) / processors;
-        for (int i = 0; i < processors; i++) {
-            if(i == (processors - 1)){	numItersPerProcessor = (iters+1) - i * numItersPerProcessor; 	}
-            lines.push_back(numItersPerProcessor);
+        while (tileSize > 1) {
+            long long numTileRows = (numGroups + tileSize - 1) / tileSize;
+            if (((numTileRows * (numTileRows + 1)) / 2) * numBatchIters >= (4 * processors)) { break; }
+            tileSize /= 2;
         }
         
-        //create array of worker threads
-        vector<thread*> workerThreads;
-        vector<distSharedData*> data;
+        return tileSize;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "MatrixOutputCommand", "getTileSize");
+        exit(1);
+    }
+}
+/***********************************************************/
+//the iterations are run in batches of processors. the main thread samples a batch, then all the threads take tiles of
+//group pairs from every iteration in the batch, so dist.shared uses all the processors with or without subsampling.
+int MatrixOutputCommand::createProcesses(SharedRAbundVectors*& thisLookup){
+    try {
         
-        //Lauch worker threads
-        for (int i = 0; i < processors-1; i++) {
-            
-            //make copy of lookup so we don't get access violations
-            SharedRAbundVectors* newLookup = new SharedRAbundVectors(*thisLookup);
-            distSharedData* dataBundle = new distSharedData(lines[i+1], false, subsample, subsampleSize, Estimators, newLookup);
-            
-            data.push_back(dataBundle);
-            
-            workerThreads.push_back(new thread(process, dataBundle));
-        }
+        vector<string> groupNames = thisLookup->getNamesGroups();
+        numGroups = thisLookup->size();
+        long long numPairs = ((long long)numGroups * (numGroups-1)) / 2;
         
-        //make copy of lookup so we don't get access violations
-        SharedRAbundVectors* newLookup = new SharedRAbundVectors(*thisLookup);
-        distSharedData* dataBundle = new distSharedData(lines[0], true, subsample, subsampleSize, Estimators, newLookup);
-        process(dataBundle);
-        delete newLookup;
+        vector<Calculator*> matrixCalculators = getMatrixCalculators(Estimators);
         
-        Estimators.clear(); Estimators = dataBundle->Estimators;
+        //if the users entered no valid calculators don't execute command
+        if (matrixCalculators.size() == 0) { m->mothurOut("No valid calculators."); m->mothurOutEndLine();  return 0; }
+        Estimators.clear();
+        for (int i=0; i<matrixCalculators.size(); i++) { Estimators.push_back(matrixCalculators[i]->getName()); delete matrixCalculators[i]; }
         
         map<string, string> variables;
         variables["[filename]"] = outputDir + util.getRootName(util.getSimpleName(sharedfile));
@@ -603,31 +570,118 @@ int MatrixOutputCommand::createProcesses(SharedRAbundVectors*& thisLookup){
         variables["[tag2]"] = "";
         variables["[outputtag]"] = output;
         
-        /// fix to print out matrices for each calc - only main does this
-        for (int i = 0; i < Estimators.size(); i++) {
-            variables["[calc]"] = Estimators[i];
-            string distFileName = getOutputFileName("phylip",variables);
-            outputNames.push_back(distFileName); outputTypes["phylip"].push_back(distFileName);
+        vector< vector< vector<seqDist> > > calcDistsTotals;  //each iter, one for each calc, then each groupCombos dists. this will be used to make .dist files
+        SubSample sample;
+        int numIters = iters+1; //the first iteration is the whole dataset
+        
+        for (int batchStart = 0; batchStart < numIters; batchStart += processors) {
             
-            ofstream outDist; util.openOutputFile(distFileName, outDist);
-            outDist.setf(ios::fixed, ios::floatfield); outDist.setf(ios::showpoint);
+            if (m->getControl_pressed()) { break; }
             
-            printSims(outDist, dataBundle->matrices[i], groupNames); outDist.close();
-        }
-
-        vector< vector< vector<seqDist> > > calcDistsTotals = dataBundle->calcDistsTotals;
-        
-        for (int i = 0; i < processors-1; i++) {
-            workerThreads[i]->join();
+            int batchEnd = min(batchStart + processors, numIters);
+            
+            //sampled by the main thread in order, so the subsamples do not depend on the number of processors
+            vector< vector<SharedRAbundVector*> > lookups;
+            vector< vector<SparseRAbund> > sparseLookups;
+            for (int thisIter = batchStart; thisIter < batchEnd; thisIter++) {
+                SharedRAbundVectors* thisItersLookup = new SharedRAbundVectors(*thisLookup);
+                
+                if (thisIter != 0) { sample.getSample(thisItersLookup, subsampleSize); }
+                
+                lookups.push_back(thisItersLookup->getSharedRAbundVectors());
+                delete thisItersLookup;
+                
+                vector<SparseRAbund> sparseLookup;
+                for (int k = 0; k < lookups.back().size(); k++) { sparseLookup.push_back(SparseRAbund(lookups.back()[k])); }
+                sparseLookups.push_back(sparseLookup);
+            }
+            
+            distSharedTileQueue tiles;
+            int tileSize = getTileSize(sparseLookups[0], lookups.size());
+            for (int b = 0; b < lookups.size(); b++) {
+                for (int rowStart = 0; rowStart < numGroups; rowStart += tileSize) {
+                    for (int colStart = 0; colStart <= rowStart; colStart += tileSize) {
+                        tiles.tiles.push_back(distSharedTile(b, rowStart, min(rowStart+tileSize, numGroups), colStart, min(colStart+tileSize, numGroups)));
+                    }
+                }
+            }
             
-            //get calcDistsTotal info - one entry per iter
-            for (int j = 0; j < data[i]->calcDistsTotals.size(); j++) { calcDistsTotals.push_back(data[i]->calcDistsTotals[j]); }
+            vector< vector< vector<double> > > dists(lookups.size(), vector< vector<double> >(Estimators.size(), vector<double>(numPairs, 0.0)));
             
-            delete data[i]->thisLookup;
-            delete data[i];
-            delete workerThreads[i];
+            //create array of worker threads
+            vector<thread*> workerThreads;
+            vector<distSharedData*> data;
+            
+            //Lauch worker threads
+            for (int i = 0; i < processors-1; i++) {
+                distSharedData* dataBundle = new distSharedData(Estimators, &lookups, &sparseLookups, &dists, &tiles);
+                data.push_back(dataBundle);
+                workerThreads.push_back(new thread(process, dataBundle));
+            }
+            
+            distSharedData* dataBundle = new distSharedData(Estimators, &lookups, &sparseLookups, &dists, &tiles);
+            process(dataBundle);
+            delete dataBundle;
+            
+            for (int i = 0; i < processors-1; i++) {
+                workerThreads[i]->join();
+                delete data[i];
+                delete workerThreads[i];
+            }
+            
+            for (int b = 0; b < lookups.size(); b++) {
+                for (int k = 0; k < lookups[b].size(); k++) { delete lookups[b][k]; }
+            }
+            
+            if (m->getControl_pressed()) { break; }
+            
+            for (int b = 0; b < dists.size(); b++) {
+                int thisIter = batchStart + b;
+                
+                if (thisIter == 0) { //print results for whole dataset
+                    for (int i = 0; i < Estimators.size(); i++) {
+                        //initialize matrix
+                        vector< vector<double> > matrix; //square matrix to represent the distance
+                        matrix.resize(numGroups);
+                        for (int k = 0; k < numGroups; k++) {  matrix[k].resize(numGroups, 0.0); }
+                        
+                        for (int k = 0; k < numGroups; k++) {
+                            for (int l = 0; l < k; l++) {
+                                double dist = dists[b][i][((long long)k * (k-1)) / 2 + l];
+                                matrix[l][k] = dist;
+                                matrix[k][l] = dist;
+                            }
+                        }
+                        
+                        variables["[calc]"] = Estimators[i];
+                        string distFileName = getOutputFileName("phylip",variables);
+                        outputNames.push_back(distFileName); outputTypes["phylip"].push_back(distFileName);
+                        
+                        ofstream outDist; util.openOutputFile(distFileName, outDist);
+                        outDist.setf(ios::fixed, ios::floatfield); outDist.setf(ios::showpoint);
+                        
+                        printSims(outDist, matrix, groupNames); outDist.close();
+                    }
+                }else {
+                    vector< vector<seqDist> > calcDists; calcDists.resize(Estimators.size());
+                    for (int i = 0; i < Estimators.size(); i++) {
+                        for (int k = 0; k < numGroups; k++) {
+                            for (int l = 0; l < k; l++) {
+                                seqDist temp(l, k, dists[b][i][((long long)k * (k-1)) / 2 + l]);
+                                calcDists[i].push_back(temp);
+                                if (m->getDebug()) {  m->mothurOut("[DEBUG]: Results: iter = " + toString(thisIter) + ", " + groupNames[l] + " - " + groupNames[k] + " distance = " + toString(temp.dist) + ".\n");  }
+                            }
+                        }
+                    }
+                    calcDistsTotals.push_back(calcDists);
+                    
+                    if((thisIter) % 100 == 0){	m->mothurOutJustToScreen(toString(thisIter)+"\n"); 		}
+                }
+            }
         }
-        delete dataBundle;
+        if ((iters != 0) && ((iters) % 100 != 0)) {	m->mothurOutJustToScreen(toString(iters)+"\n"); 		}
+        
+        if (m->getControl_pressed()) { return 0; }
     
         //main thread finds averages
         if (iters != 0) {
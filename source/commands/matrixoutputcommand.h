@@ -96,32 +96,54 @@ private:
 	vector<string>  Estimators, Groups, outputNames; //holds estimators to be used
 	
     int createProcesses(SharedRAbundVectors*&);
-	int driver(vector<SharedRAbundVector*>&, vector< vector<seqDist> >&, vector<Calculator*>);
+    int getTileSize(vector<SparseRAbund>&, int);	//groups nonzero OTUs, number of iterations in the batch
     void printSims(ostream&, vector< vector<double> >&, vector<string>);
 
 };
 	
+/**************************************************************************************************/
+//the pairs of groups in rows [rowStart, rowEnd) and columns [colStart, colEnd) of one iteration's lower triangle
+struct distSharedTile {
+    int iter, rowStart, rowEnd, colStart, colEnd;
+    
+    distSharedTile() : iter(0), rowStart(0), rowEnd(0), colStart(0), colEnd(0) {}
+    distSharedTile(int i, int rs, int re, int cs, int ce) : iter(i), rowStart(rs), rowEnd(re), colStart(cs), colEnd(ce) {}
+};
+/**************************************************************************************************/
+//the tiles of a batch of iterations. a thread takes the next tile when it finishes one, so a thread with cheap tiles
+//does more of them and no thread waits while there are tiles left.
+struct distSharedTileQueue {
+    mutex queueMutex;
+    vector<distSharedTile> tiles;
+    int next;
+    
+    distSharedTileQueue() : next(0) {}
+    
+    //false when all the tiles have been taken
+    bool pop(distSharedTile& tile) {
+        lock_guard<mutex> lock(queueMutex);
+        if (next >= tiles.size()) { return false; }
+        tile = tiles[next]; next++;
+        return true;
+    }
+};
 /**************************************************************************************************/
 struct distSharedData {
-    SharedRAbundVectors* thisLookup;
-    vector< vector< vector<seqDist> > > calcDistsTotals;  //each iter, one for each calc, then each groupCombos dists. this will be used to make .dist files
-    vector< vector< vector<double> > > matrices; //for each calculator a square matrix to represent the distances, only filled by main thread
+    vector< vector<SharedRAbundVector*> >* lookups;  //each iteration's groups, shared by the threads
+    vector< vector<SparseRAbund> >* sparseLookups;  //each iteration's groups nonzero OTUs
+    vector< vector< vector<double> > >* dists;  //each iteration, each calc, the lower triangle. pair k,l (l < k) is at k*(k-1)/2+l
+    distSharedTileQueue* tiles;
     vector<string>  Estimators;
-    long long numIters;
 	MothurOut* m;
-    int count, subsampleSize;
-    bool mainThread, subsample;
 	
 	distSharedData(){}
-	distSharedData(long long st, bool mt, bool su, int subsize, vector<string> est, SharedRAbundVectors* lu) {
+	distSharedData(vector<string> est, vector< vector<SharedRAbundVector*> >* lu, vector< vector<SparseRAbund> >* slu, vector< vector< vector<double> > >* d, distSharedTileQueue* t) {
         m = MothurOut::getInstance();
-		numIters = st;
         Estimators = est;
-        thisLookup = lu;
-        count = 0;
-        mainThread = mt;
-        subsample = su;
-        subsampleSize = subsize;
+        lookups = lu;
+        sparseLookups = slu;
+        dists = d;
+        tiles = t;
 	}
 };
 /**************************************************************************************************/
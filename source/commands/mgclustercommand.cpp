@@ -646,7 +646,7 @@ int MGClusterCommand::runMothurCluster(){
             
             previousDist = dist;
             rndPreviousDist = rndDist;
-            oldList = *list;
+            cluster->updateOld(NULL, &oldList);
             Seq2Bin = cluster->getSeqtoBin();
             oldSeq2Bin = Seq2Bin;
         }
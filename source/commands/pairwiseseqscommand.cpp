@@ -13,7 +13,7 @@
 vector<string> PairwiseSeqsCommand::setParameters(){	
 	try {
 		CommandParameter pfasta("fasta", "InputTypes", "", "", "none", "none", "none","phylip-column",false,true,true); parameters.push_back(pfasta);
-		CommandParameter palign("align", "Multiple", "needleman-gotoh-blast-noalign", "needleman", "", "", "","",false,false); parameters.push_back(palign);
+		CommandParameter palign("align", "Multiple", "needleman-gotoh-banded-blast-noalign", "needleman", "", "", "","",false,false); parameters.push_back(palign);
 		CommandParameter pmatch("match", "Number", "", "1.0", "", "", "","",false,false); parameters.push_back(pmatch);
 		CommandParameter pmismatch("mismatch", "Number", "", "-1.0", "", "", "","",false,false); parameters.push_back(pmismatch);
 		CommandParameter pgapopen("gapopen", "Number", "", "-2.0", "", "", "","",false,false); parameters.push_back(pgapopen);
@@ -44,7 +44,7 @@ string PairwiseSeqsCommand::getHelpString(){
 		helpString += "The pairwise.seqs command reads a fasta file and creates distance matrix.\n";
 		helpString += "The pairwise.seqs command parameters are fasta, align, match, mismatch, gapopen, gapextend, calc, output, cutoff and processors.\n";
 		helpString += "The fasta parameter is required. You may enter multiple fasta files by separating their names with dashes. ie. fasta=abrecovery.fasta-amzon.fasta \n";
-		helpString += "The align parameter allows you to specify the alignment method to use.  Your options are: gotoh, needleman, blast and noalign. The default is needleman.\n";
+		helpString += "The align parameter allows you to specify the alignment method to use.  Your options are: gotoh, needleman, banded, blast and noalign. The banded option uses the gotoh scoring over a band of the alignment matrix around the diagonal shared by the most 8mers, which is much faster and uses less memory for long sequences. The default is needleman.\n";
 		helpString += "The match parameter allows you to specify the bonus for having the same base. The default is 1.0.\n";
 		helpString += "The mistmatch parameter allows you to specify the penalty for having different bases.  The default is -1.0.\n";
 		helpString += "The gapopen parameter allows you to specify the penalty for opening a gap in an alignment. The default is -2.0.\n";
@@ -353,6 +353,7 @@ int driverColumn(pairwiseData* params){
         
         Alignment* alignment;
         if(params->align == "gotoh")			{	alignment = new GotohOverlap(params->gapOpen, params->gapExtend, params->match, params->misMatch, params->longestBase);			}
+        else if(params->align == "banded")		{	alignment = new BandedOverlap(params->gapOpen, params->gapExtend, params->match, params->misMatch, params->longestBase);			}
         else if(params->align == "needleman")	{	alignment = new NeedlemanOverlap(params->gapOpen, params->match, params->misMatch, params->longestBase);				}
         else if(params->align == "blast")		{	alignment = new BlastAlignment(params->gapOpen, params->gapExtend, params->match, params->misMatch);		}
         else if(params->align == "noalign")		{	alignment = new NoAlign();													}
@@ -422,6 +423,7 @@ int driverLt(pairwiseData* params){
         
         Alignment* alignment;
         if(params->align == "gotoh")			{	alignment = new GotohOverlap(params->gapOpen, params->gapExtend, params->match, params->misMatch, params->longestBase);			}
+        else if(params->align == "banded")		{	alignment = new BandedOverlap(params->gapOpen, params->gapExtend, params->match, params->misMatch, params->longestBase);			}
         else if(params->align == "needleman")	{	alignment = new NeedlemanOverlap(params->gapOpen, params->match, params->misMatch, params->longestBase);				}
         else if(params->align == "blast")		{	alignment = new BlastAlignment(params->gapOpen, params->gapExtend, params->match, params->misMatch);		}
         else if(params->align == "noalign")		{	alignment = new NoAlign();													}
@@ -509,6 +511,7 @@ int driverSquare(pairwiseData* params){
         
         Alignment* alignment;
         if(params->align == "gotoh")			{	alignment = new GotohOverlap(params->gapOpen, params->gapExtend, params->match, params->misMatch, params->longestBase);			}
+        else if(params->align == "banded")		{	alignment = new BandedOverlap(params->gapOpen, params->gapExtend, params->match, params->misMatch, params->longestBase);			}
         else if(params->align == "needleman")	{	alignment = new NeedlemanOverlap(params->gapOpen, params->match, params->misMatch, params->longestBase);				}
         else if(params->align == "blast")		{	alignment = new BlastAlignment(params->gapOpen, params->gapExtend, params->match, params->misMatch);		}
         else if(params->align == "noalign")		{	alignment = new NoAlign();													}
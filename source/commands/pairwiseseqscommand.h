@@ -20,6 +20,7 @@
 #include "sequence.hpp"
 
 #include "gotohoverlap.hpp"
+#include "bandedoverlap.hpp"
 #include "needlemanoverlap.hpp"
 #include "blastalign.hpp"
 #include "noalign.hpp"
@@ -17,6 +17,8 @@ vector<string> PCACommand::setParameters(){
 		CommandParameter prelabund("relabund", "InputTypes", "", "", "LRSS", "LRSS", "none","pca-loadings",false,false,true); parameters.push_back(prelabund);
 		CommandParameter pgroups("groups", "String", "", "", "", "", "","",false,false); parameters.push_back(pgroups);
 		CommandParameter pmetric("metric", "Boolean", "", "T", "", "", "","",false,false); parameters.push_back(pmetric);
+		CommandParameter paxes("axes", "Number", "", "0", "", "", "","",false,false); parameters.push_back(paxes);
+		CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
 		CommandParameter plabel("label", "String", "", "", "", "", "","",false,false); parameters.push_back(plabel);
 		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
@@ -35,10 +37,12 @@ vector<string> PCACommand::setParameters(){
 string PCACommand::getHelpString(){	
 	try {
 		string helpString = "";
-		helpString += "The pca command parameters are shared, relabund, label, groups and metric.  shared or relabund is required unless you have a valid current file."; 
+		helpString += "The pca command parameters are shared, relabund, label, groups, metric, axes and processors.  shared or relabund is required unless you have a valid current file."; 
 		helpString += "The label parameter is used to analyze specific labels in your input. Default is the first label in your shared or relabund file. Multiple labels may be separated by dashes.\n";
 		helpString += "The groups parameter allows you to specify which groups you would like analyzed. Groupnames are separated by dashes.\n";
 		helpString += "The metric parameter allows you to indicate if would like the pearson correlation coefficient calculated. Default=True";
+		helpString += "The axes parameter allows you to set the number of axes to find. Only the largest axes are found, which is much faster when there are many OTUs or samples. Default=0, meaning all axes.\n";
+		helpString += "The processors parameter allows you to specify the number of processors to use when axes is set. Default=1.\n";
 		helpString += "Example pca(groups=yourGroups).\n";
 		helpString += "Example pca(groups=A-B-C).\n";
 		
@@ -168,6 +172,12 @@ PCACommand::PCACommand(string option)  {
 			string temp = validParameter.valid(parameters, "metric");	if (temp == "not found"){	temp = "T";				}
 			metric = util.isTrue(temp); 
 			
+			temp = validParameter.valid(parameters, "axes");	if (temp == "not found"){	temp = "0";				}
+			util.mothurConvert(temp, axes);
+			
+			temp = validParameter.valid(parameters, "processors");	if (temp == "not found"){	temp = current->getProcessors();	}
+			processors = current->setProcessors(temp);
+			
 			label = validParameter.valid(parameters, "label");			
 			if (label == "not found") { label = ""; if(labels.size() == 0) {  m->mothurOut("You did not provide a label, I will use the first label in your inputfile."); m->mothurOutEndLine(); } }
 			else { util.splitAtDash(label, labels); }
@@ -356,36 +366,45 @@ int PCACommand::process(SharedRAbundFloatVectors*& lookupFloat){
 		}
 
 		
-		vector< vector<double> > transpose(numOTUs);
-		for (int i = 0; i < numOTUs; i++) {
-			transpose[i].resize(numSamples, 0);
-			
-			for (int j = 0; j < numSamples; j++) {
-				transpose[i][j] = centered[j][i];
+		vector<vector<double> > X;
+		vector<double> d;
+		double dsum = 0.0000;
+		
+		if ((axes > 0) && (axes < min(numSamples, numOTUs))) {
+			dsum = findAxes(centered, X, d);
+		}else {
+			vector< vector<double> > transpose(numOTUs);
+			for (int i = 0; i < numOTUs; i++) {
+				transpose[i].resize(numSamples, 0);
+				
+				for (int j = 0; j < numSamples; j++) {
+					transpose[i][j] = centered[j][i];
+				}
 			}
-		}
 
-		vector<vector<double> > crossProduct = linearCalc.matrix_mult(transpose, centered);	
-		
-		vector<double> d;
-		vector<double> e;
+			vector<vector<double> > crossProduct = linearCalc.matrix_mult(transpose, centered);	
+			
+			vector<double> e;
 
-		linearCalc.tred2(crossProduct, d, e);		if (m->getControl_pressed()) { return 0; }
-		linearCalc.qtli(d, e, crossProduct);		if (m->getControl_pressed()) { return 0; }
-		
-		vector<vector<double> > X = linearCalc.matrix_mult(centered, crossProduct);
+			linearCalc.tred2(crossProduct, d, e);		if (m->getControl_pressed()) { return 0; }
+			linearCalc.qtli(d, e, crossProduct);		if (m->getControl_pressed()) { return 0; }
+			
+			X = linearCalc.matrix_mult(centered, crossProduct);
+			
+			for(int i=0;i<d.size();i++){ dsum += d[i]; }
+		}
 		
 		if (m->getControl_pressed()) { return 0; }
 		
 		string fbase = outputDir + util.getRootName(util.getSimpleName(inputFile));
 		//string outputFileName = fbase + lookupFloat[0]->getLabel();
-		output(fbase, lookupFloat->getLabel(), Groups, X, d);
+		output(fbase, lookupFloat->getLabel(), Groups, X, d, dsum);
 		
 		if (metric) {   
 			
 			vector<vector<double> > observedEuclideanDistance = linearCalc.getObservedEuclideanDistance(centered);
 			
-			for (int i = 1; i < 4; i++) {
+			for (int i = 1; i < min(4, (int)d.size()+1); i++) {
 				
 				vector< vector<double> > PCAEuclidDists = linearCalc.calculateEuclidianDistance(X, i); //G is the pca file
 				
@@ -408,14 +427,10 @@ int PCACommand::process(SharedRAbundFloatVectors*& lookupFloat){
 }
 /*********************************************************************************************************************************/
 
-void PCACommand::output(string fbase, string label, vector<string> name_list, vector<vector<double> >& G, vector<double> d) {
+void PCACommand::output(string fbase, string label, vector<string> name_list, vector<vector<double> >& G, vector<double> d, double dsum) {
 	try {
 
 		int numEigenValues = d.size();
-		double dsum = 0.0000;
-		for(int i=0;i<numEigenValues;i++){
-			dsum += d[i];
-		}
 		
 		ofstream pcaData;
         map<string, string> variables; 
@@ -459,5 +474,37 @@ void PCACommand::output(string fbase, string label, vector<string> name_list, ve
 	}
 }
 /*********************************************************************************************************************************/
-
-
+//the largest axes from the samples by samples matrix XX', without forming it or the OTUs by OTUs matrix X'X. They have the
+//same nonzero eigenvalues, and the scores X times the eigenvectors of X'X are the eigenvectors of XX' times the square roots.
+double PCACommand::findAxes(vector<vector<double> >& centered, vector<vector<double> >& X, vector<double>& d) {
+	try {
+		int numSamples = centered.size();
+		int numOTUs = centered[0].size();
+		
+		RowMajorMatrix data(numSamples, numOTUs);
+		double sum = 0.0;
+		for (int i = 0; i < numSamples; i++) {
+			double* row = data.row(i);
+			for (int j = 0; j < numOTUs; j++) { row[j] = centered[i][j]; sum += row[j] * row[j]; }
+		}
+		
+		GramOperator gram(data, processors);
+		double smallest = 0.0;
+		linearCalc.lanczos(gram, axes, d, X, smallest, false);
+		
+		for (int i = 0; i < numSamples; i++) {
+			for (int j = 0; j < d.size(); j++) {
+				if (d[j] > 0) { X[i][j] *= sqrt(d[j]); }
+				else { X[i][j] = 0.0; }
+			}
+		}
+		
+		//the sum of all the eigenvalues is the trace of X'X
+		return sum;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "PCACommand", "findAxes");
+		exit(1);
+	}
+}
+/*********************************************************************************************************************************/
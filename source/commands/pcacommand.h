@@ -39,6 +39,7 @@ public:
 private:
 
 	bool abort, metric;
+	int axes, processors;
 	string outputDir, mode, inputFile, label, groups, sharedfile, relabundfile;
 	vector<string> outputNames, Groups;
 	set<string> labels;
@@ -46,7 +47,8 @@ private:
 	
 	//vector< vector<double> > createMatrix(vector<SharedRAbundFloatVector*>);
 	int process(SharedRAbundFloatVectors*&);
-	void output(string, string, vector<string>, vector<vector<double> >&, vector<double>);
+	void output(string, string, vector<string>, vector<vector<double> >&, vector<double>, double);
+	double findAxes(vector<vector<double> >&, vector<vector<double> >&, vector<double>&); //centered relative abundances, scores, eigenvalues. returns the sum of all the eigenvalues
 	
 };
 
@@ -17,6 +17,8 @@ vector<string> PCOACommand::setParameters(){
 	try {
 		CommandParameter pphylip("phylip", "InputTypes", "", "", "none", "none", "none","pcoa-loadings",false,true,true); parameters.push_back(pphylip);
 		CommandParameter pmetric("metric", "Boolean", "", "T", "", "", "","",false,false); parameters.push_back(pmetric);
+		CommandParameter paxes("axes", "Number", "", "0", "", "", "","",false,false); parameters.push_back(paxes);
+		CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
 		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
 		CommandParameter poutputdir("outputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(poutputdir);
@@ -34,9 +36,11 @@ vector<string> PCOACommand::setParameters(){
 string PCOACommand::getHelpString(){	
 	try {
 		string helpString = "";
-		helpString += "The pcoa command parameters are phylip and metric"; 
+		helpString += "The pcoa command parameters are phylip, metric, axes and processors"; 
 		helpString += "The phylip parameter allows you to enter your distance file.";
 		helpString += "The metric parameter allows indicate you if would like the pearson correlation coefficient calculated. Default=True"; 
+		helpString += "The axes parameter allows you to set the number of axes to find. Only the largest axes are found, which is much faster for large matrices. Default=0, meaning all axes.\n";
+		helpString += "The processors parameter allows you to specify the number of processors to use when axes is set. Default=1.\n";
 		helpString += "Example pcoa(phylip=yourDistanceFile).\n";
 		return helpString;
 	}
@@ -139,6 +143,12 @@ PCOACommand::PCOACommand(string option)  {
 			
 			string temp = validParameter.valid(parameters, "metric");	if (temp == "not found"){	temp = "T";				}
 			metric = util.isTrue(temp); 
+			
+			temp = validParameter.valid(parameters, "axes");	if (temp == "not found"){	temp = "0";				}
+			util.mothurConvert(temp, axes);
+			
+			temp = validParameter.valid(parameters, "processors");	if (temp == "not found"){	temp = current->getProcessors();	}
+			processors = current->setProcessors(temp);
 		}
 
 	}
@@ -168,31 +178,39 @@ int PCOACommand::execute(){
 		
 		if (m->getControl_pressed()) { return 0; }
    	
-		double offset = 0.0000;
 		vector<double> d;
-		vector<double> e;
-		vector<vector<double> > G = D;
-		//vector<vector<double> > copy_G;
+		vector<vector<double> > G;
+		double dsum = 0.0000;
 				
 		m->mothurOut("\nProcessing...\n");
 		
-		for(int count=0;count<2;count++){
-			linearCalc.recenter(offset, D, G);		if (m->getControl_pressed()) { return 0; }
-			linearCalc.tred2(G, d, e);				if (m->getControl_pressed()) { return 0; }
-			linearCalc.qtli(d, e, G);				if (m->getControl_pressed()) { return 0; }
-			offset = d[d.size()-1];
-			if(offset > 0.0) break;
-		} 
+		if ((axes > 0) && (axes < D.size())) {
+			dsum = findAxes(D, G, d);
+		}else {
+			double offset = 0.0000;
+			vector<double> e;
+			G = D;
+			
+			for(int count=0;count<2;count++){
+				linearCalc.recenter(offset, D, G);		if (m->getControl_pressed()) { return 0; }
+				linearCalc.tred2(G, d, e);				if (m->getControl_pressed()) { return 0; }
+				linearCalc.qtli(d, e, G);				if (m->getControl_pressed()) { return 0; }
+				offset = d[d.size()-1];
+				if(offset > 0.0) break;
+			} 
+			
+			for(int i=0;i<d.size();i++){ dsum += d[i]; }
+		}
 		
 		if (m->getControl_pressed()) { return 0; }
 		
-		output(fbase, names, G, d);
+		output(fbase, names, G, d, dsum);
 		
 		if (m->getControl_pressed()) { for (int i = 0; i < outputNames.size(); i++) {	util.mothurRemove(outputNames[i]);  } return 0; }
 		
 		if (metric) {   
 			
-			for (int i = 1; i < 4; i++) {
+			for (int i = 1; i < min(4, (int)d.size()+1); i++) {
 							
 				vector< vector<double> > EuclidDists = linearCalc.calculateEuclidianDistance(G, i); //G is the pcoa file
 				
@@ -231,13 +249,12 @@ void PCOACommand::get_comment(istream& f, char begin, char end){
 }	
 /*********************************************************************************************************************************/
 
-void PCOACommand::output(string fnameRoot, vector<string> name_list, vector<vector<double> >& G, vector<double> d) {
+void PCOACommand::output(string fnameRoot, vector<string> name_list, vector<vector<double> >& G, vector<double> d, double dsum) {
 	try {
 		int rank = name_list.size();
-		double dsum = 0.0000;
+		int numAxes = d.size();
 		for(int i=0;i<rank;i++){
-			dsum += d[i];
-			for(int j=0;j<rank;j++){
+			for(int j=0;j<numAxes;j++){
 				if(d[j] >= 0)	{	G[i][j] *= pow(d[j],0.5);	}
 				else			{	G[i][j] = 0.00000;			}
 			}
@@ -262,19 +279,19 @@ void PCOACommand::output(string fnameRoot, vector<string> name_list, vector<vect
 		outputTypes["loadings"].push_back(loadingsFile);	
 		
 		pcaLoadings << "axis\tloading\n";
-		for(int i=0;i<rank;i++){
+		for(int i=0;i<numAxes;i++){
 			pcaLoadings << i+1 << '\t' << d[i] * 100.0 / dsum << endl;
 		}
 		
 		pcaData << "group";
-		for(int i=0;i<rank;i++){
+		for(int i=0;i<numAxes;i++){
 			pcaData << '\t' << "axis" << i+1;
 		}
 		pcaData << endl;
 		
 		for(int i=0;i<rank;i++){
 			pcaData << name_list[i];
-			for(int j=0;j<rank;j++){
+			for(int j=0;j<numAxes;j++){
 				pcaData  << '\t' << G[i][j];
 			}
 			pcaData << endl;
@@ -287,4 +304,40 @@ void PCOACommand::output(string fnameRoot, vector<string> name_list, vector<vect
 }
 
 /*********************************************************************************************************************************/
+//the largest axes of the double centered matrix, without forming it. The full solver above repeats the decomposition with
+//offset = the smallest eigenvalue when it is not positive. That adds offset to the distances, and since C(11')C = 0 it
+//only subtracts offset from the eigenvalues of the centered eigenvectors, so here it is applied to the eigenvalues found.
+double PCOACommand::findAxes(vector<vector<double> >& D, vector<vector<double> >& G, vector<double>& d) {
+	try {
+		int rank = D.size();
+		
+		RowMajorMatrix A(rank, rank);
+		double sum = 0.0;
+		for(int i=0;i<rank;i++){
+			double* row = A.row(i);
+			for(int j=0;j<rank;j++){
+				if (i != j) { row[j] = -0.5 * D[i][j] * D[i][j]; sum += row[j]; }
+			}
+		}
+		
+		//the distances are only needed again for the correlations
+		if (!metric) { vector<vector<double> > empty; D.swap(empty); }
+		
+		DoubleCenteredOperator centered(A, processors);
+		double smallest = 0.0;
+		linearCalc.lanczos(centered, axes, d, G, smallest, true);
+		
+		double offset = 0.0;
+		if (smallest <= 0.0) { offset = smallest; }
+		for(int i=0;i<d.size();i++){ d[i] -= offset; }
+		
+		//the sum of all the eigenvalues is the trace of C(A + offset(11' - I))C
+		return ((-sum / (double) rank) - (offset * (rank - 1)));
+	}
+	catch(exception& e) {
+		m->errorOut(e, "PCOACommand", "findAxes");
+		exit(1);
+	}
+}
+/*********************************************************************************************************************************/
 
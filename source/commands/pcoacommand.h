@@ -37,12 +37,14 @@ public:
 private:
 
 	bool abort, metric;
+	int axes, processors;
 	string phylipfile, filename, fbase, outputDir;
 	vector<string> outputNames;
 	LinearAlgebra linearCalc;
 	
 	void get_comment(istream&, char, char);
-	void output(string, vector<string>, vector<vector<double> >&, vector<double>);
+	void output(string, vector<string>, vector<vector<double> >&, vector<double>, double);
+	double findAxes(vector<vector<double> >&, vector<vector<double> >&, vector<double>&); //distances, axes, eigenvalues. returns the sum of all the eigenvalues
 	
 };
 	
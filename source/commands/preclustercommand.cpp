@@ -392,6 +392,14 @@ int calcMisMatches(string seq1, string seq2, preClusterData* params){
     }
 }
 /**************************************************************************************************/
+//the seqs after seq i that could be within diffs of it, everyone after it if there is no index
+void getCandidates(PreClusterIndex* index, int i, long long numSeqs, vector<int>& candidates){
+    if (index != NULL) { index->getCandidates(i, candidates); return; }
+    
+    candidates.clear();
+    for (int j = i+1; j < numSeqs; j++) { candidates.push_back(j); }
+}
+/**************************************************************************************************/
 int process(string group, string newMapFile, preClusterData* params){
     try {
         ofstream out;
@@ -400,6 +408,19 @@ int process(string group, string newMapFile, preClusterData* params){
         int count = 0;
         long long numSeqs = params->alignSeqs.size();
         
+        //only the seqs that share a piece with you can be within diffs, so find those instead of trying everyone.
+        //blast alignments can leave out the ends of the seqs and noalign doesn't align them, so they still try everyone.
+        PreClusterIndex* index = NULL;
+        if ((params->method == "aligned") || ((params->align != "blast") && (params->align != "noalign"))) {
+            vector<string> indexSeqs;
+            for (int i = 0; i < numSeqs; i++) {
+                if (params->method == "unaligned") { indexSeqs.push_back(params->alignSeqs[i]->seq.getUnaligned()); }
+                else { indexSeqs.push_back(params->alignSeqs[i]->filteredSeq); }
+            }
+            index = new PreClusterIndex(indexSeqs, params->diffs, (params->method == "aligned"));
+        }
+        vector<int> candidates;
+        
         if (params->topdown) {
             //think about running through twice...
             for (int i = 0; i < numSeqs; i++) {
@@ -409,9 +430,11 @@ int process(string group, string newMapFile, preClusterData* params){
                     string chunk = params->alignSeqs[i]->seq.getName() + "\t" + toString(params->alignSeqs[i]->numIdentical) + "\t" + toString(0) + "\t" + params->alignSeqs[i]->seq.getAligned() + "\n";
                     
                     //try to merge it with all smaller seqs
-                    for (int j = i+1; j < numSeqs; j++) {
+                    getCandidates(index, i, numSeqs, candidates);
+                    for (int c = 0; c < candidates.size(); c++) {
+                        int j = candidates[c];
                         
-                        if (params->m->getControl_pressed()) { out.close(); return 0; }
+                        if (params->m->getControl_pressed()) { out.close(); if (index != NULL) { delete index; } return 0; }
                         
                         if (params->alignSeqs[j]->active) {  //this sequence has not been merged yet
                             //are you within "diff" bases
@@ -452,9 +475,11 @@ int process(string group, string newMapFile, preClusterData* params){
             for (int i = 0; i < numSeqs; i++) {
                 
                 //try to merge it into larger seqs
-                for (int j = i+1; j < numSeqs; j++) {
+                getCandidates(index, i, numSeqs, candidates);
+                for (int c = 0; c < candidates.size(); c++) {
+                    int j = candidates[c];
                     
-                    if (params->m->getControl_pressed()) { out.close(); return 0; }
+                    if (params->m->getControl_pressed()) { out.close(); if (index != NULL) { delete index; } return 0; }
                     
                     if (originalCount[j] > originalCount[i]) {  //this sequence is more abundant than I am
                         //are you within "diff" bases
@@ -472,7 +497,7 @@ int process(string group, string newMapFile, preClusterData* params){
                             originalCount.erase(i);
                             mapFile[i] = "";
                             count++;
-                            j+=numSeqs; //exit search, we merged this one in.
+                            break; //exit search, we merged this one in.
                         }
                     }//end abundance check
                 }//end for loop j
@@ -488,6 +513,7 @@ int process(string group, string newMapFile, preClusterData* params){
             
         }
         out.close();
+        if (index != NULL) { delete index; }
         
         if(numSeqs % 100 != 0)	{ params->m->mothurOut(group + toString(numSeqs) + "\t" + toString(numSeqs - count) + "\t" + toString(count) + "\n"); 	}
         
@@ -21,11 +21,13 @@ vector<string> SharedCommand::setParameters(){
 	try {
         CommandParameter pbiom("biom", "InputTypes", "", "", "BiomListGroup", "BiomListGroup", "none","shared",false,false); parameters.push_back(pbiom);
 		CommandParameter plist("list", "InputTypes", "", "", "BiomListGroup", "BiomListGroup", "ListGroup","shared",false,false,true); parameters.push_back(plist);
+        CommandParameter pshared("shared", "InputTypes", "", "", "BiomListGroup", "BiomListGroup", "none","shared",false,false); parameters.push_back(pshared);
         CommandParameter pcount("count", "InputTypes", "", "", "none", "GroupCount", "none","",false,false); parameters.push_back(pcount);
 		CommandParameter pgroup("group", "InputTypes", "", "", "none", "GroupCount", "ListGroup","",false,false,true); parameters.push_back(pgroup);
 		//CommandParameter pordergroup("ordergroup", "InputTypes", "", "", "none", "none", "none",false,false); parameters.push_back(pordergroup);
 		CommandParameter plabel("label", "String", "", "", "", "", "","",false,false); parameters.push_back(plabel);
 		CommandParameter pgroups("groups", "String", "", "", "", "", "","group",false,false); parameters.push_back(pgroups);
+        CommandParameter psparse("sparse", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(psparse);
 		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
 		CommandParameter poutputdir("outputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(poutputdir);
@@ -44,7 +46,9 @@ string SharedCommand::getHelpString(){
 	try {
 		string helpString = "";
 		helpString += "The make.shared command reads a list and group file or a biom file and creates a shared file. If a list and group are provided a rabund file is created for each group.\n";
-		helpString += "The make.shared command parameters are list, group, biom, groups, count and label. list and group or count are required unless a current file is available or you provide a biom file.\n";
+		helpString += "The make.shared command parameters are list, group, biom, shared, groups, count, sparse and label. list and group or count are required unless a current file is available or you provide a biom or shared file.\n";
+        helpString += "The shared parameter allows you to convert a shared file between the text and sparse formats.\n";
+        helpString += "The sparse parameter allows you to write the shared file in a binary format that only stores the nonzero abundances. The sparse file is smaller and faster to read, and can be used wherever a shared file is. If you provide a sparse shared file with sparse=f, it is converted to a text shared file. Default=f.\n";
         helpString += "The count parameter allows you to provide a count file containing the group info for the list file.\n";
 		helpString += "The groups parameter allows you to indicate which groups you want to include, group names should be separated by dashes. ex. groups=A-B-C. Default is all groups in your groupfile.\n";
 		helpString += "The label parameter is only valid with the list and group option and allows you to indicate which labels you want to include, label names should be separated by dashes. Default is all labels in your list file.\n";
@@ -145,6 +149,14 @@ SharedCommand::SharedCommand(string option)  {
 					 if (path == "") {	parameters["count"] = inputDir + it->second;		}
 				 }
 
+                 it = parameters.find("shared");
+				 //user has given a template file
+				 if(it != parameters.end()){
+					 path = util.hasPath(it->second);
+					 //if the user has not given a path then, add inputdir. else leave path alone.
+					 if (path == "") {	parameters["shared"] = inputDir + it->second;		}
+				 }
+
                  it = parameters.find("biom");
 				 //user has given a template file
 				 if(it != parameters.end()){
@@ -174,6 +186,10 @@ SharedCommand::SharedCommand(string option)  {
              else if (biomfile == "not found") { biomfile = "";  }
              else { current->setBiomFile(biomfile); }
 
+             sharedfile = validParameter.validFile(parameters, "shared");
+             if (sharedfile == "not open") { sharedfile = ""; abort = true; }
+             else if (sharedfile == "not found") { sharedfile = "";  }
+
 			 ordergroupfile = validParameter.validFile(parameters, "ordergroup");
 			 if (ordergroupfile == "not open") { abort = true; }
 			 else if (ordergroupfile == "not found") { ordergroupfile = ""; }
@@ -192,7 +208,7 @@ SharedCommand::SharedCommand(string option)  {
                  if (!temp.testGroups(countfile)) { m->mothurOut("[ERROR]: Your count file does not have group info, aborting."); m->mothurOutEndLine(); abort=true; }
              }
 
-            if ((biomfile == "") && (listfile == "")) {
+            if ((biomfile == "") && (listfile == "") && (sharedfile == "")) {
 				//is there are current file available for either of these?
 				//give priority to list, then biom
 				listfile = current->getListFile();
@@ -206,7 +222,7 @@ SharedCommand::SharedCommand(string option)  {
 					}
 				}
 			}
-			else if ((biomfile != "") && (listfile != "")) { m->mothurOut("When executing a make.shared command you must enter ONLY ONE of the following: list or biom."); m->mothurOutEndLine(); abort = true; }
+			else if (((biomfile != "") + (listfile != "") + (sharedfile != "")) > 1) { m->mothurOut("When executing a make.shared command you must enter ONLY ONE of the following: list, biom or shared."); m->mothurOutEndLine(); abort = true; }
 
 			if (listfile != "") {
 				if ((groupfile == "") && (countfile == "")) {
@@ -240,6 +256,9 @@ SharedCommand::SharedCommand(string option)  {
 				 if(label != "all") {  util.splitAtDash(label, labels);  allLines = 0;  }
 				 else { allLines = 1;  }
 			 }
+
+            string temp = validParameter.valid(parameters, "sparse");		if (temp == "not found"){	temp = "F";	}
+            sparse = util.isTrue(temp);
 		}
 
 	}
@@ -255,8 +274,21 @@ int SharedCommand::execute(){
 
 		if (abort) { if (calledHelp) { return 0; }  return 2;	}
 
-        if (listfile != "") {  createSharedFromListGroup();  }
-        else {   createSharedFromBiom();  }
+        if (sharedfile != "") {  convertShared();  }
+        else {
+            if (listfile != "") {  createSharedFromListGroup();  }
+            else {   createSharedFromBiom();  }
+
+            //replace the text shared files with sparse ones. the labels and groups were already selected when they were written
+            if (sparse && !m->getControl_pressed()) {
+                for (int i = 0; i < outputTypes["shared"].size(); i++) {
+                    string filename = outputTypes["shared"][i];
+                    writeSharedFile(filename, filename + ".temp", true, false);
+                    util.mothurRemove(filename);
+                    util.renameFile(filename + ".temp", filename);
+                }
+            }
+        }
 
         if (m->getControl_pressed()) {
 			for (int i = 0; i < outputNames.size(); i++) {
@@ -962,6 +994,71 @@ int SharedCommand::createSharedFromListGroup() {
 	}
 }
 //**********************************************************************************************************************
+int SharedCommand::convertShared() {
+	try {
+        SparseSharedFile sparseFile;
+        bool inputSparse = sparseFile.isSparse(sharedfile);
+
+        if (inputSparse == sparse) {
+            if (sparse) { m->mothurOut(sharedfile + " is already a sparse shared file, nothing to do.\n"); }
+            else { m->mothurOut(sharedfile + " is already a text shared file, set sparse=t to convert it to a sparse shared file.\n"); }
+            return 0;
+        }
+
+        if (outputDir == "") { outputDir += util.hasPath(sharedfile); }
+
+        map<string, string> variables;
+        variables["[filename]"] = outputDir + util.getRootName(util.getSimpleName(sharedfile));
+        if (sparse) { variables["[filename]"] += "sparse."; }
+        else { variables["[filename]"] += "text."; }
+        string filename = getOutputFileName("shared",variables);
+        outputNames.push_back(filename); outputTypes["shared"].push_back(filename);
+
+        writeSharedFile(sharedfile, filename, sparse, true);
+
+        return 0;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SharedCommand", "convertShared");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+//reads a text or sparse shared file and writes it in the sparse or text format, keeping only the labels and groups requested if filter is set
+int SharedCommand::writeSharedFile(string inputFile, string outputFile, bool toSparse, bool filter) {
+	try {
+        vector<string> allGroups;
+        InputData input(inputFile, "sharedfile", filter ? Groups : allGroups);
+        SparseSharedFile sparseFile;
+        ofstream out;
+
+        if (toSparse) { sparseFile.openOutput(outputFile); }
+        else { util.openOutputFile(outputFile, out); }
+
+        SharedRAbundVectors* lookup = input.getSharedRAbundVectors();
+        while (lookup != NULL) {
+            if (m->getControl_pressed()) { delete lookup; break; }
+
+            if (!filter || (allLines == 1) || (labels.count(lookup->getLabel()) == 1)) {
+                if (toSparse) { sparseFile.write(lookup); }
+                else { printSharedData(lookup, out); }
+            }
+
+            delete lookup;
+            lookup = input.getSharedRAbundVectors();
+        }
+
+        if (toSparse) { sparseFile.closeOutput(); }
+        else { out.close(); }
+
+        return 0;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SharedCommand", "writeSharedFile");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
 void SharedCommand::printSharedData(SharedRAbundVectors*& thislookup, ofstream& out) {
 	try {
 
@@ -12,6 +12,7 @@
 #include "command.hpp"
 #include "sharedlistvector.h"
 #include "inputdata.h"
+#include "sparsesharedfile.h"
 
 /* The shared() command:
 	The shared command can only be executed after a successful read.shared command.  
@@ -46,6 +47,8 @@ private:
 	int ListGroupSameSeqs(vector<string>&, SharedListVector*);
     int createSharedFromListGroup();
     int createSharedFromBiom();
+    int convertShared();
+    int writeSharedFile(string, string, bool, bool); //input file, output file, write sparse, apply the label and groups parameters
     string getTag(string&);
     vector<string> readRows(string, int&);
     int getDims(string, int&, int&);
@@ -53,8 +56,8 @@ private:
 	
 	vector<string> Groups, outputNames, order;
 	set<string> labels;
-	string fileroot, outputDir, listfile, groupfile, biomfile, ordergroupfile, countfile;
-	bool firsttime, pickedGroups, abort, allLines;
+	string fileroot, outputDir, listfile, groupfile, biomfile, ordergroupfile, countfile, sharedfile;
+	bool firsttime, pickedGroups, abort, allLines, sparse;
 
 };
 
@@ -649,6 +649,11 @@ void driverSummaryShared(summarySharedData* params) {
         params->util.openOutputFile(params->sumFile, outputFileHandle);
         
         vector<SharedRAbundVector*> subset;
+        
+        //each group's nonzero OTUs, found once for all the pairs it is in
+        vector<SparseRAbund> sparseLookup;
+        for (int k = 0; k < params->end; k++) { sparseLookup.push_back(SparseRAbund(params->thisLookup[k])); }
+        
         for (int k = params->start; k < params->end; k++) { // pass cdd each set of groups to compare
             
             if (params->m->getControl_pressed()) { break; }
@@ -678,7 +683,12 @@ void driverSummaryShared(summarySharedData* params) {
                         }
                     }
                     
-                    vector<double> tempdata = sumCalculators[i]->getValues(subset); //saves the calculator outputs
+                    vector<double> tempdata;
+                    if (sumCalculators[i]->hasSparse() && !sumCalculators[i]->getNeedsAll()) {
+                        tempdata = sumCalculators[i]->getValues(&sparseLookup[k], &sparseLookup[l]);
+                    }else {
+                        tempdata = sumCalculators[i]->getValues(subset); //saves the calculator outputs
+                    }
                     
                     if (params->m->getControl_pressed()) { break; }
                     
@@ -607,6 +607,9 @@ int UnifracWeightedCommand::runRandomCalcs(Tree* thisTree, CountTable* ct, vecto
         for (int f = 0; f < numComp; f++) { randomTreeNodes.push_back(thisTree->getNodes(namesOfGroupCombos[f])); }
         vector<vector<int> > savedRandomTreeNodes = randomTreeNodes;
         
+        //the random trees only swap labels, so they all use the same flat tree
+        UnifracTree flatTree(thisTree, Groups);
+        
         //get scores for random trees
         vector<vector<double> > rScores; rScores.resize(numComp);
         for (int i = 0; i < iters; i++) {
@@ -615,7 +618,7 @@ int UnifracWeightedCommand::runRandomCalcs(Tree* thisTree, CountTable* ct, vecto
             
             for (int f = 0; f < numComp; f++) {   util.mothurRandomShuffle(randomTreeNodes[f]);   }
             
-            vector<double> thisItersRScores = createProcesses(thisTree, ct, namesOfGroupCombos, randomTreeNodes);
+            vector<double> thisItersRScores = createProcesses(&flatTree, namesOfGroupCombos, randomTreeNodes);
             
             for (int f = 0; f < numComp; f++) {   rScores[f].push_back(thisItersRScores[f]);  }
             
@@ -663,66 +666,45 @@ int UnifracWeightedCommand::runRandomCalcs(Tree* thisTree, CountTable* ct, vecto
 struct weightedRandomData {
     bool includeRoot;
     int count, numComps, start, num;
-    vector<string> Groups, Treenames;
     vector<double> scores;
     vector< vector<string> > namesOfGroupCombos;
     vector<vector<int> > randomizedTreeNodes;
     MothurOut* m;
-    Tree* t;
-    CountTable* ct;
-    Utils util;
+    UnifracTree* flatTree;
     
     weightedRandomData(){}
-    weightedRandomData(int st, int en, vector< vector<string> > ngc, Tree* tree, CountTable* count, bool ir, vector<string> g, vector<vector<int> > randomTreeNodes) {
+    weightedRandomData(int st, int en, vector< vector<string> > ngc, UnifracTree* tree, bool ir, vector<vector<int> >& randomTreeNodes) {
         m = MothurOut::getInstance();
         num = en;
         start = st;
         namesOfGroupCombos = ngc;
         numComps = namesOfGroupCombos.size();
         randomizedTreeNodes = randomTreeNodes;
-        t = tree;
-        ct = count;
+        flatTree = tree;
         includeRoot = ir;
-        Groups = g;
-        Treenames = t->getTreeNames();
         count = 0;
     }
 };
 /**************************************************************************************************/
 void driverWeightedRandom(weightedRandomData* params) {
     try {
-        Weighted weighted(params->includeRoot, params->Groups);
-        
         params->count = 0;
         
-        Tree* randT = new Tree(params->ct, params->Treenames);
-
         for (int h = params->start; h < (params->start+params->num); h++) {
             
             if (params->m->getControl_pressed()) { break; }
             
-            string groupA = params->namesOfGroupCombos[h][0];
-            string groupB = params->namesOfGroupCombos[h][1];
-            vector<int> treeNodesFromTheseGroups = params->randomizedTreeNodes[h];
-                       
-            //copy T[i]'s info.
-            randT->getCopy(params->t);
-            
-            //create a random tree with same topology as T[i], but different labels
-            randT->assembleRandomUnifracTree(params->randomizedTreeNodes[h]);
+            int groupA = params->flatTree->getGroupIndex(params->namesOfGroupCombos[h][0]);
+            int groupB = params->flatTree->getGroupIndex(params->namesOfGroupCombos[h][1]);
             
-            if (params->m->getControl_pressed()) { break; }
-            
-            //get wscore of random tree
-            EstOutput randomData = weighted.getValues(randT, groupA, groupB);
+            //score a tree with the same topology as T[i], but with the labels of these groups swapped
+            double randomData = params->flatTree->getWeighted(groupA, groupB, params->includeRoot, params->randomizedTreeNodes[h]);
             
             if (params->m->getControl_pressed()) { break; }
             
             //save scores
-            params->scores.push_back(randomData[0]);
+            params->scores.push_back(randomData);
         }
-        
-        delete randT;
     }
     catch(exception& e) {
         params->m->errorOut(e, "UnifracWeightedCommand", "driver");
@@ -730,7 +712,7 @@ void driverWeightedRandom(weightedRandomData* params) {
     }
 }
 /**************************************************************************************************/
-vector<double> UnifracWeightedCommand::createProcesses(Tree* t, CountTable* ct, vector< vector<string> > namesOfGroupCombos, vector<vector<int> >& randomizedTreeNodes) {
+vector<double> UnifracWeightedCommand::createProcesses(UnifracTree* flatTree, vector< vector<string> > namesOfGroupCombos, vector<vector<int> >& randomizedTreeNodes) {
 	try {
         //breakdown work between processors
         vector<linePair> lines;
@@ -748,20 +730,14 @@ vector<double> UnifracWeightedCommand::createProcesses(Tree* t, CountTable* ct,
         vector<thread*> workerThreads;
         vector<weightedRandomData*> data;
         
-        //Lauch worker threads
+        //Lauch worker threads, they share the flat tree
         for (int i = 0; i < processors-1; i++) {
-            CountTable* copyCount = new CountTable();
-            copyCount->copy(ct);
-            vector<string> Treenames = t->getTreeNames();
-            Tree* copyTree = new Tree(copyCount, Treenames);
-            copyTree->getCopy(t);
-            
-            weightedRandomData* dataBundle = new weightedRandomData(lines[i+1].start, lines[i+1].end, namesOfGroupCombos, copyTree, copyCount, includeRoot, Groups, randomizedTreeNodes);
+            weightedRandomData* dataBundle = new weightedRandomData(lines[i+1].start, lines[i+1].end, namesOfGroupCombos, flatTree, includeRoot, randomizedTreeNodes);
             data.push_back(dataBundle);
             workerThreads.push_back(new thread(driverWeightedRandom, dataBundle));
         }
         
-        weightedRandomData* dataBundle = new weightedRandomData(lines[0].start, lines[0].end, namesOfGroupCombos, t, ct, includeRoot, Groups, randomizedTreeNodes);
+        weightedRandomData* dataBundle = new weightedRandomData(lines[0].start, lines[0].end, namesOfGroupCombos, flatTree, includeRoot, randomizedTreeNodes);
         driverWeightedRandom(dataBundle);
         vector<double> scores = dataBundle->scores;
         
@@ -771,7 +747,7 @@ vector<double> UnifracWeightedCommand::createProcesses(Tree* t, CountTable* ct,
             
             scores.insert(scores.end(), data[i]->scores.begin(), data[i]->scores.end());
             
-            delete data[i]->t; delete data[i]->ct; delete data[i]; delete workerThreads[i];
+            delete data[i]; delete workerThreads[i];
         }
         delete dataBundle;
         return scores;
@@ -109,7 +109,18 @@ void Alignment::traceBack(){			//	This traceback routine is used by the dynamic
 			}
 		}
 		
-       
+        finishTraceBack();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Alignment", "traceBack");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//	Once seqAaln, seqBaln and the base maps are filled in by the traceback, this sets the start and end positions
+//	of each sequence and the pairwise length
+void Alignment::finishTraceBack(){
+	try {
         pairwiseLength = seqAaln.length();
 		seqAstart = 1;	seqAend = 0;
 		seqBstart = 1;	seqBend = 0;
@@ -146,7 +157,7 @@ void Alignment::traceBack(){			//	This traceback routine is used by the dynamic
 		seqBend = seqB.length() - seqBend - 1;
 	}
 	catch(exception& e) {
-		m->errorOut(e, "Alignment", "traceBack");
+		m->errorOut(e, "Alignment", "finishTraceBack");
 		exit(1);
 	}
 }
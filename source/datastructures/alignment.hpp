@@ -41,12 +41,13 @@ public:
 	int getTemplateEndPos();
 	
 	int getPairwiseLength();
-	void resize(int);
+	virtual void resize(int);
 	int getnRows() { return nRows; }
 //	int getLongestTemplateGap();
 
 protected:
 	void traceBack();
+	void finishTraceBack();
 	string seqA, seqAaln;
 	string seqB, seqBaln;
 	int seqAstart, seqAend;
@@ -148,9 +148,15 @@ AlignmentDB::~AlignmentDB() {  delete search;	}
 /**************************************************************************************************/
 Sequence AlignmentDB::findClosestSequence(Sequence* seq, float& searchScore) {
 	try{
-        lock_guard<std::mutex> guard(mutex);
         vector<float> scores;
-		vector<int> spot = search->findClosestSequences(seq, 1, scores);
+        vector<int> spot;
+        
+        //kmer searches keep their scratch space per thread, so they don't need the lock
+        if (method == "kmer") { spot = search->findClosestSequences(seq, 1, scores); }
+        else {
+            lock_guard<std::mutex> guard(mutex);
+            spot = search->findClosestSequences(seq, 1, scores);
+        }
 	
         if (spot.size() != 0)	{	searchScore = scores[0]; return templateSequences[spot[0]];	}
         else					{ 	searchScore = 0; return emptySequence;                      }
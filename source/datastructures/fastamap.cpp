@@ -16,11 +16,8 @@ void FastaMap::readFastaFile(string inFileName) {
 	try {
 		ifstream in;
 		util.openInputFile(inFileName, in);
-		string name, sequence, line;
+		string name, sequence;
 		sequence = "";
-		string temp;
-		map<string, string>::iterator itName;
-		
 		
 		while(!in.eof()){
 			if (m->getControl_pressed()) { break; }
@@ -32,19 +29,12 @@ void FastaMap::readFastaFile(string inFileName) {
 				if(currSeq.getIsAligned())	{	sequence = currSeq.getAligned();	}
 				else						{	sequence = currSeq.getUnaligned();	}
 				
-				itName = seqmap.find(name);
-				if (itName == seqmap.end()) { seqmap[name] = sequence;  }
-				else { m->mothurOut("You already have a sequence named " + name + ", sequence names must be unique, please correct."); m->mothurOutEndLine(); }
+				int seqIndex = addSequence(sequence);
+				
+				int nameIndex = setName(name, seqIndex, false);
+				if (nameIndex == -1) { m->mothurOut("You already have a sequence named " + name + ", sequence names must be unique, please correct."); m->mothurOutEndLine(); nameIndex = names.find(name); }
 				
-				map<string,group>::iterator it = data.find(sequence);
-				if (it == data.end()) { 	//it's unique.
-					data[sequence].groupname = name;  //group name will be the name of the first duplicate sequence found.
-					//				data[sequence].groupnumber = 1;
-					data[sequence].names = name;
-				}else { // its a duplicate.
-					data[sequence].names += "," + name;
-					//				data[sequence].groupnumber++;
-				}	
+				addEntry(seqIndex, nameIndex); //group name will be the name of the first duplicate sequence found.
 			}
 			util.gobble(in);
 		}
@@ -89,20 +79,13 @@ void FastaMap::readFastaFile(string inFastaFile, string oldNameFileName){ //prin
 			if(currSeq.getIsAligned())	{	sequence = currSeq.getAligned();	}
 			else						{	sequence = currSeq.getUnaligned();	}
 			
-			itName = seqmap.find(name);
-			if (itName == seqmap.end()) { seqmap[name] = sequence;  }
-			else { m->mothurOut("You already have a sequence named " + name + ", sequence names must be unique, please correct."); m->mothurOutEndLine(); }
+			int seqIndex = addSequence(sequence);
 			
-			seqmap[name] = sequence;  
-			map<string,group>::iterator it = data.find(sequence);
-			if (it == data.end()) { 	//it's unique.
-				data[sequence].groupname = name;  //group name will be the name of the first duplicate sequence found.
-				//			data[sequence].groupnumber = 1;
-				data[sequence].names = oldNameMap[name];
-			}else { // its a duplicate.
-				data[sequence].names += "," + oldNameMap[name];
-				//			data[sequence].groupnumber++;
-			}	
+			int nameIndex = setName(name, seqIndex, false);
+			if (nameIndex == -1) { m->mothurOut("You already have a sequence named " + name + ", sequence names must be unique, please correct."); m->mothurOutEndLine(); nameIndex = setName(name, seqIndex, true); }
+			
+			int entry = addEntry(seqIndex, nameIndex); //group name will be the name of the first duplicate sequence found.
+			entryNameLists[entry] = oldNameMap[name];
 		}
 		util.gobble(inFASTA);
 	}
@@ -114,22 +97,37 @@ void FastaMap::readFastaFile(string inFastaFile, string oldNameFileName){ //prin
 /*******************************************************************************/
 
 string FastaMap::getGroupName(string seq) {  //pass a sequence name get its group
-	return data[seq].groupname;
+	int seqIndex = seqs.find(seq);
+	if (seqIndex == -1) { return ""; }
+	
+	return names.get(entryNames[firstEntries[seqIndex]]);
 }
 
 /*******************************************************************************/
 
 string FastaMap::getNames(string seq) {	//pass a sequence get the string of names in the group separated by ','s.
-	return data[seq].names;
+	int seqIndex = seqs.find(seq);
+	if (seqIndex == -1) { return ""; }
+	
+	string nameList = "";
+	for (int entry = firstEntries[seqIndex]; entry != -1; entry = nextEntries[entry]) {
+		if (entry != firstEntries[seqIndex]) { nameList += ","; }
+		
+		map<int, string>::iterator it = entryNameLists.find(entry);
+		if (it != entryNameLists.end()) { nameList += it->second; }
+		else { nameList += names.get(entryNames[entry]); }
+	}
+	
+	return nameList;
 }
 
 /*******************************************************************************/
 
 string FastaMap::getSequence(string name) {
 	
-	map<string,string>::iterator it = seqmap.find(name);
-	if (it == seqmap.end()) { 	return "not found";		}
-	else					{	return it->second;		}
+	int nameIndex = names.find(name);
+	if (nameIndex == -1) { 	return "not found";		}
+	else					{	return seqs.get(nameSeqs[nameIndex]);		}
 	
 }	
 
@@ -137,20 +135,51 @@ string FastaMap::getSequence(string name) {
 
 void FastaMap::push_back(string name, string seq) {
 	
-	map<string,group>::iterator it = data.find(seq);
-	if (it == data.end()) { 	//it's unique.
-		data[seq].groupname = name;  //group name will be the name of the first duplicate sequence found.
-		data[seq].names = name;
-	}else { // its a duplicate.
-		data[seq].names += "," + name;
-	}
-	seqmap[name] = seq;
+	int seqIndex = addSequence(seq);
+	int nameIndex = setName(name, seqIndex, true);
+	addEntry(seqIndex, nameIndex);
+}
+
+/*******************************************************************************/
+
+int FastaMap::sizeUnique(){ //returns the number of unique sequences
+	return seqs.size();
 }
 
 /*******************************************************************************/
 
-int FastaMap::sizeUnique(){ //returns datas size which is the number of unique sequences
-	return data.size();
+int FastaMap::addSequence(string& seq){ //returns the index of the sequence
+	bool isNew = true;
+	int seqIndex = seqs.add(seq, isNew);
+	if (isNew) { firstEntries.push_back(-1); lastEntries.push_back(-1); }
+	
+	return seqIndex;
+}
+
+/*******************************************************************************/
+
+int FastaMap::addEntry(int seqIndex, int nameIndex){
+	int entry = (int)entryNames.size();
+	entryNames.push_back(nameIndex); nextEntries.push_back(-1);
+	
+	if (firstEntries[seqIndex] == -1) { firstEntries[seqIndex] = entry; }
+	else { nextEntries[lastEntries[seqIndex]] = entry; }
+	lastEntries[seqIndex] = entry;
+	
+	return entry;
+}
+
+/*******************************************************************************/
+
+int FastaMap::setName(string name, int seqIndex, bool replace){
+	bool isNew = true;
+	int nameIndex = names.add(name, isNew);
+	
+	if (isNew) { nameSeqs.push_back(seqIndex); }
+	else if (replace) { nameSeqs[nameIndex] = seqIndex; }
+	else { return -1; }
+	
+	return nameIndex;
 }
 
 /*******************************************************************************/
@@ -161,9 +190,10 @@ void FastaMap::printNamesFile(string outFileName){ //prints data
 		util.openOutputFile(outFileName, outFile);
 		
 		// two column file created with groupname and them list of identical sequence names
-		for (map<string,group>::iterator it = data.begin(); it != data.end(); it++) {
+		for (int i = 0; i < seqs.size(); i++) {
 			if (m->getControl_pressed()) { break; }
-			outFile << it->second.groupname << '\t' << it->second.names << endl;
+			string seq = seqs.get(i);
+			outFile << getGroupName(seq) << '\t' << getNames(seq) << endl;
 		}
 		outFile.close();
 	}
@@ -180,10 +210,11 @@ void FastaMap::printCondensedFasta(string outFileName){ //prints data
 		ofstream out;
 		util.openOutputFile(outFileName, out);
 		//creates a fasta file
-		for (map<string,group>::iterator it = data.begin(); it != data.end(); it++) {
+		for (int i = 0; i < seqs.size(); i++) {
 			if (m->getControl_pressed()) { break; }
-			out << ">" << it->second.groupname << endl;
-			out << it->first << endl;
+			string seq = seqs.get(i);
+			out << ">" << getGroupName(seq) << endl;
+			out << seq << endl;
 		}
 		out.close();
 	}
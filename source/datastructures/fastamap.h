@@ -12,11 +12,12 @@
 
 #include "mothurout.h"
 #include "utils.hpp"
+#include "sequencehashtable.h"
 
 
-/* This class represents the fasta file.  It reads a fasta file a populates the internal data structure "data".
-Data is a map where the key is the sequence and the value is a struct containing the sequences groupname, 
-a list of the sequences names who have the same sequence and a number of how many sequence names there are. */
+/* This class represents the fasta file.  It reads a fasta file a populates the internal data structures.
+Each different sequence is stored once, and each name points to its sequence.  The names that have the same sequence
+are kept as a list of indexes, the groupname of a sequence is the first name found with it. */
 
 
 class FastaMap  {
@@ -29,20 +30,27 @@ public:
 	string getNames(string);	//pass a sequence get the string of names in the group separated by ','s.
 	void push_back(string, string); //sequencename, sequence
 	int sizeUnique();					//returns number of unique sequences
-	void printNamesFile(string);		//produces a 2 column file with the groupname in the first column and the names in the second column - a names file.
-	void printCondensedFasta(string);		//produces a fasta file.
+	void printNamesFile(string);		//produces a 2 column file with the groupname in the first column and the names in the second column - a names file. in the order the sequences were found.
+	void printCondensedFasta(string);		//produces a fasta file. in the order the sequences were found.
 	void readFastaFile(string);
 	void readFastaFile(string, string);
 	string getSequence(string);		//pass it a name of a sequence, it returns the sequence.
 
 private:
-	struct group {
-		string groupname;					//the group name for identical sequences, will be set to the first sequence found.
-		string names;						//the names of the sequence separated by ','.
-	};
+	SequenceHashTable seqs;		//the different sequences, in the order they were found
+	SequenceHashTable names;	//the sequence names
+	vector<int> nameSeqs;		//index into seqs for each name  -  uncondensed representation of file
+
+	//condensed representation of file. each sequence has a list of entries, an entry is one of the names
+	//with that sequence and the names file line of that name if one was read.
+	vector<int> firstEntries, lastEntries;	//for each sequence
+	vector<int> entryNames, nextEntries;	//for each entry, -1 if it is the last entry of its sequence
+	map<int, string> entryNameLists;		//entry -> names from the names file
+
+	int addSequence(string&);
+	int addEntry(int, int);		//sequence, name.  returns the entry
+	int setName(string, int, bool);		//name, sequence, replace the sequence if the name is already there.  returns -1 if it was already there and not replaced
 
-	map<string, group>  data;  //sequence, groupinfo	- condensed representation of file
-	map<string, string>  seqmap;  //name, sequence  -  uncondensed representation of file
 	MothurOut* m;
     Utils util;
 };
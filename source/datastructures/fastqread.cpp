@@ -8,18 +8,26 @@
 
 #include "fastqread.h"
 
+/*******************************************************************************/
+//goes from solexa to sanger. Used fq_all2std.pl as a reference. They are the same for every read, so they are only filled once.
+vector<char> fillConvertTable() {
+    vector<char> table;
+    for (int i = -64; i < 65; i++) { table.push_back((char) ((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499))); }
+    return table;
+}
+vector<int> fillConvertBackTable() {
+    vector<int> table;
+    for (int i = -64; i < 65; i++) { table.push_back(((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499))); }
+    return table;
+}
+vector<char> FastqRead::convertTable = fillConvertTable();
+vector<int> FastqRead::convertBackTable = fillConvertBackTable();
 
 /*******************************************************************************/
 FastqRead::FastqRead() {
     try {
         m = MothurOut::getInstance();
         format = "illumina1.8+"; name = ""; sequence = ""; scores.clear();
-        //fill convert table - goes from solexa to sanger. Used fq_all2std.pl as a reference.
-        for (int i = -64; i < 65; i++) {
-            char temp = (char) ((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499));
-            convertTable.push_back(temp);
-            convertBackTable.push_back(((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499)));
-        }
     }
     catch(exception& e) {
         m->errorOut(e, "FastqRead", "FastqRead");
@@ -31,13 +39,6 @@ FastqRead::FastqRead(Sequence s, QualityScores q) {
     try {
         m = MothurOut::getInstance(); format = "illumina1.8+";
         
-        //fill convert table - goes from solexa to sanger. Used fq_all2std.pl as a reference.
-        for (int i = -64; i < 65; i++) {
-            char temp = (char) ((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499));
-            convertTable.push_back(temp);
-            convertBackTable.push_back(((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499)));
-        }
-        
         if (s.getName() != q.getName()) { m->mothurOut("[ERROR]: sequence name does not match quality score name. Cannot construct fastq object.\n"); m->setControl_pressed(true); }
         else {
             name = s.getName();
@@ -59,13 +60,6 @@ FastqRead::FastqRead(Sequence s, QualityScores q, string f) {
     try {
         m = MothurOut::getInstance(); format = f;
         
-        //fill convert table - goes from solexa to sanger. Used fq_all2std.pl as a reference.
-        for (int i = -64; i < 65; i++) {
-            char temp = (char) ((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499));
-            convertTable.push_back(temp);
-            convertBackTable.push_back(((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499)));
-        }
-        
         if (s.getName() != q.getName()) { m->mothurOut("[ERROR]: sequence name does not match quality score name. Cannot construct fastq object.\n"); m->setControl_pressed(true); }
         else {
             name = s.getName();
@@ -87,12 +81,6 @@ FastqRead::FastqRead(string f) {
     try {
         m = MothurOut::getInstance();
         format = f; name = ""; sequence = ""; scores.clear();
-        //fill convert table - goes from solexa to sanger. Used fq_all2std.pl as a reference.
-        for (int i = -64; i < 65; i++) {
-            char temp = (char) ((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499));
-            convertTable.push_back(temp);
-            convertBackTable.push_back(((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499)));
-        }
     }
     catch(exception& e) {
         m->errorOut(e, "FastqRead", "FastqRead");
@@ -105,12 +93,6 @@ FastqRead::FastqRead(string f, string n, string s, vector<int> sc) {
     try {
         m = MothurOut::getInstance();
         format = f; name = n; sequence = s; scores = sc;
-        //fill convert table - goes from solexa to sanger. Used fq_all2std.pl as a reference.
-        for (int i = -64; i < 65; i++) {
-            char temp = (char) ((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499));
-            convertTable.push_back(temp);
-            convertBackTable.push_back(((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499)));
-        }
     }
     catch(exception& e) {
         m->errorOut(e, "FastqRead", "FastqRead");
@@ -125,11 +107,6 @@ FastqRead::FastqRead(ifstream& in, bool& ignore, string f) {
         
         ignore = false;
         format = f;
-        //fill convert table - goes from solexa to sanger. Used fq_all2std.pl as a reference.
-        for (int i = -64; i < 65; i++) {
-            char temp = (char) ((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499));
-            convertTable.push_back(temp);
-        }
         
         //read sequence name
         string line = util.getline(in); util.gobble(in);
@@ -183,12 +160,6 @@ FastqRead::FastqRead(boost::iostreams::filtering_istream& in, bool& ignore, stri
         
         if (in.eof()) { ignore = true; }
         else {
-            //fill convert table - goes from solexa to sanger. Used fq_all2std.pl as a reference.
-            for (int i = -64; i < 65; i++) {
-                char temp = (char) ((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499));
-                convertTable.push_back(temp);
-            }
-            
             //read sequence name
             string line = ""; std::getline(in, line); util.gobble(in);
             vector<string> pieces = util.splitWhiteSpace(line);
@@ -65,8 +65,8 @@ private:
     string sequence;
     string scoreString;
     string format;
-    vector<char> convertTable;
-    vector<int> convertBackTable;
+    static vector<char> convertTable;
+    static vector<int> convertBackTable;
     
     vector<int> convertQual(string qual);
     string convertQual(vector<int>);
@@ -97,6 +97,47 @@ int Kmer::getKmerNumber(string sequence, int index){
 	return kmer;	
 }
 	
+/**************************************************************************************************/
+
+void Kmer::getKmerNumbers(const string& sequence, vector<int>& kmers){
+	
+//	Rolling version of getKmerNumber.  Each base is 2 bits, so the next kmer is the last one shifted over one base
+//	with the new base added, keeping only the last kmerSize bases.  Anything within kmerSize bases after an N gives the
+//	N kmer.  As in getKmerNumber, characters other than ACGTUN are counted as A.
+	
+	static const char baseCodes[256] = {
+		0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+		0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+		0,0,0,1,0,0,0,2,0,0,0,0,0,0,4,0, 0,0,0,0,3,3,0,0,0,0,0,0,0,0,0,0,	//A C G N T U
+		0,0,0,1,0,0,0,2,0,0,0,0,0,0,4,0, 0,0,0,0,3,3,0,0,0,0,0,0,0,0,0,0,	//a c g n t u
+		0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+		0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+		0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+		0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0 };
+	
+	int numKmers = (int)sequence.length() - kmerSize + 1;
+	kmers.clear();
+	if (numKmers < 1) { return; }
+	kmers.resize(numKmers);
+	
+	int nKmer = maxKmer - 1;						//	maxKmer includes the extra N kmer
+	int mask = nKmer - 1;
+	int kmer = 0;
+	int lastN = -kmerSize;							//	position of the last N seen
+	
+	for(int i=0;i<sequence.length();i++){
+		char code = baseCodes[(unsigned char)sequence[i]];
+		if (code == 4)	{	lastN = i;	code = 0;	}
+		kmer = ((kmer << 2) | code) & mask;
+		
+		int start = i - kmerSize + 1;
+		if (start >= 0) {
+			if ((i - lastN) < kmerSize)	{	kmers[start] = nKmer;	}
+			else						{	kmers[start] = kmer;	}
+		}
+	}
+}
+	
 /**************************************************************************************************/
 	
 string Kmer::getKmerBases(int kmerNumber){
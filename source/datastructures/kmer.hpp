@@ -21,6 +21,7 @@ public:
     ~Kmer() {}
 	string getKmerString(string);
 	int getKmerNumber(string, int);
+	void getKmerNumbers(const string&, vector<int>&);	//fills vector with the kmer number at every position, same values as getKmerNumber
 	string getKmerBases(int);
 	int getReverseKmerNumber(int);
 	vector< map<int, int> > getKmerCounts(string sequence);  //for use in chimeraCheck
@@ -27,10 +27,16 @@
 #include "database.hpp"
 #include "kmerdb.hpp"
 
+#if defined NON_WINDOWS
+	#include <sys/mman.h>
+	#include <fcntl.h>
+#endif
+
 /**************************************************************************************************/
 
 KmerDB::KmerDB(string fastaFileName, int kSize) : Database(), kmerSize(kSize) {
 	try { 
+		kmerOffsets = NULL; kmerPostings = NULL; mappedFile = NULL; mappedSize = 0;
 	
 		kmerDBName = fastaFileName.substr(0,fastaFileName.find_last_of(".")+1) + char('0'+ kmerSize) + "mer";
 		
@@ -48,11 +54,15 @@ KmerDB::KmerDB(string fastaFileName, int kSize) : Database(), kmerSize(kSize) {
 
 }
 /**************************************************************************************************/
-KmerDB::KmerDB() : Database() {}
+KmerDB::KmerDB() : Database() { kmerOffsets = NULL; kmerPostings = NULL; mappedFile = NULL; mappedSize = 0; }
 /**************************************************************************************************/
 
-KmerDB::~KmerDB(){}
+KmerDB::~KmerDB(){ unmapKmerDB(); }
+
+/**************************************************************************************************/
 
+//scratch space for findClosestSequences, sized to the largest database searched by the thread
+static thread_local kmerSearchContext searchContext;
 /**************************************************************************************************/
 
 vector<int> KmerDB::findClosestSequences(Sequence* candidateSeq, int num, vector<float>& Scores){
@@ -64,30 +74,29 @@ vector<int> KmerDB::findClosestSequences(Sequence* candidateSeq, int num, vector
 		float searchScore = 0;
 		Scores.clear();
 		
-		vector<int> matches(numSeqs, 0);						//	a record of the sequences with shared kmers
-		vector<int> timesKmerFound(kmerLocations.size()+1, 0);	//	a record of the kmers that we have already found
+		kmerSearchContext& context = searchContext;
+		if (context.kmerFound.size() < (maxKmer+1))	{	context.kmerFound.resize(maxKmer+1, 0);	}	//	a record of the kmers that we have already found
 		
-		int numKmers = candidateSeq->getNumBases() - kmerSize + 1;	
-	
-		for(int i=0;i<numKmers;i++){
-			int kmerNumber = kmer.getKmerNumber(candidateSeq->getUnaligned(), i);		//	go through the query sequence and get a kmer number
-			if(timesKmerFound[kmerNumber] == 0){				//	if we haven't seen it before...
-				for(int j=0;j<kmerLocations[kmerNumber].size();j++){//increase the count for each sequence that also has
-					matches[kmerLocations[kmerNumber][j]]++;	//	that kmer
-				}
-			}
-			timesKmerFound[kmerNumber] = 1;						//	ok, we've seen the kmer now
-		}
+		int numKmers = candidateSeq->getNumBases() - kmerSize + 1;
+		kmer.getKmerNumbers(candidateSeq->getUnaligned(), context.kmerNumbers);		//	go through the query sequence and get the kmer numbers
+		
+		//a sequence can't share more kmers than the query has, so use the smaller counters when they can't overflow
+		if (context.kmerNumbers.size() < numeric_limits<unsigned short>::max())	{	countKmerMatches(context, context.shortMatches);	}
+		else																	{	countKmerMatches(context, context.matches);		}
+		
+		vector<seqMatch>& seqMatches = context.seqMatches;
 		
 		if (num != 1) {
-			vector<seqMatch> seqMatches; seqMatches.resize(numSeqs);
-			for(int i=0;i<numSeqs;i++){		
-				seqMatches[i].seq = i;
-				seqMatches[i].match = matches[i];
+			//only the sequences that share kmers with the query can be at the top, unless too few do
+			int numNeeded = max(num, 1);
+			if (seqMatches.size() < numNeeded) {
+				vector<bool> touched(numSeqs, false);
+				for (int i = 0; i < seqMatches.size(); i++) { touched[seqMatches[i].seq] = true; }
+				for (int i = 0; (i < numSeqs) && (seqMatches.size() < numNeeded); i++) { if (!touched[i]) { seqMatches.push_back(seqMatch(i, 0)); } }
 			}
 			
-			//sorts putting largest matches first
-			sort(seqMatches.begin(), seqMatches.end(), compareSeqMatches);
+			//puts the num largest matches first
+			partial_sort(seqMatches.begin(), seqMatches.begin()+num, seqMatches.end(), compareSeqMatchesIndex);
 			
 			searchScore = seqMatches[0].match;
 			searchScore = 100 * searchScore / (float) numKmers;		//	return the Sequence object corresponding to the db
@@ -101,12 +110,11 @@ vector<int> KmerDB::findClosestSequences(Sequence* candidateSeq, int num, vector
 			}
 		}else{
 			int bestIndex = 0;
-			int bestMatch = -1;
-			for(int i=0;i<numSeqs;i++){	
-				
-				if (matches[i] > bestMatch) {
-					bestIndex = i;
-					bestMatch = matches[i];
+			int bestMatch = 0;
+			for(int i=0;i<seqMatches.size();i++){	//	ties go to the first sequence in the template
+				if ((seqMatches[i].match > bestMatch) || ((seqMatches[i].match == bestMatch) && (seqMatches[i].seq < bestIndex))) {
+					bestIndex = seqMatches[i].seq;
+					bestMatch = seqMatches[i].match;
 				}
 			}
 			
@@ -122,6 +130,48 @@ vector<int> KmerDB::findClosestSequences(Sequence* candidateSeq, int num, vector
 		exit(1);
 	}	
 }
+/**************************************************************************************************/
+//counts the kmers each template sequence shares with the query, leaving a seqMatch in context.seqMatches for every
+//sequence with at least one shared kmer.  The counters and kmerFound are put back to zero using the touched lists, so
+//the cost depends on the number of hits instead of the size of the database.
+template <typename T>
+void KmerDB::countKmerMatches(kmerSearchContext& context, vector<T>& matches){
+	try {
+		if (matches.size() < numSeqs) { matches.resize(numSeqs, 0); }
+		
+		context.touchedSeqs.clear();
+		context.touchedKmers.clear();
+		
+		for(int i=0;i<context.kmerNumbers.size();i++){
+			int kmerNumber = context.kmerNumbers[i];
+			if(context.kmerFound[kmerNumber] == 0){					//	if we haven't seen it before...
+				context.kmerFound[kmerNumber] = 1;					//	ok, we've seen the kmer now
+				context.touchedKmers.push_back(kmerNumber);
+				
+				const int* locations;
+				int numLocations = getKmerLocations(kmerNumber, locations);
+				for(int j=0;j<numLocations;j++){					//increase the count for each sequence that also has
+					int seq = locations[j];							//	that kmer
+					if (matches[seq] == 0) { context.touchedSeqs.push_back(seq); }
+					matches[seq]++;
+				}
+			}
+		}
+		
+		context.seqMatches.resize(context.touchedSeqs.size());
+		for(int i=0;i<context.touchedSeqs.size();i++){
+			int seq = context.touchedSeqs[i];
+			context.seqMatches[i].seq = seq;
+			context.seqMatches[i].match = matches[seq];
+			matches[seq] = 0;
+		}
+		for(int i=0;i<context.touchedKmers.size();i++){	context.kmerFound[context.touchedKmers[i]] = 0;	}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "KmerDB", "countKmerMatches");
+		exit(1);
+	}	
+}
 
 /**************************************************************************************************/
 //print shortcut file
@@ -129,17 +179,33 @@ void KmerDB::generateDB(){
 	try {
 		
 		ofstream kmerFile;										//	once we have the kmerLocations folder print it out
-		util.openOutputFile(kmerDBName, kmerFile);					//	to a file
+		util.openOutputFileBinary(kmerDBName, kmerFile);			//	to a file
 		
-		//output version
-		kmerFile << "#" << current->getVersion() << endl;
+		//output version, then pad so the binary data starts on an 8 byte boundary
+		string version = "#" + current->getVersion() + "\n";
+		kmerFile.write(version.c_str(), version.length());
+		long long start = ((version.length() + 7) / 8) * 8;
+		for (long long i = version.length(); i < start; i++) { kmerFile.put('\0'); }
 		
-		for(int i=0;i<maxKmer;i++){								//	step through all of the possible kmer numbers
-			kmerFile << i << ' ' << kmerLocations[i].size();	//	print the kmer number and the number of sequences with
-			for(int j=0;j<kmerLocations[i].size();j++){			//	that kmer.  then print out the indices of the sequences
-				kmerFile << ' ' << kmerLocations[i][j];			//	with that kmer.
+		//	the offsets array gives the start of each kmer's sequence indices in the postings array, so the
+		//	sequences with kmer i are postings[offsets[i]] to postings[offsets[i+1]-1]
+		int numRows = maxKmer+1;
+		vector<unsigned long long> offsets(numRows+1, 0);
+		for(int i=0;i<numRows;i++){	offsets[i+1] = offsets[i] + kmerLocations[i].size();	}
+		
+		kmerDBHeader header;
+		memcpy(header.magic, "MKDB", 4);
+		header.formatVersion = 1;
+		header.kmerSize = kmerSize;
+		header.numKmers = numRows;
+		header.numPostings = offsets[numRows];
+		
+		kmerFile.write((char*)&header, sizeof(kmerDBHeader));
+		kmerFile.write((char*)offsets.data(), offsets.size() * sizeof(unsigned long long));
+		for(int i=0;i<numRows;i++){								//	step through all of the possible kmer numbers
+			if (kmerLocations[i].size() != 0) {					//	and print the indices of the sequences with that kmer
+				kmerFile.write((char*)kmerLocations[i].data(), kmerLocations[i].size() * sizeof(int));
 			}
-			kmerFile << endl;
 		}
 		kmerFile.close();
 		
@@ -155,12 +221,12 @@ void KmerDB::addSequence(Sequence seq) {
 	try {
 		Kmer kmer(kmerSize);
 		
-		string unaligned = seq.getUnaligned();	//	...take the unaligned sequence...
-		int numKmers = unaligned.length() - kmerSize + 1;
+		vector<int> kmerNumbers;
+		kmer.getKmerNumbers(seq.getUnaligned(), kmerNumbers);	//	...take the unaligned sequence and get each kmer...
 			
-		vector<int> seenBefore(maxKmer+1,0);
-		for(int j=0;j<numKmers;j++){						//	...step though the sequence and get each kmer...
-			int kmerNumber = kmer.getKmerNumber(unaligned, j);
+		vector<char> seenBefore(maxKmer+1,0);
+		for(int j=0;j<kmerNumbers.size();j++){
+			int kmerNumber = kmerNumbers[j];
 			if(seenBefore[kmerNumber] == 0){
 				kmerLocations[kmerNumber].push_back(count);		//	...insert the sequence index into kmerLocations for
 			}												//	the appropriate kmer number
@@ -181,12 +247,42 @@ void KmerDB::readKmerDB(ifstream& kmerDBFile){
 					
 		kmerDBFile.seekg(0);									//	start at the beginning of the file
 		
+		//read version
+		string line = util.getline(kmerDBFile);
+		long long start = kmerDBFile.tellg();
+		start = ((start + 7) / 8) * 8;
+		
+		//binary shortcut files start with the magic number after the version line
+		char magic[4] = { 0, 0, 0, 0 };
+		kmerDBFile.seekg(start);
+		kmerDBFile.read(magic, 4);
+		
+		if ((kmerDBFile.gcount() == 4) && (memcmp(magic, "MKDB", 4) == 0)) { readBinaryKmerDB(kmerDBFile, start); }
+		else {
+			kmerDBFile.clear();
+			readTextKmerDB(kmerDBFile);
+		}
+		kmerDBFile.close();
+		
+	}
+	catch(exception& e) {
+		m->errorOut(e, "KmerDB", "readKmerDB");
+		exit(1);
+	}	
+}
+/**************************************************************************************************/
+//reads shortcut files created by older versions of mothur
+void KmerDB::readTextKmerDB(ifstream& kmerDBFile){
+	try {
+		
+		kmerDBFile.seekg(0);									//	start at the beginning of the file
+		
 		//read version
 		string line = util.getline(kmerDBFile); util.gobble(kmerDBFile);
 		
 		string seqName;
 		int seqNumber;
-
+		
 		for(int i=0;i<maxKmer;i++){
 			int numValues = 0;	
 			kmerDBFile >> seqName >> numValues;
@@ -196,11 +292,90 @@ void KmerDB::readKmerDB(ifstream& kmerDBFile){
 				kmerLocations[i].push_back(seqNumber);			//		2. sequence indices
 			}
 		}
-		kmerDBFile.close();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "KmerDB", "readTextKmerDB");
+		exit(1);
+	}	
+}
+/**************************************************************************************************/
+//start is the file offset of the kmerDBHeader
+bool KmerDB::readBinaryKmerDB(ifstream& kmerDBFile, long long start){
+	try {
+		
+		kmerDBHeader header;
+		kmerDBFile.seekg(start);
+		kmerDBFile.read((char*)&header, sizeof(kmerDBHeader));
 		
+		if ((header.formatVersion != 1) || (header.kmerSize != kmerSize) || (header.numKmers != (maxKmer+1))) {
+			m->mothurOut("[ERROR]: " + kmerDBName + " does not match the requested kmer size or was created on a machine with a different byte order, please remove it and rerun.\n"); m->setControl_pressed(true); return false;
+		}
+		
+		long long offsetsStart = start + sizeof(kmerDBHeader);
+		long long postingsStart = offsetsStart + (header.numKmers+1) * sizeof(unsigned long long);
+		long long fileSize = postingsStart + header.numPostings * sizeof(int);
+		
+		unmapKmerDB();
+		
+#if defined NON_WINDOWS
+		//map the file read-only so the postings are shared with every other process using this reference
+		int fd = open(util.getFullPathName(kmerDBName).c_str(), O_RDONLY);
+		if (fd != -1) {
+			struct stat st;
+			if ((fstat(fd, &st) == 0) && (st.st_size >= fileSize)) {
+				void* mapped = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+				if (mapped != MAP_FAILED) {
+					mappedFile = mapped;
+					mappedSize = st.st_size;
+					kmerOffsets = (const unsigned long long*)((char*)mapped + offsetsStart);
+					kmerPostings = (const int*)((char*)mapped + postingsStart);
+				}
+			}
+			close(fd);
+		}
+#endif
+		
+		//fall back to reading the arrays into memory
+		if (mappedFile == NULL) {
+			ifstream in;
+			util.openInputFileBinary(kmerDBName, in);
+			
+			offsetsBuffer.resize(header.numKmers+1);
+			postingsBuffer.resize(header.numPostings);
+			
+			in.seekg(offsetsStart);
+			in.read((char*)offsetsBuffer.data(), offsetsBuffer.size() * sizeof(unsigned long long));
+			if (postingsBuffer.size() != 0) { in.read((char*)postingsBuffer.data(), postingsBuffer.size() * sizeof(int)); }
+			
+			if (!in) { m->mothurOut("[ERROR]: " + kmerDBName + " is truncated, please remove it and rerun.\n"); m->setControl_pressed(true); in.close(); return false; }
+			in.close();
+			
+			kmerOffsets = offsetsBuffer.data();
+			kmerPostings = postingsBuffer.data();
+		}
+		
+		//no longer need the in memory table
+		vector<vector<int> > empty; kmerLocations.swap(empty);
+		
+		return true;
 	}
 	catch(exception& e) {
-		m->errorOut(e, "KmerDB", "readKmerDB");
+		m->errorOut(e, "KmerDB", "readBinaryKmerDB");
+		exit(1);
+	}	
+}
+/**************************************************************************************************/
+void KmerDB::unmapKmerDB(){
+	try {
+#if defined NON_WINDOWS
+		if (mappedFile != NULL) { munmap(mappedFile, mappedSize); }
+#endif
+		mappedFile = NULL; mappedSize = 0;
+		kmerOffsets = NULL; kmerPostings = NULL;
+		offsetsBuffer.clear(); postingsBuffer.clear();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "KmerDB", "unmapKmerDB");
 		exit(1);
 	}	
 }
@@ -210,7 +385,7 @@ int KmerDB::getCount(int kmer) {
 	try {
 		if (kmer < 0) { return 0; }  //if user gives negative number
 		else if (kmer > maxKmer) {	return 0;	}  //or a kmer that is bigger than maxkmer
-		else {	return kmerLocations[kmer].size();	}  // kmer is in vector range
+		else {	const int* locations; return getKmerLocations(kmer, locations);	}  // kmer is in vector range
 	}
 	catch(exception& e) {
 		m->errorOut(e, "KmerDB", "getCount");
@@ -239,7 +414,11 @@ vector<int> KmerDB::getSequencesWithKmer(int kmer) {
 	
 		if (kmer < 0) { }  //if user gives negative number
 		else if (kmer > maxKmer) {	}  //or a kmer that is bigger than maxkmer
-		else {	seqs = kmerLocations[kmer];	}
+		else {
+			const int* locations;
+			int numLocations = getKmerLocations(kmer, locations);
+			seqs.assign(locations, locations+numLocations);
+		}
 		
 		return seqs;
 	}
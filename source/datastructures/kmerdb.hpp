@@ -16,12 +16,37 @@
  *	Construction of an object of this type will first look for an appropriately named database file and if it is found
  *	then will read in the database file (readKmerDB), otherwise it will generate one and store the data in memory
  *	(generateKmerDB)
+ *
+ *	The shortcut file is written in a binary CSR layout (a "#version" line followed by a kmerDBHeader, an offsets array
+ *	and the flattened sequence indices). When read back the file is memory mapped read-only, so every thread and process
+ *	on a node shares one copy of the postings through the page cache. Older text shortcut files are still readable.
 
  */
 
 #include "mothur.h"
 #include "database.hpp"
 
+/**************************************************************************************************/
+//binary shortcut file header, written after the "#version" line at an 8 byte aligned offset
+struct kmerDBHeader {
+	char magic[4];				//"MKDB"
+	unsigned int formatVersion;
+	unsigned int kmerSize;
+	unsigned int numKmers;		//number of rows, offsets array has numKmers+1 entries
+	unsigned long long numPostings;
+};
+//scratch space for a search, reused between searches by the same thread so a search doesn't allocate
+struct kmerSearchContext {
+	vector<int> kmerNumbers;			//kmers in the query
+	vector<char> kmerFound;				//kmers already counted
+	vector<int> touchedKmers;
+	vector<unsigned short> shortMatches;	//shared kmer counts by sequence, used when the query has fewer than 65535 kmers
+	vector<int> matches;
+	vector<int> touchedSeqs;			//sequences with a nonzero count
+	vector<seqMatch> seqMatches;
+};
+/**************************************************************************************************/
+
 class KmerDB : public Database {
 	
 public:
@@ -43,7 +68,30 @@ private:
 	int kmerSize;
 	int maxKmer, count;
 	string kmerDBName;
-	vector<vector<int> > kmerLocations;
+	vector<vector<int> > kmerLocations;		//filled by addSequence or when reading a text shortcut file
+	
+	//CSR view of kmerLocations when read from a binary shortcut file
+	const unsigned long long* kmerOffsets;
+	const int* kmerPostings;
+	void* mappedFile;
+	size_t mappedSize;
+	vector<unsigned long long> offsetsBuffer;	//used if the file can't be memory mapped
+	vector<int> postingsBuffer;
+	
+	template <typename T> void countKmerMatches(kmerSearchContext&, vector<T>&);
+	bool readBinaryKmerDB(ifstream&, long long);
+	void readTextKmerDB(ifstream&);
+	void unmapKmerDB();
+	
+	//sets locations to the sequence indices containing kmer and returns how many there are
+	inline int getKmerLocations(int kmer, const int*& locations) {
+		if (kmerPostings != NULL) {
+			locations = kmerPostings + kmerOffsets[kmer];
+			return (int)(kmerOffsets[kmer+1] - kmerOffsets[kmer]);
+		}
+		locations = kmerLocations[kmer].data();
+		return kmerLocations[kmer].size();
+	}
 };
 
 #endif
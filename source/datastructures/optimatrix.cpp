@@ -73,9 +73,9 @@ ListVector* OptiMatrix::getListSingle() {
 long int OptiMatrix::print(ostream& out) {
     try {
         long int count = 0;
-        for (int i = 0; i < closeness.size(); i++) {
-            for(set<int>::iterator it = closeness[i].begin(); it != closeness[i].end(); it++){
-                out << *it << '\t';
+        for (int i = 0; i < getNumSeqs(); i++) {
+            for (long long j = closeStarts[i]; j < closeStarts[i+1]; j++) {
+                out << closeSeqs[j] << '\t';
                 count++;
             }
             out << endl;
@@ -96,7 +96,7 @@ map<string, int> OptiMatrix::getNameIndexMap() {
         map<string, int> nameIndexes;
         for (int i = 0; i < nameMap.size(); i++) {
             vector<string> thisBinsSeqs; util.splitAtComma(nameMap[i], thisBinsSeqs);
-            if (i < closeness.size()) {  nameIndexes[thisBinsSeqs[0]] = i;  }
+            if (i < getNumSeqs()) {  nameIndexes[thisBinsSeqs[0]] = i;  }
         }
         
         return nameIndexes;
@@ -116,7 +116,7 @@ vector<int> OptiMatrix::getNumSeqs(vector<vector<string> > & binNames, vector<ve
         set<string> unique;
         for (int i = 0; i < nameMap.size(); i++) {
             vector<string> thisBinsSeqs; util.splitAtComma(nameMap[i], thisBinsSeqs);
-            if (i < closeness.size()) {  nameIndexes[thisBinsSeqs[0]] = i;  }
+            if (i < getNumSeqs()) {  nameIndexes[thisBinsSeqs[0]] = i;  }
             if (thisBinsSeqs.size() == 1) { //you are unique
                 unique.insert(thisBinsSeqs[0]);
             }
@@ -149,7 +149,7 @@ vector<int> OptiMatrix::getNumSeqs(vector<vector<string> > & binNames, vector<ve
 string OptiMatrix::getName(int index) {
     try {
         //return toString(index);
-        if (index > closeness.size()) { m->mothurOut("[ERROR]: index is not valid.\n"); m->setControl_pressed(true); return ""; }
+        if (index > getNumSeqs()) { m->mothurOut("[ERROR]: index is not valid.\n"); m->setControl_pressed(true); return ""; }
         string name = nameMap[index];
         return name;
     }
@@ -174,9 +174,7 @@ string OptiMatrix::getOverlapName(int index) {
 /***********************************************************************/
 bool OptiMatrix::isClose(int i, int toFind){
     try {
-        bool found = false;
-        if (closeness[i].count(toFind) != 0) { found = true; }
-        return found;
+        return binary_search(closeSeqs.begin() + closeStarts[i], closeSeqs.begin() + closeStarts[i+1], toFind);
         
     }
     catch(exception& e) {
@@ -185,11 +183,57 @@ bool OptiMatrix::isClose(int i, int toFind){
     }
 }
 /***********************************************************************/
+//number of seqs in sortedSeqs that are close to i. sortedSeqs must be in increasing order
+long long OptiMatrix::getNumClose(int i, const vector<int>& sortedSeqs){
+    try {
+        long long numClose = 0;
+        const int* close = closeSeqs.data() + closeStarts[i]; const int* closeEnd = closeSeqs.data() + closeStarts[i+1];
+        vector<int>::const_iterator it = sortedSeqs.begin();
+        
+        while ((close != closeEnd) && (it != sortedSeqs.end())) {
+            if (*close < *it)       { close++;  }
+            else if (*it < *close)  { it++;     }
+            else                    { numClose++; close++; it++; }
+        }
+        
+        return numClose;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiMatrix", "getNumClose");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//sorts each row, removes the duplicates added by square matrices and packs the rows one after another.
+//the rows are freed as they are packed so we never hold both copies of the matrix.
+void OptiMatrix::setCloseness(vector< vector<int> >& closeness){
+    try {
+        long long numDists = 0;
+        for (int i = 0; i < closeness.size(); i++) { numDists += closeness[i].size(); }
+        
+        closeSeqs.clear(); closeSeqs.reserve(numDists);
+        closeStarts.clear(); closeStarts.reserve(closeness.size()+1);
+        closeStarts.push_back(0);
+        
+        for (int i = 0; i < closeness.size(); i++) {
+            sort(closeness[i].begin(), closeness[i].end());
+            closeSeqs.insert(closeSeqs.end(), closeness[i].begin(), unique(closeness[i].begin(), closeness[i].end()));
+            closeStarts.push_back(closeSeqs.size());
+            vector<int>().swap(closeness[i]);
+        }
+        closeness.clear();
+        
+        if (closeSeqs.size() != numDists) { closeSeqs.shrink_to_fit(); }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiMatrix", "setCloseness");
+        exit(1);
+    }
+}
+/***********************************************************************/
 long long OptiMatrix::getNumDists(){
     try {
-        long long foundDists = 0;
-        for (int i = 0; i < closeness.size(); i++) { foundDists += closeness[i].size(); }
-        return foundDists;
+        return closeSeqs.size();
     }
     catch(exception& e) {
         m->errorOut(e, "OptiMatrix", "isClose");
@@ -275,7 +319,7 @@ int OptiMatrix::readPhylip(){
         }
         singleton.clear();
 
-        closeness.resize(nonSingletonCount);
+        vector< vector<int> > closeness(nonSingletonCount); //packed into closeSeqs once the whole file is read
         
         map<string, string> names;
         if (namefile != "") {
@@ -318,8 +362,8 @@ int OptiMatrix::readPhylip(){
                     if(distance < cutoff){
                         int newB = singletonIndexSwap[j];
                         int newA = singletonIndexSwap[i];
-                        closeness[newA].insert(newB);
-                        closeness[newB].insert(newA);
+                        closeness[newA].push_back(newB);
+                        closeness[newB].push_back(newA);
                     }
                     index++; reading->update(index);
                 }
@@ -346,8 +390,8 @@ int OptiMatrix::readPhylip(){
                     if(distance < cutoff && j < i){
                         int newB = singletonIndexSwap[j];
                         int newA = singletonIndexSwap[i];
-                        closeness[newA].insert(newB);
-                        closeness[newB].insert(newA);
+                        closeness[newA].push_back(newB);
+                        closeness[newB].push_back(newA);
                     }
                     index++; reading->update(index);
                 }
@@ -356,6 +400,8 @@ int OptiMatrix::readPhylip(){
         in.close();
         reading->finish();
         delete reading;
+        
+        setCloseness(closeness);
 
         return 0;
         
@@ -370,6 +416,8 @@ int OptiMatrix::readPhylip(){
 int OptiMatrix::readColumn(){
     try {
         Utils util;
+        if (BinaryColumnFile::isBinary(distFile)) { return readBinaryColumn(); }
+        
         map<string, int> nameAssignment;
         if (namefile != "") { nameAssignment = util.readNames(namefile); }
         else  {  CountTable ct; ct.readTable(countfile, false, true); nameAssignment = ct.getNameMap(); }
@@ -427,7 +475,7 @@ int OptiMatrix::readColumn(){
         }
         singleton.clear();
         
-        closeness.resize(nonSingletonCount);
+        vector< vector<int> > closeness(nonSingletonCount); //packed into closeSeqs once the whole file is read
         
         map<string, string> names;
         if (namefile != "") {
@@ -465,8 +513,8 @@ int OptiMatrix::readColumn(){
                 
                 int newB = singletonIndexSwap[indexB];
                 int newA = singletonIndexSwap[indexA];
-                closeness[newA].insert(newB);
-                closeness[newB].insert(newA);
+                closeness[newA].push_back(newB);
+                closeness[newB].push_back(newA);
                 
                 if (namefile != "") {
                     firstName = names[firstName];  //redundant names
@@ -480,6 +528,8 @@ int OptiMatrix::readColumn(){
         in.close();
         nameAssignment.clear();
         
+        setCloseness(closeness);
+        
         return 1;
         
     }
@@ -489,6 +539,114 @@ int OptiMatrix::readColumn(){
     }
 }
 /***********************************************************************/
+//same as readColumn, but the names are looked up once per file instead of once per distance
+int OptiMatrix::readBinaryColumn(){
+    try {
+        Utils util;
+        map<string, int> nameAssignment;
+        if (namefile != "") { nameAssignment = util.readNames(namefile); }
+        else  {  CountTable ct; ct.readTable(countfile, false, true); nameAssignment = ct.getNameMap(); }
+        int count = 0;
+        for (map<string, int>::iterator it = nameAssignment.begin(); it!= nameAssignment.end(); it++) {
+            it->second = count; count++;
+            nameMap.push_back(it->first);
+        }
+        
+        BinaryColumnFile binaryFile(distFile);
+        if (!binaryFile.getOpen()) { m->setControl_pressed(true); return 0; }
+        
+        //like readColumn, only the names in a distance are looked up, each the first time it is seen
+        vector<int> indexes(binaryFile.getNumNames(), -1);
+        
+        int row, column;
+        float distance;
+        
+        ///////////////////// Read to eliminate singletons ///////////////////////
+        vector<bool> singleton; singleton.resize(nameMap.size(), true);
+        while (binaryFile.read(row, column, distance)) {
+            
+            if (m->getControl_pressed()) {  return 0; }
+            
+            if (indexes[row] == -1) {
+                map<string,int>::iterator it = nameAssignment.find(binaryFile.getName(row));
+                if(it == nameAssignment.end()){  m->mothurOut("AAError: Sequence '" + binaryFile.getName(row) + "' was not found in the name or count file, please correct\n"); exit(1);  }
+                indexes[row] = it->second;
+            }
+            if (indexes[column] == -1) {
+                map<string,int>::iterator it = nameAssignment.find(binaryFile.getName(column));
+                if(it == nameAssignment.end()){  m->mothurOut("ABError: Sequence '" + binaryFile.getName(column) + "' was not found in the name or count file, please correct\n"); exit(1);  }
+                indexes[column] = it->second;
+            }
+            
+            if (distance == -1) { distance = 1000000; }
+            else if (sim) { distance = 1.0 - distance;  }  //user has entered a sim matrix that we need to convert.
+            
+            if(distance < cutoff){
+                singleton[indexes[row]] = false;
+                singleton[indexes[column]] = false;
+            }
+        }
+        //////////////////////////////////////////////////////////////////////////
+        
+        vector<int> singletonIndexSwap(singleton.size(), -1);
+        int nonSingletonCount = 0;
+        for (int i = 0; i < singleton.size(); i++) {
+            if (!singleton[i]) { //if you are a singleton
+                singletonIndexSwap[i] = nonSingletonCount;
+                nonSingletonCount++;
+            }else { singletons.push_back(nameMap[i]); }
+        }
+        singleton.clear();
+        
+        vector< vector<int> > closeness(nonSingletonCount); //packed into closeSeqs once the whole file is read
+        
+        map<string, string> names;
+        if (namefile != "") {
+            util.readNames(namefile, names);
+            for (int i = 0; i < singletons.size(); i++) {
+                singletons[i] = names[singletons[i]];
+            }
+        }
+        
+        nameAssignment.clear();
+        
+        vector<string> fileNames(indexes.size());
+        for (int i = 0; i < indexes.size(); i++) {
+            if (indexes[i] == -1) { continue; } //not in any distance
+            fileNames[i] = binaryFile.getName(i);
+            if (namefile != "") { fileNames[i] = names[fileNames[i]]; } //redundant names
+        }
+        
+        binaryFile.rewind();
+        while (binaryFile.read(row, column, distance)) {
+            
+            if (m->getControl_pressed()) {  return 0; }
+            
+            if (distance == -1) { distance = 1000000; }
+            else if (sim) { distance = 1.0 - distance;  }  //user has entered a sim matrix that we need to convert.
+            
+            if(distance < cutoff){
+                int newA = singletonIndexSwap[indexes[row]];
+                int newB = singletonIndexSwap[indexes[column]];
+                closeness[newA].push_back(newB);
+                closeness[newB].push_back(newA);
+                
+                nameMap[newA] = fileNames[row];
+                nameMap[newB] = fileNames[column];
+            }
+        }
+        
+        setCloseness(closeness);
+        
+        return 1;
+        
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiMatrix", "readBinaryColumn");
+        exit(1);
+    }
+}
+/***********************************************************************/
 int OptiMatrix::readBlast(){
     try {
         Utils util;
@@ -726,7 +884,7 @@ int OptiMatrix::readBlast(){
         util.openInputFile(distFile, in);
         
         dists.resize(nameAssignment.size());
-        closeness.resize(nonSingletonCount);
+        vector< vector<int> > closeness(nonSingletonCount); //packed into closeSeqs once the whole file is read
         blastOverlap.resize(overlapNonSingletonCount);
         
         map<string, string> names;
@@ -862,8 +1020,8 @@ int OptiMatrix::readBlast(){
                                 
                                 int newB = singletonIndexSwap[indexB];
                                 int newA = singletonIndexSwap[indexA];
-                                closeness[newA].insert(newB);
-                                closeness[newB].insert(newA);
+                                closeness[newA].push_back(newB);
+                                closeness[newB].push_back(newA);
                             }
                             //not going to need this again
                             dists[itB->second].erase(itDist);
@@ -934,8 +1092,8 @@ int OptiMatrix::readBlast(){
                     
                     int newB = singletonIndexSwap[indexB];
                     int newA = singletonIndexSwap[indexA];
-                    closeness[newA].insert(newB);
-                    closeness[newB].insert(newA);
+                    closeness[newA].push_back(newB);
+                    closeness[newB].push_back(newA);
                 }
                 //not going to need this again
                 dists[itB->second].erase(itDist);
@@ -948,6 +1106,8 @@ int OptiMatrix::readBlast(){
         dists.clear();
         nameAssignment.clear();
         
+        setCloseness(closeness);
+        
         m->mothurOut(" done."); m->mothurOutEndLine();
         
         return 1;
@@ -12,6 +12,20 @@
 #include "mothurout.h"
 #include "listvector.hpp"
 #include "sparsedistancematrix.h"
+#include "binarycolumn.h"
+
+//the indexes of the seqs close to one seq, in increasing order. points into the matrix, so it is only good while the matrix is.
+struct closeSeqsRange {
+    const int* first;
+    const int* last;
+    
+    closeSeqsRange(const int* f, const int* l) : first(f), last(l) {}
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+    int size() const { return (int)(last - first); }
+};
+
+/***********************************************************************/
 
 class OptiMatrix {
     
@@ -23,16 +37,17 @@ class OptiMatrix {
     
 public:
     
-    OptiMatrix() { m = MothurOut::getInstance(); }
+    OptiMatrix() { m = MothurOut::getInstance(); closeStarts.push_back(0); }
     OptiMatrix(string, string, double, bool); //distfile, distformat, cutoff, sim
     OptiMatrix(string, string, string, string, double, bool); //distfile, name or count, format, distformat, cutoff, sim
     ~OptiMatrix(){ }
     
     int readFile(string, string, string, string, double, bool); //distfile, name or count, format, distformat, cutoff, sim
-    set<int> getCloseSeqs(int i) { return closeness[i]; }
+    closeSeqsRange getCloseSeqs(int i) { return closeSeqsRange(closeSeqs.data() + closeStarts[i], closeSeqs.data() + closeStarts[i+1]); }
     bool isClose(int, int);
-    int getNumClose(int index) { return closeness[index].size(); }
-    int getNumSeqs() { return closeness.size(); }
+    int getNumClose(int index) { return (int)(closeStarts[index+1] - closeStarts[index]); }
+    long long getNumClose(int, const vector<int>&); //number of seqs in the sorted vector close to seq
+    int getNumSeqs() { return (closeStarts.size() == 0) ? 0 : (int)(closeStarts.size() - 1); }
     vector<int> getNumSeqs(vector<vector<string> >&, vector< vector<int> >&);
     int getNumSingletons() { return singletons.size(); }
     long long getNumDists(); //number of distances under cutoff
@@ -50,7 +65,9 @@ public:
 protected:
     Utils util;
     MothurOut* m;
-    vector< set<int> > closeness;  //closeness[0] contains indexes of seqs "close" to seq 0.
+    //closeSeqs[closeStarts[0]] to closeSeqs[closeStarts[1]-1] are the indexes of seqs "close" to seq 0, in increasing order.
+    vector<int> closeSeqs;
+    vector<long long> closeStarts;
     vector< set<int> > blastOverlap;  //empty unless reading a blast file.
     vector<string> singletons;
     vector<string> nameMap;
@@ -64,8 +81,10 @@ protected:
 
     int readPhylip();
     int readColumn();
+    int readBinaryColumn();
     int readBlast();
     int readBlastNames(map<string, int>& nameAssignment);
+    void setCloseness(vector< vector<int> >&); //packs the rows into closeSeqs and closeStarts, empties the rows
     
 };
 
@@ -0,0 +1,136 @@
+/*
+ *  preclusterindex.cpp
+ *  Mothur
+ *
+ */
+
+#include "preclusterindex.h"
+
+static const unsigned long long hashBase = 131;
+
+/**************************************************************************************************/
+
+PreClusterIndex::PreClusterIndex(vector<string>& s, int diffs, bool a) : seqs(s), aligned(a) {
+	try {
+		m = MothurOut::getInstance();
+		numPieces = diffs + 1;
+		pieceLength = 0;
+		highestPower = 1;
+		lastSeen.resize(seqs.size(), -1);
+
+		if (seqs.size() == 0) { return; }
+
+		if (aligned) {
+			int length = seqs[0].length();
+			if (length < numPieces) { return; }
+
+			for (int k = 0; k <= numPieces; k++) { pieceStarts.push_back((int)(((long long)k * length) / numPieces)); }
+			pieceLength = pieceStarts[1] - pieceStarts[0];
+
+			pieces.resize(numPieces);
+			for (int i = 0; i < seqs.size(); i++) {
+				if (m->getControl_pressed()) { break; }
+				for (int k = 0; k < numPieces; k++) { addPiece(pieces[k], getHash(seqs[i], pieceStarts[k], pieceStarts[k+1]), i); }
+			}
+		}else {
+			int shortest = seqs[0].length();
+			for (int i = 1; i < seqs.size(); i++) { if (seqs[i].length() < shortest) { shortest = seqs[i].length(); } }
+
+			pieceLength = shortest / numPieces;
+			if (pieceLength == 0) { return; }
+
+			for (int k = 1; k < pieceLength; k++) { highestPower *= hashBase; }
+
+			pieces.resize(1);
+			for (int i = 0; i < seqs.size(); i++) {
+				if (m->getControl_pressed()) { break; }
+
+				//spread the pieces over the whole seq, they don't overlap because the seq is at least numPieces*pieceLength long
+				int length = seqs[i].length();
+				for (int k = 0; k < numPieces; k++) {
+					int start = (int)(((long long)k * length) / numPieces);
+					addPiece(pieces[0], getHash(seqs[i], start, start+pieceLength), i);
+				}
+			}
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "PreClusterIndex", "PreClusterIndex");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+unsigned long long PreClusterIndex::getHash(const string& seq, int start, int end) {
+	unsigned long long hash = 0;
+	for (int i = start; i < end; i++) { hash = hash * hashBase + (unsigned char)seq[i]; }
+	return hash;
+}
+/**************************************************************************************************/
+
+void PreClusterIndex::addPiece(map<unsigned long long, vector<int> >& thesePieces, unsigned long long hash, int index) {
+	try {
+		vector<int>& seqsWithPiece = thesePieces[hash];
+		//a seq can have the same piece more than once, it only needs to be in the list once
+		if ((seqsWithPiece.size() == 0) || (seqsWithPiece.back() != index)) { seqsWithPiece.push_back(index); }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "PreClusterIndex", "addPiece");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+void PreClusterIndex::addCandidates(map<unsigned long long, vector<int> >& thesePieces, unsigned long long hash, int index, vector<int>& candidates) {
+	try {
+		map<unsigned long long, vector<int> >::iterator it = thesePieces.find(hash);
+		if (it == thesePieces.end()) { return; }
+
+		//the seqs were added in order, so the ones after index are at the end
+		vector<int>& seqsWithPiece = it->second;
+		for (vector<int>::iterator itSeq = upper_bound(seqsWithPiece.begin(), seqsWithPiece.end(), index); itSeq != seqsWithPiece.end(); itSeq++) {
+			if (lastSeen[*itSeq] != index) { lastSeen[*itSeq] = index; candidates.push_back(*itSeq); }
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "PreClusterIndex", "addCandidates");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+void PreClusterIndex::getCandidates(int index, vector<int>& candidates) {
+	try {
+		candidates.clear();
+
+		if (pieceLength == 0) {
+			for (int j = index+1; j < seqs.size(); j++) { candidates.push_back(j); }
+			return;
+		}
+
+		const string& seq = seqs[index];
+
+		if (aligned) {
+			for (int k = 0; k < numPieces; k++) { addCandidates(pieces[k], getHash(seq, pieceStarts[k], pieceStarts[k+1]), index, candidates); }
+		}else {
+			//look up every window of pieceLength bases, rolling the hash along the seq
+			if (seq.length() < pieceLength) { return; }
+
+			unsigned long long hash = getHash(seq, 0, pieceLength);
+			addCandidates(pieces[0], hash, index, candidates);
+
+			for (int i = pieceLength; i < seq.length(); i++) {
+				if (m->getControl_pressed()) { break; }
+				hash = (hash - (unsigned char)seq[i-pieceLength] * highestPower) * hashBase + (unsigned char)seq[i];
+				addCandidates(pieces[0], hash, index, candidates);
+			}
+		}
+
+		sort(candidates.begin(), candidates.end());
+	}
+	catch(exception& e) {
+		m->errorOut(e, "PreClusterIndex", "getCandidates");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
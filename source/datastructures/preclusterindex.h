@@ -0,0 +1,54 @@
+#ifndef PRECLUSTERINDEX_H
+#define PRECLUSTERINDEX_H
+
+/*
+ *  preclusterindex.h
+ *  Mothur
+ *
+ *  Finds the sequences pre.cluster could merge without comparing every pair. If two sequences are within diffs of
+ *  eachother and you cut one of them into diffs+1 pieces, at least one of the pieces has no differences in it.
+ *
+ *  For aligned sequences the pieces are the same columns in every sequence, so a sequence is a candidate if it
+ *  has the same bases as you in one of the column ranges.  For unaligned sequences the less abundant sequence is
+ *  aligned to the more abundant one with free end gaps, so the pieces can be anywhere in the other sequence.
+ *  Each sequence is cut into diffs+1 pieces of the same length and a sequence is a candidate if one of its pieces
+ *  shows up anywhere in you.
+ *
+ *  The pieces are hashed, so a candidate may still be too far away, but a sequence that is not a candidate is
+ *  always too far away.  You still need to count the mismatches of the candidates.
+ *
+ */
+
+#include "mothurout.h"
+
+/**************************************************************************************************/
+
+class PreClusterIndex {
+
+public:
+	PreClusterIndex(vector<string>&, int, bool);	//seqs in the order you will search them, diffs, aligned
+	~PreClusterIndex() {}
+
+	//fills candidates with the indexes after seq that could be within diffs of it, in increasing order.
+	//for unaligned seqs these are the seqs that could be aligned to seq.
+	void getCandidates(int, vector<int>&);
+
+private:
+	MothurOut* m;
+	vector<string> seqs;
+	int numPieces, pieceLength;	//pieceLength is 0 if the seqs are too short to cut, then everyone is a candidate
+	bool aligned;
+
+	vector<int> pieceStarts;	//aligned: the first column of each piece, plus one past the end
+	vector< map<unsigned long long, vector<int> > > pieces;	//aligned: one map per column range. unaligned: one map for all the pieces.
+	unsigned long long highestPower;	//hashBase^(pieceLength-1)
+	vector<int> lastSeen;
+
+	unsigned long long getHash(const string&, int, int);
+	void addPiece(map<unsigned long long, vector<int> >&, unsigned long long, int);
+	void addCandidates(map<unsigned long long, vector<int> >&, unsigned long long, int, vector<int>&);
+};
+
+/**************************************************************************************************/
+
+#endif
@@ -401,31 +401,57 @@ string Sequence::getSequenceName(istringstream& fastaFile) {
 	}
 }
 //********************************************************************************************************************
-string Sequence::getSequenceString(ifstream& fastaFile, int& numAmbig) {
+//what each character in a fasta file becomes in the sequence, 0 if it's skipped. spaces and non printing characters
+//are skipped, U's are T's and anything that isn't a base, '.' or '-' is an 'N'.
+vector<char> fillSequenceCharTable() {
+    vector<char> table(256, 0);
+    for (int i = 0; i < 256; i++) {
+        if ((i == ' ') || !isprint(i)) { continue; }
+        char letter = toupper(i);
+        if(letter == 'U'){letter = 'T';}
+        if(letter != '.' && letter != '-' && letter != 'A' && letter != 'T' && letter != 'G'  && letter != 'C' && letter != 'N'){
+            letter = 'N';
+        }
+        table[i] = letter;
+    }
+    return table;
+}
+static const vector<char> sequenceCharTable = fillSequenceCharTable();
+//********************************************************************************************************************
+//reads up to the next '>' with one std::getline, which searches the stream's buffer for it instead of reading a character
+//at a time, then converts the characters with the table
+string Sequence::readSequenceString(istream& fastaFile, int& numAmbig) {
 	try {
-		char letter;
-		string sequence = "";	
+		string sequence = "";
 		numAmbig = 0;
-		
-		while(fastaFile){
-			letter= fastaFile.get();
-			if(letter == '>'){
-				fastaFile.putback(letter);
-				break;
-			}else if (letter == ' ') {;}
-			else if(isprint(letter)){
-				letter = toupper(letter);
-				if(letter == 'U'){letter = 'T';}
-				if(letter != '.' && letter != '-' && letter != 'A' && letter != 'T' && letter != 'G'  && letter != 'C' && letter != 'N'){
-					letter = 'N';
-					numAmbig++;
-				}
-				sequence += letter;
-			}
+
+		if (!fastaFile) { return sequence; }
+
+		string chunk = "";
+		std::getline(fastaFile, chunk, '>');
+		if (fastaFile.eof())	{	fastaFile.setstate(ios::failbit);	}
+		else					{	fastaFile.putback('>');				}
+
+		sequence.reserve(chunk.length());
+		for (int i = 0; i < chunk.length(); i++) {
+			char letter = sequenceCharTable[(unsigned char)chunk[i]];
+			if (letter == 0) { continue; }
+			if ((letter == 'N') && (chunk[i] != 'N') && (chunk[i] != 'n')) { numAmbig++; }
+			sequence += letter;
 		}
-		
+
 		return sequence;
 	}
+	catch(exception& e) {
+		m->errorOut(e, "Sequence", "readSequenceString");
+		exit(1);
+	}
+}
+//********************************************************************************************************************
+string Sequence::getSequenceString(ifstream& fastaFile, int& numAmbig) {
+	try {
+		return readSequenceString(fastaFile, numAmbig);
+	}
 	catch(exception& e) {
 		m->errorOut(e, "Sequence", "getSequenceString");
 		exit(1);
@@ -435,28 +461,7 @@ string Sequence::getSequenceString(ifstream& fastaFile, int& numAmbig) {
 #ifdef USE_BOOST
 string Sequence::getSequenceString(boost::iostreams::filtering_istream& fastaFile, int& numAmbig) {
     try {
-        char letter;
-        string sequence = "";
-        numAmbig = 0;
-        
-        while(fastaFile){
-            letter= fastaFile.get();
-            if(letter == '>'){
-                fastaFile.putback(letter);
-                break;
-            }else if (letter == ' ') {;}
-            else if(isprint(letter)){
-                letter = toupper(letter);
-                if(letter == 'U'){letter = 'T';}
-                if(letter != '.' && letter != '-' && letter != 'A' && letter != 'T' && letter != 'G'  && letter != 'C' && letter != 'N'){
-                    letter = 'N';
-                    numAmbig++;
-                }
-                sequence += letter;
-            }
-        }
-        
-        return sequence;
+        return readSequenceString(fastaFile, numAmbig);
     }
     catch(exception& e) {
         m->errorOut(e, "Sequence", "getSequenceString");
@@ -517,29 +522,7 @@ string Sequence::getCommentString(boost::iostreams::filtering_istream& fastaFile
 //********************************************************************************************************************
 string Sequence::getSequenceString(istringstream& fastaFile, int& numAmbig) {
 	try {
-		char letter;
-		string sequence = "";
-		numAmbig = 0;
-		
-		while(!fastaFile.eof()){
-			letter= fastaFile.get();
-	
-			if(letter == '>'){
-				fastaFile.putback(letter);
-				break;
-			}else if (letter == ' ') {;}
-			else if(isprint(letter)){
-				letter = toupper(letter);
-				if(letter == 'U'){letter = 'T';}
-				if(letter != '.' && letter != '-' && letter != 'A' && letter != 'T' && letter != 'G'  && letter != 'C' && letter != 'N'){
-					letter = 'N';
-					numAmbig++;
-				}
-				sequence += letter;
-			}
-		}
-		
-		return sequence;
+		return readSequenceString(fastaFile, numAmbig);
 	}
 	catch(exception& e) {
 		m->errorOut(e, "Sequence", "getSequenceString");
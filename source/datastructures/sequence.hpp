@@ -81,6 +81,7 @@ public:
 private:
 	MothurOut* m;
 	void initialize();
+	string readSequenceString(istream&, int&);
 	string getSequenceString(ifstream&, int&);
 	string getCommentString(ifstream&);
 	string getSequenceString(istringstream&, int&);
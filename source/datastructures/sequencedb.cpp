@@ -15,34 +15,35 @@
 
 /***********************************************************************/
 
-SequenceDB::SequenceDB() {  m = MothurOut::getInstance();  length = 0; samelength = true; }
+SequenceDB::SequenceDB() {  m = MothurOut::getInstance();  length = 0; samelength = true; offsets.push_back(0); }
 /***********************************************************************/
 //the clear function free's the memory
-SequenceDB::~SequenceDB() { data.clear(); }
+SequenceDB::~SequenceDB() { names.clear(); bases.clear(); offsets.clear(); firstBases.clear(); lastBases.clear(); }
 
 /***********************************************************************/
 
 SequenceDB::SequenceDB(int newSize) {
-	data.resize(newSize, Sequence());
+	m = MothurOut::getInstance();
 	length = 0; samelength = true;
+	names.resize(newSize, "");
+	bases.resize(newSize, '\0');
+	for (int i = 0; i <= newSize; i++) { offsets.push_back(i); }
+	firstBases.resize(newSize, 0); lastBases.resize(newSize, 0);
 }
 
 /***********************************************************************/
 
 SequenceDB::SequenceDB(ifstream& filehandle) {
 	try{
-		length = 0; samelength = true;
+		m = MothurOut::getInstance();
+		length = 0; samelength = true; offsets.push_back(0);
         Utils util;
 		//read through file
 		while (!filehandle.eof()) {
 			//input sequence info into sequencedb
 			Sequence newSequence(filehandle);
 			
-			if (newSequence.getName() != "") {   
-				if (length == 0) { length = newSequence.getAligned().length(); }
-                if (length != newSequence.getAligned().length()) { samelength = false;  }
-				data.push_back(newSequence);  
-			}
+			if (newSequence.getName() != "") { push_back(newSequence); }
 			
 			//takes care of white space
 			util.gobble(filehandle);
@@ -59,21 +60,28 @@ SequenceDB::SequenceDB(ifstream& filehandle) {
 /***********************************************************************/
 
 int SequenceDB::getNumSeqs() {
-	return data.size();
+	return names.size();
 }
 
 /***********************************************************************/
 Sequence SequenceDB::get(int index) {
-	return data[index];
+	return Sequence(names[index], string(getAligned(index), getAlignedLength(index)));
 }
 /***********************************************************************/
 
 void SequenceDB::push_back(Sequence newSequence) {
 	try {
-		if (length == 0) { length = newSequence.getAligned().length(); }
-		if (length != newSequence.getAligned().length()) { samelength = false; }
+		string aligned = newSequence.getAligned();
+		
+		if (length == 0) { length = aligned.length(); }
+		if (length != aligned.length()) { samelength = false; }
 
-		data.push_back(newSequence);
+		names.push_back(newSequence.getName());
+		bases.insert(bases.end(), aligned.begin(), aligned.end());
+		bases.push_back('\0');
+		offsets.push_back(bases.size());
+		firstBases.push_back(findFirstBase(aligned.c_str(), aligned.length()));
+		lastBases.push_back(findLastBase(aligned.c_str(), aligned.length()));
 	}
 	catch(exception& e) {
 		m->errorOut(e, "SequenceDB", "push_back");
@@ -11,7 +11,8 @@
  */
 
 
-/* This class is a container to store the sequences. */
+/* This class is a container to store the sequences. The aligned sequences are stored back to back in one buffer,
+ so the distance calculators can read them in place with getAligned(index) instead of copying a Sequence for each pair. */
 
 
 #include "sequence.hpp"
@@ -24,16 +25,25 @@ public:
 	SequenceDB();
 	SequenceDB(int);           //makes data that size
 	SequenceDB(ifstream&);	   //reads file to fill data
-	SequenceDB(const SequenceDB& sdb) : data(sdb.data) {};
+	SequenceDB(const SequenceDB& sdb) : names(sdb.names), bases(sdb.bases), offsets(sdb.offsets), firstBases(sdb.firstBases), lastBases(sdb.lastBases), samelength(sdb.samelength), length(sdb.length) { m = MothurOut::getInstance(); };
 	~SequenceDB();             //loops through data and delete each sequence
 
 	int getNumSeqs();
     Sequence get(int);         //returns sequence name at that location
 	void push_back(Sequence);  //adds unaligned sequence
 	bool sameLength() { return samelength; }
+    
+    string getName(int index)                   { return names[index];                                  }
+    const char* getAligned(int index)           { return &bases[offsets[index]];                        }
+    int getAlignedLength(int index)             { return (int)(offsets[index+1] - offsets[index] - 1);  }
+    int getFirstBase(int index)                 { return firstBases[index];                             }   //first column that isn't '.'
+    int getLastBase(int index)                  { return lastBases[index];                              }   //one past the last column that isn't '.'
 		
 private:
-	vector<Sequence> data;
+	vector<string> names;
+	vector<char> bases;             //aligned sequences, each followed by a '\0'
+	vector<long long> offsets;      //start of each sequence in bases, offsets[numSeqs] is the size of bases
+	vector<int> firstBases, lastBases;
 	MothurOut* m;
 	bool samelength;
 	int length;
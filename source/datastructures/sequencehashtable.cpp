@@ -0,0 +1,208 @@
+/*
+ *  sequencehashtable.cpp
+ *  Mothur
+ *
+ */
+
+#include "sequencehashtable.h"
+
+//the strings are found by block and offset, so a block can grow. a new block is started when the last one is full
+//so that adding a string never copies more than one block.
+static const unsigned long long hashTableBlockSize = 64 * 1024 * 1024;
+
+/**************************************************************************************************/
+
+static inline unsigned long long rotateLeft(unsigned long long x, int r) { return (x << r) | (x >> (64 - r)); }
+
+static inline unsigned long long finalMix(unsigned long long k) {
+	k ^= k >> 33; k *= 0xff51afd7ed558ccdULL;
+	k ^= k >> 33; k *= 0xc4ceb9fe1a85ec53ULL;
+	k ^= k >> 33;
+	return k;
+}
+/**************************************************************************************************/
+
+SequenceHashTable::SequenceHashTable() {
+	try {
+		m = MothurOut::getInstance();
+		slots.resize(1024, -1);
+		slotMask = slots.size()-1;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SequenceHashTable", "SequenceHashTable");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//MurmurHash3 x64 128
+SequenceHash SequenceHashTable::getHash(const string& s) {
+	try {
+		const unsigned char* data = (const unsigned char*)s.data();
+		int length = (int)s.length();
+		int numBlocks = length / 16;
+
+		unsigned long long h1 = 0; unsigned long long h2 = 0;
+		const unsigned long long c1 = 0x87c37b91114253d5ULL;
+		const unsigned long long c2 = 0x4cf5ad432745937fULL;
+
+		for (int i = 0; i < numBlocks; i++) {
+			unsigned long long k1, k2;
+			memcpy(&k1, data + (i * 16), 8);
+			memcpy(&k2, data + (i * 16) + 8, 8);
+
+			k1 *= c1; k1 = rotateLeft(k1, 31); k1 *= c2; h1 ^= k1;
+			h1 = rotateLeft(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+			k2 *= c2; k2 = rotateLeft(k2, 33); k2 *= c1; h2 ^= k2;
+			h2 = rotateLeft(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+		}
+
+		const unsigned char* tail = data + (numBlocks * 16);
+		unsigned long long k1 = 0; unsigned long long k2 = 0;
+		int tailLength = length & 15;
+
+		for (int i = tailLength-1; i >= 8; i--) { k2 ^= ((unsigned long long)tail[i]) << ((i - 8) * 8); }
+		if (tailLength > 8) { k2 *= c2; k2 = rotateLeft(k2, 33); k2 *= c1; h2 ^= k2; }
+
+		for (int i = min(tailLength, 8)-1; i >= 0; i--) { k1 ^= ((unsigned long long)tail[i]) << (i * 8); }
+		if (tailLength > 0) { k1 *= c1; k1 = rotateLeft(k1, 31); k1 *= c2; h1 ^= k1; }
+
+		h1 ^= (unsigned long long)length; h2 ^= (unsigned long long)length;
+		h1 += h2; h2 += h1;
+		h1 = finalMix(h1); h2 = finalMix(h2);
+		h1 += h2; h2 += h1;
+
+		SequenceHash hash; hash.first = h1; hash.second = h2;
+		return hash;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SequenceHashTable", "getHash");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+bool SequenceHashTable::isSame(int index, const string& s) {
+	try {
+		if (lengths[index] != s.length()) { return false; }
+
+		const string& block = blocks[starts[index] >> 32];
+		unsigned long long offset = starts[index] & 0xFFFFFFFFULL;
+
+		return (block.compare(offset, lengths[index], s) == 0);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SequenceHashTable", "isSame");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+int SequenceHashTable::store(const string& s, SequenceHash& hash) {
+	try {
+		//strings longer than a block get a block of their own
+		if ((blocks.size() == 0) || ((blocks.back().length() != 0) && ((blocks.back().length() + s.length()) > hashTableBlockSize))) {
+			blocks.push_back("");
+		}
+
+		unsigned long long blockIndex = blocks.size()-1;
+		unsigned long long offset = blocks.back().length();
+		blocks.back().append(s);
+
+		starts.push_back((blockIndex << 32) | offset);
+		lengths.push_back((int)s.length());
+		hashes.push_back(hash);
+
+		return (int)lengths.size()-1;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SequenceHashTable", "store");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+int SequenceHashTable::findSlot(const SequenceHash& hash, const string& s) {
+	try {
+		unsigned long long slot = hash.first & slotMask;
+
+		while (slots[slot] != -1) {
+			int index = slots[slot];
+			if ((hashes[index] == hash) && isSame(index, s)) { break; }
+			slot = (slot + 1) & slotMask;
+		}
+
+		return (int)slot;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SequenceHashTable", "findSlot");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+void SequenceHashTable::resize() {
+	try {
+		slots.assign(slots.size() * 2, -1);
+		slotMask = slots.size()-1;
+
+		//the strings are all different, so each one goes in the first empty slot from its hash
+		for (int index = 0; index < hashes.size(); index++) {
+			unsigned long long slot = hashes[index].first & slotMask;
+			while (slots[slot] != -1) { slot = (slot + 1) & slotMask; }
+			slots[slot] = index;
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SequenceHashTable", "resize");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+int SequenceHashTable::add(const string& s, bool& isNew) {
+	try {
+		SequenceHash hash = getHash(s);
+
+		int slot = findSlot(hash, s);
+		if (slots[slot] != -1) { isNew = false; return slots[slot]; }
+
+		isNew = true;
+		int index = store(s, hash);
+		slots[slot] = index;
+
+		if ((2 * (unsigned long long)lengths.size()) > slots.size()) { resize(); }
+
+		return index;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SequenceHashTable", "add");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+int SequenceHashTable::find(const string& s) {
+	try {
+		return slots[findSlot(getHash(s), s)];
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SequenceHashTable", "find");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+string SequenceHashTable::get(int index) {
+	try {
+		const string& block = blocks[starts[index] >> 32];
+		unsigned long long offset = starts[index] & 0xFFFFFFFFULL;
+
+		return block.substr(offset, lengths[index]);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SequenceHashTable", "get");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
@@ -0,0 +1,64 @@
+#ifndef SEQUENCEHASHTABLE_H
+#define SEQUENCEHASHTABLE_H
+
+/*
+ *  sequencehashtable.h
+ *  Mothur
+ *
+ *  Keeps one copy of each different string it is given and numbers them in the order they were added. It is used to
+ *  dereplicate sequences and to look up sequence names without a tree of string copies.
+ *
+ *  The strings are stored back to back in large blocks. The lookup is on a 128 bit hash of the string in an open
+ *  addressing table, and a match is always checked against the stored copy, so two strings with the same hash are
+ *  still kept apart.
+ *
+ */
+
+#include "mothurout.h"
+
+/**************************************************************************************************/
+
+struct SequenceHash {
+	unsigned long long first, second;
+
+	bool operator==(const SequenceHash& other) const { return ((first == other.first) && (second == other.second)); }
+};
+
+/**************************************************************************************************/
+
+class SequenceHashTable {
+
+#ifdef UNIT_TEST
+	friend class TestSequenceHashTable;
+#endif
+
+public:
+	SequenceHashTable();
+	~SequenceHashTable() {}
+
+	int add(const string&, bool&);	//string, set to true if it was not in the table. returns the index of the string
+	int find(const string&);		//returns the index of the string, or -1 if it is not in the table
+	string get(int);				//index
+	int size() { return (int)lengths.size(); }
+
+private:
+	MothurOut* m;
+
+	vector<string> blocks;
+	vector<unsigned long long> starts;	//block in the high 32 bits, offset into the block in the low 32 bits
+	vector<int> lengths;
+	vector<SequenceHash> hashes;	//for each string
+
+	vector<int> slots;				//index of the string in each slot, -1 if empty. never more than half full.
+	unsigned long long slotMask;	//number of slots - 1, the number of slots is a power of 2
+
+	SequenceHash getHash(const string&);
+	bool isSame(int, const string&);
+	int findSlot(const SequenceHash&, const string&);	//slot of the string, or the empty slot it would go in
+	int store(const string&, SequenceHash&);
+	void resize();
+};
+
+/**************************************************************************************************/
+
+#endif
@@ -46,7 +46,7 @@ class SharedOrderVector : public DataVector {
 public:
 	SharedOrderVector();
 //	SharedOrderVector(int ns, int nb=0, int mr=0)	: DataVector(), data(ns, -1), maxRank(0), numBins(0), numSeqs(0) {};
-	SharedOrderVector(const SharedOrderVector& ov)	: DataVector(ov.label), data(ov.data), maxRank(ov.maxRank), numBins(ov.numBins), numSeqs(ov.numSeqs), needToUpdate(ov.needToUpdate) {if(needToUpdate == 1){	updateStats();}};
+	SharedOrderVector(const SharedOrderVector& ov)	: DataVector(ov.label), data(ov.data), allGroups(ov.allGroups), maxRank(ov.maxRank), numBins(ov.numBins), numSeqs(ov.numSeqs), needToUpdate(ov.needToUpdate) {if(needToUpdate == 1){	updateStats();}};
 
 	SharedOrderVector(string, vector<individual>);
 	SharedOrderVector(ifstream&, vector<string>&, string&);
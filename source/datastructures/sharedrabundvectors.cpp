@@ -15,68 +15,65 @@ SharedRAbundVectors::SharedRAbundVectors(ifstream& f, vector<string>& userGroups
     try {
         printSharedHeaders = true;
         int num, count;
-        count = 0;
-        string holdLabel, nextLabel, groupN;
+        count = 0; numBins = 0;
+        string holdLabel, groupN;
         int numUserGroups = userGroups.size();
         
         for (int i = 0; i < lookup.size(); i++) {  if (lookup[i] != NULL) { delete lookup[i];  lookup[i] = NULL; } }  lookup.clear();
         
+        //no labels left, numBins = 0 tells the caller the file is done
+        if (f.eof()) { return; }
+        
         //are we at the beginning of the file??
-        if (nextLabel == "") {
-            f >> label;
+        if (nextLabel == "") { f >> label; }
+        else { label = nextLabel; }
+        
+        //is this a shared file that has headers. make.shared writes a header line before each label
+        if (label == "label") {
+            //gets "group"
+            f >> label; util.gobble(f);
             
-            //is this a shared file that has headers
-            if (label == "label") {
-                //gets "group"
-                f >> label; util.gobble(f);
-                
-                //gets "numOtus"
-                f >> label; util.gobble(f);
-                
-                //eat rest of line
-                label = util.getline(f); util.gobble(f);
-                
-                //parse labels to save
-                istringstream iStringStream(label);
-                while(!iStringStream.eof()){
-                    if (m->getControl_pressed()) { break; }
-                    string temp;
-                    iStringStream >> temp;  util.gobble(iStringStream);
-                    
-                    currentLabels.push_back(temp);
-                }
-                
-                if (currentLabels.size() != 0) {
-                    string binLabelTag = currentLabels[0];
-                    labelTag = "";
-                    for (int i = 0; i < binLabelTag.length(); i++) { if (isalpha(binLabelTag[i])){ labelTag += binLabelTag[i]; } }
-                }
-                
-                f >> label >> groupN >> num;
-            }else {
-                //read in first row since you know there is at least 1 group.
-                f >> groupN >> num;
+            //gets "numOtus"
+            f >> label; util.gobble(f);
+            
+            //eat rest of line
+            label = util.getline(f); util.gobble(f);
+            
+            //parse labels to save
+            istringstream iStringStream(label);
+            while(!iStringStream.eof()){
+                if (m->getControl_pressed()) { break; }
+                string temp;
+                iStringStream >> temp;  util.gobble(iStringStream);
                 
-                //make binlabels because we don't have any
-                string snumBins = toString(num);
-                if (labelTag == "") { labelTag = "Otu"; }
-                for (int i = 0; i < num; i++) {
-                    //if there is a bin label use it otherwise make one
-                    string binLabel = labelTag;
-                    string sbinNumber = toString(i+1);
-                    if (sbinNumber.length() < snumBins.length()) {
-                        int diff = snumBins.length() - sbinNumber.length();
-                        for (int h = 0; h < diff; h++) { binLabel += "0"; }
-                    }
-                    binLabel += sbinNumber;
-                    currentLabels.push_back(binLabel);
-                }
+                currentLabels.push_back(temp);
             }
-        }else {
-            label = nextLabel;
             
+            if (currentLabels.size() != 0) {
+                string binLabelTag = currentLabels[0];
+                labelTag = "";
+                for (int i = 0; i < binLabelTag.length(); i++) { if (isalpha(binLabelTag[i])){ labelTag += binLabelTag[i]; } }
+            }
+            
+            f >> label >> groupN >> num;
+        }else {
             //read in first row since you know there is at least 1 group.
             f >> groupN >> num;
+            
+            //make binlabels because we don't have any
+            string snumBins = toString(num);
+            if (labelTag == "") { labelTag = "Otu"; }
+            for (int i = 0; i < num; i++) {
+                //if there is a bin label use it otherwise make one
+                string binLabel = labelTag;
+                string sbinNumber = toString(i+1);
+                if (sbinNumber.length() < snumBins.length()) {
+                    int diff = snumBins.length() - sbinNumber.length();
+                    for (int h = 0; h < diff; h++) { binLabel += "0"; }
+                }
+                binLabel += sbinNumber;
+                currentLabels.push_back(binLabel);
+            }
         }
         
         //reset labels, currentLabels may have gotten changed as otus were eliminated because of group choices or sampling
@@ -49,6 +49,7 @@ public:
     vector<string> getOTUNames();
     string getOTUName(int);
     void setOTUName(int, string);
+    void setOTUTag(string t) { otuTag = t; }
     
     void eliminateZeroOTUS(); //run after push_backs if groups are chosen
     
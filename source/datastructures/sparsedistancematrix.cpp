@@ -23,6 +23,7 @@ int SparseDistanceMatrix::getNNodes(){
 void SparseDistanceMatrix::clear(){
     for (int i = 0; i < seqVec.size(); i++) {  seqVec[i].clear();  }
     seqVec.clear();
+    rowMins.clear(); minRows.clear(); changedRows.clear(); changedRowList.clear();
 }
 
 /***********************************************************************/
@@ -36,14 +37,12 @@ int SparseDistanceMatrix::updateCellCompliment(ull row, ull col){
     try {
         
         ull vrow = seqVec[row][col].index;
-        ull vcol = 0;
         
         //find the columns entry for this cell as well
-        for (int i = 0; i < seqVec[vrow].size(); i++) {  
-            if (seqVec[vrow][i].index == row) { vcol = i;  break; }  
-        }
+        ull vcol = findCell(vrow, row);
        
         seqVec[vrow][vcol].dist = seqVec[row][col].dist;
+        setChanged(row); setChanged(vrow);
         
         return 0;
     }
@@ -59,13 +58,13 @@ int SparseDistanceMatrix::rmCell(ull row, ull col){
         numNodes-=2;
  
         ull vrow = seqVec[row][col].index;
-        ull vcol = 0;
         
         //find the columns entry for this cell as well
-        for (int i = 0; i < seqVec[vrow].size(); i++) {  if (seqVec[vrow][i].index == row) { vcol = i;  break; }  }
+        ull vcol = findCell(vrow, row);
         
         seqVec[vrow].erase(seqVec[vrow].begin()+vcol);
         seqVec[row].erase(seqVec[row].begin()+col);
+        setChanged(row); setChanged(vrow);
  
 		return(0);
     }
@@ -83,6 +82,7 @@ void SparseDistanceMatrix::addCell(ull row, PDistCell cell){
         seqVec[row].push_back(cell);
         PDistCell temp(row, cell.dist);
         seqVec[cell.index].push_back(temp);
+        setChanged(row); setChanged(cell.index);
 	}
 	catch(exception& e) {
 		m->errorOut(e, "SparseDistanceMatrix", "addCell");
@@ -95,15 +95,26 @@ int SparseDistanceMatrix::addCellSorted(ull row, PDistCell cell){
 		numNodes+=2;
 		if(cell.dist < smallDist){ smallDist = cell.dist; }
         
-        seqVec[row].push_back(cell);
         PDistCell temp(row, cell.dist);
-        seqVec[cell.index].push_back(temp);
+        setChanged(row); setChanged(cell.index);
+        
+        if (!sorted) {
+            seqVec[row].push_back(cell);
+            seqVec[cell.index].push_back(temp);
+            
+            sortSeqVec(row);
+            sortSeqVec(cell.index);
+            
+            return findCell(row, cell.index); //find location of new cell when sorted
+        }
         
-        sortSeqVec(row);
-        sortSeqVec(cell.index);
+        //the rows are already sorted, so put the cells in place
+        vector<PDistCell>::iterator it = upper_bound(seqVec[cell.index].begin(), seqVec[cell.index].end(), temp, compareIndexes);
+        seqVec[cell.index].insert(it, temp);
         
-        int location = -1; //find location of new cell when sorted
-        for (int i = 0; i < seqVec[row].size(); i++) {  if (seqVec[row][i].index == cell.index) { location = i; break; } }
+        it = upper_bound(seqVec[row].begin(), seqVec[row].end(), cell, compareIndexes);
+        int location = it - seqVec[row].begin();
+        seqVec[row].insert(it, cell);
         
         return location;
 	}
@@ -117,33 +128,34 @@ int SparseDistanceMatrix::addCellSorted(ull row, PDistCell cell){
 
 ull SparseDistanceMatrix::getSmallestCell(ull& row){
 	try {
-        if (!sorted) { sortSeqVec(); sorted = true; }
+        if (!sorted) {
+            sortSeqVec(); sorted = true;
+            for (int i = 0; i < seqVec.size(); i++) { setChanged(i); }
+        }
+        updateRowMins();
         
         vector<PDistCellMin> mins;
         smallDist = 1e6;
-       
-        for (int i = 0; i < seqVec.size(); i++) {
+        if (minRows.size() != 0) { smallDist = minRows.begin()->first; }
+        
+        //the rows with the smallest distance come out of minRows in order, so the cells are found in the same order as
+        //a search of the whole matrix
+        for (set< pair<float, ull> >::iterator it = minRows.begin(); it != minRows.end(); it++) {
+            
+            if (m->getControl_pressed()) { return smallDist; }
+            if (it->first != smallDist) { break; }
+            
+            ull i = it->second;
+            
+            //rows are sorted with the largest indexes first, so stop at the first cell below the diagonal
             for (int j = 0; j < seqVec[i].size(); j++) {
-                
-                if (m->getControl_pressed()) { return smallDist; }
-                
-                //already checked everyone else in row
-                if (i < seqVec[i][j].index) {  
-			    
-                    float dist = seqVec[i][j].dist;
-                  
-                    if(dist < smallDist){  //found a new smallest distance
-                        mins.clear();
-                        smallDist = dist;
-                        PDistCellMin temp(i, seqVec[i][j].index);
-                        mins.push_back(temp);  
-                    }
-                    else if(dist == smallDist){  //if a subsequent distance is the same as mins distance add the new iterator to the mins vector
+                if (i < seqVec[i][j].index) {
+                    if (seqVec[i][j].dist == smallDist) {
                         PDistCellMin temp(i, seqVec[i][j].index);
-                        mins.push_back(temp); 
+                        mins.push_back(temp);
                     }
-                }else { j+=seqVec[i].size(); } //stop looking 
-			}
+                }else { break; }
+            }
 		}
         
 		util.mothurRandomShuffle(mins);  //randomize the order of the iterators in the mins vector
@@ -160,6 +172,63 @@ ull SparseDistanceMatrix::getSmallestCell(ull& row){
 }
 /***********************************************************************/
 
+void SparseDistanceMatrix::setChanged(ull row){
+	try {
+        if (row >= changedRows.size()) { changedRows.resize(seqVec.size(), false); rowMins.resize(seqVec.size(), -1.0); }
+        
+        if (!changedRows[row]) { changedRows[row] = true; changedRowList.push_back(row); }
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SparseDistanceMatrix", "setChanged");
+		exit(1);
+	}
+}
+/***********************************************************************/
+
+void SparseDistanceMatrix::updateRowMins(){
+	try {
+        for (int k = 0; k < changedRowList.size(); k++) {
+            ull row = changedRowList[k];
+            changedRows[row] = false;
+            
+            if (rowMins[row] != -1.0) { minRows.erase(make_pair(rowMins[row], row)); }
+            
+            rowMins[row] = -1.0;
+            for (int j = 0; j < seqVec[row].size(); j++) {
+                if (row < seqVec[row][j].index) {
+                    if ((rowMins[row] == -1.0) || (seqVec[row][j].dist < rowMins[row])) { rowMins[row] = seqVec[row][j].dist; }
+                }else { break; }
+            }
+            
+            if (rowMins[row] != -1.0) { minRows.insert(make_pair(rowMins[row], row)); }
+        }
+        changedRowList.clear();
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SparseDistanceMatrix", "updateRowMins");
+		exit(1);
+	}
+}
+/***********************************************************************/
+
+ull SparseDistanceMatrix::findCell(ull row, ull index){
+	try {
+        if (sorted) {
+            PDistCell temp(index, 0);
+            return (lower_bound(seqVec[row].begin(), seqVec[row].end(), temp, compareIndexes) - seqVec[row].begin());
+        }
+        
+        for (int i = 0; i < seqVec[row].size(); i++) {  if (seqVec[row][i].index == index) { return i; }  }
+        
+        return 0;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SparseDistanceMatrix", "findCell");
+		exit(1);
+	}
+}
+/***********************************************************************/
+
 int SparseDistanceMatrix::sortSeqVec(){
 	try {
         
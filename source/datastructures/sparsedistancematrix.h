@@ -29,7 +29,7 @@ public:
 	
 	int rmCell(ull, ull);
     int updateCellCompliment(ull, ull);
-    void resize(ull n) { seqVec.resize(n);  }
+    void resize(ull n) { seqVec.resize(n); rowMins.resize(n, -1.0); changedRows.resize(n, false); }
     void clear();
 	void addCell(ull, PDistCell);
     int addCellSorted(ull, PDistCell);
@@ -43,6 +43,16 @@ private:
     bool sorted;
     int sortSeqVec();
     int sortSeqVec(int);
+    
+    //smallest distance to a larger index for each row, -1 if none. minRows orders the rows by it, so getSmallestCell
+    //only has to look at the rows holding the smallest distance. Rows changed since the last search are rechecked first.
+    vector<float> rowMins;
+    set< pair<float, ull> > minRows;
+    vector<bool> changedRows;
+    vector<ull> changedRowList;
+    void setChanged(ull);
+    void updateRowMins();
+    ull findCell(ull, ull); //row, index of the column. returns the cells location in the row
 	float smallDist, aboveCutoff;
     
 	MothurOut* m;
@@ -0,0 +1,340 @@
+/*
+ *  sparsesharedfile.cpp
+ *  Mothur
+ *
+ */
+
+#include "sparsesharedfile.h"
+
+static const string sparseSharedMagic = "MTHRSPS1";
+
+/**************************************************************************************************/
+
+static inline void writeInt(ofstream& out, int value) { out.write((const char*)&value, sizeof(int)); }
+static inline void writeLong(ofstream& out, long long value) { out.write((const char*)&value, sizeof(long long)); }
+static inline void writeString(ofstream& out, const string& value) { writeInt(out, (int)value.length()); out.write(value.c_str(), value.length()); }
+
+static inline int readInt(ifstream& in) { int value = 0; in.read((char*)&value, sizeof(int)); return value; }
+static inline long long readLong(ifstream& in) { long long value = 0; in.read((char*)&value, sizeof(long long)); return value; }
+//strings longer than the bytes left before end are not read, and leave the stream failed
+static inline string readString(ifstream& in, long long end) {
+	int length = readInt(in);
+	if ((length <= 0) || (!in)) { return ""; }
+	if (length > end - (long long)in.tellg()) { in.setstate(ios::failbit); return ""; }
+	string value(length, ' ');
+	in.read(&value[0], length);
+	return value;
+}
+/**************************************************************************************************/
+
+SparseSharedFile::SparseSharedFile() {
+	try {
+		m = MothurOut::getInstance();
+		nextLabel = 0;
+		namesOffset = 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SparseSharedFile", "SparseSharedFile");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+SparseSharedFile::~SparseSharedFile() {
+	if (out.is_open()) { closeOutput(); }
+	if (in.is_open()) { in.close(); }
+}
+/**************************************************************************************************/
+
+bool SparseSharedFile::isSparse(string filename) {
+	try {
+		ifstream test;
+		test.open(util.getFullPathName(filename).c_str(), ios::binary);
+		if (!test) { return false; }
+
+		char magic[8];
+		test.read(magic, 8);
+		bool sparse = (test.gcount() == 8) && (string(magic, 8) == sparseSharedMagic);
+		test.close();
+
+		return sparse;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SparseSharedFile", "isSparse");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+bool SparseSharedFile::openOutput(string filename) {
+	try {
+		labels.clear(); offsets.clear(); otuNames.clear();
+
+		if (!util.openOutputFileBinary(filename, out)) { return false; }
+
+		out.write(sparseSharedMagic.c_str(), 8);
+
+		return true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SparseSharedFile", "openOutput");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+void SparseSharedFile::write(SharedRAbundVectors* shared) {
+	try {
+		//the names in a text shared file come from its first header line
+		if (labels.size() == 0) { otuNames = shared->getOTUNames(); }
+
+		labels.push_back(shared->getLabel());
+		offsets.push_back((long long)out.tellp());
+
+		vector<SharedRAbundVector*> data = shared->getSharedRAbundVectors();
+		int numBins = shared->getNumBins();
+
+		writeString(out, shared->getLabel());
+		writeInt(out, numBins);
+		writeInt(out, (int)data.size());
+		for (int i = 0; i < data.size(); i++) { writeString(out, data[i]->getGroup()); }
+
+		vector<long long> rowStarts(1, 0);
+		vector<int> otus, counts;
+		for (int i = 0; i < data.size(); i++) {
+			for (int j = 0; j < numBins; j++) {
+				int abund = data[i]->get(j);
+				if (abund != 0) { otus.push_back(j); counts.push_back(abund); }
+			}
+			rowStarts.push_back((long long)otus.size());
+			delete data[i];
+		}
+
+		out.write((const char*)&rowStarts[0], rowStarts.size() * sizeof(long long));
+		if (otus.size() != 0) {
+			out.write((const char*)&otus[0], otus.size() * sizeof(int));
+			out.write((const char*)&counts[0], counts.size() * sizeof(int));
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SparseSharedFile", "write");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+void SparseSharedFile::closeOutput() {
+	try {
+		long long namesOffset = (long long)out.tellp();
+		writeInt(out, (int)otuNames.size());
+		for (int i = 0; i < otuNames.size(); i++) { writeString(out, otuNames[i]); }
+
+		long long labelsOffset = (long long)out.tellp();
+		writeInt(out, (int)labels.size());
+		for (int i = 0; i < labels.size(); i++) { writeString(out, labels[i]); writeLong(out, offsets[i]); }
+
+		writeLong(out, namesOffset);
+		writeLong(out, labelsOffset);
+		out.write(sparseSharedMagic.c_str(), 8);
+
+		out.close();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SparseSharedFile", "closeOutput");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+bool SparseSharedFile::openInput(string filename) {
+	try {
+		labels.clear(); offsets.clear(); otuNames.clear(); nextLabel = 0;
+
+		in.open(util.getFullPathName(filename).c_str(), ios::binary);
+		if (!in) { m->mothurOut("[ERROR]: Could not open " + filename + "\n"); return false; }
+
+		in.seekg(0, ios::end);
+		long long fileSize = (long long)in.tellg();
+
+		//the footer says where the names and labels are
+		in.seekg(-24, ios::end);
+		namesOffset = readLong(in);
+		long long labelsOffset = readLong(in);
+		char magic[8]; in.read(magic, 8);
+
+		if (!in || (string(magic, 8) != sparseSharedMagic) || (namesOffset < 8) || (labelsOffset < namesOffset) || (labelsOffset > fileSize - 24)) {
+			m->mothurOut("[ERROR]: " + filename + " is not a complete sparse shared file, please correct.\n"); m->setControl_pressed(true);
+			in.close(); return false;
+		}
+
+		in.seekg(namesOffset);
+		int numOtus = readInt(in);
+		for (int i = 0; (i < numOtus) && in; i++) { otuNames.push_back(readString(in, labelsOffset)); }
+
+		in.seekg(labelsOffset);
+		int numLabels = readInt(in);
+		for (int i = 0; (i < numLabels) && in; i++) {
+			labels.push_back(readString(in, fileSize - 24));
+			offsets.push_back(readLong(in));
+			if ((offsets.back() < 8) || (offsets.back() >= namesOffset)) { in.setstate(ios::failbit); }
+		}
+
+		if (!in) {
+			m->mothurOut("[ERROR]: " + filename + " has a damaged OTU name or label index, please correct.\n"); m->setControl_pressed(true);
+			in.close(); return false;
+		}
+
+		return true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SparseSharedFile", "openInput");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+void SparseSharedFile::closeInput() {
+	if (in.is_open()) { in.close(); }
+}
+/**************************************************************************************************/
+
+SharedRAbundVectors* SparseSharedFile::getSharedRAbundVectors(vector<string>& userGroups) {
+	try {
+		if (nextLabel >= labels.size()) { return NULL; }
+
+		SharedRAbundVectors* shared = readLabel(nextLabel, userGroups);
+		nextLabel++;
+
+		return shared;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SparseSharedFile", "getSharedRAbundVectors");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+SharedRAbundVectors* SparseSharedFile::getSharedRAbundVectors(string label, vector<string>& userGroups) {
+	try {
+		for (int i = 0; i < labels.size(); i++) {
+			if (labels[i] == label) { return readLabel(i, userGroups); }
+		}
+
+		return NULL;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SparseSharedFile", "getSharedRAbundVectors");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//builds the same SharedRAbundVectors the text reader would for this label and these groups
+SharedRAbundVectors* SparseSharedFile::readLabel(int index, vector<string>& userGroups) {
+	try {
+		in.clear();
+		in.seekg(offsets[index]);
+
+		string damaged = "[ERROR]: label " + labels[index] + " of the sparse shared file is damaged, please correct.\n";
+
+		//every size is checked against the bytes left in the label blocks before anything is allocated from it
+		string label = readString(in, namesOffset);
+		int numBins = readInt(in);
+		int numGroups = readInt(in);
+		if (!in || (numBins < 0) || (numGroups < 0) || (((long long)numGroups+1) * (long long)sizeof(long long) > namesOffset - (long long)in.tellg())) {
+			m->mothurOut(damaged); m->setControl_pressed(true); return NULL;
+		}
+
+		vector<string> groupNames;
+		for (int i = 0; (i < numGroups) && in; i++) { groupNames.push_back(readString(in, namesOffset)); }
+
+		vector<long long> rowStarts(numGroups+1, 0);
+		if (in) { in.read((char*)&rowStarts[0], rowStarts.size() * sizeof(long long)); }
+
+		//each group's OTUs follow the last group's, and there must be room for them
+		bool valid = in && (rowStarts[0] == 0);
+		for (int i = 0; valid && (i < numGroups); i++) {
+			if ((rowStarts[i+1] < rowStarts[i]) || (rowStarts[i+1] - rowStarts[i] > numBins)) { valid = false; }
+		}
+		if (valid && (rowStarts[numGroups] * 2 * (long long)sizeof(int) > namesOffset - (long long)in.tellg())) { valid = false; }
+		if (!valid) { m->mothurOut(damaged); m->setControl_pressed(true); return NULL; }
+
+		long long numCells = rowStarts[numGroups];
+		vector<int> otus(numCells, 0), counts(numCells, 0);
+		if (numCells != 0) {
+			in.read((char*)&otus[0], numCells * sizeof(int));
+			in.read((char*)&counts[0], numCells * sizeof(int));
+		}
+
+		for (long long j = 0; valid && (j < numCells); j++) {
+			if ((otus[j] < 0) || (otus[j] >= numBins) || (counts[j] < 0)) { valid = false; }
+		}
+		if (!in || !valid) { m->mothurOut(damaged); m->setControl_pressed(true); return NULL; }
+
+		//which groups to keep
+		int numUserGroups = userGroups.size();
+		bool remove = false;
+		vector<int> keep;
+		for (int i = 0; i < numGroups; i++) {
+			if (numUserGroups == 0) { userGroups.push_back(groupNames[i]); keep.push_back(i); }
+			else if (util.inUsersGroups(groupNames[i], userGroups)) { keep.push_back(i); }
+			else { remove = true; }
+		}
+
+		//OTUs no longer seen in any of the groups kept are dropped, like eliminateZeroOTUS
+		vector<int> newBin(numBins, 0);
+		for (int i = 0; i < numBins; i++) { newBin[i] = i; }
+		int newNumBins = numBins;
+		if (remove && (keep.size() > 1)) {
+			vector<bool> seen(numBins, false);
+			for (int i = 0; i < keep.size(); i++) {
+				for (long long j = rowStarts[keep[i]]; j < rowStarts[keep[i]+1]; j++) { seen[otus[j]] = true; }
+			}
+			newNumBins = 0;
+			for (int i = 0; i < numBins; i++) {
+				if (seen[i]) { newBin[i] = newNumBins; newNumBins++; }
+				else { newBin[i] = -1; }
+			}
+		}
+
+		SharedRAbundVectors* shared = new SharedRAbundVectors();
+		for (int i = 0; i < keep.size(); i++) {
+			if (m->getControl_pressed()) { break; }
+
+			vector<int> data(newNumBins, 0);
+			int maxRank = 0; int numSeqs = 0;
+			for (long long j = rowStarts[keep[i]]; j < rowStarts[keep[i]+1]; j++) {
+				data[newBin[otus[j]]] = counts[j];
+				if (counts[j] > maxRank) { maxRank = counts[j]; }
+				numSeqs += counts[j];
+			}
+
+			SharedRAbundVector* temp = new SharedRAbundVector(data, maxRank, newNumBins, numSeqs);
+			temp->setLabel(label);
+			temp->setGroup(groupNames[keep[i]]);
+			shared->push_back(temp);
+		}
+
+		if (otuNames.size() != 0) {
+			string tag = "";
+			for (int i = 0; i < otuNames[0].length(); i++) { if (isalpha(otuNames[0][i])){ tag += otuNames[0][i]; } }
+			shared->setOTUTag(tag);
+
+			//only the first label has its names saved, later labels are given them by InputData
+			if ((index == 0) && (otuNames.size() == numBins)) {
+				vector<string> names;
+				for (int i = 0; i < numBins; i++) { if (newBin[i] != -1) { names.push_back(otuNames[i]); } }
+				shared->setOTUNames(names);
+			}
+		}
+
+		//error in names of user inputted Groups
+		if (shared->size() < userGroups.size()) { m->mothurOut("[ERROR]: requesting groups not present in files, aborting.\n"); m->setControl_pressed(true); }
+
+		return shared;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SparseSharedFile", "readLabel");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
@@ -0,0 +1,71 @@
+#ifndef SPARSESHAREDFILE_H
+#define SPARSESHAREDFILE_H
+
+/*
+ *  sparsesharedfile.h
+ *  Mothur
+ *
+ *  Reads and writes shared files in a binary format that only stores the OTUs a group was seen in. Most of the
+ *  counts in a large shared file are zero, so the sparse file is much smaller and is loaded without parsing text.
+ *
+ *  The file looks like:
+ *
+ *  MTHRSPS1								magic
+ *  for each label:
+ *      label, numOtus, numGroups			strings are an int length followed by the characters
+ *      group names
+ *      rowStarts[numGroups+1]				long long, where each group's OTUs start in the next two arrays
+ *      otus[rowStarts[numGroups]]			int, OTU index, increasing within a group
+ *      counts[rowStarts[numGroups]]		int, abundance of the OTU
+ *  numOtus, OTU names						names from the first label, like the header line of a text shared file
+ *  numLabels, label and offset of each label
+ *  offset of the OTU names, offset of the labels, MTHRSPS1
+ *
+ *  The numbers are written in the byte order of the machine that made the file.
+ *
+ */
+
+#include "mothurout.h"
+#include "utils.hpp"
+#include "sharedrabundvectors.hpp"
+
+/**************************************************************************************************/
+
+class SparseSharedFile {
+
+public:
+	SparseSharedFile();
+	~SparseSharedFile();
+
+	bool isSparse(string);	//filename, true if the file is a sparse shared file
+
+	bool openOutput(string);	//filename
+	void write(SharedRAbundVectors*);
+	void closeOutput();
+
+	bool openInput(string);	//filename
+	vector<string> getLabels() { return labels; }
+	vector<string> getOTUNames() { return otuNames; }
+	SharedRAbundVectors* getSharedRAbundVectors(vector<string>&);	//groups, returns the next label or NULL at the end of the file
+	SharedRAbundVectors* getSharedRAbundVectors(string, vector<string>&);	//label, groups. returns NULL if the label is not in the file
+	void closeInput();
+
+private:
+	MothurOut* m;
+	Utils util;
+
+	ofstream out;
+	ifstream in;
+
+	vector<string> labels;
+	vector<long long> offsets;	//where each label starts in the file
+	vector<string> otuNames;
+	int nextLabel;
+	long long namesOffset;	//the label blocks end where the OTU names start
+
+	SharedRAbundVectors* readLabel(int, vector<string>&);	//index of label, groups
+};
+
+/**************************************************************************************************/
+
+#endif
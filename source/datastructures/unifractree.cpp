@@ -0,0 +1,214 @@
+/*
+ *  unifractree.cpp
+ *  Mothur
+ *
+ */
+
+#include "unifractree.h"
+
+/***********************************************************************/
+
+UnifracTree::UnifracTree(Tree* t, vector<string> Groups) {
+	try {
+		m = MothurOut::getInstance();
+
+		numLeaves = t->getNumLeaves();
+		numNodes = t->getNumNodes();
+		CountTable* ct = t->getCountTable();
+
+		for (int i = 0; i < Groups.size(); i++) { groupIndexes[Groups[i]] = i; groupTotals.push_back(ct->getGroupCount(Groups[i])); }
+
+		parents.resize(numNodes, -1); branchLengths.resize(numNodes, -1); lengthToRoot.resize(numNodes, 0.0);
+		for (int i = 0; i < numNodes; i++) {
+			parents[i] = t->tree[i].getParent();
+			branchLengths[i] = t->tree[i].getBranchLength();
+		}
+
+		//parents come after their children, so going backwards the parent is always done first
+		for (int i = numNodes-1; i >= 0; i--) {
+			if (parents[i] == -1) { continue; }
+			lengthToRoot[i] = lengthToRoot[parents[i]];
+			if (branchLengths[i] != -1) { lengthToRoot[i] += abs(branchLengths[i]); }
+		}
+
+		leafStart.push_back(0);
+		vector< vector<int> > groupLeaves; groupLeaves.resize(Groups.size());
+		for (int i = 0; i < numLeaves; i++) {
+			for (map<string, int>::iterator it = t->tree[i].pcount.begin(); it != t->tree[i].pcount.end(); it++) {
+				map<string, int>::iterator itGroup = groupIndexes.find(it->first);
+				if ((itGroup == groupIndexes.end()) || (it->second == 0)) { continue; }
+
+				leafGroups.push_back(itGroup->second); leafCounts.push_back(it->second);
+				groupLeaves[itGroup->second].push_back(i);
+			}
+			leafStart.push_back(leafGroups.size());
+		}
+
+		//the nodes with seqs from a group are its leaves and their ancestors. stop climbing at a node you already have.
+		vector<int> marked; marked.resize(numNodes, -1);
+		groupNodes.resize(Groups.size());
+		for (int g = 0; g < Groups.size(); g++) {
+			if (m->getControl_pressed()) { break; }
+
+			for (int j = 0; j < groupLeaves[g].size(); j++) {
+				int index = groupLeaves[g][j];
+				while ((index != -1) && (marked[index] != g)) {
+					marked[index] = g;
+					groupNodes[g].push_back(index);
+					index = parents[index];
+				}
+			}
+			sort(groupNodes[g].begin(), groupNodes[g].end());
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "UnifracTree", "UnifracTree");
+		exit(1);
+	}
+}
+/***********************************************************************/
+
+int UnifracTree::getGroupIndex(string group) {
+	map<string, int>::iterator it = groupIndexes.find(group);
+	if (it == groupIndexes.end()) { return -1; }
+	return it->second;
+}
+/***********************************************************************/
+
+int UnifracTree::getLeafCount(int leaf, int group) {
+	for (int i = leafStart[leaf]; i < leafStart[leaf+1]; i++) { if (leafGroups[i] == group) { return leafCounts[i]; } }
+	return 0;
+}
+/***********************************************************************/
+//fills nodes with the sorted indexes of the nodes that have seqs from groupA or groupB, and countA and countB with
+//how many seqs from each group are below them after the swaps. false if neither group is in the tree.
+bool UnifracTree::getCounts(int a, int b, vector<int>& swaps, vector<int>& nodes, vector<int>& countA, vector<int>& countB) {
+	try {
+		nodes.clear();
+		set_union(groupNodes[a].begin(), groupNodes[a].end(), groupNodes[b].begin(), groupNodes[b].end(), back_inserter(nodes));
+		if (nodes.size() == 0) { return false; }
+
+		countA.assign(nodes.size(), 0); countB.assign(nodes.size(), 0);
+
+		//leaves have the lowest indexes, so they are at the front
+		int numNodeLeaves = 0;
+		while ((numNodeLeaves < nodes.size()) && (nodes[numNodeLeaves] < numLeaves)) {
+			countA[numNodeLeaves] = getLeafCount(nodes[numNodeLeaves], a);
+			countB[numNodeLeaves] = getLeafCount(nodes[numNodeLeaves], b);
+			numNodeLeaves++;
+		}
+
+		//the swaps are all leaves from these groups, so the set of nodes stays the same, only the counts move
+		for (int j = 0; j+1 < swaps.size(); j += 2) {
+			vector<int>::iterator first = lower_bound(nodes.begin(), nodes.begin()+numNodeLeaves, swaps[j]);
+			vector<int>::iterator second = lower_bound(nodes.begin(), nodes.begin()+numNodeLeaves, swaps[j+1]);
+			if ((first == nodes.begin()+numNodeLeaves) || (*first != swaps[j]) || (second == nodes.begin()+numNodeLeaves) || (*second != swaps[j+1])) {
+				m->mothurOut("[ERROR]: cannot swap tree indexes.\n"); m->setControl_pressed(true); return false;
+			}
+
+			int firstPos = first - nodes.begin(); int secondPos = second - nodes.begin();
+			swap(countA[firstPos], countA[secondPos]);
+			swap(countB[firstPos], countB[secondPos]);
+		}
+
+		//every parent of these nodes is also one of them and comes later
+		for (int i = 0; i < nodes.size(); i++) {
+			int parent = parents[nodes[i]];
+			if (parent == -1) { continue; }
+
+			int parentPos = lower_bound(nodes.begin()+i+1, nodes.end(), parent) - nodes.begin();
+			countA[parentPos] += countA[i];
+			countB[parentPos] += countB[i];
+		}
+
+		return true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "UnifracTree", "getCounts");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//a branch length is unique if its descendants are all from one of the groups. unless you are including the root,
+//the root of the two groups and the nodes above it are left out. The root is the lowest node with all the seqs from
+//both groups below it, or the parent of the only leaf. Either way it and the nodes above it are the internal nodes
+//with all the seqs.
+double UnifracTree::getUnweighted(int a, int b, bool includeRoot, vector<int>& swaps) {
+	try {
+		vector<int> nodes, countA, countB;
+		if (!getCounts(a, b, swaps, nodes, countA, countB)) { return 0.0; }
+
+		int totalA = 0; int totalB = 0;
+		for (int i = 0; (i < nodes.size()) && (nodes[i] < numLeaves); i++) { totalA += countA[i]; totalB += countB[i]; }
+
+		double UniqueBL = 0.0000;	//a branch length is unique if it's chidren are from the same group
+		double totalBL = 0.00;		//all branch lengths
+
+		for (int i = 0; i < nodes.size(); i++) {
+			int index = nodes[i];
+			if (branchLengths[index] == -1) { continue; }
+			if (!includeRoot && (index >= numLeaves) && (countA[i] == totalA) && (countB[i] == totalB)) { continue; }
+
+			if ((countA[i] == 0) || (countB[i] == 0)) { UniqueBL += abs(branchLengths[index]); }
+			totalBL += abs(branchLengths[index]);
+		}
+
+		double UW = (UniqueBL / totalBL);
+		if (isnan(UW) || isinf(UW)) { UW = 0; }
+
+		return UW;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "UnifracTree", "getUnweighted");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//the sum over the branches of the difference in the fraction of each group's seqs below them, divided by the
+//weighted distance from each group's leaves to the root. The root is the same one getUnweighted leaves out, or the
+//root of the tree if you are including it.
+double UnifracTree::getWeighted(int a, int b, bool includeRoot, vector<int>& swaps) {
+	try {
+		vector<int> nodes, countA, countB;
+		if (!getCounts(a, b, swaps, nodes, countA, countB)) { return 0.0; }
+
+		int totalA = 0; int totalB = 0;
+		for (int i = 0; (i < nodes.size()) && (nodes[i] < numLeaves); i++) { totalA += countA[i]; totalB += countB[i]; }
+
+		double rootLength = 0.0;
+		if (!includeRoot) {
+			for (int i = 0; i < nodes.size(); i++) {
+				if ((nodes[i] >= numLeaves) && (countA[i] == totalA) && (countB[i] == totalB)) { rootLength = lengthToRoot[nodes[i]]; break; }
+			}
+		}
+
+		double D = 0.0; double WScore = 0.0;
+		for (int i = 0; i < nodes.size(); i++) {
+			int index = nodes[i];
+
+			if (index < numLeaves) {
+				double sum = lengthToRoot[index] - rootLength;
+				if (countA[i] != 0) { D += ((countA[i] * sum) / groupTotals[a]); }
+				if (countB[i] != 0) { D += ((countB[i] * sum) / groupTotals[b]); }
+			}
+
+			if (branchLengths[index] == -1) { continue; }
+			if (!includeRoot && (index >= numLeaves) && (countA[i] == totalA) && (countB[i] == totalB)) { continue; }
+
+			double u = 0.00;
+			if (countA[i] != 0) { u = (double) countA[i] / groupTotals[a]; }
+			if (countB[i] != 0) { u -= (double) countB[i] / groupTotals[b]; }
+			WScore += abs(u * branchLengths[index]);
+		}
+
+		double W = (WScore / D);
+		if (isnan(W) || isinf(W)) { W = 0; }
+
+		return W;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "UnifracTree", "getWeighted");
+		exit(1);
+	}
+}
+/***********************************************************************/
@@ -0,0 +1,57 @@
+#ifndef UNIFRACTREE_H
+#define UNIFRACTREE_H
+
+/*
+ *  unifractree.h
+ *  Mothur
+ *
+ *  A read only, integer indexed copy of a Tree made for the unifrac calculators.  The Tree keeps the group counts of
+ *  every node in a map<string, int>, and the random trees were made by copying the whole Tree and reassembling it for
+ *  every group combination.  Here the nodes are kept in the Tree's index order, which is a post order because
+ *  assembleTree depends on children coming before their parents, and each group keeps the sorted indexes of the nodes
+ *  that have seqs from it.  A pair of groups only ever looks at the nodes with seqs from either group, and swapping
+ *  labels for the random trees just moves the two groups' counts between leaves, so the Tree is never copied.
+ *
+ *  The calculators share one UnifracTree between their threads.
+ *
+ */
+
+#include "tree.h"
+
+/***********************************************************************/
+
+class UnifracTree {
+
+public:
+	UnifracTree(Tree*, vector<string>);	//the groups you want to compare, in the order getGroupIndex returns
+	~UnifracTree() {}
+
+	int getGroupIndex(string);	//-1 if the group is not one of the groups passed in
+	bool hasNodes(int a, int b) { return ((groupNodes[a].size() != 0) || (groupNodes[b].size() != 0)); }
+
+	//swaps are the leaf nodes to swap labels between, in pairs, like Tree::assembleRandomUnifracTree. pass an empty vector for the tree as it is.
+	double getUnweighted(int, int, bool, vector<int>&);	//groupA, groupB, includeRoot, swaps
+	double getWeighted(int, int, bool, vector<int>&);	//groupA, groupB, includeRoot, swaps
+
+private:
+	MothurOut* m;
+	int numLeaves, numNodes;
+
+	vector<int> parents;
+	vector<float> branchLengths;			//-1 if the node has none
+	vector<double> lengthToRoot;			//sum of the branch lengths from the node up to, but not including, its root
+
+	vector<int> leafStart;					//the groups of leaf i are leafGroups[leafStart[i]] to leafGroups[leafStart[i+1]-1]
+	vector<int> leafGroups, leafCounts;
+
+	map<string, int> groupIndexes;
+	vector<double> groupTotals;				//number of seqs in each group from the count table
+	vector< vector<int> > groupNodes;		//sorted indexes of the nodes with seqs from each group
+
+	int getLeafCount(int, int);
+	bool getCounts(int, int, vector<int>&, vector<int>&, vector<int>&, vector<int>&);
+};
+
+/***********************************************************************/
+
+#endif
@@ -22,11 +22,21 @@ InputData::InputData(string fName, string f, vector<string> userGroups) : format
 	nextDistanceLabel = "";
     groups = userGroups;
     otuTag = util.getTag(fName);
+    
+    sparseShared = NULL;
+    if (format == "sharedfile") {
+        SparseSharedFile sparse;
+        if (sparse.isSparse(fName)) {
+            sparseShared = new SparseSharedFile();
+            if (!sparseShared->openInput(fName)) { delete sparseShared; sparseShared = NULL; }
+        }
+    }
 }
 /***********************************************************************/
 
 InputData::~InputData(){
 	fileHandle.close();
+    if (sparseShared != NULL) { delete sparseShared; }
 	nextDistanceLabel = "";
 }
 
@@ -52,6 +62,7 @@ InputData::InputData(string fName, string orderFileName, string f) : format(f){
 		util.openInputFile(fName, fileHandle);
 		nextDistanceLabel = "";
         otuTag = util.getTag(fName);
+        sparseShared = NULL;
 		
 	}
 	catch(exception& e) {
@@ -247,6 +258,16 @@ SharedListVector* InputData::getSharedListVector(string label){
 
 SharedOrderVector* InputData::getSharedOrderVector(){
 	try {
+        if (sparseShared != NULL) {
+            SharedRAbundVectors* shared = getSparseSharedRAbundVectors("");
+            if (shared == NULL) { return NULL; }
+            
+            SharedOrderVector* SharedOrder = new SharedOrderVector(shared->getSharedOrderVector());
+            SharedOrder->setLabel(shared->getLabel()); SharedOrder->updateStats();
+            delete shared;
+            return SharedOrder;
+        }
+        
 		if(fileHandle){
 			if (format == "sharedfile")  {
 				SharedOrder = new SharedOrderVector(fileHandle, groups, nextDistanceLabel);
@@ -270,6 +291,16 @@ SharedOrderVector* InputData::getSharedOrderVector(){
 
 SharedOrderVector* InputData::getSharedOrderVector(string label){
 	try {
+        if (sparseShared != NULL) {
+            SharedRAbundVectors* shared = getSparseSharedRAbundVectors(label);
+            if (shared == NULL) { return NULL; }
+            
+            SharedOrderVector* SharedOrder = new SharedOrderVector(shared->getSharedOrderVector());
+            SharedOrder->setLabel(shared->getLabel()); SharedOrder->updateStats();
+            delete shared;
+            return SharedOrder;
+        }
+        
 		ifstream in;
 		string  thisLabel;
 		util.openInputFile(filename, in);
@@ -453,6 +484,8 @@ OrderVector* InputData::getOrderVector(string label){
 /***********************************************************************/
 SharedRAbundVectors* InputData::getSharedRAbundVectors(){
     try {
+        if (sparseShared != NULL) { return getSparseSharedRAbundVectors(""); }
+        
         if(fileHandle){
             if (format == "sharedfile")  {
                 SharedRAbundVectors* shared = new SharedRAbundVectors(fileHandle, groups, nextDistanceLabel, otuTag);
@@ -491,6 +524,8 @@ SharedRAbundVectors* InputData::getSharedRAbundVectors(){
 /***********************************************************************/
 SharedRAbundVectors* InputData::getSharedRAbundVectors(string label){
 	try {
+        if (sparseShared != NULL) { return getSparseSharedRAbundVectors(label); }
+        
 		ifstream in;
 		string  thisLabel;
 		
@@ -562,6 +597,18 @@ SharedRAbundVectors* InputData::getSharedRAbundVectors(string label){
 //this is used when you don't need the order vector
 SharedRAbundFloatVectors* InputData::getSharedRAbundFloatVectors(){
 	try {
+        if (sparseShared != NULL) {
+            SharedRAbundVectors* SharedRAbund = getSparseSharedRAbundVectors("");
+            if (SharedRAbund == NULL) { return NULL; }
+            
+            vector<SharedRAbundFloatVector*> lookup = SharedRAbund->getSharedRAbundFloatVectors();
+            SharedRAbundFloatVectors* SharedRelAbund = new SharedRAbundFloatVectors();
+            SharedRelAbund->setOTUNames(currentLabels);
+            for (int i = 0; i < lookup.size(); i++) { SharedRelAbund->push_back(lookup[i]); }
+            delete SharedRAbund;
+            return SharedRelAbund;
+        }
+        
 		if(fileHandle){
 			if (format == "relabund")  {
 				SharedRAbundFloatVectors* SharedRelAbund = new SharedRAbundFloatVectors(fileHandle, groups, nextDistanceLabel, otuTag);
@@ -602,6 +649,18 @@ SharedRAbundFloatVectors* InputData::getSharedRAbundFloatVectors(){
 /***********************************************************************/
 SharedRAbundFloatVectors* InputData::getSharedRAbundFloatVectors(string label){
 	try {
+        if (sparseShared != NULL) {
+            SharedRAbundVectors* SharedRAbund = getSparseSharedRAbundVectors(label);
+            if (SharedRAbund == NULL) { return NULL; }
+            
+            vector<SharedRAbundFloatVector*> lookup = SharedRAbund->getSharedRAbundFloatVectors();
+            SharedRAbundFloatVectors* SharedRelAbund = new SharedRAbundFloatVectors();
+            SharedRelAbund->setOTUNames(currentLabels);
+            for (int i = 0; i < lookup.size(); i++) { SharedRelAbund->push_back(lookup[i]); }
+            delete SharedRAbund;
+            return SharedRelAbund;
+        }
+        
 		ifstream in;
 		string  thisLabel;
 		
@@ -952,3 +1011,40 @@ RAbundVector* InputData::getRAbundVector(string label){
 
 
 
+//reads from the sparse shared file, giving later labels the OTU names of the first label like the text reader does
+SharedRAbundVectors* InputData::getSparseSharedRAbundVectors(string label){
+    try {
+        SharedRAbundVectors* shared = NULL;
+        
+        if (label == "") { shared = sparseShared->getSharedRAbundVectors(groups); }
+        else {
+            //the text reader would have read the first label on its way to this one
+            if (currentLabels.size() == 0) {
+                vector<string> labels = sparseShared->getLabels();
+                if ((labels.size() != 0) && (labels[0] != label)) {
+                    SharedRAbundVectors* first = sparseShared->getSharedRAbundVectors(labels[0], groups);
+                    if (first != NULL) {
+                        if (first->getNumBins() != 0) { currentLabels = first->getOTUNames(); }
+                        delete first;
+                    }
+                }
+            }
+            shared = sparseShared->getSharedRAbundVectors(label, groups);
+        }
+        
+        if (shared != NULL) {
+            if (shared->getNumBins() == 0) { delete shared; return NULL; } //no valid groups
+            
+            //pass labels to others distances in file
+            if (currentLabels.size() == 0) { currentLabels = shared->getOTUNames(); }
+            else { shared->setOTUNames(currentLabels);  }
+        }
+        
+        return shared;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "InputData", "getSparseSharedRAbundVectors");
+        exit(1);
+    }
+}
+/***********************************************************************/
@@ -8,6 +8,7 @@
 #include "listvector.hpp"
 #include "sharedrabundvectors.hpp"
 #include "sharedrabundfloatvectors.hpp"
+#include "sparsesharedfile.h"
 #include "utils.hpp"
 
 class InputData {
@@ -52,6 +53,9 @@ private:
     vector<string> groups;
     string nextDistanceLabel;
     string otuTag;
+    SparseSharedFile* sparseShared; //set if the shared file is in the sparse format
+    
+    SharedRAbundVectors* getSparseSharedRAbundVectors(string); //label you want, "" for the next label
 };
 
 
@@ -236,7 +236,7 @@ double LinearAlgebra::betacf(const double a, const double b, const double x) {
 }
 /*********************************************************************************************************************************/
 //[3][4] * [4][5] - columns in first must match rows in second, returns matrix[3][5]
-vector<vector<double> > LinearAlgebra::matrix_mult(vector<vector<double> > first, vector<vector<double> > second){
+vector<vector<double> > LinearAlgebra::matrix_mult(const vector<vector<double> >& first, const vector<vector<double> >& second){
 	try {
 		vector<vector<double> > product;
 		
@@ -288,7 +288,7 @@ vector<vector<double> > LinearAlgebra::transpose(vector<vector<double> >matrix){
 }
 /*********************************************************************************************************************************/
 
-void LinearAlgebra::recenter(double offset, vector<vector<double> > D, vector<vector<double> >& G){
+void LinearAlgebra::recenter(double offset, const vector<vector<double> >& D, vector<vector<double> >& G){
 	try {
 		int rank = D.size();
 		
@@ -2610,5 +2610,263 @@ int LinearAlgebra::svd(vector< vector<double> >& a, vector<double>& w, vector< v
 		exit(1);
 	}
 }
-
-
+/*********************************************************************************************************************************/
+struct matVecData {
+	RowMajorMatrix* A;
+	vector<double>* x;
+	vector<double> y; //rows start to end of Ax, or this thread's part of the sum A'x
+	int start, end;
+	
+	matVecData(RowMajorMatrix* a, vector<double>* xx, int s, int e) : A(a), x(xx), start(s), end(e) {}
+};
+/*********************************************************************************************************************************/
+//4 rows at a time, so each part of x is read from memory once for 4 rows
+void driverMatVec(matVecData* params) {
+	try {
+		RowMajorMatrix& A = *params->A;
+		double* x = &(*params->x)[0];
+		int numCols = A.numCols;
+		params->y.assign(params->end - params->start, 0.0);
+		
+		int i = params->start;
+		for (; (i+3) < params->end; i += 4) {
+			double* r0 = A.row(i); double* r1 = A.row(i+1); double* r2 = A.row(i+2); double* r3 = A.row(i+3);
+			double s0 = 0.0; double s1 = 0.0; double s2 = 0.0; double s3 = 0.0;
+			for (int j = 0; j < numCols; j++) {
+				double xj = x[j];
+				s0 += r0[j] * xj; s1 += r1[j] * xj; s2 += r2[j] * xj; s3 += r3[j] * xj;
+			}
+			params->y[i - params->start] = s0; params->y[i+1 - params->start] = s1;
+			params->y[i+2 - params->start] = s2; params->y[i+3 - params->start] = s3;
+		}
+		for (; i < params->end; i++) {
+			double* r = A.row(i);
+			double sum = 0.0;
+			for (int j = 0; j < numCols; j++) { sum += r[j] * x[j]; }
+			params->y[i - params->start] = sum;
+		}
+	}
+	catch(exception& e) {
+		MothurOut::getInstance()->errorOut(e, "LinearAlgebra", "driverMatVec");
+		exit(1);
+	}
+}
+/*********************************************************************************************************************************/
+void driverMatVecTranspose(matVecData* params) {
+	try {
+		RowMajorMatrix& A = *params->A;
+		vector<double>& x = *params->x;
+		int numCols = A.numCols;
+		params->y.assign(numCols, 0.0);
+		double* y = &params->y[0];
+		
+		for (int i = params->start; i < params->end; i++) {
+			double* r = A.row(i);
+			double xi = x[i];
+			for (int j = 0; j < numCols; j++) { y[j] += r[j] * xi; }
+		}
+	}
+	catch(exception& e) {
+		MothurOut::getInstance()->errorOut(e, "LinearAlgebra", "driverMatVecTranspose");
+		exit(1);
+	}
+}
+/*********************************************************************************************************************************/
+//splits the rows of A between the processors
+vector<matVecData*> splitMatVec(RowMajorMatrix& A, vector<double>& x, int processors) {
+	try {
+		//small products are not worth starting threads for
+		if (((long long)A.numRows * A.numCols) < 1000000) { processors = 1; }
+		processors = max(1, min(processors, A.numRows));
+		
+		vector<matVecData*> data;
+		int rowsPerProcessor = A.numRows / processors;
+		for (int i = 0; i < processors; i++) {
+			int start = i * rowsPerProcessor;
+			int end = (i == (processors-1)) ? A.numRows : (start + rowsPerProcessor);
+			data.push_back(new matVecData(&A, &x, start, end));
+		}
+		return data;
+	}
+	catch(exception& e) {
+		MothurOut::getInstance()->errorOut(e, "LinearAlgebra", "splitMatVec");
+		exit(1);
+	}
+}
+/*********************************************************************************************************************************/
+void LinearAlgebra::multiply(RowMajorMatrix& A, vector<double>& x, vector<double>& y, int processors) {
+	try {
+		vector<matVecData*> data = splitMatVec(A, x, processors);
+		
+		vector<thread*> workerThreads;
+		for (int i = 1; i < data.size(); i++) { workerThreads.push_back(new thread(driverMatVec, data[i])); }
+		driverMatVec(data[0]);
+		for (int i = 0; i < workerThreads.size(); i++) { workerThreads[i]->join(); delete workerThreads[i]; }
+		
+		y.resize(A.numRows);
+		for (int i = 0; i < data.size(); i++) {
+			for (int j = data[i]->start; j < data[i]->end; j++) { y[j] = data[i]->y[j - data[i]->start]; }
+			delete data[i];
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "LinearAlgebra", "multiply");
+		exit(1);
+	}
+}
+/*********************************************************************************************************************************/
+void LinearAlgebra::multiplyTranspose(RowMajorMatrix& A, vector<double>& x, vector<double>& y, int processors) {
+	try {
+		vector<matVecData*> data = splitMatVec(A, x, processors);
+		
+		vector<thread*> workerThreads;
+		for (int i = 1; i < data.size(); i++) { workerThreads.push_back(new thread(driverMatVecTranspose, data[i])); }
+		driverMatVecTranspose(data[0]);
+		for (int i = 0; i < workerThreads.size(); i++) { workerThreads[i]->join(); delete workerThreads[i]; }
+		
+		y.assign(A.numCols, 0.0);
+		for (int i = 0; i < data.size(); i++) {
+			for (int j = 0; j < A.numCols; j++) { y[j] += data[i]->y[j]; }
+			delete data[i];
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "LinearAlgebra", "multiplyTranspose");
+		exit(1);
+	}
+}
+/*********************************************************************************************************************************/
+//Lanczos with full reorthogonalization. The basis grows until the Ritz vectors of the largest numAxes eigenvalues, and of
+//the smallest if asked, have residuals below the tolerance. Only the products with the operator touch the whole matrix,
+//so a few hundred of them replace the n^3 of tred2 and qtli.
+int LinearAlgebra::lanczos(SymmetricOperator& op, int numAxes, vector<double>& d, vector<vector<double> >& vectors, double& smallest, bool findSmallest) {
+	try {
+		int n = op.size();
+		numAxes = min(numAxes, n);
+		
+		vector< vector<double> > Q; //orthonormal basis of the Krylov space
+		vector<double> alpha, beta; //the tridiagonal matrix of the operator in that basis
+		vector<double> ritzValues;
+		vector< vector<double> > ritzVectors;
+		
+		vector<double> q(n, 0.0); vector<double> w;
+		double norm = 0.0;
+		for (int i = 0; i < n; i++) { q[i] = util.randomUniform() - 0.5; norm += q[i] * q[i]; }
+		norm = sqrt(norm);
+		for (int i = 0; i < n; i++) { q[i] /= norm; }
+		
+		double largest = 0.0; //largest value in the tridiagonal matrix, to find an invariant subspace
+		bool converged = false;
+		while (!converged) {
+			
+			if (m->getControl_pressed()) { return 0; }
+			
+			Q.push_back(q);
+			int j = Q.size()-1;
+			
+			op.multiply(Q[j], w);
+			
+			double a = 0.0;
+			for (int i = 0; i < n; i++) { a += Q[j][i] * w[i]; }
+			alpha.push_back(a);
+			
+			//against the whole basis, twice, so it stays orthogonal in floating point
+			for (int pass = 0; pass < 2; pass++) {
+				for (int k = 0; k <= j; k++) {
+					double projection = 0.0;
+					for (int i = 0; i < n; i++) { projection += Q[k][i] * w[i]; }
+					for (int i = 0; i < n; i++) { w[i] -= projection * Q[k][i]; }
+				}
+			}
+			
+			double b = 0.0;
+			for (int i = 0; i < n; i++) { b += w[i] * w[i]; }
+			b = sqrt(b);
+			
+			largest = max(largest, max(fabs(a), b));
+			int numSteps = j+1;
+			bool invariant = (b <= (1e-12 * largest));
+			
+			if (invariant || (numSteps == n) || ((numSteps >= numAxes) && ((numSteps % 10) == 0))) {
+				ritzValues = alpha;
+				vector<double> e(numSteps+1, 0.0);
+				for (int k = 1; k < numSteps; k++) { e[k] = beta[k-1]; }
+				ritzVectors.assign(numSteps, vector<double>(numSteps, 0.0));
+				for (int k = 0; k < numSteps; k++) { ritzVectors[k][k] = 1.0; }
+				
+				qtli(ritzValues, e, ritzVectors); //largest first
+				
+				if (invariant || (numSteps == n)) { converged = true; }
+				else {
+					//the residual of a Ritz vector is b times its last component
+					double tolerance = 1e-8 * max(fabs(ritzValues[0]), fabs(ritzValues[numSteps-1]));
+					converged = true;
+					for (int k = 0; k < numAxes; k++) {
+						if ((b * fabs(ritzVectors[numSteps-1][k])) > tolerance) { converged = false; }
+					}
+					if (findSmallest && ((b * fabs(ritzVectors[numSteps-1][numSteps-1])) > tolerance)) { converged = false; }
+				}
+			}
+			
+			if (!converged) {
+				beta.push_back(b);
+				for (int i = 0; i < n; i++) { q[i] = w[i] / b; }
+			}
+		}
+		
+		int numSteps = Q.size();
+		numAxes = min(numAxes, numSteps); //the operator has fewer distinct eigenvalues than axes
+		smallest = ritzValues[numSteps-1];
+		
+		d.assign(ritzValues.begin(), ritzValues.begin() + numAxes);
+		vectors.assign(n, vector<double>(numAxes, 0.0));
+		for (int k = 0; k < numSteps; k++) {
+			for (int i = 0; i < n; i++) {
+				double qki = Q[k][i];
+				for (int axis = 0; axis < numAxes; axis++) { vectors[i][axis] += qki * ritzVectors[k][axis]; }
+			}
+		}
+		
+		return numSteps;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "LinearAlgebra", "lanczos");
+		exit(1);
+	}
+}
+/*********************************************************************************************************************************/
+void DoubleCenteredOperator::multiply(vector<double>& x, vector<double>& y) {
+	try {
+		int n = A.numRows;
+		
+		double mean = 0.0;
+		for (int i = 0; i < n; i++) { mean += x[i]; }
+		mean /= (double) n;
+		
+		vector<double> centered(n);
+		for (int i = 0; i < n; i++) { centered[i] = x[i] - mean; }
+		
+		linear.multiply(A, centered, y, processors);
+		
+		mean = 0.0;
+		for (int i = 0; i < n; i++) { mean += y[i]; }
+		mean /= (double) n;
+		for (int i = 0; i < n; i++) { y[i] -= mean; }
+	}
+	catch(exception& e) {
+		MothurOut::getInstance()->errorOut(e, "DoubleCenteredOperator", "multiply");
+		exit(1);
+	}
+}
+/*********************************************************************************************************************************/
+void GramOperator::multiply(vector<double>& x, vector<double>& y) {
+	try {
+		linear.multiplyTranspose(X, x, features, processors);
+		linear.multiply(X, features, y, processors);
+	}
+	catch(exception& e) {
+		MothurOut::getInstance()->errorOut(e, "GramOperator", "multiply");
+		exit(1);
+	}
+}
+/*********************************************************************************************************************************/
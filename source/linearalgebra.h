@@ -13,6 +13,26 @@
 #include "mothurout.h"
 #include "utils.hpp"
 
+/*****************************************************************/
+//a dense matrix stored one row after another in a single block, so a mat-vec product reads it front to back
+struct RowMajorMatrix {
+	int numRows, numCols;
+	vector<double> values;
+	
+	RowMajorMatrix() : numRows(0), numCols(0) {}
+	RowMajorMatrix(int r, int c) : numRows(r), numCols(c), values((long long)r * c, 0.0) {}
+	
+	double* row(int i) { return &values[(long long)i * numCols]; }
+};
+/*****************************************************************/
+//a symmetric matrix that is only used through its product with a vector, so it never has to be stored
+class SymmetricOperator {
+public:
+	virtual ~SymmetricOperator() {}
+	virtual int size() = 0;
+	virtual void multiply(vector<double>&, vector<double>&) = 0; //x, y = Mx
+};
+/*****************************************************************/
 
 class LinearAlgebra {
 	
@@ -20,9 +40,9 @@ public:
 	LinearAlgebra() { m = MothurOut::getInstance(); }
 	~LinearAlgebra() {}
 	
-	vector<vector<double> > matrix_mult(vector<vector<double> >, vector<vector<double> >);
+	vector<vector<double> > matrix_mult(const vector<vector<double> >&, const vector<vector<double> >&);
     vector<vector<double> >transpose(vector<vector<double> >);
-	void recenter(double, vector<vector<double> >, vector<vector<double> >&);
+	void recenter(double, const vector<vector<double> >&, vector<vector<double> >&);
 	//eigenvectors
     int tred2(vector<vector<double> >&, vector<double>&, vector<double>&);
 	int qtli(vector<double>&, vector<double>&, vector<vector<double> >&);
@@ -51,6 +71,12 @@ public:
     double normalvariate(double mu, double sigma);
     vector< vector<double> > lda(vector< vector<double> >& a, vector<string> groups, vector< vector<double> >& means, bool&); //Linear discriminant analysis - a is [features][valuesFromGroups] groups indicates which group each sampling comes from. For example if groups = early, late, mid, early, early. a[0][0] = value for feature0 from groupEarly.
     int svd(vector< vector<double> >& a, vector<double>& w, vector< vector<double> >& v); //Singular value decomposition
+    
+    void multiply(RowMajorMatrix&, vector<double>&, vector<double>&, int); //A, x, y = Ax, processors
+    void multiplyTranspose(RowMajorMatrix&, vector<double>&, vector<double>&, int); //A, x, y = A'x, processors
+    //largest eigenvalues and their eigenvectors of a symmetric operator. numAxes, eigenvalues largest first, eigenvectors as
+    //columns [size][numAxes], smallest eigenvalue, whether to converge the smallest eigenvalue too
+    int lanczos(SymmetricOperator&, int, vector<double>&, vector<vector<double> >&, double&, bool);
 private:
 	MothurOut* m;
     Utils util;
@@ -80,6 +106,32 @@ private:
     void lubksb(vector<vector<float> >&, vector<int>&, vector<float>&);
     
 };
+/*****************************************************************/
+//the double centered matrix of PCoA, CAC where C = I - 11'/n, without forming it
+class DoubleCenteredOperator : public SymmetricOperator {
+public:
+	DoubleCenteredOperator(RowMajorMatrix& a, int p) : A(a), processors(p) {}
+	int size() { return A.numRows; }
+	void multiply(vector<double>&, vector<double>&);
+private:
+	RowMajorMatrix& A;
+	int processors;
+	LinearAlgebra linear;
+};
+/*****************************************************************/
+//XX' for a centered samples by features matrix X. its eigenvectors times the square roots of the eigenvalues are the PCA scores
+class GramOperator : public SymmetricOperator {
+public:
+	GramOperator(RowMajorMatrix& x, int p) : X(x), processors(p) {}
+	int size() { return X.numRows; }
+	void multiply(vector<double>&, vector<double>&);
+private:
+	RowMajorMatrix& X;
+	int processors;
+	LinearAlgebra linear;
+	vector<double> features;
+};
+/*****************************************************************/
 
 #endif
 
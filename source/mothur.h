@@ -58,6 +58,7 @@
 #include <limits>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
 
 
 
@@ -22,56 +22,40 @@ int OptiCluster::initialize(double& value, bool randomize, string initialize) {
         
         vector<int> temp;
         bins.push_back(temp);
-        seqBin[numSeqs] = -1;
         insertLocation = numSeqs;
         Utils util;
         
+        for (int i = 0; i < numSeqs; i++) { randomizeSeqs.push_back(i); }
+        if (randomize) { util.mothurRandomShuffle(randomizeSeqs); }
+        
         if (initialize == "singleton") {
             
             //put everyone in own bin
             for (int i = 0; i < numSeqs; i++) { bins[i].push_back(i); }
             
-            //maps randomized sequences to bins
-            for (int i = 0; i < numSeqs; i++) {
-                seqBin[i] = bins[i][0];
-                randomizeSeqs.push_back(i);
-            }
-            
-            if (randomize) { util.mothurRandomShuffle(randomizeSeqs); }
-            
             //for each sequence (singletons removed on read)
-            for (map<int, int>::iterator it = seqBin.begin(); it != seqBin.end(); it++) {
-                if (it->second == -1) { }
-                else {
-                    long long numCloseSeqs = (matrix->getNumClose(it->first)); //does not include self
-                    falseNegatives += numCloseSeqs;
-                }
+            for (int i = 0; i < numSeqs; i++) {
+                long long numCloseSeqs = (matrix->getNumClose(i)); //does not include self
+                falseNegatives += numCloseSeqs;
             }
             falseNegatives /= 2; //square matrix
             trueNegatives = numSeqs * (numSeqs-1)/2 - (falsePositives + falseNegatives + truePositives); //since everyone is a singleton no one clusters together. True negative = num far apart
         }else {
             
             //put everyone in first bin
-            for (int i = 0; i < numSeqs; i++) {
-                bins[0].push_back(i);
-                seqBin[i] = 0;
-                randomizeSeqs.push_back(i);
-            }
-            
-            if (randomize) { util.mothurRandomShuffle(randomizeSeqs); }
+            for (int i = 0; i < numSeqs; i++) { bins[0].push_back(i); }
             
             //for each sequence (singletons removed on read)
-            for (map<int, int>::iterator it = seqBin.begin(); it != seqBin.end(); it++) {
-                if (it->second == -1) { }
-                else {
-                    long long numCloseSeqs = (matrix->getNumClose(it->first)); //does not include self
-                    truePositives += numCloseSeqs;
-                }
+            for (int i = 0; i < numSeqs; i++) {
+                long long numCloseSeqs = (matrix->getNumClose(i)); //does not include self
+                truePositives += numCloseSeqs;
             }
             truePositives /= 2; //square matrix
             falsePositives = numSeqs * (numSeqs-1)/2 - (trueNegatives + falseNegatives + truePositives);
         }
         
+        setSeqBins();
+        
         value = metric->getValue(truePositives, trueNegatives, falsePositives, falseNegatives);
         
         return value;
@@ -98,68 +82,48 @@ int OptiCluster::initialize(double& value, bool randomize, string initialize, ve
         bins.resize(numSeqs); //place seqs in own bin
     
         Utils util;
+        randomizeSeqs = namesSeqs;
+        if (randomize) { util.mothurRandomShuffle(randomizeSeqs); }
+        
         if (initialize == "singleton") {
             
             //put everyone in own bin
             for (int i = 0; i < numSeqs; i++) { bins[i].push_back(namesSeqs[i]); }
             
-            //maps randomized sequences to bins
-            for (int i = 0; i < numSeqs; i++) {
-                seqBin[i] = bins[i][0];
-                randomizeSeqs.push_back(namesSeqs[i]);
-            }
-            
-            if (randomize) { util.mothurRandomShuffle(randomizeSeqs); }
-            
             //for each sequence (singletons removed on read)
-            for (map<int, int>::iterator it = seqBin.begin(); it != seqBin.end(); it++) {
-                if (it->second == -1) { }
-                else {
-                    long long numCloseSeqs = (matrix->getNumClose(it->first)); //does not include self
-                    falseNegatives += numCloseSeqs;
-                }
+            for (int i = 0; i < numSeqs; i++) {
+                long long numCloseSeqs = (matrix->getNumClose(namesSeqs[i])); //does not include self
+                falseNegatives += numCloseSeqs;
             }
             falseNegatives /= 2; //square matrix
             trueNegatives = numSeqs * (numSeqs-1)/2 - (falsePositives + falseNegatives + truePositives); //since everyone is a singleton no one clusters together. True negative = num far apart
         }else {
             
             //put everyone in first bin
-            for (int i = 0; i < numSeqs; i++) {
-                bins[0].push_back(i);
-                seqBin[i] = 0;
-                randomizeSeqs.push_back(i);
-            }
-            
-            if (randomize) { util.mothurRandomShuffle(randomizeSeqs); }
+            for (int i = 0; i < numSeqs; i++) { bins[0].push_back(namesSeqs[i]); }
             
             //for each sequence (singletons removed on read)
-            for (map<int, int>::iterator it = seqBin.begin(); it != seqBin.end(); it++) {
-                if (it->second == -1) { }
-                else {
-                    long long numCloseSeqs = (matrix->getNumClose(it->first)); //does not include self
-                    truePositives += numCloseSeqs;
-                }
+            for (int i = 0; i < numSeqs; i++) {
+                long long numCloseSeqs = (matrix->getNumClose(namesSeqs[i])); //does not include self
+                truePositives += numCloseSeqs;
             }
             truePositives /= 2; //square matrix
             falsePositives = numSeqs * (numSeqs-1)/2 - (trueNegatives + falseNegatives + truePositives);
         }
         
         int binNumber = bins.size();
-        for (int i = 0; i < translatedBins.size(); i++) {
-            binLabels[binNumber] = bls[i];
-            for (int j = 0; j < translatedBins[i].size(); j++) {  seqBin[translatedBins[i][j]] = binNumber;   }
-            binNumber++;
-        }
+        for (int i = 0; i < translatedBins.size(); i++) { binLabels[binNumber] = bls[i]; binNumber++; }
 
         //add existing bins
         bins.insert(bins.end(), translatedBins.begin(), translatedBins.end());
         
         //add insert location
-        seqBin[bins.size()] = -1;
         insertLocation = bins.size();
         vector<int> temp;
         bins.push_back(temp);
         
+        setSeqBins();
+        
         truePositives += tp;  falsePositives += fp; trueNegatives += tn; falseNegatives += fn;
         
         value = metric->getValue(truePositives, trueNegatives, falsePositives, falseNegatives);
@@ -172,80 +136,74 @@ int OptiCluster::initialize(double& value, bool randomize, string initialize, ve
     }
 }
 /***********************************************************************/
+//fills seqBin, seqPosition and emptyBins from bins
+void OptiCluster::setSeqBins() {
+    try {
+        seqBin.assign(matrix->getNumSeqs(), -1);
+        seqPosition.assign(matrix->getNumSeqs(), -1);
+        emptyBins.clear();
+        
+        for (int i = 0; i < bins.size(); i++) {
+            if (bins[i].size() == 0) { emptyBins.insert(i); }
+            
+            for (int j = 0; j < bins[i].size(); j++) {
+                if (bins[i][j] != -1) { seqBin[bins[i][j]] = i; seqPosition[bins[i][j]] = j; }
+            }
+        }
+
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCluster", "setSeqBins");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//the last seq in the old bin takes the moved seq's place so removing is constant time
+void OptiCluster::moveSeq(int seq, int newBin) {
+    try {
+        int oldBin = seqBin[seq];
+        int position = seqPosition[seq];
+        
+        int lastSeq = bins[oldBin].back();
+        bins[oldBin][position] = lastSeq;
+        if (lastSeq != -1) { seqPosition[lastSeq] = position; }
+        bins[oldBin].pop_back();
+        if (bins[oldBin].size() == 0) { emptyBins.insert(oldBin); }
+        
+        if (bins[newBin].size() == 0) { emptyBins.erase(newBin); }
+        seqPosition[seq] = bins[newBin].size();
+        bins[newBin].push_back(seq);
+        seqBin[seq] = newBin;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCluster", "moveSeq");
+        exit(1);
+    }
+}
+/***********************************************************************/
 /* for each sequence with mutual information (close)
 * remove from current OTU and calculate MCC when sequence forms its own OTU or joins one of the other OTUs where there is a sequence within the `threshold` (no need to calculate MCC if the paired sequence is already in same OTU and no need to try every OTU - just those where there's a close sequence) 
  * keep or move the sequence to the OTU where the `metric` is the largest - flip a coin on ties */
 bool OptiCluster::update(double& listMetric) {
     try {
         
-        //for each sequence (singletons removed on read)
-        for (int i = 0; i < randomizeSeqs.size(); i++) {
-            
-            if (m->getControl_pressed()) { break; }
-            
-            map<int, int>::iterator it = seqBin.find(randomizeSeqs[i]);
-            
-            int seqNumber = it->first;
-            int binNumber = it->second;
+        if (processors > 1) { updateBatches(); }
+        else {
+            vector<int> closeBins;
             
-            
-            if (binNumber == -1) { }
-            else {
-                
-                long long tn, tp, fp, fn;
-                double bestMetric = -1;
-                long long bestBin, bestTp, bestTn, bestFn, bestFp;
-                tn = trueNegatives; tp = truePositives; fp = falsePositives; fn = falseNegatives;
-                
-                //close / far count in current bin
-                vector<long long> results = getCloseFarCounts(seqNumber, binNumber);
-                long long cCount = results[0];  long long fCount = results[1];
-                
-                //metric in current bin
-                bestMetric = metric->getValue(tp, tn, fp, fn); bestBin = binNumber; bestTp = tp; bestTn = tn; bestFp = fp; bestFn = fn;
-                
-                //if not already singleton, then calc value if singleton was created
-                if (!((bins[binNumber].size()) == 1)) {
-                    //make a singleton
-                    //move out of old bin
-                    fn+=cCount; tn+=fCount; fp-=fCount; tp-=cCount;
-                    double singleMetric = metric->getValue(tp, tn, fp, fn);
-                    if (singleMetric > bestMetric) {
-                        bestBin = -1; bestTp = tp; bestTn = tn; bestFp = fp; bestFn = fn;
-                        bestMetric = singleMetric;
-                    }
-                }
-                
-                set<int> binsToTry;
-                set<int> closeSeqs = matrix->getCloseSeqs(seqNumber);
-                for (set<int>::iterator itClose = closeSeqs.begin(); itClose != closeSeqs.end(); itClose++) {  binsToTry.insert(seqBin[*itClose]); }
+            //for each sequence (singletons removed on read)
+            for (int i = 0; i < randomizeSeqs.size(); i++) {
                 
-                //merge into each "close" otu
-                for (set<int>::iterator it = binsToTry.begin(); it != binsToTry.end(); it++) {
-                    tn = trueNegatives; tp = truePositives; fp = falsePositives; fn = falseNegatives;
-                    fn+=cCount; tn+=fCount; fp-=fCount; tp-=cCount; //move out of old bin
-                    results = getCloseFarCounts(seqNumber, *it);
-                    fn-=results[0]; tn-=results[1];  tp+=results[0]; fp+=results[1]; //move into new bin
-                    double newMetric = metric->getValue(tp, tn, fp, fn); //score when sequence is moved
-                    //new best
-                    if (newMetric > bestMetric) { bestMetric = newMetric; bestBin = (*it); bestTp = tp; bestTn = tn; bestFp = fp; bestFn = fn; }
-                }
+                if (m->getControl_pressed()) { break; }
                 
-                bool usedInsert = false;
-                if (bestBin == -1) {  bestBin = insertLocation;  usedInsert = true;  }
+                int seqNumber = randomizeSeqs[i];
                 
-                if (bestBin != binNumber) {
-                    truePositives = bestTp; trueNegatives = bestTn; falsePositives = bestFp; falseNegatives = bestFn;
-            
-                    //move seq from i to j
-                    bins[bestBin].push_back(seqNumber); //add seq to bestbin
-                    bins[binNumber].erase(remove(bins[binNumber].begin(), bins[binNumber].end(), seqNumber), bins[binNumber].end()); //remove from old bin i
+                if (seqBin[seqNumber] == -1) { }
+                else {
+                    long long tp = truePositives; long long tn = trueNegatives; long long fp = falsePositives; long long fn = falseNegatives;
+                    int bestBin = findBestBin(seqNumber, closeBins, tp, tn, fp, fn);
+                    placeSeq(seqNumber, bestBin, tp, tn, fp, fn);
                 }
-                
-                if (usedInsert) { insertLocation = findInsert(); }
-                
-                //update seqBins
-                seqBin[seqNumber] = bestBin; //set new OTU location
             }
         }
         
@@ -262,17 +220,219 @@ bool OptiCluster::update(double& listMetric) {
     }
 }
 /***********************************************************************/
+//scores moving seq to each bin with a close seq and to a new bin, starting from the tp, tn, fp and fn passed in.
+//returns the best bin, -1 for a new bin, and sets tp, tn, fp and fn to their values after the move. does not change the clusters.
+int OptiCluster::findBestBin(int seqNumber, vector<int>& closeBins, long long& tp, long long& tn, long long& fp, long long& fn) {
+    try {
+        int binNumber = seqBin[seqNumber];
+        
+        //bins of the close seqs, sorted so each bin's close seqs are together and the bins are tried in order
+        closeBins.clear();
+        closeSeqsRange closeSeqs = matrix->getCloseSeqs(seqNumber);
+        for (const int* itClose = closeSeqs.begin(); itClose != closeSeqs.end(); itClose++) {
+            if (*itClose == seqNumber) { continue; } //ignore self
+            int closeBin = seqBin[*itClose];
+            if (closeBin != -1) { closeBins.push_back(closeBin); }
+        }
+        sort(closeBins.begin(), closeBins.end());
+        
+        long long startTp = tp; long long startTn = tn; long long startFp = fp; long long startFn = fn;
+        
+        //close / far count in current bin, every member of a bin that isn't close is far
+        long long cCount = upper_bound(closeBins.begin(), closeBins.end(), binNumber) - lower_bound(closeBins.begin(), closeBins.end(), binNumber);
+        long long fCount = bins[binNumber].size() - 1 - cCount;
+        
+        //metric in current bin
+        double bestMetric = metric->getValue(tp, tn, fp, fn);
+        int bestBin = binNumber; long long bestTp = tp; long long bestTn = tn; long long bestFp = fp; long long bestFn = fn;
+        
+        //if not already singleton, then calc value if singleton was created
+        if (!((bins[binNumber].size()) == 1)) {
+            //make a singleton
+            //move out of old bin
+            fn+=cCount; tn+=fCount; fp-=fCount; tp-=cCount;
+            double singleMetric = metric->getValue(tp, tn, fp, fn);
+            if (singleMetric > bestMetric) {
+                bestBin = -1; bestTp = tp; bestTn = tn; bestFp = fp; bestFn = fn;
+                bestMetric = singleMetric;
+            }
+        }
+        
+        //merge into each "close" otu
+        for (int j = 0; j < closeBins.size();) {
+            int thisBin = closeBins[j];
+            int next = j; while ((next < closeBins.size()) && (closeBins[next] == thisBin)) { next++; }
+            
+            long long closeCount = next - j;
+            long long farCount = bins[thisBin].size() - closeCount;
+            if (thisBin == binNumber) { farCount--; } //self
+            j = next;
+            
+            tn = startTn; tp = startTp; fp = startFp; fn = startFn;
+            fn+=cCount; tn+=fCount; fp-=fCount; tp-=cCount; //move out of old bin
+            fn-=closeCount; tn-=farCount;  tp+=closeCount; fp+=farCount; //move into new bin
+            double newMetric = metric->getValue(tp, tn, fp, fn); //score when sequence is moved
+            //new best
+            if (newMetric > bestMetric) { bestMetric = newMetric; bestBin = thisBin; bestTp = tp; bestTn = tn; bestFp = fp; bestFn = fn; }
+        }
+        
+        tp = bestTp; tn = bestTn; fp = bestFp; fn = bestFn;
+        
+        return bestBin;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCluster", "findBestBin");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//moves seq to bestBin (-1 for a new bin) and sets the counts. returns the bin the seq ends up in
+int OptiCluster::placeSeq(int seqNumber, int bestBin, long long tp, long long tn, long long fp, long long fn) {
+    try {
+        int binNumber = seqBin[seqNumber];
+        
+        bool usedInsert = false;
+        if (bestBin == -1) {  bestBin = insertLocation;  usedInsert = true;  }
+        
+        if (bestBin != binNumber) {
+            truePositives = tp; trueNegatives = tn; falsePositives = fp; falseNegatives = fn;
+            
+            //move seq from i to j
+            moveSeq(seqNumber, bestBin);
+        }
+        
+        if (usedInsert) { insertLocation = findInsert(); }
+        
+        return bestBin;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCluster", "placeSeq");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//finds the best bin for randomizeSeqs[start] to randomizeSeqs[end-1] without moving anyone. bestCounts holds the change in tp, tn, fp and fn.
+void OptiCluster::findBestBins(int start, int end, vector<int>* bestBins, vector< vector<long long> >* bestCounts) {
+    try {
+        vector<int> closeBins;
+        
+        for (int i = start; i < end; i++) {
+            
+            if (m->getControl_pressed()) { break; }
+            
+            int seqNumber = randomizeSeqs[i];
+            if (seqBin[seqNumber] == -1) { (*bestBins)[i-start] = -2; continue; }
+            
+            long long tp = truePositives; long long tn = trueNegatives; long long fp = falsePositives; long long fn = falseNegatives;
+            (*bestBins)[i-start] = findBestBin(seqNumber, closeBins, tp, tn, fp, fn);
+            
+            vector<long long>& counts = (*bestCounts)[i-start];
+            counts[0] = tp - truePositives; counts[1] = tn - trueNegatives; counts[2] = fp - falsePositives; counts[3] = fn - falseNegatives;
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCluster", "findBestBins");
+        exit(1);
+    }
+}
+/***********************************************************************/
+/* the multiprocessor update. randomizeSeqs is done in batches, the processors find the best bin for each seq in the
+ * batch against the clusters at the start of the batch, then the moves are made in order. the change in the counts
+ * for a move only depends on the bin the seq leaves and the bin it joins, so if neither has changed since the start
+ * of the batch the move is made as found. otherwise the seq is scored again against the current clusters.
+ * the batches don't depend on the number of processors, so a seed gives the same clusters with any number of processors. */
+void OptiCluster::updateBatches() {
+    try {
+        const int batchSize = 10000;
+        
+        vector<int> closeBins;
+        vector<bool> changedBins(bins.size(), false);
+        vector<int> changed;
+        
+        for (int batchStart = 0; batchStart < randomizeSeqs.size(); batchStart += batchSize) {
+            
+            if (m->getControl_pressed()) { break; }
+            
+            int batchEnd = min((int)randomizeSeqs.size(), batchStart + batchSize);
+            int numInBatch = batchEnd - batchStart;
+            
+            //divide the batch between the processors
+            int numPerProcessor = numInBatch / processors;
+            int remainingPairs = numInBatch % processors;
+            int startIndex = 0;
+            
+            vector<std::thread*> workerThreads;
+            vector< vector<int> > threadBins(processors);
+            vector< vector< vector<long long> > > threadCounts(processors);
+            for (int i = 0; i < processors; i++) {
+                int numToProcess = numPerProcessor;
+                if (i < remainingPairs) { numToProcess++; }
+                
+                threadBins[i].resize(numToProcess, -2);
+                threadCounts[i].resize(numToProcess, vector<long long>(4, 0));
+                
+                if (i == (processors-1)) { findBestBins(batchStart+startIndex, batchStart+startIndex+numToProcess, &threadBins[i], &threadCounts[i]); }
+                else { workerThreads.push_back(new std::thread(&OptiCluster::findBestBins, this, batchStart+startIndex, batchStart+startIndex+numToProcess, &threadBins[i], &threadCounts[i])); }
+                
+                startIndex += numToProcess;
+            }
+            
+            for (int i = 0; i < workerThreads.size(); i++) { workerThreads[i]->join(); delete workerThreads[i]; }
+            
+            if (m->getControl_pressed()) { break; }
+            
+            //make the moves in order
+            int index = batchStart;
+            for (int i = 0; i < processors; i++) {
+                for (int j = 0; j < threadBins[i].size(); j++) {
+                    int seqNumber = randomizeSeqs[index]; index++;
+                    int bestBin = threadBins[i][j];
+                    int binNumber = seqBin[seqNumber];
+                    
+                    if ((bestBin == -2) || (bestBin == binNumber)) { continue; } //not clustered or staying put
+                    
+                    long long tp, tn, fp, fn;
+                    if (changedBins[binNumber] || ((bestBin != -1) && changedBins[bestBin])) { //clusters changed under us, score again
+                        tp = truePositives; tn = trueNegatives; fp = falsePositives; fn = falseNegatives;
+                        bestBin = findBestBin(seqNumber, closeBins, tp, tn, fp, fn);
+                    }else {
+                        vector<long long>& counts = threadCounts[i][j];
+                        tp = truePositives + counts[0]; tn = trueNegatives + counts[1]; fp = falsePositives + counts[2]; fn = falseNegatives + counts[3];
+                    }
+                    
+                    int newBin = placeSeq(seqNumber, bestBin, tp, tn, fp, fn);
+                    if (newBin != binNumber) {
+                        if (!changedBins[binNumber]) { changedBins[binNumber] = true; changed.push_back(binNumber); }
+                        if (!changedBins[newBin]) { changedBins[newBin] = true; changed.push_back(newBin); }
+                    }
+                }
+            }
+            
+            for (int i = 0; i < changed.size(); i++) { changedBins[changed[i]] = false; }
+            changed.clear();
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCluster", "updateBatches");
+        exit(1);
+    }
+}
+/***********************************************************************/
 vector<long long> OptiCluster::getCloseFarCounts(int seq, int newBin) {
     try {
         vector<long long> results; results.push_back(0); results.push_back(0);
         
         if (newBin == -1) { }  //making a singleton bin. Close but we are forcing apart.
         else { //merging a bin
-            for (int i = 0; i < bins[newBin].size(); i++) {
-                if (seq == bins[newBin][i]) {} //ignore self
-                else if (!matrix->isClose(seq, bins[newBin][i])) { results[1]++; }  //this sequence is "far away" from sequence i - above the cutoff
-                else { results[0]++;  }  //this sequence is "close" to sequence i - distance between them is less than cutoff
+            closeSeqsRange closeSeqs = matrix->getCloseSeqs(seq);
+            for (const int* itClose = closeSeqs.begin(); itClose != closeSeqs.end(); itClose++) {
+                if (*itClose == seq) {} //ignore self
+                else if (seqBin[*itClose] == newBin) { results[0]++; } //this sequence is "close" to sequence i - distance between them is less than cutoff
             }
+            
+            //everyone else in the bin is "far away" - above the cutoff
+            results[1] = bins[newBin].size() - results[0];
+            if (seqBin[seq] == newBin) { results[1]--; } //ignore self
         }
         
         return results;
@@ -327,12 +487,17 @@ ListVector* OptiCluster::getList() {
             delete singleton;
         }
         
+        //moveSeq swaps the last seq of a bin into the place of the one leaving, so the names are listed in the order the
+        //seqs were read instead of the order they joined the bin
         for (int i = 0; i < bins.size(); i++) {
             if (bins[i].size() != 0) {
-                string otu = matrix->getName(bins[i][0]);
+                vector<int> binSeqs = bins[i];
+                sort(binSeqs.begin(), binSeqs.end());
+                
+                string otu = matrix->getName(binSeqs[0]);
                 
-                for (int j = 1; j < bins[i].size(); j++) {
-                    otu += "," + matrix->getName(bins[i][j]);
+                for (int j = 1; j < binSeqs.size(); j++) {
+                    otu += "," + matrix->getName(binSeqs[j]);
                 }
                 list->push_back(otu);
             }
@@ -357,10 +522,8 @@ ListVector* OptiCluster::getList(set<string>& unfittedSeqs) {
                 
                 if (m->getControl_pressed()) { break; }
                 
-                map<int, int>::iterator it = seqBin.find(randomizeSeqs[i]);
-                
-                int seqNumber = it->first;
-                int binNumber = it->second;
+                int seqNumber = randomizeSeqs[i];
+                int binNumber = seqBin[seqNumber];
                 
                 map<int, string>::iterator itBin = newBins.find(binNumber); // have we seen this otu yet?
                 
@@ -426,14 +589,9 @@ int OptiCluster::findInsert() {
     try {
         
         //initially there are bins for each sequence (excluding singletons removed on read)
-        for (int i = 0; i < bins.size(); i++) {
-            
-            if (m->getControl_pressed()) { break; }
-            
-            if (bins[i].size() == 0) { return i;  } //this bin is empty
-        }
+        if (emptyBins.size() == 0) { return -1; }
         
-        return -1;
+        return *(emptyBins.begin()); //lowest empty bin
     }
     catch(exception& e) {
         m->errorOut(e, "OptiCluster", "findInsert");
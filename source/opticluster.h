@@ -35,12 +35,12 @@ public:
     
 #ifdef UNIT_TEST
     friend class TestOptiCluster;
-    OptiCluster() : Cluster() { m = MothurOut::getInstance(); truePositives = 0; trueNegatives = 0; falseNegatives = 0; falsePositives = 0; removeTrainers = false; } //for testing class
+    OptiCluster() : Cluster() { m = MothurOut::getInstance(); truePositives = 0; trueNegatives = 0; falseNegatives = 0; falsePositives = 0; removeTrainers = false; numSingletons = 0; processors = 1; } //for testing class
     void setVariables(OptiMatrix* mt, ClusterMetric* met) { matrix = mt; metric = met; }
 #endif
     
     OptiCluster(OptiMatrix* mt, ClusterMetric* met, long long ns) : Cluster() {
-        m = MothurOut::getInstance(); matrix = mt; metric = met; truePositives = 0; trueNegatives = 0; falseNegatives = 0; falsePositives = 0; numSingletons = ns;
+        m = MothurOut::getInstance(); matrix = mt; metric = met; truePositives = 0; trueNegatives = 0; falseNegatives = 0; falsePositives = 0; numSingletons = ns; processors = 1;
     }
     ~OptiCluster() {}
     bool updateDistance(PDistCell& colCell, PDistCell& rowCell) { return false; } //inheritance compliant
@@ -49,6 +49,7 @@ public:
     int initialize(double&, bool, string);  //randomize and place in "best" OTUs
     int initialize(double& value, bool randomize, string initialize, vector<vector< string > > existingBins, vector<string>, long long tp, long long tn, long long fp, long long fn);
     bool update(double&); //returns whether list changed and MCC
+    void setProcessors(int p) { processors = p; } //more than 1 moves the sequences in batches, see updateBatches
     vector<double> getStats( long long&,  long long&,  long long&,  long long&);
     ListVector* getList();
     ListVector* getList(set<string>&);
@@ -56,18 +57,27 @@ public:
 protected:
     MothurOut* m;
     Utils util;
-    map<int, int> seqBin; //sequence# -> bin#
+    vector<int> seqBin; //sequence# -> bin#, -1 if the sequence is not being clustered
+    vector<int> seqPosition; //sequence# -> index of the sequence in its bin
     OptiMatrix* matrix;
     vector<int> randomizeSeqs;
-    vector< vector<int> > bins; //bin[0] -> seqs in bin[0]
+    vector< vector<int> > bins; //bin[0] -> seqs in bin[0]. fitted bins may hold -1 for reference seqs without distances
+    set<int> emptyBins;
     map<int, string> binLabels; //for fitting - maps binNumber to existing reference label
     set<string> immovableNames;
     ClusterMetric* metric;
     long long truePositives, trueNegatives, falsePositives, falseNegatives, numSeqs, insertLocation, numSingletons;
     bool removeTrainers;
+    int processors;
     
     int findInsert();
     vector<long long> getCloseFarCounts(int seq, int newBin);
+    void setSeqBins();
+    void moveSeq(int seq, int newBin);
+    int findBestBin(int seq, vector<int>& closeBins, long long& tp, long long& tn, long long& fp, long long& fn);
+    int placeSeq(int seq, int bestBin, long long tp, long long tn, long long fp, long long fn);
+    void updateBatches();
+    void findBestBins(int start, int end, vector<int>* bestBins, vector< vector<long long> >* bestCounts);
 };
 
 #endif /* defined(__Mothur__opticluster__) */
@@ -0,0 +1,457 @@
+/*
+ *  permutationtest.cpp
+ *  Mothur
+ *
+ */
+
+#include "permutationtest.h"
+
+//each block of iters gets its own random stream
+static const int permutationBlockSize = 100;
+
+/**************************************************************************************************/
+
+double PermutationStatistic::getObserved() {
+	try {
+		vector<int> order(numSamples);
+		for (int i = 0; i < numSamples; i++) { order[i] = i; }
+
+		return getStatistic(order);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "PermutationStatistic", "getObserved");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+GroupStatistic::GroupStatistic(vector< vector<double> >& distanceMatrix, map<string, vector<int> >& groupSampleMap) : PermutationStatistic() {
+	try {
+		vector<int> indexes;
+		for (map<string, vector<int> >::iterator it = groupSampleMap.begin(); it != groupSampleMap.end(); it++) {
+			groupStarts.push_back(indexes.size());
+			indexes.insert(indexes.end(), it->second.begin(), it->second.end());
+		}
+		groupStarts.push_back(indexes.size());
+		numSamples = indexes.size();
+
+		dists.resize(((long long)numSamples * (numSamples-1)) / 2, 0.0);
+		for (int i = 1; i < numSamples; i++) {
+			for (int j = 0; j < i; j++) {
+				int row = indexes[i]; int col = indexes[j];
+				if (row < col) { row = indexes[j]; col = indexes[i]; }
+				dists[((long long)i * (i-1)) / 2 + j] = distanceMatrix[row][col];
+			}
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "GroupStatistic", "GroupStatistic");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+void GroupStatistic::getWithinSums(vector<int>& order, vector<double>& sums) {
+	try {
+		sums.assign(groupStarts.size()-1, 0.0);
+
+		for (int g = 0; g < sums.size(); g++) {
+			for (int i = groupStarts[g]+1; i < groupStarts[g+1]; i++) {
+				int row = order[i];
+				for (int j = groupStarts[g]; j < i; j++) { sums[g] += getDist(row, order[j]); }
+			}
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "GroupStatistic", "getWithinSums");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+double AmovaStatistic::getStatistic(vector<int>& order) {
+	try {
+		vector<double> sums;
+		getWithinSums(order, sums);
+
+		double ssWithin = 0.0;
+		for (int g = 0; g < sums.size(); g++) { ssWithin += sums[g] / (groupStarts[g+1] - groupStarts[g]); }
+
+		return ssWithin;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "AmovaStatistic", "getStatistic");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+double HomovaStatistic::getStatistic(vector<int>& order) {
+	try {
+		vector<double> sums;
+		getWithinSums(order, sums);
+
+		double numGroups = (double)sums.size();
+		double totalNumSamples = 0; double ssWithinFull = 0; double secondTermSum = 0; double inverseOneMinusSum = 0;
+
+		for (int g = 0; g < sums.size(); g++) {
+			int numSamplesInGroup = groupStarts[g+1] - groupStarts[g];
+			totalNumSamples += numSamplesInGroup;
+
+			double ssWithin = sums[g] / (double) numSamplesInGroup;
+			ssWithinFull += ssWithin;
+
+			secondTermSum += (numSamplesInGroup - 1) * log(ssWithin / (double)(numSamplesInGroup - 1));
+			inverseOneMinusSum += 1.0 / (double)(numSamplesInGroup - 1);
+		}
+
+		double B = (totalNumSamples - numGroups) * log(ssWithinFull/(totalNumSamples-numGroups)) - secondTermSum;
+		double denomintor = 1 + 1.0/(3.0 * (numGroups - 1.0)) * (inverseOneMinusSum - 1.0 / (double) (totalNumSamples - numGroups));
+		B /= denomintor;
+
+		return B;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "HomovaStatistic", "getStatistic");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+AnosimStatistic::AnosimStatistic(vector< vector<double> >& rankMatrix, map<string, vector<int> >& groupSampleMap) : GroupStatistic(rankMatrix, groupSampleMap) {
+	try {
+		//the between sum is everything that is not within, and the number of comparisons doesn't depend on the order
+		totalSum = 0.0;
+		for (int i = 0; i < dists.size(); i++) { totalSum += dists[i]; }
+
+		numWithinComps = 0;
+		for (int g = 0; g+1 < groupStarts.size(); g++) {
+			int numSamplesInGroup = groupStarts[g+1] - groupStarts[g];
+			numWithinComps += (numSamplesInGroup * (numSamplesInGroup-1)) / 2;
+		}
+		numBetweenComps = dists.size() - numWithinComps;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "AnosimStatistic", "AnosimStatistic");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+double AnosimStatistic::getStatistic(vector<int>& order) {
+	try {
+		vector<double> sums;
+		getWithinSums(order, sums);
+
+		double within = 0.0;
+		for (int g = 0; g < sums.size(); g++) { within += sums[g]; }
+
+		double between = totalSum - within;
+
+		within /= (float) numWithinComps;
+		between /= (float) numBetweenComps;
+
+		double Rvalue = (between - within)/(numSamples * (numSamples-1) / 4.0);
+
+		return Rvalue;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "AnosimStatistic", "getStatistic");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+MantelStatistic::MantelStatistic(vector< vector<double> >& matrix1, vector< vector<double> >& matrix2, string meth) : PermutationStatistic() {
+	try {
+		method = meth;
+		yMatrix = matrix2;
+		numSamples = matrix2.size();
+
+		for (int i = 0; i < matrix1.size(); i++) {
+			for (int j = 0; j < i; j++) { xValues.push_back(matrix1[i][j]); }
+		}
+
+		if (method == "pearson") {
+			averageX = 0.0;
+			for (int i = 0; i < matrix1.size(); i++) {
+				for (int j = 0; j < i; j++) { averageX += matrix1[i][j]; }
+			}
+			averageX = averageX / (float) xValues.size();
+
+			denomX = 0.0;
+			for (int i = 0; i < xValues.size(); i++) {
+				float diff = xValues[i] - averageX;
+				xDiffs.push_back(diff);
+				denomX += (diff * diff);
+			}
+		}else if (method == "spearman") {
+			getRanks(xValues, xRanks, Lx);
+		}else if (method == "kendall") {
+			//sorted the same way as LinearAlgebra::calcKendall, so ties of x end up in the same order
+			vector<spearmanRank> scores;
+			for (int i = 0; i < xValues.size(); i++) { scores.push_back(spearmanRank(toString(i), xValues[i])); }
+			sort(scores.begin(), scores.end(), compareSpearman);
+
+			for (int i = 0; i < scores.size(); i++) { xOrder.push_back(atoi(scores[i].name.c_str())); }
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "MantelStatistic", "MantelStatistic");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//the second matrix with its rows in this order, same as shuffling the rows of the matrix
+double MantelStatistic::getStatistic(vector<int>& order) {
+	try {
+		vector<double> yValues; yValues.reserve(xValues.size());
+		for (int i = 0; i < numSamples; i++) {
+			vector<double>& row = yMatrix[order[i]];
+			for (int j = 0; j < i; j++) { yValues.push_back(row[j]); }
+		}
+
+		if (method == "pearson")		{ return getPearson(yValues);	}
+		else if (method == "spearman")	{ return getSpearman(yValues);	}
+		else if (method == "kendall")	{ return getKendall(yValues);	}
+
+		return 0.0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "MantelStatistic", "getStatistic");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//same as LinearAlgebra::calcPearson with the x terms done once
+double MantelStatistic::getPearson(vector<double>& yValues) {
+	try {
+		float averageY = 0.0;
+		for (int i = 0; i < yValues.size(); i++) { averageY += yValues[i]; }
+		averageY = averageY / (float) yValues.size();
+
+		double numerator = 0.0; double denomY = 0.0;
+		for (int i = 0; i < yValues.size(); i++) {
+			float Yi = yValues[i];
+			float diff = Yi - averageY;
+			numerator += (xDiffs[i] * diff);
+			denomY += (diff * diff);
+		}
+
+		double r = numerator / (sqrt(denomX) * sqrt(denomY));
+
+		//divide by zero error
+		if (isnan(r) || isinf(r)) { r = 0.0; }
+
+		return r;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "MantelStatistic", "getPearson");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//ties get the average of their ranks, L is the sum of (t^3 - t)/12 over the ties
+void MantelStatistic::getRanks(vector<float>& values, vector<float>& ranks, double& L) {
+	try {
+		vector<int> sorted(values.size());
+		for (int i = 0; i < sorted.size(); i++) { sorted[i] = i; }
+		sort(sorted.begin(), sorted.end(), [&values](int left, int right) { return values[left] < values[right]; });
+
+		ranks.resize(values.size()); L = 0.0;
+		int start = 0;
+		while (start < sorted.size()) {
+			int end = start+1;
+			while ((end < sorted.size()) && (values[sorted[end]] == values[sorted[start]])) { end++; }
+
+			int rankTotal = 0;
+			for (int j = start; j < end; j++) { rankTotal += (j+1); }
+			float thisrank = rankTotal / (float) (end-start);
+			for (int j = start; j < end; j++) { ranks[sorted[j]] = thisrank; }
+
+			double t = (double) (end-start);
+			L += ((pow(t, 3.0) - t) / 12.0);
+
+			start = end;
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "MantelStatistic", "getRanks");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//same as LinearAlgebra::calcSpearman with the x ranks done once
+double MantelStatistic::getSpearman(vector<double>& values) {
+	try {
+		vector<float> yValues(values.begin(), values.end());
+		vector<float> yRanks; double Ly;
+		getRanks(yValues, yRanks, Ly);
+
+		double di = 0.0;
+		for (int i = 0; i < yRanks.size(); i++) { di += ((xRanks[i] - yRanks[i]) * (xRanks[i] - yRanks[i])); }
+
+		double n = (double) yRanks.size();
+
+		double SX2 = ((pow(n, 3.0) - n) / 12.0) - Lx;
+		double SY2 = ((pow(n, 3.0) - n) / 12.0) - Ly;
+
+		double r = (SX2 + SY2 - di) / (2.0 * sqrt((SX2*SY2)));
+
+		//divide by zero error
+		if (isnan(r) || isinf(r)) { r = 0.0; }
+
+		return r;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "MantelStatistic", "getSpearman");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//(concordant - discordant) / pairs, with the pairs in x order. instead of comparing every pair, walk backwards
+//through the x order and count how many of the y values after you are above and below yours with a fenwick tree.
+double MantelStatistic::getKendall(vector<double>& values) {
+	try {
+		vector<float> yValues(values.begin(), values.end());
+
+		//only the order of the ys matters, so give equal values the same small integer
+		vector<int> sorted(yValues.size());
+		for (int i = 0; i < sorted.size(); i++) { sorted[i] = i; }
+		sort(sorted.begin(), sorted.end(), [&yValues](int left, int right) { return yValues[left] < yValues[right]; });
+
+		vector<int> yRanks(yValues.size()); int numRanks = 0;
+		for (int i = 0; i < sorted.size(); i++) {
+			if ((i != 0) && (yValues[sorted[i]] != yValues[sorted[i-1]])) { numRanks++; }
+			yRanks[sorted[i]] = numRanks + 1;
+		}
+		numRanks++;
+
+		vector<int> tree(numRanks+1, 0);
+		long long numCoor = 0; long long numDisCoor = 0; long long numSeen = 0;
+		for (int l = xOrder.size()-1; l >= 0; l--) {
+			int rank = yRanks[xOrder[l]];
+
+			long long numBelow = 0; for (int k = rank-1; k > 0; k -= (k & -k)) { numBelow += tree[k]; }
+			long long numAtOrBelow = 0; for (int k = rank; k > 0; k -= (k & -k)) { numAtOrBelow += tree[k]; }
+
+			numCoor += (numSeen - numAtOrBelow);
+			numDisCoor += numBelow;
+
+			for (int k = rank; k <= numRanks; k += (k & -k)) { tree[k]++; }
+			numSeen++;
+		}
+
+		long long count = ((long long)xOrder.size() * (xOrder.size()-1)) / 2;
+		double r = (float)(numCoor - numDisCoor) / (float) count;
+
+		//divide by zero error
+		if (isnan(r) || isinf(r)) { r = 0.0; }
+
+		return r;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "MantelStatistic", "getKendall");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+struct permutationData {
+	PermutationStatistic* statistic;
+	MothurOut* m;
+	unsigned seed;
+	int run, startBlock, endBlock, iters, count;
+	double observed;
+	bool greater;
+
+	permutationData(PermutationStatistic* s, unsigned se, int r, int sb, int eb, int it, double o, bool g) : statistic(s), seed(se), run(r), startBlock(sb), endBlock(eb), iters(it), observed(o), greater(g) {
+		m = MothurOut::getInstance();
+		count = 0;
+	}
+};
+/**************************************************************************************************/
+
+void driverPermutations(permutationData* params) {
+	try {
+		int numSamples = params->statistic->getNumSamples();
+
+		for (int b = params->startBlock; b < params->endBlock; b++) {
+			seed_seq blockSeed = { params->seed, (unsigned) params->run, (unsigned) b };
+			mt19937_64 randomGenerator(blockSeed);
+
+			vector<int> order(numSamples);
+			for (int i = 0; i < numSamples; i++) { order[i] = i; }
+
+			int numIters = min(permutationBlockSize, params->iters - (b * permutationBlockSize));
+			for (int i = 0; i < numIters; i++) {
+				if (params->m->getControl_pressed()) { return; }
+
+				shuffle(order.begin(), order.end(), randomGenerator);
+				double randomStatistic = params->statistic->getStatistic(order);
+
+				if (params->greater)	{ if (randomStatistic >= params->observed) { params->count++; } }
+				else					{ if (randomStatistic <= params->observed) { params->count++; } }
+			}
+		}
+	}
+	catch(exception& e) {
+		params->m->errorOut(e, "PermutationTest", "driverPermutations");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+PermutationTest::PermutationTest(int i, int p) : iters(i), processors(p) {
+	m = MothurOut::getInstance();
+	numRuns = 0;
+}
+/**************************************************************************************************/
+
+int PermutationTest::getCount(PermutationStatistic* statistic, double observed, bool greater) {
+	try {
+		//each test of a command gets different streams
+		int run = numRuns; numRuns++;
+		unsigned seed = m->getRandomSeed();
+
+		int numBlocks = (iters + permutationBlockSize - 1) / permutationBlockSize;
+		int numThreads = processors;
+		if (numThreads > numBlocks) { numThreads = numBlocks; }
+		if (numThreads < 1) { numThreads = 1; }
+
+		vector<int> startBlocks;
+		for (int i = 0; i <= numThreads; i++) { startBlocks.push_back((int)(((long long)i * numBlocks) / numThreads)); }
+
+		//create array of worker threads
+		vector<thread*> workerThreads;
+		vector<permutationData*> data;
+
+		//Lauch worker threads
+		for (int i = 1; i < numThreads; i++) {
+			permutationData* dataBundle = new permutationData(statistic, seed, run, startBlocks[i], startBlocks[i+1], iters, observed, greater);
+			data.push_back(dataBundle);
+
+			workerThreads.push_back(new thread(driverPermutations, dataBundle));
+		}
+
+		permutationData* dataBundle = new permutationData(statistic, seed, run, startBlocks[0], startBlocks[1], iters, observed, greater);
+		driverPermutations(dataBundle);
+		int count = dataBundle->count;
+		delete dataBundle;
+
+		for (int i = 0; i < workerThreads.size(); i++) {
+			workerThreads[i]->join();
+			count += data[i]->count;
+
+			delete data[i];
+			delete workerThreads[i];
+		}
+
+		return count;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "PermutationTest", "getCount");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
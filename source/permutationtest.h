@@ -0,0 +1,130 @@
+#ifndef PERMUTATIONTEST_H
+#define PERMUTATIONTEST_H
+
+/*
+ *  permutationtest.h
+ *  Mothur
+ *
+ *  Runs the randomizations for amova, homova, anosim and mantel. The statistics know how to score one order of the
+ *  samples, the test shuffles the order iters times and counts the shuffles that score at least as extreme as the
+ *  original order.
+ *
+ *  The iters are split into blocks and each block has its own random stream made from the seed, so the counts only
+ *  depend on the seed and not on the number of processors.
+ *
+ */
+
+#include "mothurout.h"
+
+/**************************************************************************************************/
+
+class PermutationStatistic {
+
+public:
+	PermutationStatistic() { m = MothurOut::getInstance(); numSamples = 0; }
+	virtual ~PermutationStatistic() {}
+
+	//the statistic when the sample in position i is order[i]. called from several threads at once.
+	virtual double getStatistic(vector<int>&) = 0;
+	double getObserved();	//the statistic with the samples in their original order
+	int getNumSamples() { return numSamples; }
+
+protected:
+	MothurOut* m;
+	int numSamples;
+};
+
+/**************************************************************************************************/
+//the squared distances between the samples of the groups in a packed lower triangle. The samples are numbered
+//in group order, so group g is positions groupStarts[g] to groupStarts[g+1]-1 of the order.
+class GroupStatistic : public PermutationStatistic {
+
+public:
+	GroupStatistic(vector< vector<double> >&, map<string, vector<int> >&);	//distance matrix (lower triangle filled), group -> indexes into matrix
+	virtual ~GroupStatistic() {}
+
+	virtual double getStatistic(vector<int>&) = 0;
+
+protected:
+	vector<double> dists;
+	vector<int> groupStarts;
+
+	double getDist(int i, int j) { if (i < j) { int temp = i; i = j; j = temp; } return dists[((long long)i * (i-1)) / 2 + j]; }
+	void getWithinSums(vector<int>&, vector<double>&);	//sum of the dists within each group
+};
+
+/**************************************************************************************************/
+//sum of squares within the groups
+class AmovaStatistic : public GroupStatistic {
+
+public:
+	AmovaStatistic(vector< vector<double> >& d, map<string, vector<int> >& g) : GroupStatistic(d, g) {}
+	double getStatistic(vector<int>&);
+};
+
+/**************************************************************************************************/
+//Bartlett's B of the sum of squares within the groups
+class HomovaStatistic : public GroupStatistic {
+
+public:
+	HomovaStatistic(vector< vector<double> >& d, map<string, vector<int> >& g) : GroupStatistic(d, g) {}
+	double getStatistic(vector<int>&);
+};
+
+/**************************************************************************************************/
+//R from the ranks of the distances. the dists are the ranks.
+class AnosimStatistic : public GroupStatistic {
+
+public:
+	AnosimStatistic(vector< vector<double> >&, map<string, vector<int> >&);
+	double getStatistic(vector<int>&);
+
+private:
+	double totalSum;
+	int numWithinComps, numBetweenComps;
+};
+
+/**************************************************************************************************/
+//correlation of the lower triangles of two matrices, the rows of the second matrix are shuffled
+class MantelStatistic : public PermutationStatistic {
+
+public:
+	MantelStatistic(vector< vector<double> >&, vector< vector<double> >&, string);	//matrix1, matrix2, method - pearson, spearman or kendall
+	double getStatistic(vector<int>&);
+
+private:
+	string method;
+	vector< vector<double> > yMatrix;
+	vector<float> xValues;		//lower triangle of matrix1, row by row
+	vector<float> xDiffs;		//pearson: x - average x
+	float averageX;
+	double denomX;
+	vector<float> xRanks;		//spearman
+	double Lx;
+	vector<int> xOrder;			//kendall: indexes of the x values in sorted order
+
+	double getPearson(vector<double>&);
+	double getSpearman(vector<double>&);
+	double getKendall(vector<double>&);
+	void getRanks(vector<float>&, vector<float>&, double&);	//values, ranks, sum of the ties terms
+};
+
+/**************************************************************************************************/
+
+class PermutationTest {
+
+public:
+	PermutationTest(int, int);	//iters, processors
+	~PermutationTest() {}
+
+	//number of shuffles whose statistic is >= observed, or <= observed if greater is false
+	int getCount(PermutationStatistic*, double, bool);
+
+private:
+	MothurOut* m;
+	int iters, processors, numRuns;
+};
+
+/**************************************************************************************************/
+
+#endif
@@ -13,7 +13,8 @@
 AbstractDecisionTree::AbstractDecisionTree(vector<vector<int> >& baseDataSet,
                                          vector<int> globalDiscardedFeatureIndices,
                                          OptimumFeatureSubsetSelector optimumFeatureSubsetSelector, 
-                                         string treeSplitCriterion)
+                                         string treeSplitCriterion,
+                                         int treeIndex)
 
                     : baseDataSet(baseDataSet),
                     numSamples((int)baseDataSet.size()),
@@ -29,6 +30,10 @@ AbstractDecisionTree::AbstractDecisionTree(vector<vector<int> >& baseDataSet,
         // TODO: istead of calculating this for every DecisionTree
         // clacualte this once in the RandomForest class and pass the values
         m = MothurOut::getInstance();
+        
+        seed_seq treeSeed = { m->getRandomSeed(), (unsigned) treeIndex };
+        randomGenerator.seed(treeSeed);
+        
         for (int i = 0;  i < numSamples; i++) {
             if (m->getControl_pressed()) { break; }
             int outcome = baseDataSet[i][numFeatures];
@@ -54,35 +59,19 @@ AbstractDecisionTree::AbstractDecisionTree(vector<vector<int> >& baseDataSet,
 int AbstractDecisionTree::createBootStrappedSamples(){
     try {    
         vector<bool> isInTrainingSamples(numSamples, false);
-        Utils util;
+        uniform_int_distribution<int> randomSample(0, numSamples-1);
         for (int i = 0; i < numSamples; i++) {
             if (m->getControl_pressed()) { return 0; }
         
-            int randomIndex = util.getRandomIndex(numSamples-1);
-            bootstrappedTrainingSamples.push_back(baseDataSet[randomIndex]);
+            int randomIndex = randomSample(randomGenerator);
+            bootstrappedTrainingSamples.push_back(randomIndex);
             isInTrainingSamples[randomIndex] = true;
         }
         
         for (int i = 0; i < numSamples; i++) {
             if (m->getControl_pressed()) { return 0; }
             if (isInTrainingSamples[i]){ bootstrappedTrainingSampleIndices.push_back(i); }
-            else{
-                bootstrappedTestSamples.push_back(baseDataSet[i]);
-                bootstrappedTestSampleIndices.push_back(i);
-            }
-        }
-        
-            // do the transpose of Test Samples
-        for (int i = 0; i < bootstrappedTestSamples[0].size(); i++) {
-            if (m->getControl_pressed()) { return 0; }
-            
-            vector<int> tmpFeatureVector(bootstrappedTestSamples.size(), 0);
-            for (int j = 0; j < bootstrappedTestSamples.size(); j++) {
-                if (m->getControl_pressed()) { return 0; }
-                
-                tmpFeatureVector[j] = bootstrappedTestSamples[j][i];
-            }
-            testSampleFeatureVectors.push_back(tmpFeatureVector);
+            else{ bootstrappedTestSampleIndices.push_back(i); }
         }
         
         return 0;
@@ -93,8 +82,8 @@ int AbstractDecisionTree::createBootStrappedSamples(){
 	} 
 }
 /**************************************************************************************************/
-int AbstractDecisionTree::getMinEntropyOfFeature(vector<int> featureVector,
-                                                 vector<int> outputVector,
+int AbstractDecisionTree::getMinEntropyOfFeature(vector<int>& featureVector,
+                                                 vector<int>& outputVector,
                                                  double& minEntropy,
                                                  int& featureSplitValue,
                                                  double& intrinsicValue){
@@ -113,23 +102,12 @@ int AbstractDecisionTree::getMinEntropyOfFeature(vector<int> featureVector,
         IntPairVectorSorter intPairVectorSorter;
         sort(featureOutputPair.begin(), featureOutputPair.end(), intPairVectorSorter);
         
+        //the pairs are sorted, so a split point is anywhere the feature value changes
         vector<int> splitPoints;
-        vector<int> uniqueFeatureValues(1, featureOutputPair[0].first);
-        
-        for (int i = 0; i < featureOutputPair.size(); i++) {
-
-            if (m->getControl_pressed()) { return 0; }
-            int featureValue = featureOutputPair[i].first;
-
-            vector<int>::iterator it = find(uniqueFeatureValues.begin(), uniqueFeatureValues.end(), featureValue);
-            if (it == uniqueFeatureValues.end()){                 // NOT FOUND
-                uniqueFeatureValues.push_back(featureValue);
-                splitPoints.push_back(i);
-            }
+        for (int i = 1; i < featureOutputPair.size(); i++) {
+            if (featureOutputPair[i].first != featureOutputPair[i-1].first) { splitPoints.push_back(i); }
         }
         
-
-        
         int bestSplitIndex = -1;
         if (splitPoints.size() == 0){
             // TODO: trying out C++'s infitinity, don't know if this will work properly
@@ -172,7 +150,7 @@ double AbstractDecisionTree::calcIntrinsicValue(int numLessThanValueAtSplitPoint
 }
 /**************************************************************************************************/
 
-int AbstractDecisionTree::getBestSplitAndMinEntropy(vector< pair<int, int> > featureOutputPairs, vector<int> splitPoints,
+int AbstractDecisionTree::getBestSplitAndMinEntropy(vector< pair<int, int> >& featureOutputPairs, vector<int>& splitPoints,
                                                     double& minEntropy, int& minEntropyIndex, double& relatedIntrinsicValue){
     try {
         
@@ -180,23 +158,26 @@ int AbstractDecisionTree::getBestSplitAndMinEntropy(vector< pair<int, int> > fea
         vector<double> entropies;
         vector<double> intrinsicValues;
         
+        //the pairs are sorted by feature value, so the samples less than the value at a split point are the ones before it.
+        //moving from one split point to the next only moves the samples in between from the lower to the upper counts.
+        vector<int> upperClassCounts(numOutputClasses, 0);
+        vector<int> lowerClassCounts(numOutputClasses, 0);
+        for (int j = 0; j < numSamples; j++) { lowerClassCounts[featureOutputPairs[j].second]++; }
+        
+        int numLessThanValueAtSplitPoint = 0;
         for (int i = 0; i < splitPoints.size(); i++) {
             if (m->getControl_pressed()) { return 0; }
             int index = splitPoints[i];
-            int valueAtSplitPoint = featureOutputPairs[index].first;
-
-            int numLessThanValueAtSplitPoint = 0;
-            int numGreaterThanValueAtSplitPoint = 0;
             
-            for (int j = 0; j < featureOutputPairs.size(); j++) {
-                if (m->getControl_pressed()) { return 0; }
-                pair<int, int> record = featureOutputPairs[j];
-                if (record.first < valueAtSplitPoint){ numLessThanValueAtSplitPoint++; }
-                else{ numGreaterThanValueAtSplitPoint++; }
+            for (; numLessThanValueAtSplitPoint < index; numLessThanValueAtSplitPoint++) {
+                int outputClass = featureOutputPairs[numLessThanValueAtSplitPoint].second;
+                upperClassCounts[outputClass]++;
+                lowerClassCounts[outputClass]--;
             }
+            int numGreaterThanValueAtSplitPoint = numSamples - numLessThanValueAtSplitPoint;
             
-            double upperEntropyOfSplit = calcSplitEntropy(featureOutputPairs, index, numOutputClasses, true);
-            double lowerEntropyOfSplit = calcSplitEntropy(featureOutputPairs, index, numOutputClasses, false);
+            double upperEntropyOfSplit = calcSplitEntropy(upperClassCounts);
+            double lowerEntropyOfSplit = calcSplitEntropy(lowerClassCounts);
             
             double totalEntropy = (numLessThanValueAtSplitPoint * upperEntropyOfSplit + numGreaterThanValueAtSplitPoint * lowerEntropyOfSplit) / (double)numSamples;
             double intrinsicValue = calcIntrinsicValue(numLessThanValueAtSplitPoint, numGreaterThanValueAtSplitPoint, numSamples);
@@ -220,22 +201,8 @@ int AbstractDecisionTree::getBestSplitAndMinEntropy(vector< pair<int, int> > fea
 }
 /**************************************************************************************************/
 
-double AbstractDecisionTree::calcSplitEntropy(vector< pair<int, int> > featureOutputPairs, int splitIndex, int numOutputClasses, bool isUpperSplit = true) {
+double AbstractDecisionTree::calcSplitEntropy(vector<int>& classCounts) {
     try {
-        vector<int> classCounts(numOutputClasses, 0);
-        
-        if (isUpperSplit) { 
-            for (int i = 0; i < splitIndex; i++) {
-                if (m->getControl_pressed()) { return 0; }
-                classCounts[featureOutputPairs[i].second]++;
-            }
-        } else {
-            for (int i = splitIndex; i < featureOutputPairs.size(); i++) { 
-                if (m->getControl_pressed()) { return 0; }
-                classCounts[featureOutputPairs[i].second]++;
-            }
-        }
-        
         int totalClassCounts = accumulate(classCounts.begin(), classCounts.end(), 0);
         
         double splitEntropy = 0.0;
@@ -257,24 +224,17 @@ double AbstractDecisionTree::calcSplitEntropy(vector< pair<int, int> > featureOu
 
 /**************************************************************************************************/
 
-int AbstractDecisionTree::getSplitPopulation(RFTreeNode* node, vector< vector<int> >& leftChildSamples, vector< vector<int> >& rightChildSamples){    
+int AbstractDecisionTree::getSplitPopulation(RFTreeNode* node, vector<int>& leftChildSamples, vector<int>& rightChildSamples){    
     try {
-        // TODO: there is a possibility of optimization if we can recycle the samples in each nodes
-        // we just need to pointers to the samples i.e. vector<int> and use it everywhere and not create the sample 
-        // sample over and over again
-        // we need to make this const so that it is not modified by all the function calling
-        // currently purgeTreeNodesDataRecursively() is used for the same purpose, but this can be avoided altogher
-        // if re-using the same data over the classes
-        
         int splitFeatureGlobalIndex = node->getSplitFeatureIndex();
         
-        for (int i = 0; i < node->getBootstrappedTrainingSamples().size(); i++) {
-            if (m->getControl_pressed()) { return 0; }
-            vector<int> sample =  node->getBootstrappedTrainingSamples()[i];
+        //the children get the indexes of their samples, the samples themselves stay in baseDataSet
+        const vector<int>& samples = node->getBootstrappedTrainingSamples();
+        for (int i = 0; i < samples.size(); i++) {
             if (m->getControl_pressed()) { return 0; }
             
-            if (sample[splitFeatureGlobalIndex] < node->getSplitFeatureValue()) { leftChildSamples.push_back(sample); }
-            else { rightChildSamples.push_back(sample); }
+            if (baseDataSet[samples[i]][splitFeatureGlobalIndex] < node->getSplitFeatureValue()) { leftChildSamples.push_back(samples[i]); }
+            else { rightChildSamples.push_back(samples[i]); }
         }
         
         return 0;
@@ -286,14 +246,14 @@ int AbstractDecisionTree::getSplitPopulation(RFTreeNode* node, vector< vector<in
 }
 /**************************************************************************************************/
 // TODO: checkIfAlreadyClassified() verify code
-// TODO: use bootstrappedOutputVector for easier calculation instead of using getBootstrappedTrainingSamples()
 bool AbstractDecisionTree::checkIfAlreadyClassified(RFTreeNode* treeNode, int& outputClass) {
     try {
 
+        const vector<int>& outputVector = treeNode->getBootstrappedOutputVector();
         vector<int> tempOutputClasses;
-        for (int i = 0; i < treeNode->getBootstrappedTrainingSamples().size(); i++) {
+        for (int i = 0; i < outputVector.size(); i++) {
             if (m->getControl_pressed()) { return 0; }
-            int sampleOutputClass = treeNode->getBootstrappedTrainingSamples()[i][numFeatures];
+            int sampleOutputClass = outputVector[i];
             vector<int>::iterator it = find(tempOutputClasses.begin(), tempOutputClasses.end(), sampleOutputClass);
             if (it == tempOutputClasses.end()) {               // NOT FOUND
                 tempOutputClasses.push_back(sampleOutputClass);
@@ -311,4 +271,3 @@ bool AbstractDecisionTree::checkIfAlreadyClassified(RFTreeNode* treeNode, int& o
 }
 
 /**************************************************************************************************/
-
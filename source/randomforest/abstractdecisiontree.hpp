@@ -33,19 +33,20 @@ public:
     AbstractDecisionTree(vector<vector<int> >& baseDataSet,
                            vector<int> globalDiscardedFeatureIndices, 
                            OptimumFeatureSubsetSelector optimumFeatureSubsetSelector, 
-                           string treeSplitCriterion);    
+                           string treeSplitCriterion,
+                           int treeIndex);
     virtual ~AbstractDecisionTree(){}
     
   
 protected:
   
     virtual int createBootStrappedSamples();
-    virtual int getMinEntropyOfFeature(vector<int> featureVector, vector<int> outputVector, double& minEntropy, int& featureSplitValue, double& intrinsicValue);
-        virtual int getBestSplitAndMinEntropy(vector< pair<int, int> > featureOutputPairs, vector<int> splitPoints, double& minEntropy, int& minEntropyIndex, double& relatedIntrinsicValue);
+    virtual int getMinEntropyOfFeature(vector<int>& featureVector, vector<int>& outputVector, double& minEntropy, int& featureSplitValue, double& intrinsicValue);
+    virtual int getBestSplitAndMinEntropy(vector< pair<int, int> >& featureOutputPairs, vector<int>& splitPoints, double& minEntropy, int& minEntropyIndex, double& relatedIntrinsicValue);
     virtual double calcIntrinsicValue(int numLessThanValueAtSplitPoint, int numGreaterThanValueAtSplitPoint, int numSamples);
-    virtual double calcSplitEntropy(vector< pair<int, int> > featureOutputPairs, int splitIndex, int numOutputClasses, bool);
+    virtual double calcSplitEntropy(vector<int>& classCounts);
 
-    virtual int getSplitPopulation(RFTreeNode* node, vector< vector<int> >& leftChildSamples, vector< vector<int> >& rightChildSamples);
+    virtual int getSplitPopulation(RFTreeNode* node, vector<int>& leftChildSamples, vector<int>& rightChildSamples);
     virtual bool checkIfAlreadyClassified(RFTreeNode* treeNode, int& outputClass);
 
     vector< vector<int> >& baseDataSet;
@@ -54,12 +55,14 @@ protected:
     int numOutputClasses;
     vector<int> outputClasses;
     
-    vector< vector<int> > bootstrappedTrainingSamples;
+    // the samples are indexes into baseDataSet, a training sample is listed once for each time it was drawn
+    vector<int> bootstrappedTrainingSamples;
     vector<int> bootstrappedTrainingSampleIndices;
-    vector< vector<int> > bootstrappedTestSamples;
     vector<int> bootstrappedTestSampleIndices;
     
-    vector<vector<int> > testSampleFeatureVectors;
+    // each tree has its own random stream made from the random seed and the tree's index, so the forest
+    // is the same no matter how many processors build it
+    mt19937_64 randomGenerator;
     
     RFTreeNode* rootNode;
     int nodeIdCount;
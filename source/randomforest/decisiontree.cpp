@@ -13,16 +13,23 @@ DecisionTree::DecisionTree(vector< vector<int> >& baseDataSet,
                            vector<int> globalDiscardedFeatureIndices,
                            OptimumFeatureSubsetSelector optimumFeatureSubsetSelector,
                            string treeSplitCriterion,
-                           float featureStandardDeviationThreshold)
+                           float featureStandardDeviationThreshold,
+                           int treeIndex)
             : AbstractDecisionTree(baseDataSet,
                                    globalDiscardedFeatureIndices,
                                    optimumFeatureSubsetSelector,
-                                   treeSplitCriterion),
+                                   treeSplitCriterion,
+                                   treeIndex),
             variableImportanceList(numFeatures, 0),
             featureStandardDeviationThreshold(featureStandardDeviationThreshold) {
                 
     try {
         m = MothurOut::getInstance();
+        
+        vector<bool> isGloballyDiscarded(numFeatures, false);
+        for (int i = 0; i < globalDiscardedFeatureIndices.size(); i++) { isGloballyDiscarded[globalDiscardedFeatureIndices[i]] = true; }
+        for (int i = 0; i < numFeatures; i++) { if (!isGloballyDiscarded[i]) { suitableFeatureIndices.push_back(i); } }
+        
         createBootStrappedSamples();
         buildDecisionTree();
     }
@@ -36,42 +43,34 @@ DecisionTree::DecisionTree(vector< vector<int> >& baseDataSet,
 
 int DecisionTree::calcTreeVariableImportanceAndError(int& numCorrect, double& treeErrorRate) {
     try {
-        vector< vector<int> > randomlySampledTestData(bootstrappedTestSamples.size(), vector<int>(bootstrappedTestSamples[0].size(), 0));
+        // shuffling a feature can only change a prediction if the tree splits on that feature,
+        // so the features the tree never looks at add nothing to the importance
+        vector<bool> isSplitFeature(numFeatures, false);
+        getSplitFeaturesRecursively(rootNode, isSplitFeature);
         
-            // TODO: is is possible to further speed up the following O(N^2) by using std::copy?
-        for (int i = 0; i < bootstrappedTestSamples.size(); i++) {
-            for (int j = 0; j < bootstrappedTestSamples[i].size(); j++) {
-                randomlySampledTestData[i][j] = bootstrappedTestSamples[i][j];
-            }
-        }
-        Utils util;
+        vector<int> featureVector;
         for (int i = 0; i < numFeatures; i++) {
             if (m->getControl_pressed()) { return 0; }
+            if (!isSplitFeature[i]) { continue; }
             
-                // if the index is in globalDiscardedFeatureIndices (i.e, null feature) we don't want to shuffle them
-            vector<int>::iterator it = find(globalDiscardedFeatureIndices.begin(), globalDiscardedFeatureIndices.end(), i);
-            if (it == globalDiscardedFeatureIndices.end()) {        // NOT FOUND
-                // if the standard deviation is very low, we know it's not a good feature at all
-                // we can save some time here by discarding that feature
+            // if the standard deviation is very low, we know it's not a good feature at all
+            // we can save some time here by discarding that feature
+            getFeatureVector(bootstrappedTestSampleIndices, i, featureVector);
+            if (util.getStandardDeviation(featureVector) > featureStandardDeviationThreshold) {
+                // NOTE: only shuffle the features, never shuffle the output vector
+                // the shuffled value of the feature is handed to evaluateSample, the test samples are not changed
+                shuffle(featureVector.begin(), featureVector.end(), randomGenerator);
                 
-                vector<int> featureVector = testSampleFeatureVectors[i];
-                if (util.getStandardDeviation(featureVector) > featureStandardDeviationThreshold) {
-                    // NOTE: only shuffle the features, never shuffle the output vector
-                    // so i = 0 and i will be alwaays <= (numFeatures - 1) as the index at numFeatures will denote
-                    // the feature vector
-                    randomlyShuffleAttribute(bootstrappedTestSamples, i, i - 1, randomlySampledTestData);
-
-                    int numCorrectAfterShuffle = 0;
-                    for (int j = 0; j < randomlySampledTestData.size(); j++) {
-                        if (m->getControl_pressed()) {return 0; }
-                        
-                        vector<int> shuffledSample = randomlySampledTestData[j];
-                        int actualSampleOutputClass = shuffledSample[numFeatures];
-                        int predictedSampleOutputClass = evaluateSample(shuffledSample);
-                        if (actualSampleOutputClass == predictedSampleOutputClass) { numCorrectAfterShuffle++; }
-                    }
-                    variableImportanceList[i] += (numCorrect - numCorrectAfterShuffle);
+                int numCorrectAfterShuffle = 0;
+                for (int j = 0; j < bootstrappedTestSampleIndices.size(); j++) {
+                    if (m->getControl_pressed()) {return 0; }
+                    
+                    const vector<int>& testSample = baseDataSet[bootstrappedTestSampleIndices[j]];
+                    int actualSampleOutputClass = testSample[numFeatures];
+                    int predictedSampleOutputClass = evaluateSample(testSample, i, featureVector[j]);
+                    if (actualSampleOutputClass == predictedSampleOutputClass) { numCorrectAfterShuffle++; }
                 }
+                variableImportanceList[i] += (numCorrect - numCorrectAfterShuffle);
             }
         }
         
@@ -101,8 +100,12 @@ int DecisionTree::calcTreeVariableImportanceAndError(int& numCorrect, double& tr
 }
 /***********************************************************************/
 
-// TODO: there must be a way to optimize this function
-int DecisionTree::evaluateSample(vector<int> testSample) {
+int DecisionTree::evaluateSample(const vector<int>& testSample) {
+    return evaluateSample(testSample, -1, 0);
+}
+/***********************************************************************/
+//evaluates the sample as if its value for shuffledFeatureIndex was shuffledFeatureValue
+int DecisionTree::evaluateSample(const vector<int>& testSample, int shuffledFeatureIndex, int shuffledFeatureValue) {
     try {
         RFTreeNode *node = rootNode;
         while (true) {
@@ -111,6 +114,8 @@ int DecisionTree::evaluateSample(vector<int> testSample) {
             if (node->checkIsLeaf()) { return node->getOutputClass(); }
             
             int sampleSplitFeatureValue = testSample[node->getSplitFeatureIndex()];
+            if (node->getSplitFeatureIndex() == shuffledFeatureIndex) { sampleSplitFeatureValue = shuffledFeatureValue; }
+            
             if (sampleSplitFeatureValue < node->getSplitFeatureValue()) { node = node->getLeftChildNode(); }
             else { node = node->getRightChildNode(); } 
         }
@@ -127,11 +132,11 @@ int DecisionTree::evaluateSample(vector<int> testSample) {
 int DecisionTree::calcTreeErrorRate(int& numCorrect, double& treeErrorRate){
     numCorrect = 0;
     try {
-        for (int i = 0; i < bootstrappedTestSamples.size(); i++) {
+        for (int i = 0; i < bootstrappedTestSampleIndices.size(); i++) {
              if (m->getControl_pressed()) {return 0; }
             
-            vector<int> testSample = bootstrappedTestSamples[i];
             int testSampleIndex = bootstrappedTestSampleIndices[i];
+            const vector<int>& testSample = baseDataSet[testSampleIndex];
             
             int actualSampleOutputClass = testSample[numFeatures];
             int predictedSampleOutputClass = evaluateSample(testSample);
@@ -141,7 +146,7 @@ int DecisionTree::calcTreeErrorRate(int& numCorrect, double& treeErrorRate){
             outOfBagEstimates[testSampleIndex] = predictedSampleOutputClass;
         }
         
-        treeErrorRate = 1 - ((double)numCorrect / (double)bootstrappedTestSamples.size());   
+        treeErrorRate = 1 - ((double)numCorrect / (double)bootstrappedTestSampleIndices.size());   
         
         return 0;
     }
@@ -152,53 +157,10 @@ int DecisionTree::calcTreeErrorRate(int& numCorrect, double& treeErrorRate){
 }
 
 /***********************************************************************/
-// TODO: optimize the algo, instead of transposing two time, we can extarct the feature,
-// shuffle it and then re-insert in the original place, thus iproving runnting time
-//This function randomize abundances for a given OTU/feature.
-
-void DecisionTree::randomlyShuffleAttribute(const vector< vector<int> >& samples,
-                               const int featureIndex,
-                               const int prevFeatureIndex,
-                               vector< vector<int> >& shuffledSample) {
-    try {
-        // NOTE: we need (numFeatures + 1) featureVecotors, the last extra vector is actually outputVector
-        
-        // restore previously shuffled feature
-        if (prevFeatureIndex > -1) {
-            for (int j = 0; j < samples.size(); j++) {
-                if (m->getControl_pressed()) { return; }
-                shuffledSample[j][prevFeatureIndex] = samples[j][prevFeatureIndex];
-            }
-        }
-        
-        // now do the shuffling
-        vector<int> featureVectors(samples.size(), 0);
-        for (int j = 0; j < samples.size(); j++) {
-            if (m->getControl_pressed()) { return; }
-            featureVectors[j] = samples[j][featureIndex];
-        }
-        Utils util; util.mothurRandomShuffle(featureVectors);
-        for (int j = 0; j < samples.size(); j++) {
-            if (m->getControl_pressed()) { return; }
-            shuffledSample[j][featureIndex] = featureVectors[j];
-        }
-    }
-	catch(exception& e) {
-        m->errorOut(e, "DecisionTree", "randomlyShuffleAttribute");
-		exit(1);
-	}
-    
-}
-
-/***********************************************************************/
-
 int DecisionTree::purgeTreeNodesDataRecursively(RFTreeNode* treeNode) {
     try {
         treeNode->bootstrappedTrainingSamples.clear();
-        treeNode->bootstrappedFeatureVectors.clear();
         treeNode->bootstrappedOutputVector.clear();
-        treeNode->localDiscardedFeatureIndices.clear();
-        treeNode->globalDiscardedFeatureIndices.clear();
         
         if (treeNode->leftChildNode != NULL) { purgeTreeNodesDataRecursively(treeNode->leftChildNode); }
         if (treeNode->rightChildNode != NULL) { purgeTreeNodesDataRecursively(treeNode->rightChildNode); }
@@ -215,8 +177,7 @@ void DecisionTree::buildDecisionTree(){
     try {
     
         int generation = 0;
-        rootNode = new RFTreeNode(bootstrappedTrainingSamples, globalDiscardedFeatureIndices, numFeatures, numSamples, numOutputClasses, generation, nodeIdCount, featureStandardDeviationThreshold);
-        nodeIdCount++;
+        rootNode = createTreeNode(bootstrappedTrainingSamples, generation);
         
         splitRecursively(rootNode);
         
@@ -234,7 +195,7 @@ int DecisionTree::splitRecursively(RFTreeNode* rootNode) {
        
         if (rootNode->getNumSamples() < 2){
             rootNode->setIsLeaf(true);
-            rootNode->setOutputClass(rootNode->getBootstrappedTrainingSamples()[0][rootNode->getNumFeatures()]);
+            rootNode->setOutputClass(rootNode->getBootstrappedOutputVector()[0]);
             return 0;
         }
         
@@ -246,7 +207,14 @@ int DecisionTree::splitRecursively(RFTreeNode* rootNode) {
             return 0;
         }
         if (m->getControl_pressed()) { return 0; }
-        vector<int> featureSubsetIndices = selectFeatureSubsetRandomly(globalDiscardedFeatureIndices, rootNode->getLocalDiscardedFeatureIndices());
+        vector<int> featureSubsetIndices = selectFeatureSubsetRandomly(rootNode);
+        
+        // every feature has the same value in all of the node's samples, so there is nothing left to split on
+        if (featureSubsetIndices.size() == 0) {
+            rootNode->setIsLeaf(true);
+            updateOutputClassOfNode(rootNode);
+            return 0;
+        }
         
             // TODO: need to check if the value is actually copied correctly
         rootNode->setFeatureSubsetIndices(featureSubsetIndices);
@@ -260,17 +228,15 @@ int DecisionTree::splitRecursively(RFTreeNode* rootNode) {
         
         if (m->getControl_pressed()) { return 0; }
         
-        vector< vector<int> > leftChildSamples;
-        vector< vector<int> > rightChildSamples;
+        vector<int> leftChildSamples;
+        vector<int> rightChildSamples;
         getSplitPopulation(rootNode, leftChildSamples, rightChildSamples);
         
         if (m->getControl_pressed()) { return 0; }
         
         // TODO: need to write code to clear this memory
-        RFTreeNode* leftChildNode = new RFTreeNode(leftChildSamples, globalDiscardedFeatureIndices, numFeatures, (int)leftChildSamples.size(), numOutputClasses, rootNode->getGeneration() + 1, nodeIdCount, featureStandardDeviationThreshold);
-        nodeIdCount++;
-        RFTreeNode* rightChildNode = new RFTreeNode(rightChildSamples, globalDiscardedFeatureIndices, numFeatures, (int)rightChildSamples.size(), numOutputClasses, rootNode->getGeneration() + 1, nodeIdCount, featureStandardDeviationThreshold);
-        nodeIdCount++;
+        RFTreeNode* leftChildNode = createTreeNode(leftChildSamples, rootNode->getGeneration() + 1);
+        RFTreeNode* rightChildNode = createTreeNode(rightChildSamples, rootNode->getGeneration() + 1);
         
         rootNode->setLeftChildNode(leftChildNode);
         leftChildNode->setParentNode(rootNode);
@@ -296,8 +262,6 @@ int DecisionTree::splitRecursively(RFTreeNode* rootNode) {
 int DecisionTree::findAndUpdateBestFeatureToSplitOn(RFTreeNode* node){
     try {
 
-        vector< vector<int> > bootstrappedFeatureVectors = node->getBootstrappedFeatureVectors();
-        if (m->getControl_pressed()) { return 0; }
         vector<int> bootstrappedOutputVector = node->getBootstrappedOutputVector();
         if (m->getControl_pressed()) { return 0; }
         vector<int> featureSubsetIndices = node->getFeatureSubsetIndices();
@@ -307,6 +271,7 @@ int DecisionTree::findAndUpdateBestFeatureToSplitOn(RFTreeNode* node){
         vector<int> featureSubsetSplitValues;
         vector<double> featureSubsetIntrinsicValues;
         vector<double> featureSubsetGainRatios;
+        vector<int> featureVector;
         
         for (int i = 0; i < featureSubsetIndices.size(); i++) {
             if (m->getControl_pressed()) { return 0; }
@@ -317,7 +282,8 @@ int DecisionTree::findAndUpdateBestFeatureToSplitOn(RFTreeNode* node){
             int featureSplitValue;
             double featureIntrinsicValue;
             
-            getMinEntropyOfFeature(bootstrappedFeatureVectors[tryIndex], bootstrappedOutputVector, featureMinEntropy, featureSplitValue, featureIntrinsicValue);
+            getFeatureVector(node->getBootstrappedTrainingSamples(), tryIndex, featureVector);
+            getMinEntropyOfFeature(featureVector, bootstrappedOutputVector, featureMinEntropy, featureSplitValue, featureIntrinsicValue);
             if (m->getControl_pressed()) { return 0; }
             
             featureSubsetEntropies.push_back(featureMinEntropy);
@@ -369,33 +335,28 @@ int DecisionTree::findAndUpdateBestFeatureToSplitOn(RFTreeNode* node){
 	} 
 }
 /***********************************************************************/
-vector<int> DecisionTree::selectFeatureSubsetRandomly(vector<int> globalDiscardedFeatureIndices, vector<int> localDiscardedFeatureIndices){
+vector<int> DecisionTree::selectFeatureSubsetRandomly(RFTreeNode* node){
     try {
 
         vector<int> featureSubsetIndices;
         
-        vector<int> combinedDiscardedFeatureIndices;
-        combinedDiscardedFeatureIndices.insert(combinedDiscardedFeatureIndices.end(), globalDiscardedFeatureIndices.begin(), globalDiscardedFeatureIndices.end());
-        combinedDiscardedFeatureIndices.insert(combinedDiscardedFeatureIndices.end(), localDiscardedFeatureIndices.begin(), localDiscardedFeatureIndices.end());
-        
-        sort(combinedDiscardedFeatureIndices.begin(), combinedDiscardedFeatureIndices.end());
-        
-        int numberOfRemainingSuitableFeatures = (int)(numFeatures - combinedDiscardedFeatureIndices.size());
-        int currentFeatureSubsetSize = numberOfRemainingSuitableFeatures < optimumFeatureSubsetSize ? numberOfRemainingSuitableFeatures : optimumFeatureSubsetSize;
-        
-        Utils util;
-        while (featureSubsetIndices.size() < currentFeatureSubsetSize) {
+        // draws the suitable features in random order and skips the ones that have the same value in all of the node's
+        // samples, until there are enough. this gives the same subsets as finding all of the node's discarded features
+        // first, but usually only a few features need to be looked at.
+        vector<int> featureVector;
+        int numSuitableFeatures = (int)suitableFeatureIndices.size();
+        for (int i = 0; i < numSuitableFeatures; i++) {
             
             if (m->getControl_pressed()) { return featureSubsetIndices; }
+            if (featureSubsetIndices.size() >= optimumFeatureSubsetSize) { break; }
             
-            int randomIndex = util.getRandomIndex(numFeatures-1);
-            vector<int>::iterator it = find(featureSubsetIndices.begin(), featureSubsetIndices.end(), randomIndex);
-            if (it == featureSubsetIndices.end()){    // NOT FOUND
-                vector<int>::iterator it2 = find(combinedDiscardedFeatureIndices.begin(), combinedDiscardedFeatureIndices.end(), randomIndex);
-                if (it2 == combinedDiscardedFeatureIndices.end()){  // NOT FOUND AGAIN
-                    featureSubsetIndices.push_back(randomIndex);
-                }
-            }
+            uniform_int_distribution<int> randomFeature(i, numSuitableFeatures-1);
+            int randomIndex = randomFeature(randomGenerator);
+            swap(suitableFeatureIndices[i], suitableFeatureIndices[randomIndex]);
+            
+            int featureIndex = suitableFeatureIndices[i];
+            getFeatureVector(node->getBootstrappedTrainingSamples(), featureIndex, featureVector);
+            if (util.getStandardDeviation(featureVector) > featureStandardDeviationThreshold) { featureSubsetIndices.push_back(featureIndex); }
         }
         sort(featureSubsetIndices.begin(), featureSubsetIndices.end());
         
@@ -411,6 +372,36 @@ vector<int> DecisionTree::selectFeatureSubsetRandomly(vector<int> globalDiscarde
 	} 
 }
 /***********************************************************************/
+//the values of featureIndex for the samples
+void DecisionTree::getFeatureVector(const vector<int>& samples, int featureIndex, vector<int>& featureVector) {
+    featureVector.resize(samples.size());
+    for (int i = 0; i < samples.size(); i++) { featureVector[i] = baseDataSet[samples[i]][featureIndex]; }
+}
+/***********************************************************************/
+RFTreeNode* DecisionTree::createTreeNode(vector<int>& samples, int generation) {
+    try {
+        vector<int> outputVector(samples.size(), 0);
+        for (int i = 0; i < samples.size(); i++) { outputVector[i] = baseDataSet[samples[i]][numFeatures]; }
+        
+        RFTreeNode* treeNode = new RFTreeNode(samples, outputVector, numFeatures, numOutputClasses, generation, nodeIdCount);
+        nodeIdCount++;
+        
+        return treeNode;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "DecisionTree", "createTreeNode");
+		exit(1);
+	} 
+}
+/***********************************************************************/
+void DecisionTree::getSplitFeaturesRecursively(RFTreeNode* treeNode, vector<bool>& isSplitFeature) {
+    if (treeNode == NULL || treeNode->checkIsLeaf()) { return; }
+    
+    isSplitFeature[treeNode->getSplitFeatureIndex()] = true;
+    getSplitFeaturesRecursively(treeNode->getLeftChildNode(), isSplitFeature);
+    getSplitFeaturesRecursively(treeNode->getRightChildNode(), isSplitFeature);
+}
+/***********************************************************************/
 
 // TODO: printTree() needs a check if correct
 int DecisionTree::printTree(RFTreeNode* treeNode, string caption){
@@ -453,11 +444,10 @@ void DecisionTree::deleteTreeNodesRecursively(RFTreeNode* treeNode) {
 void DecisionTree::pruneTree(double pruneAggressiveness = 0.9) {
     
     // find out the number of misclassification by each of the nodes
-    for (int i = 0; i < bootstrappedTestSamples.size(); i++) {
+    for (int i = 0; i < bootstrappedTestSampleIndices.size(); i++) {
         if (m->getControl_pressed()) { return; }
         
-        vector<int> testSample = bootstrappedTestSamples[i];
-        updateMisclassificationCountRecursively(rootNode, testSample);
+        updateMisclassificationCountRecursively(rootNode, baseDataSet[bootstrappedTestSampleIndices[i]]);
     }
     
     // do the actual pruning
@@ -491,7 +481,7 @@ void DecisionTree::pruneRecursively(RFTreeNode* treeNode, double pruneAggressive
 }
 /***********************************************************************/
 
-void DecisionTree::updateMisclassificationCountRecursively(RFTreeNode* treeNode, vector<int> testSample) {
+void DecisionTree::updateMisclassificationCountRecursively(RFTreeNode* treeNode, const vector<int>& testSample) {
     
     int actualSampleOutputClass = testSample[numFeatures];
     int nodePredictedOutputClass = treeNode->outputClass;
@@ -37,25 +37,21 @@ public:
                  vector<int> globalDiscardedFeatureIndices,
                  OptimumFeatureSubsetSelector optimumFeatureSubsetSelector,
                  string treeSplitCriterion,
-                 float featureStandardDeviationThreshold);
+                 float featureStandardDeviationThreshold,
+                 int treeIndex);
     
     virtual ~DecisionTree(){ deleteTreeNodesRecursively(rootNode); }
     
     int calcTreeVariableImportanceAndError(int& numCorrect, double& treeErrorRate);
-    int evaluateSample(vector<int> testSample);
+    int evaluateSample(const vector<int>& testSample);
     int calcTreeErrorRate(int& numCorrect, double& treeErrorRate);
     
-    void randomlyShuffleAttribute(const vector< vector<int> >& samples,
-                                  const int featureIndex,
-                                  const int prevFeatureIndex,
-                                  vector< vector<int> >& shuffledSample);
-    
     void purgeDataSetsFromTree() { purgeTreeNodesDataRecursively(rootNode); }
     int purgeTreeNodesDataRecursively(RFTreeNode* treeNode);
     
     void pruneTree(double pruneAggressiveness);
     void pruneRecursively(RFTreeNode* treeNode, double pruneAggressiveness);
-    void updateMisclassificationCountRecursively(RFTreeNode* treeNode, vector<int> testSample);
+    void updateMisclassificationCountRecursively(RFTreeNode* treeNode, const vector<int>& testSample);
     void updateOutputClassOfNode(RFTreeNode* treeNode);
     
     
@@ -64,14 +60,20 @@ private:
     void buildDecisionTree();
     int splitRecursively(RFTreeNode* rootNode);
     int findAndUpdateBestFeatureToSplitOn(RFTreeNode* node);
-    vector<int> selectFeatureSubsetRandomly(vector<int> globalDiscardedFeatureIndices, vector<int> localDiscardedFeatureIndices);
+    vector<int> selectFeatureSubsetRandomly(RFTreeNode* node);
+    void getFeatureVector(const vector<int>& samples, int featureIndex, vector<int>& featureVector);
+    int evaluateSample(const vector<int>& testSample, int shuffledFeatureIndex, int shuffledFeatureValue);
+    void getSplitFeaturesRecursively(RFTreeNode* treeNode, vector<bool>& isSplitFeature);
+    RFTreeNode* createTreeNode(vector<int>& samples, int generation);
     int printTree(RFTreeNode* treeNode, string caption);
     void deleteTreeNodesRecursively(RFTreeNode* treeNode);
     
+    vector<int> suitableFeatureIndices;     // the features that are not globally discarded
     vector<int> variableImportanceList;
     map<int, int> outOfBagEstimates;
   
     float featureStandardDeviationThreshold;
+    Utils util;
 };
 
 #endif
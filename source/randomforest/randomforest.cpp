@@ -19,8 +19,10 @@ RandomForest::RandomForest(const vector <vector<int> > dataSet,
                            const bool discardHighErrorTrees = true,
                            const float highErrorTreeDiscardThreshold = 0.4,
                            const string optimumFeatureSubsetSelectionCriteria = "log2",
-                           const float featureStandardDeviationThreshold = 0.0)
-            : Forest(dataSet, numDecisionTrees, treeSplitCriterion, doPruning, pruneAggressiveness, discardHighErrorTrees, highErrorTreeDiscardThreshold, optimumFeatureSubsetSelectionCriteria, featureStandardDeviationThreshold) {
+                           const float featureStandardDeviationThreshold = 0.0,
+                           const int processors = 1)
+            : Forest(dataSet, numDecisionTrees, treeSplitCriterion, doPruning, pruneAggressiveness, discardHighErrorTrees, highErrorTreeDiscardThreshold, optimumFeatureSubsetSelectionCriteria, featureStandardDeviationThreshold),
+            processors(processors) {
     m = MothurOut::getInstance();
 }
 
@@ -184,77 +186,145 @@ int RandomForest::calcForrestVariableImportance(string filename) {
 	}  
 }
 /***********************************************************************/
-int RandomForest::populateDecisionTrees() {
+DecisionTree* RandomForest::createDecisionTree(int treeIndex, double& errorRateImprovement) {
     try {
         
-        vector<double> errorRateImprovements;
+        if (((treeIndex+1) % 100) == 0) {  m->mothurOut("Creating " + toString(treeIndex+1) + " (th) Decision tree\n");  }
         
-        for (int i = 0; i < numDecisionTrees; i++) {
-          
-            if (m->getControl_pressed()) { return 0; }
-            if (((i+1) % 100) == 0) {  m->mothurOut("Creating " + toString(i+1) + " (th) Decision tree\n");  }
-          
-            // TODO: need to first fix if we are going to use pointer based system or anything else
-            DecisionTree* decisionTree = new DecisionTree(dataSet, globalDiscardedFeatureIndices, OptimumFeatureSubsetSelector(optimumFeatureSubsetSelectionCriteria), treeSplitCriterion, featureStandardDeviationThreshold);
-          
-            if (m->getDebug() && doPruning) {
-                m->mothurOut("Before pruning\n");
+        // TODO: need to first fix if we are going to use pointer based system or anything else
+        DecisionTree* decisionTree = new DecisionTree(dataSet, globalDiscardedFeatureIndices, OptimumFeatureSubsetSelector(optimumFeatureSubsetSelectionCriteria), treeSplitCriterion, featureStandardDeviationThreshold, treeIndex);
+        
+        if (m->getDebug() && doPruning) {
+            m->mothurOut("Before pruning\n");
+            decisionTree->printTree(decisionTree->rootNode, "ROOT");
+        }
+        
+        int numCorrect;
+        double treeErrorRate;
+        
+        decisionTree->calcTreeErrorRate(numCorrect, treeErrorRate);
+        double prePrunedErrorRate = treeErrorRate;
+        
+        if (m->getDebug()) {
+            m->mothurOut("treeErrorRate: " + toString(treeErrorRate) + " numCorrect: " + toString(numCorrect) + "\n");
+        }
+        
+        if (doPruning) {
+            decisionTree->pruneTree(pruneAggressiveness);
+            if (m->getDebug()) {
+                m->mothurOut("After pruning\n");
                 decisionTree->printTree(decisionTree->rootNode, "ROOT");
             }
-            
-            int numCorrect;
-            double treeErrorRate;
-            
             decisionTree->calcTreeErrorRate(numCorrect, treeErrorRate);
-            double prePrunedErrorRate = treeErrorRate;
-            
-            if (m->getDebug()) {
-                m->mothurOut("treeErrorRate: " + toString(treeErrorRate) + " numCorrect: " + toString(numCorrect) + "\n");
-            }
-            
+        }
+        double postPrunedErrorRate = treeErrorRate;
+        
+        
+        decisionTree->calcTreeVariableImportanceAndError(numCorrect, treeErrorRate);
+        errorRateImprovement = (prePrunedErrorRate - postPrunedErrorRate) / prePrunedErrorRate;
+        
+        if (m->getDebug()) {
+            m->mothurOut("treeErrorRate: " + toString(treeErrorRate) + " numCorrect: " + toString(numCorrect) + "\n");
             if (doPruning) {
-                decisionTree->pruneTree(pruneAggressiveness);
-                if (m->getDebug()) {
-                    m->mothurOut("After pruning\n");
-                    decisionTree->printTree(decisionTree->rootNode, "ROOT");
-                }
-                decisionTree->calcTreeErrorRate(numCorrect, treeErrorRate);
+                m->mothurOut("errorRateImprovement: " + toString(errorRateImprovement) + "\n");
             }
-            double postPrunedErrorRate = treeErrorRate;
-            
-          
-            decisionTree->calcTreeVariableImportanceAndError(numCorrect, treeErrorRate);
-            double errorRateImprovement = (prePrunedErrorRate - postPrunedErrorRate) / prePrunedErrorRate;
+        }
+        
+        if (discardHighErrorTrees && (treeErrorRate >= highErrorTreeDiscardThreshold)) {
+            delete decisionTree;
+            return NULL;
+        }
+        
+        decisionTree->purgeDataSetsFromTree();
+        
+        return decisionTree;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "RandomForest", "createDecisionTree");
+        exit(1);
+    }
+}
+/***********************************************************************/
 
-            if (m->getDebug()) {
-                m->mothurOut("treeErrorRate: " + toString(treeErrorRate) + " numCorrect: " + toString(numCorrect) + "\n");
-                if (doPruning) {
-                    m->mothurOut("errorRateImprovement: " + toString(errorRateImprovement) + "\n");
-                }
-            }
+struct decisionTreeData {
+    RandomForest* forest;
+    MothurOut* m;
+    int start, end;
+    vector<DecisionTree*> decisionTrees;        //NULL if the tree was discarded
+    vector<double> errorRateImprovements;
+    
+    decisionTreeData(RandomForest* f, int s, int e) : forest(f), start(s), end(e) {
+        m = MothurOut::getInstance();
+    }
+};
+/***********************************************************************/
+
+void driverDecisionTrees(decisionTreeData* params) {
+    try {
+        for (int i = params->start; i < params->end; i++) {
+            if (params->m->getControl_pressed()) { break; }
             
+            double errorRateImprovement = 0.0;
+            params->decisionTrees.push_back(params->forest->createDecisionTree(i, errorRateImprovement));
+            params->errorRateImprovements.push_back(errorRateImprovement);
+        }
+    }
+    catch(exception& e) {
+        params->m->errorOut(e, "RandomForest", "driverDecisionTrees");
+        exit(1);
+    }
+}
+/***********************************************************************/
+int RandomForest::populateDecisionTrees() {
+    try {
+        
+        vector<double> errorRateImprovements;
+        
+        //each tree has its own random stream, so the threads can build any of them. the trees are
+        //added to the forest in order, so the forest is the same for any number of processors.
+        int numThreads = processors;
+        if (numThreads > numDecisionTrees) { numThreads = numDecisionTrees; }
+        if (numThreads < 1) { numThreads = 1; }
+        
+        vector<int> startTrees;
+        for (int i = 0; i <= numThreads; i++) { startTrees.push_back((int)(((long long)i * numDecisionTrees) / numThreads)); }
+        
+        //create array of worker threads
+        vector<thread*> workerThreads;
+        vector<decisionTreeData*> data;
+        
+        //Lauch worker threads
+        for (int i = 1; i < numThreads; i++) {
+            decisionTreeData* dataBundle = new decisionTreeData(this, startTrees[i], startTrees[i+1]);
+            data.push_back(dataBundle);
             
-            if (discardHighErrorTrees) {
-                if (treeErrorRate < highErrorTreeDiscardThreshold) {
-                    updateGlobalOutOfBagEstimates(decisionTree);
-                    decisionTree->purgeDataSetsFromTree();
-                    decisionTrees.push_back(decisionTree);
-                    if (doPruning) {
-                        errorRateImprovements.push_back(errorRateImprovement);
-                    }
-                } else {
-                    delete decisionTree;
-                }
-            } else {
+            workerThreads.push_back(new thread(driverDecisionTrees, dataBundle));
+        }
+        
+        decisionTreeData* dataBundle = new decisionTreeData(this, startTrees[0], startTrees[1]);
+        driverDecisionTrees(dataBundle);
+        
+        for (int i = 0; i < workerThreads.size(); i++) { workerThreads[i]->join(); delete workerThreads[i]; }
+        data.insert(data.begin(), dataBundle);
+        
+        for (int i = 0; i < data.size(); i++) {
+            for (int j = 0; j < data[i]->decisionTrees.size(); j++) {
+                DecisionTree* decisionTree = data[i]->decisionTrees[j];
+                if (decisionTree == NULL) { continue; }
+                
+                if (m->getControl_pressed()) { delete decisionTree; continue; }
+                
                 updateGlobalOutOfBagEstimates(decisionTree);
-                decisionTree->purgeDataSetsFromTree();
                 decisionTrees.push_back(decisionTree);
                 if (doPruning) {
-                    errorRateImprovements.push_back(errorRateImprovement);
+                    errorRateImprovements.push_back(data[i]->errorRateImprovements[j]);
                 }
-            }          
+            }
+            delete data[i];
         }
         
+        if (m->getControl_pressed()) { return 0; }
+        
         double avgErrorRateImprovement = -1.0;
         if (errorRateImprovements.size() > 0) {
             avgErrorRateImprovement = accumulate(errorRateImprovements.begin(), errorRateImprovements.end(), 0.0);
@@ -25,7 +25,8 @@ public:
                  const bool discardHighErrorTrees,
                  const float highErrorTreeDiscardThreshold,
                  const string optimumFeatureSubsetSelectionCriteria,
-                 const float featureStandardDeviationThreshold);
+                 const float featureStandardDeviationThreshold,
+                 const int processors);
     
     
     //NOTE:: if you are going to dynamically cast, aren't you undoing the advantage of abstraction. Why abstract at all?
@@ -46,8 +47,12 @@ public:
     int printConfusionMatrix(map<int, string> intToTreatmentMap);
     int getMissclassifications(string, map<int, string> intToTreatmentMap, vector<string> names);
     
+    //builds, prunes and scores the tree, returns NULL if the tree is discarded. called from several threads at once.
+    DecisionTree* createDecisionTree(int treeIndex, double& errorRateImprovement);
+    
 private:
     MothurOut* m;
+    int processors;
     
 };
 
@@ -7,22 +7,19 @@
 //
 
 #include "rftreenode.hpp"
-#include "utils.hpp"
 
 /***********************************************************************/
-RFTreeNode::RFTreeNode(vector< vector<int> > bootstrappedTrainingSamples,
-                       vector<int> globalDiscardedFeatureIndices,
+RFTreeNode::RFTreeNode(vector<int> bootstrappedTrainingSamples,
+                       vector<int> bootstrappedOutputVector,
                        int numFeatures,
-                       int numSamples,
                        int numOutputClasses,
                        int generation,
-                       int nodeId,
-                       float featureStandardDeviationThreshold)
+                       int nodeId)
 
             : bootstrappedTrainingSamples(bootstrappedTrainingSamples),
-            globalDiscardedFeatureIndices(globalDiscardedFeatureIndices),
+            bootstrappedOutputVector(bootstrappedOutputVector),
             numFeatures(numFeatures),
-            numSamples(numSamples),
+            numSamples((int)bootstrappedTrainingSamples.size()),
             numOutputClasses(numOutputClasses),
             generation(generation),
             isLeaf(false),
@@ -33,48 +30,15 @@ RFTreeNode::RFTreeNode(vector< vector<int> > bootstrappedTrainingSamples,
             splitFeatureValue(-1),
             splitFeatureEntropy(-1.0),
             ownEntropy(-1.0),
-            featureStandardDeviationThreshold(featureStandardDeviationThreshold),
-            bootstrappedFeatureVectors(numFeatures, vector<int>(numSamples, 0)),
-            bootstrappedOutputVector(numSamples, 0),
             leftChildNode(NULL),
             rightChildNode(NULL),
             parentNode(NULL) {
                 
     m = MothurOut::getInstance();
     
-    for (int i = 0; i < numSamples; i++) {    // just doing a simple transpose of the matrix
-        if (m->getControl_pressed()) { break; }
-        for (int j = 0; j < numFeatures; j++) { bootstrappedFeatureVectors[j][i] = bootstrappedTrainingSamples[i][j]; }
-    }
-    
-    for (int i = 0; i < numSamples; i++) { if (m->getControl_pressed()) { break; }
-        bootstrappedOutputVector[i] = bootstrappedTrainingSamples[i][numFeatures]; }
-    
-    createLocalDiscardedFeatureList();
     updateNodeEntropy();
 }
 /***********************************************************************/
-int RFTreeNode::createLocalDiscardedFeatureList(){
-    try {
-        Utils util;
-        for (int i = 0; i < numFeatures; i++) {
-                // TODO: need to check if bootstrappedFeatureVectors == numFeatures, in python code we are using bootstrappedFeatureVectors instead of numFeatures
-            if (m->getControl_pressed()) { return 0; } 
-            vector<int>::iterator it = find(globalDiscardedFeatureIndices.begin(), globalDiscardedFeatureIndices.end(), i);
-            if (it == globalDiscardedFeatureIndices.end()) {                           // NOT FOUND
-                double standardDeviation = util.getStandardDeviation(bootstrappedFeatureVectors[i]);  
-                if (standardDeviation <= featureStandardDeviationThreshold) { localDiscardedFeatureIndices.push_back(i); }
-            }
-        }
-        
-        return 0;
-    }
-    catch(exception& e) {
-        m->errorOut(e, "RFTreeNode", "createLocalDiscardedFeatureList");
-        exit(1);
-    }  
-}
-/***********************************************************************/
 int RFTreeNode::updateNodeEntropy() {
     try {
         
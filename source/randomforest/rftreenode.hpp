@@ -16,14 +16,12 @@ class RFTreeNode{
     
 public:
     
-    RFTreeNode(vector< vector<int> > bootstrappedTrainingSamples,
-               vector<int> globalDiscardedFeatureIndices,
+    RFTreeNode(vector<int> bootstrappedTrainingSamples,        //indexes into the tree's data set
+               vector<int> bootstrappedOutputVector,            //output class of each of the samples
                int numFeatures,
-               int numSamples,
                int numOutputClasses,
                int generation,
-               int nodeId,
-               float featureStandardDeviationThreshold = 0.0);
+               int nodeId);
     
     virtual ~RFTreeNode(){}
     
@@ -32,7 +30,7 @@ public:
     // plus we do not modify the value as well
     const int getSplitFeatureIndex() { return splitFeatureIndex; }
     // TODO: check if this works properly or returs a shallow copy of the data
-    const vector< vector<int> >& getBootstrappedTrainingSamples() { return bootstrappedTrainingSamples; }
+    const vector<int>& getBootstrappedTrainingSamples() { return bootstrappedTrainingSamples; }
     const int getSplitFeatureValue() { return splitFeatureValue; }
     const int getGeneration() { return generation; }
     const bool checkIsLeaf() { return isLeaf; }
@@ -43,8 +41,6 @@ public:
     const int getOutputClass() { return outputClass; }
     const int getNumSamples() { return numSamples; }
     const int getNumFeatures() { return numFeatures; }
-    const vector<int>& getLocalDiscardedFeatureIndices() { return localDiscardedFeatureIndices; }
-    const vector< vector<int> >& getBootstrappedFeatureVectors() { return bootstrappedFeatureVectors; }
     const vector<int>& getBootstrappedOutputVector() { return bootstrappedOutputVector; }
     const vector<int>& getFeatureSubsetIndices() { return featureSubsetIndices; }
     const double getOwnEntropy() { return ownEntropy; }
@@ -67,10 +63,7 @@ public:
     friend class AbstractDecisionTree;
     
 private:
-    vector<vector<int> > bootstrappedTrainingSamples;
-    vector<int> globalDiscardedFeatureIndices;
-    vector<int> localDiscardedFeatureIndices;
-    vector<vector<int> > bootstrappedFeatureVectors;
+    vector<int> bootstrappedTrainingSamples;
     vector<int> bootstrappedOutputVector;
     vector<int> featureSubsetIndices;
 
@@ -86,7 +79,6 @@ private:
     double ownEntropy;
     
     int nodeId;
-    float featureStandardDeviationThreshold;
     int testSampleMisclassificationCount;
     
     RFTreeNode* leftChildNode;
@@ -95,7 +87,6 @@ private:
     
     MothurOut* m;
     
-    int createLocalDiscardedFeatureList();
     int updateNodeEntropy();
     
 };
@@ -0,0 +1,203 @@
+/*
+ *  binarycolumn.cpp
+ *  Mothur
+ *
+ */
+
+#include "binarycolumn.h"
+
+static const unsigned int binaryColumnVersion = 1;
+static const int binaryColumnBufferSize = 1048576;
+
+/***********************************************************************/
+
+BinaryColumnFile::BinaryColumnFile(string distFile) {
+	try {
+		m = MothurOut::getInstance();
+		bufferStart = 0; bufferEnd = 0; row = 0; remainingInRow = 0; column = 0;
+
+		in.open(util.getFullPathName(distFile).c_str(), ios::binary);
+		successOpen = (bool)in;
+		if (!successOpen) { m->mothurOut("[ERROR]: Could not open " + distFile + "\n"); return; }
+
+		char magic[4]; unsigned int version, numNames;
+		in.read(magic, 4);
+		in.read((char*)&version, sizeof(unsigned int));
+		in.read((char*)&numNames, sizeof(unsigned int));
+
+		if (!in || (memcmp(magic, "MDST", 4) != 0)) { m->mothurOut("[ERROR]: " + distFile + " is not a binary column file.\n"); successOpen = false; return; }
+		if (version != binaryColumnVersion) { m->mothurOut("[ERROR]: " + distFile + " was written by a different version of mothur, please recreate it with dist.seqs.\n"); successOpen = false; return; }
+
+		names.resize(numNames);
+		for (int i = 0; i < numNames; i++) { getline(in, names[i], '\0'); }
+
+		if (!in) { m->mothurOut("[ERROR]: " + distFile + " is truncated, please recreate it with dist.seqs.\n"); successOpen = false; return; }
+
+		firstRow = in.tellg();
+		buffer.resize(binaryColumnBufferSize);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BinaryColumnFile", "BinaryColumnFile");
+		exit(1);
+	}
+}
+/***********************************************************************/
+
+BinaryColumnFile::~BinaryColumnFile() { in.close(); }
+
+/***********************************************************************/
+
+bool BinaryColumnFile::isBinary(string distFile) {
+	try {
+		Utils util;
+		ifstream file(util.getFullPathName(distFile).c_str(), ios::binary);
+		char magic[4] = { 0, 0, 0, 0 };
+		file.read(magic, 4);
+		bool binary = ((file.gcount() == 4) && (memcmp(magic, "MDST", 4) == 0));
+		file.close();
+
+		return binary;
+	}
+	catch(exception& e) {
+		MothurOut::getInstance()->errorOut(e, "BinaryColumnFile", "isBinary");
+		exit(1);
+	}
+}
+/***********************************************************************/
+
+string BinaryColumnFile::getHeader(vector<string>& names) {
+	try {
+		string header = "MDST";
+		unsigned int version = binaryColumnVersion;
+		unsigned int numNames = names.size();
+		header.append((char*)&version, sizeof(unsigned int));
+		header.append((char*)&numNames, sizeof(unsigned int));
+
+		for (int i = 0; i < names.size(); i++) { header += names[i]; header += '\0'; }
+
+		return header;
+	}
+	catch(exception& e) {
+		MothurOut::getInstance()->errorOut(e, "BinaryColumnFile", "getHeader");
+		exit(1);
+	}
+}
+/***********************************************************************/
+
+static inline void appendVarint(string& output, unsigned int value) {
+	while (value >= 128) { output += (char)((value & 127) | 128); value >>= 7; }
+	output += (char)value;
+}
+/***********************************************************************/
+
+void BinaryColumnFile::appendRow(string& output, int thisRow, vector<int>& columns, vector<float>& dists) {
+	try {
+		if (columns.size() == 0) { return; }
+
+		appendVarint(output, thisRow);
+		appendVarint(output, columns.size());
+
+		int lastColumn = 0;
+		for (int i = 0; i < columns.size(); i++) {
+			appendVarint(output, columns[i] - lastColumn);
+			output.append((char*)&dists[i], sizeof(float));
+			lastColumn = columns[i];
+		}
+	}
+	catch(exception& e) {
+		MothurOut::getInstance()->errorOut(e, "BinaryColumnFile", "appendRow");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//makes sure there are at least numBytes unread bytes in the buffer, unless the file ends first
+bool BinaryColumnFile::fillBuffer(int numBytes) {
+	try {
+		if ((bufferEnd - bufferStart) >= numBytes) { return true; }
+
+		int leftOver = bufferEnd - bufferStart;
+		if (leftOver > 0) { memmove(&buffer[0], &buffer[bufferStart], leftOver); }
+		bufferStart = 0; bufferEnd = leftOver;
+
+		if (in) {
+			in.read(&buffer[bufferEnd], buffer.size() - bufferEnd);
+			bufferEnd += in.gcount();
+		}
+
+		return ((bufferEnd - bufferStart) >= numBytes);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BinaryColumnFile", "fillBuffer");
+		exit(1);
+	}
+}
+/***********************************************************************/
+
+//false if the buffer ends before the varint does or it is longer than an unsigned int can be
+bool BinaryColumnFile::readVarint(unsigned int& value) {
+	value = 0;
+	int shift = 0;
+	while ((bufferStart < bufferEnd) && (shift < 32)) {
+		unsigned char byte = (unsigned char)buffer[bufferStart++];
+		value |= ((unsigned int)(byte & 127)) << shift;
+		if (byte < 128) { return true; }
+		shift += 7;
+	}
+	return false;
+}
+/***********************************************************************/
+
+bool BinaryColumnFile::read(int& thisRow, int& thisColumn, float& dist) {
+	try {
+		//a varint is at most 5 bytes, so a row start fits in 10 and a distance in 5 + sizeof(float)
+		unsigned int value, numInRow;
+		while (remainingInRow == 0) {
+			if (!fillBuffer(1)) { return false; }
+			fillBuffer(10);
+			if (!readVarint(value) || !readVarint(numInRow)) { m->mothurOut("[ERROR]: the binary column file is truncated.\n"); m->setControl_pressed(true); return false; }
+			row = value; remainingInRow = numInRow;
+			column = 0;
+		}
+
+		fillBuffer(5 + sizeof(float));
+
+		//the distance has to follow the bytes the column used, not just the 5 a column may use
+		if (!readVarint(value) || ((bufferEnd - bufferStart) < (int)sizeof(float))) { m->mothurOut("[ERROR]: the binary column file is truncated.\n"); m->setControl_pressed(true); return false; }
+		column += value;
+		memcpy(&dist, &buffer[bufferStart], sizeof(float));
+		bufferStart += sizeof(float);
+		remainingInRow--;
+
+		if ((row < 0) || (row >= names.size()) || (column < 0) || (column >= names.size())) { m->mothurOut("[ERROR]: the binary column file is corrupted.\n"); m->setControl_pressed(true); return false; }
+
+		thisRow = row; thisColumn = column;
+		return true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BinaryColumnFile", "read");
+		exit(1);
+	}
+}
+/***********************************************************************/
+
+bool BinaryColumnFile::read(string& rowName, string& columnName, float& dist) {
+	int thisRow, thisColumn;
+	if (!read(thisRow, thisColumn, dist)) { return false; }
+
+	rowName = names[thisRow]; columnName = names[thisColumn];
+	return true;
+}
+/***********************************************************************/
+
+void BinaryColumnFile::rewind() {
+	try {
+		in.clear();
+		in.seekg(firstRow);
+		bufferStart = 0; bufferEnd = 0; remainingInRow = 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BinaryColumnFile", "rewind");
+		exit(1);
+	}
+}
+/***********************************************************************/
@@ -0,0 +1,66 @@
+#ifndef BINARYCOLUMN_H
+#define BINARYCOLUMN_H
+
+/*
+ *  binarycolumn.h
+ *  Mothur
+ *
+ *  A compact version of the column distance format, written by dist.seqs with output=binary.
+ *  Instead of repeating both names on every line, the names are stored once and each row of the
+ *  lower triangle is stored as the indexes of its columns and their distances:
+ *
+ *	"MDST"					magic number
+ *	unsigned int			format version
+ *	unsigned int			number of names, followed by the names, each ending with a '\0'
+ *	rows, until the end of the file:
+ *		varint				row
+ *		varint				number of distances in the row
+ *		varint, float		for each distance, the column minus the previous column (the first is the column itself) and the distance
+ *
+ *  The varints are 7 bits at a time, low bits first, with the high bit set when more bytes follow.
+ *  The rows don't have to be in order, dist.seqs writes them as the processors finish them.
+ *
+ */
+
+#include "mothurout.h"
+#include "utils.hpp"
+
+/******************************************************/
+
+class BinaryColumnFile {
+
+public:
+	BinaryColumnFile(string);	//opens the file and reads the names
+	~BinaryColumnFile();
+
+	static bool isBinary(string);	//true if the file is in the binary column format
+	static string getHeader(vector<string>&);	//magic number, version and names
+	static void appendRow(string&, int, vector<int>&, vector<float>&);	//adds a row to the buffer, columns must be in increasing order
+
+	bool getOpen() { return successOpen; }
+	int getNumNames() { return names.size(); }
+	string getName(int index) { return names[index]; }
+
+	bool read(int&, int&, float&);	//row, column and distance of the next distance, false at the end of the file
+	bool read(string&, string&, float&);	//same as above with the names of the row and column
+	void rewind();	//back to the first distance
+
+private:
+	MothurOut* m;
+	Utils util;
+	ifstream in;
+	vector<string> names;
+	bool successOpen;
+	streampos firstRow;
+
+	vector<char> buffer;
+	int bufferStart, bufferEnd;
+	int row, remainingInRow, column;
+
+	bool fillBuffer(int);
+	bool readVarint(unsigned int&);	//false if the buffer ends inside the varint
+};
+
+/******************************************************/
+
+#endif
@@ -36,6 +36,14 @@ int ReadColumnMatrix::read(NameAssignment* nameMap){
 		int nseqs = nameMap->size();
         DMatrix->resize(nseqs);
 		list = new ListVector(nameMap->getListVector());
+		
+		if (BinaryColumnFile::isBinary(distFile)) {
+			fileHandle.close();
+			BinaryColumnFile binaryFile(distFile);
+			if (!binaryFile.getOpen()) { return 0; }
+			
+			return readBinary(binaryFile, nameMap, NULL);
+		}
 	
 		Progress* reading = new Progress("Reading matrix:     ", nseqs * nseqs);
 
@@ -162,6 +170,14 @@ int ReadColumnMatrix::read(CountTable* countTable){
         DMatrix->resize(nseqs);
 		list = new ListVector(countTable->getListVector());
         
+		if (BinaryColumnFile::isBinary(distFile)) {
+			fileHandle.close();
+			BinaryColumnFile binaryFile(distFile);
+			if (!binaryFile.getOpen()) { return 0; }
+			
+			return readBinary(binaryFile, NULL, countTable);
+		}
+        
 		Progress* reading = new Progress("Reading matrix:     ", nseqs * nseqs);
         
 		int lt = 1;
@@ -273,6 +289,62 @@ int ReadColumnMatrix::read(CountTable* countTable){
 	}
 }
 
+/***********************************************************************/
+//the binary files are always lower triangle, so there is no need to check for a square matrix. like the text reader,
+//only the names in a distance are looked up, each the first time it is seen
+int ReadColumnMatrix::readBinary(BinaryColumnFile& binaryFile, NameAssignment* nameMap, CountTable* countTable){
+	try {
+		int nseqs = DMatrix->seqVec.size();
+		Progress* reading = new Progress("Reading matrix:     ", nseqs * nseqs);
+		
+		vector<int> indexes(binaryFile.getNumNames(), -1);
+		int row, column; float distance;
+		while (binaryFile.read(row, column, distance)) {
+			
+			if (m->getControl_pressed()) {  delete reading; return 0; }
+			
+			int fileIndexes[2] = { row, column };
+			for (int i = 0; i < 2; i++) {
+				int fileIndex = fileIndexes[i];
+				if (indexes[fileIndex] != -1) { continue; }
+				
+				string name = binaryFile.getName(fileIndex);
+				if (countTable != NULL) {
+					indexes[fileIndex] = countTable->get(name);
+					if (m->getControl_pressed()) { exit(1); }
+				}else {
+					map<string,int>::iterator it = nameMap->find(name);
+					if(it == nameMap->end()){  m->mothurOut("AAError: Sequence '" + name + "' was not found in the names file, please correct\n"); exit(1);  }
+					indexes[fileIndex] = it->second;
+				}
+			}
+			
+			if (distance == -1) { distance = 1000000; }
+			else if (sim) { distance = 1.0 - distance;  }  //user has entered a sim matrix that we need to convert.
+			
+			int itA = indexes[row]; int itB = indexes[column];
+			
+			if(distance < cutoff && itA != itB){
+				if (itA > itB) { PDistCell value(itA, distance); DMatrix->addCell(itB, value); }
+				else { PDistCell value(itB, distance); DMatrix->addCell(itA, value); }
+				reading->update(itA * nseqs);
+			}
+		}
+		
+		if (m->getControl_pressed()) {  delete reading; return 0; }
+		
+		reading->finish();
+		delete reading;
+		
+		list->setLabel("0");
+		
+		return 1;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ReadColumnMatrix", "readBinary");
+		exit(1);
+	}
+}
 /***********************************************************************/
 ReadColumnMatrix::~ReadColumnMatrix(){}
 /***********************************************************************/
@@ -10,6 +10,7 @@
  */
 
 #include "readmatrix.hpp"
+#include "binarycolumn.h"
 
 /******************************************************/
 
@@ -25,6 +26,8 @@ private:
 	ifstream fileHandle;
 	string distFile;
 	
+	int readBinary(BinaryColumnFile&, NameAssignment*, CountTable*);	//the names are found in the count table if there is one
+	
 };
 
 /******************************************************/
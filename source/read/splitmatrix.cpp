@@ -46,6 +46,13 @@ SplitMatrix::SplitMatrix(string ffile, string name, string count, string tax, fl
 
 int SplitMatrix::split(){
 	try {
+        //the splitters read the distances as text, so a binary column file is written out as a temporary column file first
+        string binaryFile = "";
+        if (((method == "distance") || (method == "classify")) && (distFile != "") && BinaryColumnFile::isBinary(distFile)) {
+            binaryFile = distFile;
+            distFile = convertBinaryColumn(binaryFile);
+            if (m->getControl_pressed()) { util.mothurRemove(distFile); distFile = binaryFile; return 0; }
+        }
         
 		if (method == "distance") {  
 			splitDistance();
@@ -59,6 +66,8 @@ int SplitMatrix::split(){
 			dists.push_back(temp);
 		}
 		
+        if (binaryFile != "") { util.mothurRemove(distFile); distFile = binaryFile; }
+        
 		return 0;
 	}
 	catch(exception& e) {
@@ -67,6 +76,31 @@ int SplitMatrix::split(){
 	}
 }
 /***********************************************************************/
+string SplitMatrix::convertBinaryColumn(string binaryFile){
+	try {
+        string columnFile = binaryFile + ".column.temp";
+        
+        BinaryColumnFile in(binaryFile);
+        if (!in.getOpen()) { m->setControl_pressed(true); return columnFile; }
+        
+        ofstream out;
+        util.openOutputFile(columnFile, out);
+        
+        string firstName, secondName; float distance;
+        while (in.read(firstName, secondName, distance)) {
+            if (m->getControl_pressed()) { break; }
+            out << firstName << '\t' << secondName << '\t' << distance << '\n';
+        }
+        out.close();
+        
+        return columnFile;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SplitMatrix", "convertBinaryColumn");
+		exit(1);
+	}
+}
+/***********************************************************************/
 int SplitMatrix::splitDistance(){
 	try {
         
@@ -13,6 +13,7 @@
 #include "mothur.h"
 #include "mothurout.h"
 #include "utils.hpp"
+#include "binarycolumn.h"
 
 /******************************************************/
 
@@ -48,6 +49,7 @@ class SplitMatrix  {
         int splitNamesVsearch(map<string, int>& groups, int, vector<string>&);
 		int splitDistanceFileByTax(map<string, int>&, int);
 		int createDistanceFilesFromTax(map<string, int>&, int);
+		string convertBinaryColumn(string);
 };
 
 /******************************************************/
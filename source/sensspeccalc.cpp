@@ -54,12 +54,14 @@ void SensSpecCalc::getResults(OptiMatrix& matrix, long long& tp, long long& tn,
         for(int otu=0;otu<otus.size();otu++){
             if (m->getControl_pressed()) { break; }
             
-            for(int i=0;i<otus[otu].size();i++){
-                for(int j=0;j<i;j++){
-                    if (matrix.isClose(otus[otu][i], otus[otu][j])) { tp++; }
-                    else { fp++; }
-                }
-            }
+            //each close pair is found from both ends
+            vector<int> otuSeqs = otus[otu]; sort(otuSeqs.begin(), otuSeqs.end());
+            long long numClose = 0;
+            for(int i=0;i<otuSeqs.size();i++){ numClose += matrix.getNumClose(otuSeqs[i], otuSeqs); }
+            
+            long long numPairs = ((long long)otuSeqs.size() * (otuSeqs.size()-1)) / 2;
+            tp += numClose / 2;
+            fp += numPairs - (numClose / 2);
         }
         long long numSeqs = matrix.getNumSeqs() + matrix.getNumSingletons();
         long long numDists = matrix.getNumDists(); //square matrix
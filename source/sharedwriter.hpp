@@ -17,6 +17,10 @@ class SynchronizedOutputFile {
 public:
     SynchronizedOutputFile (const string& p)                : path(p) { util.openOutputFile(p, out);        }
     SynchronizedOutputFile (const string& p, bool append)   : path(p) { util.openOutputFileAppend(p, out);  }
+    SynchronizedOutputFile (const string& p, bool append, bool binary) : path(p) {
+        if (binary) { if (append) { util.openOutputFileBinaryAppend(p, out); } else { util.openOutputFileBinary(p, out); } }
+        else        { if (append) { util.openOutputFileAppend(p, out);       } else { util.openOutputFile(p, out);       } }
+    }
     ~SynchronizedOutputFile() { out.close(); }
     
     void write (const string& dataToWrite) {
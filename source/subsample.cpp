@@ -8,6 +8,58 @@
 
 #include "subsample.h"
 //**********************************************************************************************************************
+/* Instead of writing out one entry per read and shuffling, the reads are drawn one at a time from a Fenwick tree of
+ * the abundances that haven't been drawn yet, so finding a read's bin and removing it are O(log bins) and the memory
+ * is O(bins). When more than half the reads are wanted, the reads left out are drawn instead. */
+vector<int> SubSample::getSample(const vector<int>& abunds, int size) {
+    try {
+        int numBins = abunds.size();
+        long long total = 0;
+        for (int i = 0; i < numBins; i++) { total += abunds[i]; }
+        
+        if (size >= total) { return abunds; }
+        
+        bool drawLeftOut = (size > (total / 2));
+        long long numDraws = size;
+        if (drawLeftOut) { numDraws = total - size; }
+        
+        //tree[i] holds the sum of abunds (i - lowbit(i), i], 1 based
+        vector<long long> tree(numBins+1, 0);
+        for (int i = 1; i <= numBins; i++) {
+            tree[i] += abunds[i-1];
+            int parent = i + (i & (-i));
+            if (parent <= numBins) { tree[parent] += tree[i]; }
+        }
+        int highBit = 1; while ((highBit * 2) <= numBins) { highBit *= 2; }
+        
+        vector<int> drawn(numBins, 0);
+        long long remaining = total;
+        for (long long d = 0; d < numDraws; d++) {
+            
+            if (m->getControl_pressed()) { break; }
+            
+            //find the bin holding the read, the first bin whose running total is above it
+            long long read = util.getRandomLongIndex(remaining-1);
+            int bin = 0;
+            for (int step = highBit; step > 0; step /= 2) {
+                int next = bin + step;
+                if ((next <= numBins) && (tree[next] <= read)) { bin = next; read -= tree[next]; }
+            }
+            
+            drawn[bin]++; remaining--;
+            for (int i = bin+1; i <= numBins; i += (i & (-i))) { tree[i]--; }
+        }
+        
+        if (drawLeftOut) { for (int i = 0; i < numBins; i++) { drawn[i] = abunds[i] - drawn[i]; } }
+        
+        return drawn;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "SubSample", "getSample-abunds");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
 Tree* SubSample::getSample(Tree* T, CountTable* ct, CountTable* newCt, int size, vector<string>& mGroups) {
     try {
         Tree* newTree = NULL;
@@ -32,21 +84,14 @@ Tree* SubSample::getSample(Tree* T, CountTable* ct, CountTable* newCt, int size,
                 if (thisSize >= size) {	
                     
                     vector<string> names = ct->getNamesOfSeqs(Groups[i]);
-                    vector<int> random;
-                    for (int j = 0; j < names.size(); j++) {
-                        int num = ct->getGroupCount(names[j], Groups[i]);
-                        for (int k = 0; k < num; k++) { random.push_back(j); }
-                    }
-                    util.mothurRandomShuffle(random);
+                    vector<int> abunds;
+                    for (int j = 0; j < names.size(); j++) { abunds.push_back(ct->getGroupCount(names[j], Groups[i])); }
                     
-                    vector<int> sampleRandoms; sampleRandoms.resize(names.size(), 0);
-                    for (int j = 0; j < size; j++) { sampleRandoms[random[j]]++; }
+                    vector<int> sampleRandoms = getSample(abunds, size);
                     for (int j = 0; j < sampleRandoms.size(); j++) {
                         newCt->setAbund(names[j], Groups[i], sampleRandoms[j]);
+                        doNotIncludeTotals[names[j]] += (abunds[j] - sampleRandoms[j]);
                     }
-                    sampleRandoms.clear(); sampleRandoms.resize(names.size(), 0);
-                    for (int j = size; j < thisSize; j++) { sampleRandoms[random[j]]++; }
-                    for (int j = 0; j < sampleRandoms.size(); j++) {  doNotIncludeTotals[names[j]] += sampleRandoms[j]; }
                 }else {  m->mothurOut("[ERROR]: You have selected a size that is larger than "+Groups[i]+" number of sequences.\n"); m->setControl_pressed(true); }
             }
 
@@ -120,22 +165,17 @@ vector<string> SubSample::getSample(vector<SharedRAbundVector*>& rabunds, int si
             
             if (thisSize != size) {
                 
-                vector<int> order;
-                for (int j = 0; j < rabunds[i]->size(); j++) {
-                    int abund = rabunds[i]->get(j);
-                    for(int k=0;k<abund;k++){ order.push_back(j);  }
-                }
+                vector<int> abunds;
+                for (int j = 0; j < rabunds[i]->size(); j++) { abunds.push_back(rabunds[i]->get(j)); }
                 
-                util.mothurRandomShuffle(order);
+                vector<int> sampled = getSample(abunds, size);
+                if (m->getControl_pressed()) {  delete newLookup; return currentLabels; }
                 
                 SharedRAbundVector* temp = new SharedRAbundVector(numBins);
                 temp->setLabel(rabunds[i]->getLabel());
                 temp->setGroup(rabunds[i]->getGroup());
                 
-                for (int j = 0; j < size; j++) {
-                    if (m->getControl_pressed()) {  return currentLabels; }
-                    temp->increment(order[j]);
-                }
+                for (int j = 0; j < sampled.size(); j++) { if (sampled[j] != 0) { temp->set(j, sampled[j]); } }
                 newLookup->push_back(temp);
             }else { SharedRAbundVector* temp = new SharedRAbundVector(*rabunds[i]); newLookup->push_back(temp); }
         }
@@ -184,24 +224,19 @@ vector<string> SubSample::getSample(SharedRAbundVectors*& thislookup, int size)
 int SubSample::getSample(SAbundVector*& sabund, int size) {
 	try {
 		
-        int numBins = sabund->getNumBins();
         int thisSize = sabund->getNumSeqs();
-
-        OrderVector order = sabund->getOrderVector();
         
 		if (thisSize > size) {
-			util.mothurRandomShuffle(order);
+            RAbundVector allRabund = sabund->getRAbundVector();
+            vector<int> abunds;
+            for (int j = 0; j < allRabund.getNumBins(); j++) { abunds.push_back(allRabund.get(j)); }
+            
+            vector<int> sampled = getSample(abunds, size);
+            if (m->getControl_pressed()) { return 0; }
 			
-            RAbundVector rabund(numBins);
+            RAbundVector rabund(sampled.size());
 			rabund.setLabel(sabund->getLabel());
-
-			for (int j = 0; j < size; j++) {
-                
-				if (m->getControl_pressed()) { return 0; }
-				
-                int abund = rabund.get(order.get(j));
-				rabund.set(order.get(j), (abund+1));
-			}
+			for (int j = 0; j < sampled.size(); j++) { rabund.set(j, sampled[j]); }
 
             delete sabund;
             sabund = new SAbundVector();
@@ -230,31 +265,30 @@ CountTable SubSample::getSample(CountTable& ct, int size, vector<string> Groups)
             sampledCt.addGroup(Groups[i]);
             
             vector<string> names = ct.getNamesOfSeqs(Groups[i]);
-            vector<string> allNames;
+            vector<int> abunds;
+            long long numSeqs = 0;
             for (int j = 0; j < names.size(); j++) {
-                
-                if (m->getControl_pressed()) { return sampledCt; }
-                
-                int num = ct. getGroupCount(names[j], Groups[i]);
-                for (int k = 0; k < num; k++) { allNames.push_back(names[j]); }
+                abunds.push_back(ct.getGroupCount(names[j], Groups[i]));
+                numSeqs += abunds[j];
             }
             
-            util.mothurRandomShuffle(allNames);
-            
-            if (allNames.size() < size) { m->mothurOut("[ERROR]: You have selected a size that is larger than "+Groups[i]+" number of sequences.\n"); m->setControl_pressed(true); }
+            if (numSeqs < size) { m->mothurOut("[ERROR]: You have selected a size that is larger than "+Groups[i]+" number of sequences.\n"); m->setControl_pressed(true); }
             else{
-                for (int j = 0; j < size; j++) {
+                vector<int> sampled = getSample(abunds, size);
+                
+                for (int j = 0; j < names.size(); j++) {
                     
                     if (m->getControl_pressed()) { return sampledCt; }
+                    if (sampled[j] == 0) { continue; }
                     
-                    map<string, vector<int> >::iterator it = tempCount.find(allNames[j]);
+                    map<string, vector<int> >::iterator it = tempCount.find(names[j]);
                     
                     if (it == tempCount.end()) { //we have not seen this sequence at all yet
                         vector<int> tempGroups; tempGroups.resize(Groups.size(), 0);
-                        tempGroups[i]++;
-                        tempCount[allNames[j]] = tempGroups;
+                        tempGroups[i] = sampled[j];
+                        tempCount[names[j]] = tempGroups;
                     }else{
-                        tempCount[allNames[j]][i]++;
+                        tempCount[names[j]][i] = sampled[j];
                     }
                 }
             }
@@ -281,7 +315,9 @@ CountTable SubSample::getSample(CountTable& ct, int size, vector<string> Groups,
         
         if (ct.hasGroupInfo()) {
             map<string, vector<int> > tempCount;
-            vector<item> allNames;
+            vector<item> allNames; //one per name and group, abunds holds its count
+            vector<int> abunds;
+            long long numSeqs = 0;
             map<string, int> groupMap;
             
             vector<string> myGroups;
@@ -298,32 +334,33 @@ CountTable SubSample::getSample(CountTable& ct, int size, vector<string> Groups,
                     if (m->getControl_pressed()) { return sampledCt; }
                     
                     int num = ct. getGroupCount(names[j], myGroups[i]);
-                    for (int k = 0; k < num; k++) { 
-                        item temp(names[j], myGroups[i]);
-                        allNames.push_back(temp); 
-                    }
+                    item temp(names[j], myGroups[i]);
+                    allNames.push_back(temp);
+                    abunds.push_back(num);
+                    numSeqs += num;
                 }
             }
             
-            util.mothurRandomShuffle(allNames);
-            
-            if (allNames.size() < size) { 
+            if (numSeqs < size) { 
                 if (pickedGroups) { m->mothurOut("[ERROR]: You have selected a size that is larger than the number of sequences.\n"); } 
                 else { m->mothurOut("[ERROR]: You have selected a size that is larger than the number of sequences in the groups you chose.\n"); }
                 m->setControl_pressed(true); return sampledCt; }
             else{
-                for (int j = 0; j < size; j++) {
+                vector<int> sampled = getSample(abunds, size);
+                
+                for (int j = 0; j < allNames.size(); j++) {
                     
                     if (m->getControl_pressed()) { return sampledCt; }
+                    if (sampled[j] == 0) { continue; }
                     
                     map<string, vector<int> >::iterator it = tempCount.find(allNames[j].name);
                     
                     if (it == tempCount.end()) { //we have not seen this sequence at all yet
                         vector<int> tempGroups; tempGroups.resize(myGroups.size(), 0);
-                        tempGroups[groupMap[allNames[j].group]]++;
+                        tempGroups[groupMap[allNames[j].group]] = sampled[j];
                         tempCount[allNames[j].name] = tempGroups;
                     }else{
-                        tempCount[allNames[j].name][groupMap[allNames[j].group]]++;
+                        tempCount[allNames[j].name][groupMap[allNames[j].group]] = sampled[j];
                     }
                 }
             }
@@ -340,25 +377,22 @@ CountTable SubSample::getSample(CountTable& ct, int size, vector<string> Groups,
         }else {
             vector<string> names = ct.getNamesOfSeqs();
             map<string, int> nameMap;
-            vector<string> allNames;
+            vector<int> abunds;
+            long long numSeqs = 0;
             
             for (int i = 0; i < names.size(); i++) {
-                int num = ct.getNumSeqs(names[i]);
-                for (int j = 0; j < num; j++) { allNames.push_back(names[i]); }
+                abunds.push_back(ct.getNumSeqs(names[i]));
+                numSeqs += abunds[i];
             }
             
-            if (allNames.size() < size) { m->mothurOut("[ERROR]: You have selected a size that is larger than the number of sequences.\n"); m->setControl_pressed(true); return sampledCt; }
+            if (numSeqs < size) { m->mothurOut("[ERROR]: You have selected a size that is larger than the number of sequences.\n"); m->setControl_pressed(true); return sampledCt; }
             else {
-                util.mothurRandomShuffle(allNames);
+                vector<int> sampled = getSample(abunds, size);
                 
-                for (int j = 0; j < size; j++) {
+                for (int j = 0; j < names.size(); j++) {
                     if (m->getControl_pressed()) { return sampledCt; }
                     
-                    map<string, int>::iterator it = nameMap.find(allNames[j]);
-                    
-                    //we have not seen this sequence at all yet
-                    if (it == nameMap.end()) { nameMap[allNames[j]] = 1;  }
-                    else{  nameMap[allNames[j]]++;  }
+                    if (sampled[j] != 0) { nameMap[names[j]] = sampled[j]; }
                 }
                 
                 //build count table
@@ -33,6 +33,7 @@ class SubSample {
         int getSample(SAbundVector*&, int); //destroys sabundvector passed in, so copy it if you need it
         CountTable getSample(CountTable&, int, vector<string>); //subsample a countTable bygroup(same number sampled from each group, returns subsampled countTable 
         CountTable getSample(CountTable&, int, vector<string>, bool); //subsample a countTable. If you want to only sample from specific groups, pass in groups in the vector and set bool=true, otherwise set bool=false.   
+        vector<int> getSample(const vector<int>&, int); //draws size reads without replacement from the abundances, returns the number drawn from each. All the other getSamples use this one.
     
     private:
     
@@ -91,6 +91,13 @@ int TrimOligos::preProcess(int p, int b, int l, int s, int rd, map<string, int>
             }
         }
         
+        aligner = NULL; alignerSize = 0;
+        for(it=primers.begin();it!=primers.end();it++){ addOligoMasks(it->first); }
+        for(it=barcodes.begin();it!=barcodes.end();it++){ addOligoMasks(it->first); }
+        for(int i = 0; i < revPrimer.size(); i++){ addOligoMasks(revPrimer[i]); }
+        for(int i = 0; i < linker.size(); i++){ addOligoMasks(linker[i]); }
+        for(int i = 0; i < spacer.size(); i++){ addOligoMasks(spacer[i]); }
+        
         return 0;
     }
     catch(exception& e) {
@@ -164,6 +171,13 @@ int TrimOligos::preProcess(int p, int b, int l, int s, map<int, oligosPair> pr,
         
         ipbarcodes = br;
         ipprimers = pr;
+        
+        aligner = NULL; alignerSize = 0;
+        map<string, vector<int> >::iterator it;
+        for(it=ifbarcodes.begin();it!=ifbarcodes.end();it++){ addOligoMasks(it->first); }
+        for(it=irbarcodes.begin();it!=irbarcodes.end();it++){ addOligoMasks(it->first); }
+        for(it=ifprimers.begin();it!=ifprimers.end();it++){ addOligoMasks(it->first); }
+        for(it=irprimers.begin();it!=irprimers.end();it++){ addOligoMasks(it->first); }
 
         return 0;
     }
@@ -172,6 +186,118 @@ int TrimOligos::preProcess(int p, int b, int l, int s, map<int, oligosPair> pr,
         exit(1);
     }
 }
+/********************************************************************/
+TrimOligos::~TrimOligos(){ if (aligner != NULL) { delete aligner; } }
+/********************************************************************/
+//the strip functions used to make a new aligner for every read. this one is kept until you need a bigger one.
+Alignment* TrimOligos::getAligner(int size){
+    try {
+        if ((aligner == NULL) || (alignerSize < size)) {
+            if (aligner != NULL) { delete aligner; }
+            aligner = new NeedlemanOverlap(-1.0, 1.0, -1.0, size);
+            alignerSize = size;
+        }
+        return aligner;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrimOligos", "getAligner");
+        exit(1);
+    }
+}
+/********************************************************************/
+//adds the masks for the oligo and its reverse complement. oligos with N, I or anything else countDiffs doesn't
+//count as a difference are left out, couldMatch lets them through.
+void TrimOligos::addOligoMasks(string oligo){
+    try {
+        if ((oligo.length() == 0) || (oligo.length() > 64) || (oligoMasks.count(oligo) != 0)) { return; }
+        
+        vector<unsigned long long> masks(4, 0);
+        for (int i = 0; i < oligo.length(); i++) {
+            string matches;
+            switch (oligo[i]) {
+                case 'A': matches = "A"; break;
+                case 'C': matches = "C"; break;
+                case 'G': matches = "G"; break;
+                case 'T': matches = "T"; break;
+                case 'R': matches = "AG"; break;
+                case 'Y': matches = "CT"; break;
+                case 'M': matches = "AC"; break;
+                case 'K': matches = "GT"; break;
+                case 'W': matches = "AT"; break;
+                case 'S': matches = "CG"; break;
+                case 'B': matches = "CGT"; break;
+                case 'D': matches = "AGT"; break;
+                case 'H': matches = "ACT"; break;
+                case 'V': matches = "ACG"; break;
+                default: return;
+            }
+            for (int j = 0; j < matches.length(); j++) {
+                int base = ((matches[j] == 'A') ? 0 : ((matches[j] == 'C') ? 1 : ((matches[j] == 'G') ? 2 : 3)));
+                masks[base] |= (1ULL << i);
+            }
+        }
+        oligoMasks[oligo] = masks;
+        
+        if (oligo != reverseOligo(oligo)) { addOligoMasks(reverseOligo(oligo)); }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrimOligos", "addOligoMasks");
+        exit(1);
+    }
+}
+/********************************************************************/
+//false if the oligo can't be aligned to seq with maxDiffs or fewer differences. Every difference countDiffs finds is
+//a substitution, insertion or deletion, so the number of differences is at least the edit distance between the oligo
+//and the closest stretch of seq. That distance is found with Myers' bit-vector algorithm, one machine word for the
+//whole oligo, so it costs a few instructions per base instead of an alignment.
+bool TrimOligos::couldMatch(string& oligo, string& seq, int maxDiffs){
+    try {
+        if (maxDiffs >= oligo.length()) { return true; }
+        
+        map<string, vector<unsigned long long> >::iterator it = oligoMasks.find(oligo);
+        if (it == oligoMasks.end()) { return true; }
+        vector<unsigned long long>& masks = it->second;
+        
+        unsigned long long lastBit = 1ULL << (oligo.length()-1);
+        unsigned long long Pv = ~0ULL; unsigned long long Mv = 0;
+        int score = oligo.length();
+        
+        for (int i = 0; i < seq.length(); i++) {
+            unsigned long long Eq = 0;
+            switch (seq[i]) {
+                case 'A': Eq = masks[0]; break;
+                case 'C': Eq = masks[1]; break;
+                case 'G': Eq = masks[2]; break;
+                case 'T': Eq = masks[3]; break;
+                default:
+                    //countDiffs calls a read IUPAC code or N a match only where the oligo has the same character
+                    for (int j = 0; j < oligo.length(); j++) { if (oligo[j] == seq[i]) { Eq |= (1ULL << j); } }
+                    break;
+            }
+            
+            unsigned long long Xv = Eq | Mv;
+            unsigned long long Xh = (((Eq & Pv) + Pv) ^ Pv) | Eq;
+            unsigned long long Ph = Mv | ~(Xh | Pv);
+            unsigned long long Mh = Pv & Xh;
+            
+            if (Ph & lastBit) { score++; }
+            else if (Mh & lastBit) { score--; }
+            
+            //the oligo can start anywhere in seq, so nothing is shifted into the first row
+            Ph <<= 1; Mh <<= 1;
+            Pv = Mh | ~(Xv | Ph);
+            Mv = Ph & Xv;
+            
+            if (score <= maxDiffs) { return true; }
+        }
+        
+        return false;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrimOligos", "couldMatch");
+        exit(1);
+    }
+}
 //********************************************************************/
 vector<int> TrimOligos::findForward(Sequence& seq, int& primerStart, int& primerEnd){
     try {
@@ -212,7 +338,7 @@ vector<int> TrimOligos::findForward(Sequence& seq, int& primerStart, int& primer
             int minCount = 1;
             
             Alignment* alignment;
-            if (primers.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFPrimerLength+pdiffs+1)); }
+            if (primers.size() > 0) { alignment = getAligner(maxFPrimerLength+pdiffs+1); }
             else{ alignment = NULL; }
             
             for(map<string,int>::iterator it=primers.begin();it!=primers.end();it++){
@@ -231,6 +357,7 @@ vector<int> TrimOligos::findForward(Sequence& seq, int& primerStart, int& primer
                         string rawChunk = rawSequence.substr(j, olength+pdiffs);
                         
                         //use needleman to align first primer.length()+numdiffs of sequence to each barcode
+                        if (!couldMatch(oligo, rawChunk, minDiff)) { continue; }
                         alignment->alignPrimer(oligo, rawChunk);
                         oligo = alignment->getSeqAAln();
                         string temp = alignment->getSeqBAln();
@@ -255,7 +382,6 @@ vector<int> TrimOligos::findForward(Sequence& seq, int& primerStart, int& primer
                 }
             }
             
-            if (alignment != NULL) { delete alignment; }
             
             if(minDiff > pdiffs)	{	primerStart = 0; primerEnd = 0; success[0] = minDiff;  success[1] = 1e6; return success;	}	//no good matches
             else if(minCount > 1)	{	minDiff = 1e6; primerStart = 0; primerEnd = 0; success[0] = minDiff; success[1] = pdiffs + 10000; return success;	}	//can't tell the difference between multiple primers
@@ -309,7 +435,7 @@ vector<int> TrimOligos::findReverse(Sequence& seq, int& primerStart, int& primer
         if ((rdiffs == 0) || (success[0] == 0)) { return success; }
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (revPrimer.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxRevPrimerLength+rdiffs+1)); }
+            if (revPrimer.size() > 0) { alignment = getAligner(maxRevPrimerLength+rdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the revPrimer
@@ -332,6 +458,7 @@ vector<int> TrimOligos::findReverse(Sequence& seq, int& primerStart, int& primer
                         //cout << "r before = " << oligo << '\t' << rawChunk << endl;
                         // cout << oligo << '\t' << olength << endl;
                         //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
+                        if (!couldMatch(oligo, rawChunk, minDiff)) { continue; }
                         alignment->alignPrimer(oligo, rawChunk);
                         oligo = alignment->getSeqAAln();
                         string temp = alignment->getSeqBAln();
@@ -361,7 +488,6 @@ vector<int> TrimOligos::findReverse(Sequence& seq, int& primerStart, int& primer
                 }
             }
             
-            if (alignment != NULL) { delete alignment; }
             
             if(minDiff > rdiffs)	{	primerStart = 0; primerEnd = 0; success[0] = minDiff;  success[1] = 1e6; return success;	}	//no good matches
             else if(minCount > 1)	{	primerStart = 0; primerEnd = 0; success[0] = minDiff; success[1] = rdiffs + 10000; return success;	}	//can't tell the difference between multiple primers
@@ -433,7 +559,7 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, QualityScores& qual, int& gr
         
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (barcodes.size() > 0) {alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFBarcodeLength+bdiffs+1)); }
+            if (barcodes.size() > 0) {alignment = getAligner(maxFBarcodeLength+bdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -453,7 +579,9 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, QualityScores& qual, int& gr
                 }
                 
                 //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                alignment->alignPrimer(oligo, rawSequence.substr(0,oligo.length()+bdiffs));
+                string rawChunk = rawSequence.substr(0,oligo.length()+bdiffs);
+                if (!couldMatch(oligo, rawChunk, minDiff)) { continue; }
+                alignment->alignPrimer(oligo, rawChunk);
                 oligo = alignment->getSeqAAln();
                 string temp = alignment->getSeqBAln();
                 
@@ -497,7 +625,6 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, QualityScores& qual, int& gr
                 success[0] = minDiff; success[1] = 0;
             }
             
-            if (alignment != NULL) { delete alignment; }
             
         }
         
@@ -564,7 +691,7 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
         if ((bdiffs == 0) || (success[0] == 0)) { return success; }
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (ifbarcodes.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFBarcodeLength+bdiffs+1)); }
+            if (ifbarcodes.size() > 0) { alignment = getAligner(maxFBarcodeLength+bdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -599,7 +726,9 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                 if (oligo != "NONE") {
                     //cout << "before = " << oligo << '\t' << rawFSequence.substr(0,oligo.length()+bdiffs) << endl;
                     //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                    alignment->alignPrimer(oligo, rawFSequence.substr(0,oligo.length()+bdiffs));
+                    string rawChunk = rawFSequence.substr(0,oligo.length()+bdiffs);
+                    if (!couldMatch(oligo, rawChunk, minDiff)) { continue; }
+                    alignment->alignPrimer(oligo, rawChunk);
                     oligo = alignment->getSeqAAln();
                     string temp = alignment->getSeqBAln();
                     
@@ -651,9 +780,8 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                 success[0] = minDiff;
                 
                 //check for reverse match
-                if (alignment != NULL) { delete alignment; }
                 
-                if (irbarcodes.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxRBarcodeLength+bdiffs+1)); }
+                if (irbarcodes.size() > 0) { alignment = getAligner(maxRBarcodeLength+bdiffs+1); }
                 else{ alignment = NULL; }
                 
                 //can you find the barcode
@@ -673,7 +801,9 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                     
                     if (oligo != "NONE") {
                         //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                        alignment->alignPrimer(oligo, rawRSequence.substr(0,oligo.length()+bdiffs));
+                        string rawChunk = rawRSequence.substr(0,oligo.length()+bdiffs);
+                        if (!couldMatch(oligo, rawChunk, minDiff)) { continue; }
+                        alignment->alignPrimer(oligo, rawChunk);
                         oligo = alignment->getSeqAAln();
                         string temp = alignment->getSeqBAln();
                         
@@ -749,7 +879,6 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                 }
             }
             
-            if (alignment != NULL) { delete alignment; }
         }
         
         return success;
@@ -828,7 +957,7 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
         if ((bdiffs == 0) || (success[0] == 0)) { return success; }
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (ifbarcodes.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFBarcodeLength+bdiffs+1)); }
+            if (ifbarcodes.size() > 0) { alignment = getAligner(maxFBarcodeLength+bdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -862,7 +991,9 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                 if (oligo != "NONE") {
                     //cout << "before = " << oligo << '\t' << rawFSequence.substr(0,oligo.length()+bdiffs) << endl;
                     //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                    alignment->alignPrimer(oligo, rawFSequence.substr(0,oligo.length()+bdiffs));
+                    string rawChunk = rawFSequence.substr(0,oligo.length()+bdiffs);
+                    if (!couldMatch(oligo, rawChunk, minDiff)) { continue; }
+                    alignment->alignPrimer(oligo, rawChunk);
                     oligo = alignment->getSeqAAln();
                     string temp = alignment->getSeqBAln();
                     
@@ -912,9 +1043,8 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                 success[0] = minDiff; //set forward barcode diffs
                 
                 //check for reverse match
-                if (alignment != NULL) { delete alignment; }
                 
-                if (irbarcodes.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxRBarcodeLength+bdiffs+1)); }
+                if (irbarcodes.size() > 0) { alignment = getAligner(maxRBarcodeLength+bdiffs+1); }
                 else{ alignment = NULL; }
                 
                 //can you find the barcode
@@ -934,7 +1064,9 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                     
                     if (oligo != "NONE") {
                         //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                        alignment->alignPrimer(oligo, rawRSequence.substr(0,oligo.length()+bdiffs));
+                        string rawChunk = rawRSequence.substr(0,oligo.length()+bdiffs);
+                        if (!couldMatch(oligo, rawChunk, minDiff)) { continue; }
+                        alignment->alignPrimer(oligo, rawChunk);
                         oligo = alignment->getSeqAAln();
                         string temp = alignment->getSeqBAln();
                         
@@ -1013,7 +1145,6 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                 }
             }
             
-            if (alignment != NULL) { delete alignment; }
         }
         
         return success;
@@ -1098,7 +1229,7 @@ vector<int> TrimOligos::stripPairedBarcode(Sequence& seq, QualityScores& qual, i
         if ((bdiffs == 0) || (success[0] == 0)) { return success; }
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (ifbarcodes.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFBarcodeLength+bdiffs+1)); }
+            if (ifbarcodes.size() > 0) { alignment = getAligner(maxFBarcodeLength+bdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -1132,7 +1263,9 @@ vector<int> TrimOligos::stripPairedBarcode(Sequence& seq, QualityScores& qual, i
                 //cout << "before = " << oligo << '\t' << rawSeq.substr(0,oligo.length()+bdiffs) << endl;
                 if (oligo != "NONE") {
                     //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                    alignment->alignPrimer(oligo, rawSeq.substr(0,oligo.length()+bdiffs));
+                    string rawChunk = rawSeq.substr(0,oligo.length()+bdiffs);
+                    if (!couldMatch(oligo, rawChunk, minDiff)) { continue; }
+                    alignment->alignPrimer(oligo, rawChunk);
                     oligo = alignment->getSeqAAln();
                     string temp = alignment->getSeqBAln();
                     
@@ -1184,9 +1317,8 @@ vector<int> TrimOligos::stripPairedBarcode(Sequence& seq, QualityScores& qual, i
                 success[0] = minDiff; //set forward barcode diffs
                 
                 //check for reverse match
-                if (alignment != NULL) { delete alignment; }
                 
-                if (irbarcodes.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxRBarcodeLength+bdiffs+1)); }
+                if (irbarcodes.size() > 0) { alignment = getAligner(maxRBarcodeLength+bdiffs+1); }
                 else{ alignment = NULL; }
                 
                 //can you find the barcode
@@ -1209,7 +1341,9 @@ vector<int> TrimOligos::stripPairedBarcode(Sequence& seq, QualityScores& qual, i
                     
                     if (oligo != "NONE") {
                         //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                        alignment->alignPrimer(oligo, rawRSequence.substr(0,oligo.length()+bdiffs));
+                        string rawChunk = rawRSequence.substr(0,oligo.length()+bdiffs);
+                        if (!couldMatch(oligo, rawChunk, minDiff)) { continue; }
+                        alignment->alignPrimer(oligo, rawChunk);
                         oligo = alignment->getSeqAAln();
                         string temp = alignment->getSeqBAln();
                         
@@ -1288,7 +1422,6 @@ vector<int> TrimOligos::stripPairedBarcode(Sequence& seq, QualityScores& qual, i
             }
             rMinDiff = minDiff;
 
-            if (alignment != NULL) { delete alignment; }
         }
 
         return success;
@@ -1380,7 +1513,7 @@ vector<int> TrimOligos::stripPairedPrimers(Sequence& seq, QualityScores& qual, i
         if ((pdiffs == 0) || (success[0] == 0)) { return success; }
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (ifprimers.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFPrimerLength+pdiffs+1)); }
+            if (ifprimers.size() > 0) { alignment = getAligner(maxFPrimerLength+pdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -1414,7 +1547,9 @@ vector<int> TrimOligos::stripPairedPrimers(Sequence& seq, QualityScores& qual, i
                 //cout << "before = " << oligo << '\t' << rawSeq.substr(0,oligo.length()+pdiffs) << endl;
                 if (oligo != "NONE") {
                     //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                    alignment->alignPrimer(oligo, rawSeq.substr(0,oligo.length()+pdiffs));
+                    string rawChunk = rawSeq.substr(0,oligo.length()+pdiffs);
+                    if (!couldMatch(oligo, rawChunk, minDiff)) { continue; }
+                    alignment->alignPrimer(oligo, rawChunk);
                     oligo = alignment->getSeqAAln();
                     string temp = alignment->getSeqBAln();
                     
@@ -1472,9 +1607,8 @@ vector<int> TrimOligos::stripPairedPrimers(Sequence& seq, QualityScores& qual, i
                 success[0] = minDiff; //set forward primer diffs
                 
                 //check for reverse match
-                if (alignment != NULL) { delete alignment; }
                 
-                if (irprimers.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxRPrimerLength+pdiffs+1)); }
+                if (irprimers.size() > 0) { alignment = getAligner(maxRPrimerLength+pdiffs+1); }
                 else{ alignment = NULL; }
                 
                 //can you find the barcode
@@ -1497,7 +1631,9 @@ vector<int> TrimOligos::stripPairedPrimers(Sequence& seq, QualityScores& qual, i
                     
                     if (oligo != "NONE") {
                         //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                        alignment->alignPrimer(oligo, rawRSequence.substr(0,oligo.length()+pdiffs));
+                        string rawChunk = rawRSequence.substr(0,oligo.length()+pdiffs);
+                        if (!couldMatch(oligo, rawChunk, minDiff)) { continue; }
+                        alignment->alignPrimer(oligo, rawChunk);
                         oligo = alignment->getSeqAAln();
                         string temp = alignment->getSeqBAln();
                         
@@ -1584,7 +1720,6 @@ vector<int> TrimOligos::stripPairedPrimers(Sequence& seq, QualityScores& qual, i
 
             rMinDiff = minDiff;
             
-            if (alignment != NULL) { delete alignment; }
         }
         
 //        cout << "\nalign:\t" << fMinDiff << '\t' << rMinDiff << endl;
@@ -1659,7 +1794,7 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
         if ((pdiffs == 0) || (success[0] == 0)) { return success; }
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (ifprimers.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFPrimerLength+pdiffs+1)); }
+            if (ifprimers.size() > 0) { alignment = getAligner(maxFPrimerLength+pdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -1693,7 +1828,9 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                 //cout << "before = " << oligo << '\t' << rawFSequence.substr(0,oligo.length()+pdiffs) << endl;
                 if (oligo != "NONE") {
                     //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                    alignment->alignPrimer(oligo, rawFSequence.substr(0,oligo.length()+pdiffs));
+                    string rawChunk = rawFSequence.substr(0,oligo.length()+pdiffs);
+                    if (!couldMatch(oligo, rawChunk, minDiff)) { continue; }
+                    alignment->alignPrimer(oligo, rawChunk);
                     oligo = alignment->getSeqAAln();
                     string temp = alignment->getSeqBAln();
                     
@@ -1745,9 +1882,8 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                 success[0] = minDiff; //set forward primer diffs
                 
                 //check for reverse match
-                if (alignment != NULL) { delete alignment; }
                 
-                if (irprimers.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxRPrimerLength+pdiffs+1)); }
+                if (irprimers.size() > 0) { alignment = getAligner(maxRPrimerLength+pdiffs+1); }
                 else{ alignment = NULL; }
                 
                 //can you find the barcode
@@ -1767,7 +1903,9 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                     
                     if (oligo != "NONE") {
                         //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                        alignment->alignPrimer(oligo, rawRSequence.substr(0,oligo.length()+pdiffs));
+                        string rawChunk = rawRSequence.substr(0,oligo.length()+pdiffs);
+                        if (!couldMatch(oligo, rawChunk, minDiff)) { continue; }
+                        alignment->alignPrimer(oligo, rawChunk);
                         oligo = alignment->getSeqAAln();
                         string temp = alignment->getSeqBAln();
                         
@@ -1844,7 +1982,6 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                 }
             }
             
-            if (alignment != NULL) { delete alignment; }
         }
         
         return success;
@@ -1912,7 +2049,7 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
         if ((pdiffs == 0) || (success[0] == 0)) { return success; }
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (ifprimers.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFPrimerLength+pdiffs+1)); }
+            if (ifprimers.size() > 0) { alignment = getAligner(maxFPrimerLength+pdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -1946,7 +2083,9 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                 //cout << "before = " << oligo << '\t' << rawFSequence.substr(0,oligo.length()+pdiffs) << endl;
                 if (oligo != "NONE") {
                     //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                    alignment->alignPrimer(oligo, rawFSequence.substr(0,oligo.length()+pdiffs));
+                    string rawChunk = rawFSequence.substr(0,oligo.length()+pdiffs);
+                    if (!couldMatch(oligo, rawChunk, minDiff)) { continue; }
+                    alignment->alignPrimer(oligo, rawChunk);
                     oligo = alignment->getSeqAAln();
                     string temp = alignment->getSeqBAln();
                     
@@ -1998,9 +2137,8 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                 success[0] = minDiff; //set forward primer diffs
                 
                 //check for reverse match
-                if (alignment != NULL) { delete alignment; }
                 
-                if (irprimers.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxRPrimerLength+pdiffs+1)); }
+                if (irprimers.size() > 0) { alignment = getAligner(maxRPrimerLength+pdiffs+1); }
                 else{ alignment = NULL; }
                 
                 //can you find the barcode
@@ -2020,7 +2158,9 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                     
                     if (oligo != "NONE") {
                         //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                        alignment->alignPrimer(oligo, rawRSequence.substr(0,oligo.length()+pdiffs));
+                        string rawChunk = rawRSequence.substr(0,oligo.length()+pdiffs);
+                        if (!couldMatch(oligo, rawChunk, minDiff)) { continue; }
+                        alignment->alignPrimer(oligo, rawChunk);
                         oligo = alignment->getSeqAAln();
                         string temp = alignment->getSeqBAln();
                         
@@ -2096,7 +2236,6 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                 }
             }
             
-            if (alignment != NULL) { delete alignment; }
         }
         
         return success;
@@ -2140,7 +2279,7 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, int& group){
         
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (barcodes.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFBarcodeLength+bdiffs+1)); }
+            if (barcodes.size() > 0) { alignment = getAligner(maxFBarcodeLength+bdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -2160,7 +2299,9 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, int& group){
                 }
                 
                 //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                alignment->alignPrimer(oligo, rawSequence.substr(0,oligo.length()+bdiffs));
+                string rawChunk = rawSequence.substr(0,oligo.length()+bdiffs);
+                if (!couldMatch(oligo, rawChunk, minDiff)) { continue; }
+                alignment->alignPrimer(oligo, rawChunk);
                 oligo = alignment->getSeqAAln();
                 string temp = alignment->getSeqBAln();
                 
@@ -2201,7 +2342,6 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, int& group){
                 success[0] = minDiff; success[1] = 0;
             }
             
-            if (alignment != NULL) { delete alignment; }
             
         }
         
@@ -2245,7 +2385,7 @@ vector<int> TrimOligos::stripForward(Sequence& seq, int& group){
         
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (primers.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFPrimerLength+pdiffs+1)); }
+            if (primers.size() > 0) { alignment = getAligner(maxFPrimerLength+pdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -2265,7 +2405,9 @@ vector<int> TrimOligos::stripForward(Sequence& seq, int& group){
                 }
                 
                 //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                alignment->alignPrimer(oligo, rawSequence.substr(0,oligo.length()+pdiffs));
+                string rawChunk = rawSequence.substr(0,oligo.length()+pdiffs);
+                if (!couldMatch(oligo, rawChunk, minDiff)) { continue; }
+                alignment->alignPrimer(oligo, rawChunk);
                 oligo = alignment->getSeqAAln();
                 string temp = alignment->getSeqBAln();
                 
@@ -2306,7 +2448,6 @@ vector<int> TrimOligos::stripForward(Sequence& seq, int& group){
                 success[0] = minDiff; success[1] = 0;
             }
             
-            if (alignment != NULL) { delete alignment; }
             
         }
         
@@ -2356,7 +2497,7 @@ vector<int> TrimOligos::stripForward(Sequence& seq, QualityScores& qual, int& gr
         
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (primers.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFPrimerLength+pdiffs+1)); }
+            if (primers.size() > 0) { alignment = getAligner(maxFPrimerLength+pdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -2376,7 +2517,9 @@ vector<int> TrimOligos::stripForward(Sequence& seq, QualityScores& qual, int& gr
                 }
                 
                 //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                alignment->alignPrimer(oligo, rawSequence.substr(0,oligo.length()+pdiffs));
+                string rawChunk = rawSequence.substr(0,oligo.length()+pdiffs);
+                if (!couldMatch(oligo, rawChunk, minDiff)) { continue; }
+                alignment->alignPrimer(oligo, rawChunk);
                 oligo = alignment->getSeqAAln();
                 string temp = alignment->getSeqBAln();
                 
@@ -2420,7 +2563,6 @@ vector<int> TrimOligos::stripForward(Sequence& seq, QualityScores& qual, int& gr
                 success[0] = minDiff; success[1] = 0;
             }
             
-            if (alignment != NULL) { delete alignment; }
             
         }
         
@@ -2467,7 +2609,7 @@ vector<int> TrimOligos::stripReverse(Sequence& seq, QualityScores& qual){
         
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (revPrimer.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxRevPrimerLength+pdiffs+1)); }
+            if (revPrimer.size() > 0) { alignment = getAligner(maxRevPrimerLength+pdiffs+1); }
             else{ alignment = NULL; }
         
             //can you find the revPrimer
@@ -2488,7 +2630,9 @@ vector<int> TrimOligos::stripReverse(Sequence& seq, QualityScores& qual){
                 }
             
                 //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                alignment->alignPrimer(oligo, rawRSequence.substr(0,oligo.length()+pdiffs));
+                string rawChunk = rawRSequence.substr(0,oligo.length()+pdiffs);
+                if (!couldMatch(oligo, rawChunk, minDiff)) { continue; }
+                alignment->alignPrimer(oligo, rawChunk);
                 oligo = alignment->getSeqAAln();
                 string temp = alignment->getSeqBAln();
             
@@ -2529,7 +2673,6 @@ vector<int> TrimOligos::stripReverse(Sequence& seq, QualityScores& qual){
                 success[0] = minDiff; success[1] = 0;
             }
             
-            if (alignment != NULL) { delete alignment; }
             
         }
     
@@ -2576,7 +2719,7 @@ vector<int> TrimOligos::stripReverse(Sequence& seq){
         
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (revPrimer.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxRevPrimerLength+pdiffs+1)); }
+            if (revPrimer.size() > 0) { alignment = getAligner(maxRevPrimerLength+pdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the revPrimer
@@ -2597,7 +2740,9 @@ vector<int> TrimOligos::stripReverse(Sequence& seq){
                 }
                 
                 //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                alignment->alignPrimer(oligo, rawRSequence.substr(0,oligo.length()+pdiffs));
+                string rawChunk = rawRSequence.substr(0,oligo.length()+pdiffs);
+                if (!couldMatch(oligo, rawChunk, minDiff)) { continue; }
+                alignment->alignPrimer(oligo, rawChunk);
                 oligo = alignment->getSeqAAln();
                 string temp = alignment->getSeqBAln();
                 
@@ -2635,7 +2780,6 @@ vector<int> TrimOligos::stripReverse(Sequence& seq){
                 success[0] = minDiff; success[1] = 0;
             }
             
-            if (alignment != NULL) { delete alignment; }
             
         }
         
@@ -2677,7 +2821,7 @@ bool TrimOligos::stripLinker(Sequence& seq, QualityScores& qual){
         
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (linker.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxLinkerLength+ldiffs+1)); }	
+            if (linker.size() > 0) { alignment = getAligner(maxLinkerLength+ldiffs+1); }	
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -2695,7 +2839,9 @@ bool TrimOligos::stripLinker(Sequence& seq, QualityScores& qual){
                 }
                 
                 //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                alignment->alignPrimer(oligo, rawSequence.substr(0,oligo.length()+ldiffs));
+                string rawChunk = rawSequence.substr(0,oligo.length()+ldiffs);
+                if (!couldMatch(oligo, rawChunk, minDiff)) { continue; }
+                alignment->alignPrimer(oligo, rawChunk);
                 oligo = alignment->getSeqAAln();
                 string temp = alignment->getSeqBAln();
                 
@@ -2736,7 +2882,6 @@ bool TrimOligos::stripLinker(Sequence& seq, QualityScores& qual){
                 success = minDiff;
             }
             
-            if (alignment != NULL) { delete alignment; }
             
         }
         
@@ -2776,7 +2921,7 @@ bool TrimOligos::stripLinker(Sequence& seq){
         
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (linker.size() > 0) {alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxLinkerLength+ldiffs+1)); }
+            if (linker.size() > 0) {alignment = getAligner(maxLinkerLength+ldiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -2794,7 +2939,9 @@ bool TrimOligos::stripLinker(Sequence& seq){
                 }
                 
                 //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                alignment->alignPrimer(oligo, rawSequence.substr(0,oligo.length()+ldiffs));
+                string rawChunk = rawSequence.substr(0,oligo.length()+ldiffs);
+                if (!couldMatch(oligo, rawChunk, minDiff)) { continue; }
+                alignment->alignPrimer(oligo, rawChunk);
                 oligo = alignment->getSeqAAln();
                 string temp = alignment->getSeqBAln();
                 
@@ -2831,7 +2978,6 @@ bool TrimOligos::stripLinker(Sequence& seq){
                 success = minDiff;
             }
             
-            if (alignment != NULL) { delete alignment; }
             
         }
         
@@ -2873,7 +3019,7 @@ bool TrimOligos::stripSpacer(Sequence& seq, QualityScores& qual){
         
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (spacer.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxSpacerLength+sdiffs+1)); }
+            if (spacer.size() > 0) { alignment = getAligner(maxSpacerLength+sdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -2891,7 +3037,9 @@ bool TrimOligos::stripSpacer(Sequence& seq, QualityScores& qual){
                 }
                 
                 //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                alignment->alignPrimer(oligo, rawSequence.substr(0,oligo.length()+sdiffs));
+                string rawChunk = rawSequence.substr(0,oligo.length()+sdiffs);
+                if (!couldMatch(oligo, rawChunk, minDiff)) { continue; }
+                alignment->alignPrimer(oligo, rawChunk);
                 oligo = alignment->getSeqAAln();
                 string temp = alignment->getSeqBAln();
                 
@@ -2932,7 +3080,6 @@ bool TrimOligos::stripSpacer(Sequence& seq, QualityScores& qual){
                 success = minDiff;
             }
             
-            if (alignment != NULL) { delete alignment; }
             
         }
         
@@ -2972,7 +3119,7 @@ bool TrimOligos::stripSpacer(Sequence& seq){
         
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (spacer.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxSpacerLength+sdiffs+1)); }
+            if (spacer.size() > 0) { alignment = getAligner(maxSpacerLength+sdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -2990,7 +3137,9 @@ bool TrimOligos::stripSpacer(Sequence& seq){
                 }
                 
                 //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                alignment->alignPrimer(oligo, rawSequence.substr(0,oligo.length()+sdiffs));
+                string rawChunk = rawSequence.substr(0,oligo.length()+sdiffs);
+                if (!couldMatch(oligo, rawChunk, minDiff)) { continue; }
+                alignment->alignPrimer(oligo, rawChunk);
                 oligo = alignment->getSeqAAln();
                 string temp = alignment->getSeqBAln();
                 
@@ -3027,7 +3176,6 @@ bool TrimOligos::stripSpacer(Sequence& seq){
                 success = minDiff;
             }
             
-            if (alignment != NULL) { delete alignment; }
             
         }
         
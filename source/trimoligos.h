@@ -14,19 +14,23 @@
 #include "sequence.hpp"
 #include "qualityscores.h"
 
+class Alignment;
+
 
 class TrimOligos {
     
 #ifdef UNIT_TEST
     friend class TestTrimOligos;
-    TrimOligos() { m = MothurOut::getInstance(); }
+    TrimOligos() { m = MothurOut::getInstance(); aligner = NULL; alignerSize = 0; }
 #endif
 	
 	public:
         TrimOligos(int,int,int, map<string, int>, map<string, int>, vector<string>); //pdiffs, bdiffs, primers, barcodes, revPrimers
         TrimOligos(int,int, int, int, map<string, int>, map<string, int>, vector<string>, vector<string>, vector<string>); //pdiffs, bdiffs, ldiffs, sdiffs, primers, barcodes, revPrimers, linker, spacer
         TrimOligos(int,int, int, int, map<int, oligosPair>, map<int, oligosPair>, bool); //pdiffs, bdiffs, ldiffs, sdiffs, primers, barcodes, hasIndex
-    ~TrimOligos(){}
+    ~TrimOligos();
+        TrimOligos(const TrimOligos&) = delete;    //a copy would delete the aligner a second time
+        TrimOligos& operator=(const TrimOligos&) = delete;
 	
     
         //codes : 10 means sequence shorter than barcode, 100 means multiple matches, 1e6 no matches, 0 found match.
@@ -76,11 +80,21 @@ class TrimOligos {
         map<int, oligosPair> ipprimers;
     
         int maxFBarcodeLength, maxRBarcodeLength, maxFPrimerLength, maxRPrimerLength, maxLinkerLength, maxSpacerLength;
+    
+        Alignment* aligner;     //shared by all the strip functions, made the first time one of them needs to align
+        int alignerSize;
+    
+        //for each oligo made of bases and IUPAC codes, bit i of oligoMasks[oligo][base] is set if position i matches that base (A, C, G, T)
+        map<string, vector<unsigned long long> > oligoMasks;
 	
 		MothurOut* m;
 	
 		bool compareDNASeq(string, string);				
 		int countDiffs(string, string);
+    
+        Alignment* getAligner(int);
+        void addOligoMasks(string);
+        bool couldMatch(string&, string&, int);
         
         vector<int> stripPairedBarcode(Sequence& seq, QualityScores& qual, int& group);
         vector<int> stripPairedPrimers(Sequence& seq, QualityScores& qual, int& group, bool);
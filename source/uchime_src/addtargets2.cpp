@@ -7,6 +7,8 @@
 
 const float MAX_WORD_COUNT_DROP = 1;
 
+vector<vector<unsigned> > g_ChunkTops;
+
 void SortDescending(const vector<float> &Values, vector<unsigned> &Order);
 bool GlobalAlign(const SeqData &Query, const SeqData &Target, string &Path);
 double GetFractIdGivenPath(const byte *A, const byte *B, const char *Path);
@@ -25,6 +27,12 @@ void AddTargets(SeqDB &DB, const SeqData &Query, set<unsigned> &TargetIndexes)
 	asserta(SIZE(Order) == SeqCount);
 	unsigned TopSeqIndex = Order[0];
 	float TopWordCount = WordCounts[TopSeqIndex];
+
+	vector<unsigned> Tops;
+	for (unsigned i = 0; i < SeqCount && WordCounts[Order[i]] == TopWordCount; ++i)
+		Tops.push_back(Order[i]);
+	g_ChunkTops.push_back(Tops);
+
 	for (unsigned i = 0; i < SeqCount; ++i)
 		{
 		unsigned SeqIndex = Order[i];
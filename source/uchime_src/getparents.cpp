@@ -5,6 +5,11 @@
 
 void AddTargets(Ultra &U, const SeqData &Query, set<unsigned> &TargetIndexes);
 
+// For the last query, its candidate parents and, for each chunk, the database
+// sequences with the top word count. Used by the de novo batches.
+vector<unsigned> g_CandidateParents;
+extern vector<vector<unsigned> > g_ChunkTops;
+
 void GetChunkInfo(unsigned L, unsigned &Length, vector<unsigned> &Los)
 	{
 	Los.clear();
@@ -45,6 +50,8 @@ void GetCandidateParents(Ultra &U, const SeqData &QSD, float AbQ,
 
 	SeqData QuerySD = QSD;
 
+	g_ChunkTops.clear();
+
 	unsigned ChunkLength;
 	vector<unsigned> ChunkLos;
 	GetChunkInfo(QL, ChunkLength, ChunkLos);
@@ -86,4 +93,5 @@ void GetCandidateParents(Ultra &U, const SeqData &QSD, float AbQ,
 		if (Accept)
 			Parents.push_back(TargetIndex);
 		}
+	g_CandidateParents = Parents;
 	}
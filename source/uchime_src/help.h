@@ -114,6 +114,13 @@
 "    Minimum fraction of the query sequence that must be covered by a local-X\n"
 "    alignment. Default 0.5. Applies only when --ucl is specified.\n"
 "\n"
+"--threads n\n"
+"    Number of worker processes for de novo mode. Default 1.\n"
+"    The queries are checked in batches, each assuming the earlier queries\n"
+"    in the batch are not chimeric. A query whose candidate parents include\n"
+"    an earlier query found to be chimeric is checked again, so the results\n"
+"    are the same as with --threads 1. Not available on Windows.\n"
+"\n"
 "--quiet\n"
 "    Do not display progress messages on stderr.\n"
 "\n"
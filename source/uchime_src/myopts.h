@@ -104,6 +104,7 @@ UNS_OPT(	hashsize,				4195879,	1,			UINT_MAX)
 UNS_OPT(	maxpoly,				0,			0,			UINT_MAX)
 UNS_OPT(	droppct,				50,			0,			100)
 UNS_OPT(	secs,					10,			0,			UINT_MAX)
+UNS_OPT(	threads,				1,			1,			UINT_MAX)
 UNS_OPT(	maxqgap,				0,			0,			UINT_MAX)
 UNS_OPT(	maxtgap,				0,			0,			UINT_MAX)
 
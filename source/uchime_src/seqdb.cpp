@@ -68,6 +68,18 @@ void SeqDB::InitEmpty(bool Nucleo)
 	m_IsNucleoSet = true;
 	}
 
+void SeqDB::Truncate(unsigned SeqCount)
+	{
+	asserta(SeqCount <= m_SeqCount);
+	for (unsigned i = SeqCount; i < m_SeqCount; ++i)
+		{
+		unsigned n = strlen(m_Labels[i]);
+		MYFREE(m_Labels[i], n, SeqDB);
+		MYFREE(m_Seqs[i], m_SeqLengths[i], SeqDB);
+		}
+	m_SeqCount = SeqCount;
+	}
+
 void SeqDB::FromFasta(const string &FileName, bool AllowGaps)
 	{
 	Clear();
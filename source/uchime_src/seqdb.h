@@ -31,6 +31,7 @@ public:
 	~SeqDB();
 	void Clear(bool ctor = false);
 	void InitEmpty(bool Nucleo);
+	void Truncate(unsigned SeqCount);
 
 	unsigned AddSeq(const char *Label, const byte *Seq, unsigned L);
 
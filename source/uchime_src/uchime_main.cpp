@@ -6,6 +6,12 @@
 #include "hspfinder.h"
 #include <algorithm>
 #include <set>
+#if	!defined(_WIN32)
+#include <errno.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
 
 bool SearchChime(Ultra &U, const SeqData &QSD, float QAb, 
   const AlnParams &AP, const AlnHeuristics &AH, HSPFinder &HF,
@@ -15,6 +21,11 @@ FILE *g_fUChime;
 FILE *g_fUChimeAlns;
 const vector<float> *g_SortVecFloat;
 bool g_UchimeDeNovo = false;
+extern vector<unsigned> g_CandidateParents;
+extern vector<vector<unsigned> > g_ChunkTops;
+
+// Queries given to each worker process in a de novo batch.
+const unsigned QUERIES_PER_THREAD = 32;
 
 void Usage()
 	{
@@ -87,6 +98,290 @@ float GetAbFromLabel(const string &Label)
 	return 0.0;
 	}
 
+static bool SearchQuery(SeqDB &Input, SeqDB &DB, unsigned QuerySeqIndex,
+  float MinFractId)
+	{
+	SeqData QSD;
+	Input.GetSeqData(QuerySeqIndex, QSD);
+
+	float QAb = -1.0;
+	if (g_UchimeDeNovo)
+		QAb = GetAbFromLabel(QSD.Label);
+
+	ChimeHit2 Hit;
+	AlnParams &AP = *(AlnParams *) 0;
+	AlnHeuristics &AH = *(AlnHeuristics *) 0;
+	HSPFinder &HF = *(HSPFinder *) 0;
+	bool Found = SearchChime(DB, QSD, QAb, AP, AH, HF, MinFractId, Hit);
+
+	WriteChimeHit(g_fUChime, Hit);
+	return Found;
+	}
+
+#if	!defined(_WIN32)
+
+// A query checked by a worker process, assuming the queries before it
+// in its batch are not chimeric.
+struct BatchResult
+	{
+	unsigned Worker;
+	bool Found;
+	off_t HitLo;
+	off_t HitHi;
+	off_t AlnLo;
+	off_t AlnHi;
+
+// Batch positions of the candidate parents from the batch, and of the top
+// word count targets of each chunk where all of them are from the batch.
+	vector<unsigned> Parents;
+	vector<vector<unsigned> > Tops;
+	};
+
+static void WriteBatchPositions(FILE *f, const vector<unsigned> &Indexes, unsigned DBCount)
+	{
+	vector<unsigned> Positions;
+	for (unsigned i = 0; i < SIZE(Indexes); ++i)
+		if (Indexes[i] >= DBCount)
+			Positions.push_back(Indexes[i] - DBCount);
+
+	unsigned n = SIZE(Positions);
+	fwrite(&n, sizeof(n), 1, f);
+	if (n > 0)
+		fwrite(&Positions[0], sizeof(unsigned), n, f);
+	}
+
+static off_t TellStdio(FILE *f)
+	{
+	if (f == 0)
+		return 0;
+	return ftello(f);
+	}
+
+static void CopyStdioRange(FILE *From, off_t Lo, off_t Hi, FILE *To)
+	{
+	if (To == 0 || Hi <= Lo)
+		return;
+
+	fseeko(From, Lo, SEEK_SET);
+	char Buffer[4096];
+	while (Lo < Hi)
+		{
+		size_t n = (size_t) min((off_t) sizeof(Buffer), Hi - Lo);
+		if (fread(Buffer, 1, n, From) != n)
+			Die("CopyStdioRange, read failed");
+		WriteStdioFile(To, Buffer, (unsigned) n);
+		Lo += n;
+		}
+	}
+
+static void RunWorker(SeqDB &Input, SeqDB &DB, const vector<unsigned> &Order,
+  unsigned BatchLo, unsigned BatchSize, unsigned DBCount, unsigned Worker,
+  unsigned WorkerCount, float MinFractId, FILE *fHits, FILE *fAlns, FILE *fResults)
+	{
+	if (g_fUChime != 0)
+		g_fUChime = fHits;
+	if (g_fUChimeAlns != 0)
+		g_fUChimeAlns = fAlns;
+
+	for (unsigned k = Worker; k < BatchSize; k += WorkerCount)
+		{
+	// The batch follows the database, only the queries before this one are visible.
+		DB.m_SeqCount = DBCount + k;
+
+		off_t HitLo = TellStdio(g_fUChime);
+		off_t AlnLo = TellStdio(g_fUChimeAlns);
+		unsigned Found = SearchQuery(Input, DB, Order[BatchLo + k], MinFractId) ? 1 : 0;
+		off_t HitHi = TellStdio(g_fUChime);
+		off_t AlnHi = TellStdio(g_fUChimeAlns);
+
+		fwrite(&Found, sizeof(Found), 1, fResults);
+		fwrite(&HitLo, sizeof(HitLo), 1, fResults);
+		fwrite(&HitHi, sizeof(HitHi), 1, fResults);
+		fwrite(&AlnLo, sizeof(AlnLo), 1, fResults);
+		fwrite(&AlnHi, sizeof(AlnHi), 1, fResults);
+		WriteBatchPositions(fResults, g_CandidateParents, DBCount);
+
+		vector<vector<unsigned> > Tops;
+		for (unsigned i = 0; i < SIZE(g_ChunkTops); ++i)
+			if (*min_element(g_ChunkTops[i].begin(), g_ChunkTops[i].end()) >= DBCount)
+				Tops.push_back(g_ChunkTops[i]);
+		unsigned TopCount = SIZE(Tops);
+		fwrite(&TopCount, sizeof(TopCount), 1, fResults);
+		for (unsigned i = 0; i < TopCount; ++i)
+			WriteBatchPositions(fResults, Tops[i], DBCount);
+		}
+
+	if (fflush(fHits) != 0 || fflush(fAlns) != 0 || fflush(fResults) != 0)
+		Die("RunWorker, write failed");
+	}
+
+static void ReadStdioValue(FILE *f, void *Value, unsigned Bytes)
+	{
+	if (fread(Value, Bytes, 1, f) != 1)
+		Die("uchime worker results truncated");
+	}
+
+static void ReadBatchPositions(FILE *f, vector<unsigned> &Positions)
+	{
+	unsigned n;
+	ReadStdioValue(f, &n, sizeof(n));
+	Positions.resize(n);
+	for (unsigned i = 0; i < n; ++i)
+		ReadStdioValue(f, &Positions[i], sizeof(unsigned));
+	}
+
+// De novo mode with --threads. A batch of queries is added to the database
+// and each worker process checks its share of them, each query seeing only the
+// queries before it. The results are then accepted in order. Leaving out the
+// batch queries found to be chimeric changes a result only if one of them was
+// a candidate parent, or all of the top word count targets of a chunk were, as
+// then the word count cutoff drops. Those queries are checked again against the
+// sequences actually accepted, so the output is the same as with one thread.
+static unsigned DeNovoBatches(SeqDB &Input, SeqDB &DB, const vector<unsigned> &Order,
+  float MinFractId)
+	{
+	const unsigned QuerySeqCount = SIZE(Order);
+	unsigned HitCount = 0;
+	for (unsigned BatchLo = 0; BatchLo < QuerySeqCount; )
+		{
+		unsigned BatchSize = min(QuerySeqCount - BatchLo, opt_threads*QUERIES_PER_THREAD);
+		unsigned WorkerCount = min(opt_threads, BatchSize);
+
+		const unsigned DBCount = DB.GetSeqCount();
+		for (unsigned k = 0; k < BatchSize; ++k)
+			{
+			SeqData QSD;
+			Input.GetSeqData(Order[BatchLo + k], QSD);
+			DB.AddSeq(QSD.Label, QSD.Seq, QSD.L);
+			}
+
+		vector<FILE *> Hits;
+		vector<FILE *> Alns;
+		vector<FILE *> Results;
+		for (unsigned w = 0; w < WorkerCount; ++w)
+			{
+			Hits.push_back(tmpfile());
+			Alns.push_back(tmpfile());
+			Results.push_back(tmpfile());
+			if (Hits[w] == 0 || Alns[w] == 0 || Results[w] == 0)
+				Die("Cannot create temporary file, errno=%d %s", errno, strerror(errno));
+			}
+
+	// Anything still buffered would be written again by each worker.
+		fflush(0);
+
+		vector<pid_t> Pids;
+		for (unsigned w = 0; w < WorkerCount; ++w)
+			{
+			pid_t Pid = fork();
+			if (Pid < 0)
+				Die("fork failed, errno=%d %s", errno, strerror(errno));
+			if (Pid == 0)
+				{
+				RunWorker(Input, DB, Order, BatchLo, BatchSize, DBCount, w, WorkerCount,
+				  MinFractId, Hits[w], Alns[w], Results[w]);
+				_exit(0);
+				}
+			Pids.push_back(Pid);
+			}
+
+		bool WorkerFailed = false;
+		for (unsigned w = 0; w < WorkerCount; ++w)
+			{
+			int Status = 0;
+			if (waitpid(Pids[w], &Status, 0) != Pids[w] || !WIFEXITED(Status) || WEXITSTATUS(Status) != 0)
+				WorkerFailed = true;
+			}
+		if (WorkerFailed)
+			Die("uchime worker process failed");
+
+		DB.Truncate(DBCount);
+
+		vector<BatchResult> Batch(BatchSize);
+		for (unsigned w = 0; w < WorkerCount; ++w)
+			{
+			rewind(Results[w]);
+			for (unsigned k = w; k < BatchSize; k += WorkerCount)
+				{
+				BatchResult &R = Batch[k];
+				R.Worker = w;
+
+				unsigned Found;
+				ReadStdioValue(Results[w], &Found, sizeof(Found));
+				ReadStdioValue(Results[w], &R.HitLo, sizeof(R.HitLo));
+				ReadStdioValue(Results[w], &R.HitHi, sizeof(R.HitHi));
+				ReadStdioValue(Results[w], &R.AlnLo, sizeof(R.AlnLo));
+				ReadStdioValue(Results[w], &R.AlnHi, sizeof(R.AlnHi));
+				R.Found = (Found != 0);
+				ReadBatchPositions(Results[w], R.Parents);
+
+				unsigned TopCount;
+				ReadStdioValue(Results[w], &TopCount, sizeof(TopCount));
+				R.Tops.resize(TopCount);
+				for (unsigned j = 0; j < TopCount; ++j)
+					ReadBatchPositions(Results[w], R.Tops[j]);
+				}
+			}
+
+		vector<bool> Chimeric(BatchSize, false);
+		for (unsigned k = 0; k < BatchSize; ++k)
+			{
+			const BatchResult &R = Batch[k];
+			unsigned QuerySeqIndex = Order[BatchLo + k];
+
+			bool Stands = true;
+			for (unsigned j = 0; j < SIZE(R.Parents); ++j)
+				if (Chimeric[R.Parents[j]])
+					Stands = false;
+
+			for (unsigned j = 0; j < SIZE(R.Tops); ++j)
+				{
+				bool TopKept = false;
+				for (unsigned t = 0; t < SIZE(R.Tops[j]); ++t)
+					if (!Chimeric[R.Tops[j][t]])
+						TopKept = true;
+				if (!TopKept)
+					Stands = false;
+				}
+
+			bool Found = false;
+			if (Stands)
+				{
+				Found = R.Found;
+				CopyStdioRange(Hits[R.Worker], R.HitLo, R.HitHi, g_fUChime);
+				CopyStdioRange(Alns[R.Worker], R.AlnLo, R.AlnHi, g_fUChimeAlns);
+				}
+			else
+				Found = SearchQuery(Input, DB, QuerySeqIndex, MinFractId);
+
+			Chimeric[k] = Found;
+			if (Found)
+				++HitCount;
+			else
+				{
+				SeqData QSD;
+				Input.GetSeqData(QuerySeqIndex, QSD);
+				DB.AddSeq(QSD.Label, QSD.Seq, QSD.L);
+				}
+
+			unsigned i = BatchLo + k;
+			ProgressStep(i, QuerySeqCount, "%u/%u chimeras found (%.1f%%)", HitCount, i, Pct(HitCount, i+1));
+			}
+
+		for (unsigned w = 0; w < WorkerCount; ++w)
+			{
+			fclose(Hits[w]);
+			fclose(Alns[w]);
+			fclose(Results[w]);
+			}
+
+		BatchLo += BatchSize;
+		}
+	return HitCount;
+	}
+
+#endif // !_WIN32
+
 int main(int argc, char *argv[])
 	{
 		
@@ -169,34 +464,38 @@ int main(int argc, char *argv[])
 			Die("Database contains amino acid sequences");
 		}
 
-	vector<ChimeHit2> Hits;
+	bool Batches = (g_UchimeDeNovo && opt_threads > 1);
+#if	defined(_WIN32)
+	if (Batches)
+		{
+		Warning("--threads is not supported on Windows, using 1");
+		Batches = false;
+		}
+#endif
+
 	unsigned HitCount = 0;
+#if	!defined(_WIN32)
+	if (Batches)
+		HitCount = DeNovoBatches(Input, DB, Order, MinFractId);
+	else
+#endif
 	for (unsigned i = 0; i < QuerySeqCount; ++i)
 		{
 		unsigned QuerySeqIndex = Order[i];
 
-		SeqData QSD;
-		Input.GetSeqData(QuerySeqIndex, QSD);
-
-		float QAb = -1.0;
-		if (g_UchimeDeNovo)
-			QAb = GetAbFromLabel(QSD.Label);
-
-		ChimeHit2 Hit;
-		AlnParams &AP = *(AlnParams *) 0;
-		AlnHeuristics &AH = *(AlnHeuristics *) 0;
-		HSPFinder &HF = *(HSPFinder *) 0;
-		bool Found = SearchChime(DB, QSD, QAb, AP, AH, HF, MinFractId, Hit);
+		bool Found = SearchQuery(Input, DB, QuerySeqIndex, MinFractId);
 		if (Found)
 			++HitCount;
 		else
 			{
 			if (g_UchimeDeNovo)
+				{
+				SeqData QSD;
+				Input.GetSeqData(QuerySeqIndex, QSD);
 				DB.AddSeq(QSD.Label, QSD.Seq, QSD.L);
+				}
 			}
 
-		WriteChimeHit(g_fUChime, Hit);
-
 		ProgressStep(i, QuerySeqCount, "%u/%u chimeras found (%.1f%%)", HitCount, i, Pct(HitCount, i+1));
 		}
 
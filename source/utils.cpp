@@ -203,6 +203,22 @@ int Utils::getRandomIndex(int highest){
         exit(1);
     }
 
+}
+/***********************************************************************/
+
+long long Utils::getRandomLongIndex(long long highest){
+    try {
+        if (highest == 0) { return 0; }
+
+        uniform_int_distribution<long long> dis(0, highest);
+        long long random = dis(mersenne_twister_engine);
+        return random;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "Utils", "getRandomLongIndex");
+        exit(1);
+    }
+
 }
 /***********************************************************************/
 int Utils::getRandomNumber(){
@@ -1125,10 +1141,13 @@ bool Utils::openOutputFileBinaryAppend(string fileName, ofstream& fileHandle){
 /***********************************************************************/
 void Utils::gobble(istream& f){
     try {
+        //uses the stream's buffer directly, f.get() checks the stream for every character
+        if (!f.good()) { f.setstate(ios::failbit); return; }
 
-        char d;
-        while(isspace(d=f.get()))		{ ;}
-        if(!f.eof()) { f.putback(d); }
+        streambuf* buffer = f.rdbuf();
+        int d = buffer->sgetc();
+        while ((d != char_traits<char>::eof()) && isspace(d)) { d = buffer->snextc(); }
+        if (d == char_traits<char>::eof()) { f.setstate(ios::eofbit | ios::failbit); }
     }
     catch(exception& e) {
         m->errorOut(e, "Utils", "gobble");
@@ -1197,9 +1216,15 @@ string Utils::getline(istringstream& fileHandle) {
 string Utils::getline(ifstream& fileHandle) {
     try {
         string line = "";
-        while (fileHandle)	{
+        if (!fileHandle) { return line; }
+
+        //uses the stream's buffer directly, fileHandle.get() checks the stream for every character
+        streambuf* buffer = fileHandle.rdbuf();
+        while (true)	{
             //get next character
-            char c = fileHandle.get();
+            int next = buffer->sbumpc();
+            if (next == char_traits<char>::eof()) { fileHandle.setstate(ios::eofbit | ios::failbit); break; }
+            char c = next;
 
             //are you at the end of the line
             if ((c == '\n') || (c == '\r') || (c == '\f') || (c == EOF)){  break;	}
@@ -27,6 +27,7 @@ public:
     
     //random operations
     int getRandomIndex(int); //highest
+    long long getRandomLongIndex(long long); //highest, for counts past INT_MAX
     int getRandomNumber();
     float randomUniform();
     float randomExp();